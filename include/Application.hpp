@@ -1,4 +1,5 @@
 #pragma once
+#include "Foundation/MemoryProfiler.hpp"
 #include "Foundation/Profiler.hpp"
 #include "Graphics/Renderer.hpp"
 
@@ -72,8 +73,10 @@ class Application
         {                                                                      \
             std::cerr << ex.what() << '\n';                                    \
             GT_FINALIZE_PROFILING;                                             \
+            GT_FINALIZE_MEMORY_PROFILING;                                      \
             return EXIT_FAILURE;                                               \
         }                                                                      \
         GT_FINALIZE_PROFILING;                                                 \
+        GT_FINALIZE_MEMORY_PROFILING;                                          \
         return EXIT_SUCCESS;                                                   \
     }
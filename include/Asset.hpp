@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Foundation/MemoryProfiler.hpp"
 #include "Foundation/Profiler.hpp"
 #include "Foundation/portable_iarchive.hpp"
 #include "Foundation/portable_oarchive.hpp"
@@ -78,6 +79,7 @@ template <class T>
 template <class Archive, class S>
 std::shared_ptr<const T> Asset<T>::request(S&& name)
 {
+    GT_PROFILE_MEMORY(Asset);
     auto iter = sCache.find(name);
     if (iter != sCache.end())
     {
@@ -123,6 +125,7 @@ template <class T>
 template <class Archive, class S>
 std::shared_ptr<const T> Asset<T>::loadFromPersistentMedia(S&& name)
 {
+    GT_PROFILE_MEMORY(Asset);
     std::ifstream input(getFilePath(name));
     Archive ia(input);
     std::shared_ptr<T> ptr(new T(std::forward<S>(name)));
@@ -96,12 +96,28 @@ class Entity : public Object<Entity, std::string>
     SQT mLocalTransform;
     mat4f mGlobalTransform;
 
+    // The inverse of mGlobalTransform. It is updated together with
+    // mGlobalTransform, so that it is computed once per change instead of
+    // once per light and per shadow caster.
+    mat4f mViewMatrix;
+
+    // Whether this entity or one of its ancestors has a non-uniform scale.
+    bool mNonUniformScale;
+
+    // The global bounding box, and the local bounding box of the mesh that
+    // it was computed from. Without a mesh, the local bounding box is the
+    // point at the origin.
+    box3f mGlobalBoundingBox;
+    box3f mLocalBoundingBox;
+
     children_datastructure_type mChildren;
 
     WeakPtr mParent = SharedPtr(nullptr);
 
     void updateGlobalInfo() noexcept;
 
+    void updateGlobalBoundingBox() noexcept;
+
   public:
     /// \brief Calls update on all of its components.
     void update();
@@ -318,6 +334,38 @@ class Entity : public Object<Entity, std::string>
     AnimationClip* activeAnimationClip = nullptr;
     float activeAnimationStartTime = 0.0f;
 
+    /**
+     * @brief The blend of clips that plays on this Entity. When set, it
+     * is used instead of activeAnimationClip. Not owned and not
+     * serialized.
+     */
+    AnimationBlend* activeAnimationBlend = nullptr;
+
+    /**
+     * @brief Set wether this Entity casts a shadow, and fire the
+     * onRenderStateChange event.
+     * @param yesOrNo True if this Entity casts a shadow, false if not.
+     */
+    void setCastShadow(const bool yesOrNo);
+
+    /**
+     * @brief Set the Material, and fire the onRenderStateChange event.
+     * @param newMaterial The new Material. May be null.
+     */
+    void setMaterial(std::shared_ptr<Material> newMaterial);
+
+    /**
+     * @brief Set the Mesh, and fire the onRenderStateChange event.
+     * @param newMesh The new Mesh. May be null.
+     */
+    void setMesh(std::shared_ptr<Mesh> newMesh);
+
+    /**
+     * @brief Set the Light, and fire the onRenderStateChange event.
+     * @param newLight The new Light. May be null.
+     */
+    void setLight(std::shared_ptr<Light> newLight);
+
     /**
      * @name Events
      */
@@ -336,6 +384,15 @@ class Entity : public Object<Entity, std::string>
      */
     boost::signals2::signal<void(SharedPtr)> onTransformChange;
 
+    /**
+     * @brief Event that fires when the castShadow flag, the Material, the
+     * Mesh or the Light has changed.
+     * @details The setters fire this event. If you assign to the members
+     * directly, fire it yourself so that the Renderer picks up the change.
+     * @param e A pointer to the Entity that has changed.
+     */
+    boost::signals2::signal<void(Entity*)> onRenderStateChange;
+
     //@}
 
     /**
@@ -665,23 +722,40 @@ class Entity : public Object<Entity, std::string>
 
     /**
      * @brief Update the given `VIEW` matrix.
-     * @details The assumption is that the given matrix
-     * is already an affine matrix. If it's not, this
-     * method will produce incorrect results. This method
-     * is a tiny bit more efficient than Entity::getViewMatrix
-     * @param alreadyAffineMatrix A mutable reference to a
-     * matrix which is assumed to already be affine.
+     * @details The view matrix is cached, so this is the same as
+     * Entity::getViewMatrix. It is kept for existing callers.
+     * @param alreadyAffineMatrix A mutable reference to a matrix.
      *
      * @sa Entity::getViewMatrix
      */
     void updateViewMatrix(mat4f& alreadyAffineMatrix) const noexcept;
 
     /**
-     * @brief Get the `VIEW` matrix of this Entity.
-     * @return The view matrix.
+     * @brief Get the `VIEW` matrix of this Entity, i.e. from `WORLD` space
+     * to `MODEL` space.
+     * @details This is the inverse of the global transformation matrix. It
+     * is computed with mat4f::inverseAffine whenever the global
+     * transformation changes, so getting it is free. Scaled entities get a
+     * correct inverse too.
+     * @return A constant reference to the view matrix.
      * @sa Entity::updateViewMatrix
      */
-    mat4f getViewMatrix() const noexcept;
+    inline const mat4f& getViewMatrix() const noexcept { return mViewMatrix; }
+
+    /**
+     * @brief Check whether the global transformation may scale
+     * non-uniformly or shear.
+     * @details This is tracked from the scales of the local transforms of
+     * this Entity and its ancestors, whenever the global transformation
+     * changes. When it is false, the normal matrix is a multiple of the
+     * global transformation. See mat4f::normalMatrix.
+     * @return True if this Entity or one of its ancestors has a non-uniform
+     * scale.
+     */
+    inline bool hasNonUniformScale() const noexcept
+    {
+        return mNonUniformScale;
+    }
 
     /**
      * @brief Get the global transformation matrix, i.e. from `MODEL` space
@@ -695,10 +769,29 @@ class Entity : public Object<Entity, std::string>
 
     /**
      * @brief Get the global bounding box.
-     * @return A constant reference to the global bounding box.
+     * @details This is the smallest axis-aligned box that contains the
+     * local bounding box of the mesh, transformed by the global
+     * transformation. It is cached, and updated together with the global
+     * transformation and by Entity::setMesh. If the mesh was assigned
+     * directly, or its local bounding box changed since then, the box is
+     * computed on the fly.
+     * @return The global bounding box.
+     * @sa Entity::globalBoundingBoxes
      */
     box3f globalBoundingBox() const noexcept;
 
+    /**
+     * @brief Get the global bounding boxes of an array of entities.
+     * @details The cached boxes are copied. The boxes that are not cached
+     * are transformed in one batch.
+     * @param entities The entities.
+     * @param count The number of entities.
+     * @param result Receives the global bounding box of every Entity.
+     * @sa Entity::globalBoundingBox
+     */
+    static void globalBoundingBoxes(const SharedPtr* entities,
+                                    const std::size_t count, box3f* result);
+
     //@}
 
     /**
@@ -787,12 +880,20 @@ class Entity : public Object<Entity, std::string>
         archive& boost::serialization::base_object<Super>(*this);
         archive& mLocalTransform;
         archive& mGlobalTransform;
+        if (Archive::is_loading::value)
+        {
+            mViewMatrix = mGlobalTransform.inverseAffine();
+            // The ancestors are not known yet, so assume the worst until
+            // the global transformation is updated.
+            mNonUniformScale = true;
+        }
         archive& mParent;
         // archive & mOctree;
         // archive & mOctreeListIter;
         archive& castShadow;
         archive& material;
         archive& mesh;
+        if (Archive::is_loading::value) updateGlobalBoundingBox();
         archive& light;
         archive& camera;
         archive& animationClips;
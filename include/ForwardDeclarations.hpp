@@ -27,6 +27,11 @@ union mat4f;
 struct SQT;
 struct box2f;
 struct box3f;
+struct frustum3f;
+struct obb3f;
+struct plane3f;
+struct ray3f;
+struct sphere3f;
 class MatrixPipeline;
 class mat4fstack;
 class SQTstack;
@@ -36,6 +41,7 @@ namespace GUI
 {
 class Base;
 }
+class AnimationBlend;
 class AnimationClip;
 class DirectionalShadowBuffer;
 class Font;
@@ -52,6 +58,7 @@ class Material;
 class Renderer;
 class Skybox;
 class Skeleton;
+class SkinnedPositions;
 class Mesh;
 class MaterialShaderProgram;
 class ShadowShaderProgram;
@@ -0,0 +1,54 @@
+/**
+ * @file CPU.hpp
+ * @brief Defines the detection of the SIMD instruction sets of the CPU.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include <iosfwd>
+
+namespace gintonic {
+
+/**
+ * @brief The instruction sets that the batched math kernels are compiled
+ * for.
+ * @details The library itself targets SSE3. The kernels of
+ * Math/Transforms.hpp, Math/Skinning.hpp, Math/SQTArray.hpp and the batched
+ * frustum3f::intersects are compiled once for every level, and the best
+ * level that the CPU supports is picked at runtime.
+ */
+enum class SIMDLevel : int
+{
+	kSSE3 = 0, ///< The baseline.
+	kAVX,      ///< AVX, two or eight lanes at a time.
+	kAVX2      ///< AVX2 with fused multiply-add.
+};
+
+/**
+ * @brief Get the best level that the CPU and the operating system support.
+ * @details This is detected with CPUID once.
+ */
+SIMDLevel supportedSIMDLevel() noexcept;
+
+/**
+ * @brief Get the level that the kernels use.
+ * @details This is the supported level, unless it was lowered by
+ * forceSIMDLevel, or by setting the environment variable GINTONIC_SIMD to
+ * sse3, avx or avx2 before the first call.
+ */
+SIMDLevel activeSIMDLevel() noexcept;
+
+/**
+ * @brief Make the kernels use another level, for instance to compare the
+ * levels in a benchmark.
+ * @param level The level. A level that is not supported is lowered to the
+ * supported level.
+ * @return The level that is used from now on.
+ */
+SIMDLevel forceSIMDLevel(const SIMDLevel level) noexcept;
+
+/// Output stream support for a SIMDLevel.
+std::ostream& operator << (std::ostream& os, const SIMDLevel level);
+
+} // namespace gintonic
@@ -0,0 +1,203 @@
+/**
+ * @file MemoryProfiler.hpp
+ * @brief Defines a memory profiler that tracks heap allocations per
+ * subsystem, and useful macros to use the memory profiler functionality.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "config.hpp"
+
+#ifdef gintonic_WITH_MEMORY_PROFILING
+
+/**
+ * @brief Put this macro at the beginning of a scope to attribute all heap
+ * allocations made in that scope (on the current thread) to a subsystem.
+ *
+ * @param subsystem One of the enumerators of
+ * gintonic::MemoryProfiler::Subsystem, without qualification.
+ */
+#define GT_PROFILE_MEMORY(subsystem) ::gintonic::MemoryProfiler::Scope __dont_touch_my_memory__(::gintonic::MemoryProfiler::Subsystem::subsystem);
+
+/**
+ * @brief Put this macro at the end of each frame. It closes the per-frame
+ * allocation counters.
+ */
+#define GT_PROFILE_MEMORY_NEXT_FRAME ::gintonic::MemoryProfiler::nextFrame();
+
+/**
+ * @brief Put this macro at the end of the program.
+ * @details This macro will write the memory profiling results of all
+ * subsystems to the file GT_PROFILING_MEM_LOG_FILE.
+ */
+#define GT_FINALIZE_MEMORY_PROFILING ::gintonic::MemoryProfiler::writeLogToFile(GT_PROFILING_MEM_LOG_FILE);
+
+#else
+
+#define GT_PROFILE_MEMORY(subsystem)
+#define GT_PROFILE_MEMORY_NEXT_FRAME
+#define GT_FINALIZE_MEMORY_PROFILING
+
+#endif
+
+/**
+ * @brief The file to save the memory profiling log to.
+ */
+#ifndef GT_PROFILING_MEM_LOG_FILE
+#define GT_PROFILING_MEM_LOG_FILE "MemProfilingResults.csv"
+#endif
+
+namespace gintonic {
+
+/**
+ * @brief Tracks heap allocations per subsystem.
+ * @details Every allocation made through MemoryProfiler::allocate is
+ * prefixed with a small header that remembers its size and the subsystem
+ * that was active when the allocation was made, so that the matching
+ * deallocation is always attributed to the same subsystem. When the macro
+ * gintonic_WITH_MEMORY_PROFILING is defined (in the config.cmake file), the
+ * global operator new and operator delete, gintonic::allocator and the
+ * aligned class-specific operator new and operator delete all route through
+ * this class. Otherwise, nothing is recorded unless you call allocate and
+ * deallocate yourself. All counters are atomic, so allocations may happen
+ * on any thread.
+ */
+class MemoryProfiler
+{
+public:
+
+	/// The subsystems that allocations can be attributed to.
+	enum class Subsystem : std::uint8_t
+	{
+		General,
+		Renderer,
+		Octree,
+		Mesh,
+		Asset,
+		Animation,
+		Count
+	};
+
+	/// A snapshot of the counters of one subsystem.
+	struct Statistics
+	{
+		/// The total number of allocations.
+		std::size_t allocations;
+
+		/// The total number of deallocations.
+		std::size_t deallocations;
+
+		/// The total number of bytes ever allocated.
+		std::size_t totalBytes;
+
+		/// The number of bytes currently allocated.
+		std::size_t liveBytes;
+
+		/// The highest value that liveBytes has ever had.
+		std::size_t peakBytes;
+
+		/// The number of allocations during the last completed frame.
+		std::size_t allocationsLastFrame;
+
+		/// The number of bytes allocated during the last completed frame.
+		std::size_t bytesLastFrame;
+
+		/// The highest number of allocations during any completed frame.
+		std::size_t maxAllocationsPerFrame;
+
+		/// The number of completed frames.
+		std::size_t frames;
+
+		/**
+		 * @brief The average number of allocations per completed frame.
+		 * @return The average number of allocations per completed frame.
+		 */
+		double averageAllocationsPerFrame() const noexcept;
+	};
+
+	/**
+	 * @brief Attributes all allocations on the current thread to a
+	 * subsystem for the duration of its lifetime. Scopes nest.
+	 */
+	class Scope
+	{
+	public:
+
+		/**
+		 * @brief Make the given subsystem the current one.
+		 * @param subsystem The subsystem.
+		 */
+		Scope(const Subsystem subsystem) noexcept;
+
+		/// Restores the previously active subsystem.
+		~Scope() noexcept;
+
+		Scope(const Scope&) = delete;
+		Scope& operator = (const Scope&) = delete;
+
+	private:
+
+		const Subsystem mPrevious;
+	};
+
+	/**
+	 * @brief Get the subsystem that is active on the current thread.
+	 * @return The subsystem that is active on the current thread.
+	 */
+	static Subsystem current() noexcept;
+
+	/**
+	 * @brief Allocate memory and record the allocation.
+	 * @param bytes The number of bytes to allocate.
+	 * @param alignment The alignment of the returned pointer. Must be a
+	 * power of two.
+	 * @return A pointer to the allocated memory, or a null pointer when
+	 * the system is out of memory.
+	 */
+	static void* allocate(const std::size_t bytes, const std::size_t alignment) noexcept;
+
+	/**
+	 * @brief Deallocate memory obtained from allocate and record the
+	 * deallocation.
+	 * @param ptr The pointer returned by allocate. May be null.
+	 */
+	static void deallocate(void* ptr) noexcept;
+
+	/**
+	 * @brief Close the per-frame counters. Call this once per frame.
+	 */
+	static void nextFrame() noexcept;
+
+	/**
+	 * @brief Get a snapshot of the counters of a subsystem.
+	 * @param subsystem The subsystem.
+	 * @return A snapshot of the counters of the subsystem.
+	 */
+	static Statistics get(const Subsystem subsystem) noexcept;
+
+	/**
+	 * @brief Get the name of a subsystem.
+	 * @param subsystem The subsystem.
+	 * @return The name of the subsystem.
+	 */
+	static const char* name(const Subsystem subsystem) noexcept;
+
+	/**
+	 * @brief Reset the allocation, deallocation, byte and frame counters
+	 * to zero. The live byte count is kept, because memory that is still
+	 * allocated will be released later on, and the peak is lowered to the
+	 * live byte count.
+	 */
+	static void reset() noexcept;
+
+	/**
+	 * @brief Write the memory statistics of all subsystems as a CSV file.
+	 * @param logFile The filename to write to.
+	 */
+	static void writeLogToFile(const char* logFile);
+};
+
+} // namespace gintonic
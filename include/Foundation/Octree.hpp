@@ -7,6 +7,7 @@
 #pragma once
 
 #include "Math/box3f.hpp"
+#include "Math/frustum3f.hpp"
 #include "Entity.hpp"
 
 #include <boost/signals2/signal.hpp>
@@ -348,6 +349,20 @@ public:
 	template <class OutputIter, class FilterFunc>
 	void query(const box3f& volume, OutputIter iter, FilterFunc filter) const;
 
+	/**
+	 * @brief Query a view frustum to obtain all the entities that are
+	 * (partially) inside it.
+	 * @details Nodes that are outside the frustum are skipped entirely, and
+	 * nodes that are completely inside are added without testing their
+	 * entities. Only the entities of the nodes that straddle a plane are
+	 * tested individually. This is the const version, so you'll get a
+	 * container of immutable entities.
+	 * @param frustum The view frustum.
+	 * @param iter An output iterator to store the results.
+	 */
+	template <class OutputIter>
+	void query(const frustum3f& frustum, OutputIter iter) const;
+
 	/**
 	 * @brief Apply a function to every Entity.
 	 * @tparam Func Type of a function pointer, lambda, functor, etc.
@@ -819,6 +834,35 @@ void Octree::query(const box3f& volume, OutputIter iter, FilterFunc filter) cons
 	}
 }
 
+template <class OutputIter>
+void Octree::query(const frustum3f& frustum, OutputIter iter) const
+{
+	for (const auto& lHolder : mEntities)
+	{
+		if (std::shared_ptr<const Entity> lEntityPtr = lHolder.entity.lock())
+		{
+			if (frustum.intersects(lEntityPtr->globalBoundingBox()))
+			{
+				*iter = std::move(lEntityPtr);
+				++iter;
+			}
+		}
+	}
+	if (mAllocationPlace == nullptr) return;
+	for (const auto* lChildNode : mChild)
+	{
+		if (lChildNode == nullptr) continue;
+		if (frustum.contains(lChildNode->mBounds))
+		{
+			lChildNode->getEntities(iter);
+		}
+		else if (frustum.intersects(lChildNode->mBounds))
+		{
+			lChildNode->query(frustum, iter);
+		}
+	}
+}
+
 template <class Func> 
 void Octree::foreach(Func f)
 {
@@ -23,13 +23,6 @@
 #define GT_PROFILING_LOG_FILE "ProfilingResults.csv"
 #endif
 
-/**
- * @brief The file to save the memory profiling log to.
- */
-#ifndef GT_PROFILING_MEM_LOG_FILE
-#define GT_PROFILING_MEM_LOG_FILE "MemProfilingResults.csv"
-#endif
-
 #ifdef WITH_PROFILING
 /**
  * @brief Put this macro at the beginning of a function to profile it.
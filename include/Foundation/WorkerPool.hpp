@@ -0,0 +1,101 @@
+/**
+ * @file WorkerPool.hpp
+ * @brief Defines a pool of worker threads that split a range of work.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gintonic {
+
+/**
+ * @brief A fixed set of worker threads that work on a range of items
+ * together.
+ *
+ * @details WorkerPool::run cuts a range of items into chunks. The workers
+ * and the calling thread take chunks until none are left, and run returns
+ * when every chunk is done. The workers sleep in between runs, so the
+ * threads are started only once.
+ *
+ * Only one thread may call WorkerPool::run at a time, and the task may not
+ * call WorkerPool::run itself.
+ */
+class WorkerPool
+{
+public:
+
+	/// The task of a run. It is called with a chunk [first, last).
+	using Task = std::function<void(std::size_t, std::size_t)>;
+
+	/**
+	 * @brief Constructor. Starts the worker threads.
+	 * @param workerCount The number of worker threads. With zero workers,
+	 * every run is done on the calling thread.
+	 */
+	explicit WorkerPool(const std::size_t workerCount = defaultWorkerCount());
+
+	/// Stops and joins the worker threads.
+	~WorkerPool() noexcept;
+
+	/// You cannot copy a WorkerPool.
+	WorkerPool(const WorkerPool&) = delete;
+
+	/// You cannot copy a WorkerPool.
+	WorkerPool& operator = (const WorkerPool&) = delete;
+
+	/**
+	 * @brief The number of workers to use when nothing else is known. This
+	 * is one less than the number of hardware threads, since the calling
+	 * thread takes chunks as well.
+	 */
+	static std::size_t defaultWorkerCount() noexcept;
+
+	/// Get the number of worker threads.
+	inline std::size_t workerCount() const noexcept
+	{
+		return mWorkers.size();
+	}
+
+	/**
+	 * @brief Run a task over the items [0, count).
+	 * @details Returns when the task has been called for every chunk. Runs
+	 * with a single chunk do not wake the workers.
+	 * @param count The number of items.
+	 * @param chunkSize The number of items per chunk. Zero is treated as
+	 * one.
+	 * @param task The task. It must be safe to call it from several threads
+	 * at once for different chunks.
+	 */
+	void run(const std::size_t count, const std::size_t chunkSize,
+		const Task& task);
+
+private:
+
+	void workerLoop();
+	void runChunks();
+
+	// The run that is in progress.
+	const Task* mTask = nullptr;
+	std::size_t mCount = 0;
+	std::size_t mChunkSize = 1;
+	std::size_t mChunkCount = 0;
+	std::atomic<std::size_t> mNextChunk;
+
+	std::vector<std::thread> mWorkers;
+	std::mutex mMutex;
+	std::condition_variable mWake;
+	std::condition_variable mDone;
+	std::size_t mGeneration = 0;
+	std::size_t mBusyWorkers = 0;
+	bool mQuit = false;
+};
+
+} // namespace gintonic
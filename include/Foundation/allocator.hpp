@@ -7,6 +7,7 @@
 #pragma once
 
 #include "Foundation/simd.hpp"
+#include "Foundation/MemoryProfiler.hpp"
 
 #include <memory>
 #include <cstddef>
@@ -137,7 +138,11 @@ public:
 	 */
 	inline T* allocate(const std::size_t n) const
 	{
+		#ifdef gintonic_WITH_MEMORY_PROFILING
+		return static_cast<T*>(MemoryProfiler::allocate(n * sizeof(T), Alignment));
+		#else
 		return static_cast<T*>(_mm_malloc(n * sizeof(T), Alignment));
+		#endif
 	}
 
 	/**
@@ -147,7 +152,11 @@ public:
 	 */
 	inline void deallocate(T* const p, const std::size_t n) const
 	{
+		#ifdef gintonic_WITH_MEMORY_PROFILING
+		MemoryProfiler::deallocate(p);
+		#else
 		_mm_free(p);
+		#endif
 	}
 
 	/**
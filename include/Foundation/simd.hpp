@@ -76,6 +76,16 @@
 
 #define _mm_negate(v) _mm_xor_ps((v), _mm_set1_ps(-0.0f))
 
+// a * b + c, fused when the compiler targets FMA. MSVC has no __FMA__, but
+// /arch:AVX2 implies it.
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define _mm_madd_ps(a,b,c) _mm_fmadd_ps((a),(b),(c))
+#define _mm256_madd_ps(a,b,c) _mm256_fmadd_ps((a),(b),(c))
+#else
+#define _mm_madd_ps(a,b,c) _mm_add_ps(_mm_mul_ps((a),(b)),(c))
+#define _mm256_madd_ps(a,b,c) _mm256_add_ps(_mm256_mul_ps((a),(b)),(c))
+#endif
+
 // #ifdef BOOST_MSVC
 
 #define _mm_x000_ps(v) _mm_and_ps((v),                   _mm_castsi128_ps(_mm_setr_epi32(0xffffffff, 0x0, 0x0, 0x0)))
@@ -14,6 +14,7 @@
 
 #include "simd.hpp"
 #include "config.hpp"
+#include "MemoryProfiler.hpp"
 
 #ifdef BOOST_MSVC
 
@@ -39,6 +40,22 @@
 
 #endif
 
+#ifdef gintonic_WITH_MEMORY_PROFILING
+	#define GINTONIC_ALIGNED_MALLOC(count, alignment) ::gintonic::MemoryProfiler::allocate(count, alignment)
+	#define GINTONIC_ALIGNED_FREE(ptr) ::gintonic::MemoryProfiler::deallocate(ptr)
+#else
+	/**
+	 * @brief Allocate aligned memory. Routes through the MemoryProfiler
+	 * when memory profiling is enabled.
+	 */
+	#define GINTONIC_ALIGNED_MALLOC(count, alignment) _mm_malloc(count, alignment)
+
+	/**
+	 * @brief Free memory obtained with GINTONIC_ALIGNED_MALLOC.
+	 */
+	#define GINTONIC_ALIGNED_FREE(ptr) _mm_free(ptr)
+#endif
+
 /**
  * @brief Convenience macro to define custom operator new / operator delete
  * for your class to get your class aligned on a memory boundary.
@@ -48,11 +65,11 @@
 #define GINTONIC_DEFINE_ALIGNED_OPERATOR_NEW_DELETE(alignment)               \
 inline static void* operator new(const std::size_t count)                    \
 {                                                                            \
-	return _mm_malloc(count, alignment);                                     \
+	return GINTONIC_ALIGNED_MALLOC(count, alignment);                        \
 }                                                                            \
 inline static void* operator new[](const std::size_t count)                  \
 {                                                                            \
-	return _mm_malloc(count, alignment);                                     \
+	return GINTONIC_ALIGNED_MALLOC(count, alignment);                        \
 }                                                                            \
 inline static void* operator new(const std::size_t /*count*/, void* here)    \
 {                                                                            \
@@ -66,11 +83,11 @@ inline static void* operator new[](const std::size_t /*count*/, void* here)  \
 }                                                                            \
 inline static void operator delete(void* ptr)                                \
 {                                                                            \
-	_mm_free(ptr);                                                           \
+	GINTONIC_ALIGNED_FREE(ptr);                                              \
 }                                                                            \
 inline static void operator delete[](void* ptr)                              \
 {                                                                            \
-	_mm_free(ptr);                                                           \
+	GINTONIC_ALIGNED_FREE(ptr);                                              \
 }                                                                            \
 inline static void operator delete(void* ptr, void* here)                    \
 {                                                                            \
@@ -0,0 +1,105 @@
+/**
+ * @file AnimationBlend.hpp
+ * @brief Defines the blending and layering of animation clips.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "../ForwardDeclarations.hpp"
+
+#include "../Foundation/allocator.hpp"
+
+#include "../Math/mat4f.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace gintonic
+{
+
+class PosePool; // Forward declaration.
+class SQTArray; // Forward declaration.
+
+/**
+ * @brief Blends the clips that play on one entity at runtime, so that
+ * transitions and layers need not be baked into clips of their own.
+ *
+ * @details Every layer samples its clip into a local pose from a PosePool.
+ * The first layer is the base pose. Every next layer is blended into the
+ * result with its weight, times the weight of the joint in its mask:
+ *
+ * - A regular layer is interpolated towards its pose: the scales and
+ *   translations linearly, the rotations by an nlerp. A crossfade is a
+ *   second layer whose weight goes from zero to one.
+ * - An additive layer adds the difference between its pose and the first
+ *   frame of its clip.
+ *
+ * All of this works on the local poses with SIMD; see SQTArray. The joints
+ * are composed into model space once, at the end. All clips must animate
+ * the skeleton of the clip of the first layer.
+ */
+class AnimationBlend
+{
+  public:
+    /// A weight per joint, padded like a channel of an SQTArray.
+    using JointMask = std::vector<float, allocator<float, 32>>;
+
+    /// A clip that plays on the entity.
+    struct Layer
+    {
+        /// The clip.
+        const AnimationClip* clip = nullptr;
+
+        /// The time at which the clip started.
+        float startTime = 0.0f;
+
+        /// The weight of the layer. Ignored for the first layer.
+        float weight = 1.0f;
+
+        /// The weight of every joint, or null to weigh all joints fully.
+        /// Ignored for the first layer.
+        const JointMask* mask = nullptr;
+
+        /// Whether the layer is added to the layers below it instead of
+        /// blended with them. Ignored for the first layer.
+        bool additive = false;
+    };
+
+    /**
+     * @brief Make a mask for a skeleton.
+     * @param jointCount The number of joints of the skeleton.
+     * @param value The weight of every joint.
+     * @return The mask.
+     */
+    static JointMask makeMask(const std::size_t jointCount,
+                              const float value = 0.0f);
+
+    /// The layers, from the bottom up.
+    std::vector<Layer> layers;
+
+    /// Get the number of joints, or zero when there are no layers.
+    std::uint8_t jointCount() const noexcept;
+
+    /**
+     * @brief Blend the local poses of all layers.
+     * @param currentTime The current time.
+     * @param pool The pool that the poses of the layers come from.
+     * @param outPose Receives the blended transform of every joint relative
+     * to its parent.
+     */
+    void samplePose(const float currentTime, PosePool& pool,
+                    SQTArray& outPose) const;
+
+    /**
+     * @brief Blend the local poses of all layers and compose the joints.
+     * @param currentTime The current time.
+     * @param pool The pool that the poses come from.
+     * @param outPalette Receives AnimationBlend::jointCount matrices, as
+     * AnimationClip::evaluatePose does.
+     */
+    void evaluatePose(const float currentTime, PosePool& pool,
+                      mat4f* outPalette) const;
+};
+
+} // namespace gintonic
@@ -4,10 +4,14 @@
 
 #include "../Foundation/allocator.hpp"
 
+#include "CompressedAnimation.hpp"
+
 #include "../Math/SQT.hpp"
+#include "../Math/SQTArray.hpp"
 
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/tracking.hpp>
+#include <boost/serialization/version.hpp>
 
 #include <vector>
 
@@ -45,19 +49,104 @@ class AnimationClip
 
     inline uint8_t jointCount() const noexcept
     {
-        return static_cast<uint8_t>(frames.size());
+        return static_cast<uint8_t>(
+            isCompressed() ? mCompressed.jointCount() : frames.size());
     }
 
+    /**
+     * @brief Get the length of the clip in seconds.
+     * @details A clip that does not loop holds its last frame after this.
+     */
+    float duration() const noexcept;
+
     mat4f evaluate(const uint8_t jointIndex, const float startTime,
                    const float currentTime) const noexcept;
 
+    /**
+     * @brief Sample the local transforms of all joints at once.
+     * @details This is the first half of AnimationClip::evaluatePose. Use
+     * it to blend several clips before composing the joints with
+     * Skeleton::compose; see AnimationBlend.
+     * @param startTime The time at which the clip started.
+     * @param currentTime The current time.
+     * @param outPose Receives the transform of every joint relative to its
+     * parent. It is resized to AnimationClip::jointCount.
+     */
+    void samplePose(const float startTime, const float currentTime,
+                    SQTArray& outPose) const;
+
+    /**
+     * @brief Evaluate the matrices of all joints at once.
+     * @details Gives the same matrices as calling AnimationClip::evaluate
+     * for every joint, up to rounding, but the local transform of every
+     * joint is sampled and composed with its parent only once, instead of
+     * once for every descendant. When the clip is packed, the local
+     * transforms of all joints are interpolated at once with SIMD, and the
+     * rotations are nlerped instead of slerped.
+     * @param startTime The time at which the clip started.
+     * @param currentTime The current time.
+     * @param outPalette Receives AnimationClip::jointCount matrices.
+     */
+    void evaluatePose(const float startTime, const float currentTime,
+                      mat4f* outPalette) const noexcept;
+
+    /**
+     * @brief Pack the frames into one SQTArray per frame, so that
+     * AnimationClip::evaluatePose can interpolate all joints at once.
+     * @details Call this again after changing the frames. A joint with
+     * fewer frames than the others holds its last frame.
+     */
+    void pack();
+
+    /// Check whether AnimationClip::pack has been called.
+    inline bool isPacked() const noexcept { return !mPackedFrames.empty(); }
+
+    /// Get the packed frames.
+    inline const std::vector<SQTArray>& packedFrames() const noexcept
+    {
+        return mPackedFrames;
+    }
+
+    /**
+     * @brief Compress the frames.
+     * @details The frames are moved into a CompressedAnimation and
+     * AnimationClip::frames is emptied, as are the packed frames.
+     * AnimationClip::evaluate and AnimationClip::evaluatePose decode the
+     * compressed frames directly. A compressed clip is also serialized
+     * compressed, so this can be done once offline.
+     * @param settings The tolerances.
+     * @throws CompressedAnimation::TooManyFramesException if the clip has
+     * more than 65536 frames.
+     */
+    void compress(const CompressedAnimation::Settings& settings =
+                      CompressedAnimation::Settings());
+
+    /// Check whether AnimationClip::compress has been called.
+    inline bool isCompressed() const noexcept { return !mCompressed.empty(); }
+
+    /// Get the compressed frames.
+    inline const CompressedAnimation& compressed() const noexcept
+    {
+        return mCompressed;
+    }
+
   private:
+    std::vector<SQTArray> mPackedFrames;
+
+    CompressedAnimation mCompressed;
+
+    void sampleTime(const std::size_t frameCount, const float startTime,
+                    const float currentTime, std::size_t& lowerFrame,
+                    std::size_t& upperFrame, float& lambda) const noexcept;
+
     friend class boost::serialization::access;
 
     template <class Archive>
-    void serialize(Archive& archive, const unsigned /*version*/)
+    void serialize(Archive& archive, const unsigned version)
     {
+        GT_PROFILE_MEMORY(Animation);
         archive& name& skeleton& framesPerSecond& isLooping& frames;
+        if (version >= 1) archive& mCompressed;
     }
 };
 
@@ -65,3 +154,4 @@ class AnimationClip
 
 BOOST_CLASS_TRACKING(gintonic::AnimationClip,
                      boost::serialization::track_always);
+BOOST_CLASS_VERSION(gintonic::AnimationClip, 1);
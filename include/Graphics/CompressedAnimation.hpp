@@ -0,0 +1,202 @@
+/**
+ * @file CompressedAnimation.hpp
+ * @brief Defines the compressed storage of the frames of an animation
+ * clip.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "../Foundation/allocator.hpp"
+#include "../Math/SQT.hpp"
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+namespace gintonic
+{
+
+class SQTArray; // Forward declaration.
+
+/**
+ * @brief The frames of an animation clip, compressed.
+ *
+ * @details Every joint has a scale track, a rotation track and a
+ * translation track. Every track is compressed on its own:
+ *
+ * - A track that stays within the tolerance of its first value is stored
+ *   as a single key.
+ * - Otherwise, only the keys that are needed to reconstruct every frame
+ *   within the tolerance by linear interpolation are kept.
+ * - Rotations are quantized with the "smallest three" scheme: the largest
+ *   component is dropped and the other three are stored in 15 bits each.
+ * - Scales and translations are quantized to 16 bits per component within
+ *   the range of their track.
+ *
+ * The tolerance is checked against the quantized keys, so the decoded
+ * frames are within the tolerance of the original frames. A key costs 6
+ * bytes and 2 bytes for its frame number, compared to the 48 bytes of an
+ * SQT.
+ */
+class CompressedAnimation
+{
+  public:
+    /// The error that the compression may introduce.
+    struct Settings
+    {
+        /// The largest error of a component of a scale.
+        float scaleTolerance;
+
+        /// The largest error of a component of a rotation quaternion.
+        float rotationTolerance;
+
+        /// The largest error of a component of a translation.
+        float translationTolerance;
+
+        /// Default constructor sets every tolerance to 0.001.
+        Settings() noexcept
+            : scaleTolerance(1e-3f), rotationTolerance(1e-3f),
+              translationTolerance(1e-3f)
+        {
+        }
+    };
+
+    /// Thrown when a clip has more frames than a key can address.
+    class TooManyFramesException : public std::exception
+    {
+      public:
+        virtual ~TooManyFramesException() noexcept = default;
+        inline const char* what() const noexcept
+        {
+            return "TooManyFramesException";
+        }
+    };
+
+    /// The frames of a clip, stored per joint.
+    using Frames = std::vector<std::vector<SQT, allocator<SQT>>>;
+
+    /// Default constructor constructs an empty animation.
+    CompressedAnimation() = default;
+
+    /**
+     * @brief Compress the frames of a clip.
+     * @details A joint with fewer frames than the others holds its last
+     * frame.
+     * @param frames The frames, per joint.
+     * @param settings The tolerances.
+     * @throws TooManyFramesException if there are more than 65536 frames.
+     */
+    CompressedAnimation(const Frames& frames,
+                        const Settings& settings = Settings());
+
+    /// Get the number of joints.
+    inline std::size_t jointCount() const noexcept
+    {
+        return mRotationTracks.size();
+    }
+
+    /// Get the number of frames.
+    inline std::size_t frameCount() const noexcept { return mFrameCount; }
+
+    /// Check whether there are no joints.
+    inline bool empty() const noexcept { return mRotationTracks.empty(); }
+
+    /// Get the number of bytes that the compressed frames take up.
+    std::size_t byteSize() const noexcept;
+
+    /**
+     * @brief Decode one joint.
+     * @param joint The joint.
+     * @param lowerFrame The frame at lambda = 0.
+     * @param upperFrame The frame at lambda = 1.
+     * @param lambda The interpolation parameter between the two frames.
+     * @return The local transform of the joint.
+     */
+    SQT sample(const std::size_t joint, const std::size_t lowerFrame,
+               const std::size_t upperFrame, const float lambda) const
+        noexcept;
+
+    /**
+     * @brief Decode all joints.
+     * @param lowerFrame The frame at lambda = 0.
+     * @param upperFrame The frame at lambda = 1.
+     * @param lambda The interpolation parameter between the two frames.
+     * @param result Receives the local transforms of all joints.
+     */
+    void sample(const std::size_t lowerFrame, const std::size_t upperFrame,
+                const float lambda, SQTArray& result) const;
+
+  private:
+    // The keys of a track are the range [first, first + count) of the key
+    // arrays of its kind.
+    struct Track
+    {
+        std::uint32_t first;
+        std::uint32_t count;
+
+        template <class Archive>
+        void serialize(Archive& archive, const unsigned /*version*/)
+        {
+            archive& first& count;
+        }
+    };
+
+    // The range of a quantized scale or translation track.
+    struct Range
+    {
+        float minimum[3];
+        float extent[3];
+
+        template <class Archive>
+        void serialize(Archive& archive, const unsigned /*version*/)
+        {
+            archive& minimum& extent;
+        }
+    };
+
+    void compressVectorTrack(const Frames& frames, const std::size_t joint,
+                             const bool isScale, const float tolerance);
+    void compressRotationTrack(const Frames& frames, const std::size_t joint,
+                               const float tolerance);
+
+    vec3f sampleVector(const Track& track, const Range& range,
+                       const std::vector<std::uint16_t>& frames,
+                       const std::vector<std::uint16_t>& keys,
+                       const float frame) const noexcept;
+    quatf sampleRotation(const Track& track, const float frame) const
+        noexcept;
+
+    std::uint32_t mFrameCount = 0;
+
+    std::vector<Track> mScaleTracks;
+    std::vector<Range> mScaleRanges;
+    std::vector<std::uint16_t> mScaleFrames;
+    std::vector<std::uint16_t> mScaleKeys; // Three per key.
+
+    std::vector<Track> mRotationTracks;
+    std::vector<std::uint16_t> mRotationFrames;
+    std::vector<std::uint16_t> mRotationKeys; // Three per key.
+
+    std::vector<Track> mTranslationTracks;
+    std::vector<Range> mTranslationRanges;
+    std::vector<std::uint16_t> mTranslationFrames;
+    std::vector<std::uint16_t> mTranslationKeys; // Three per key.
+
+    friend class boost::serialization::access;
+
+    template <class Archive>
+    void serialize(Archive& archive, const unsigned /*version*/)
+    {
+        archive& mFrameCount;
+        archive& mScaleTracks& mScaleRanges& mScaleFrames& mScaleKeys;
+        archive& mRotationTracks& mRotationFrames& mRotationKeys;
+        archive& mTranslationTracks& mTranslationRanges& mTranslationFrames&
+            mTranslationKeys;
+    }
+};
+
+} // namespace gintonic
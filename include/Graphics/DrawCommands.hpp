@@ -0,0 +1,147 @@
+/**
+ * @file DrawCommands.hpp
+ * @brief Defines per-draw command packets that are built in parallel and
+ * replayed on the OpenGL thread.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "../Foundation/allocator.hpp"
+#include "../Math/mat3f.hpp"
+#include "../Math/mat4f.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace gintonic
+{
+
+class Entity;        // Forward declaration.
+class Material;      // Forward declaration.
+class Mesh;          // Forward declaration.
+class RenderQueue;   // Forward declaration.
+class SkinningCache; // Forward declaration.
+class Texture2D;     // Forward declaration.
+class WorkerPool;    // Forward declaration.
+
+/**
+ * @brief Everything the geometry pass needs to know about one draw.
+ * @details A packet holds plain pointers and matrices only. Building it
+ * does not touch OpenGL.
+ */
+struct DrawCommand
+{
+    /// The projection-view-model matrix.
+    mat4f matrixPVM;
+
+    /// The view-model matrix.
+    mat4f matrixVM;
+
+    /// The normal matrix.
+    mat3f matrixN;
+
+    /// The entity that is drawn.
+    const Entity* entity;
+
+    /// The mesh of the entity.
+    Mesh* mesh;
+
+    /// The material of the entity.
+    const Material* material;
+
+    /// The diffuse texture of the material, or nullptr.
+    const Texture2D* diffuseTexture;
+
+    /// The specular texture of the material, or nullptr.
+    const Texture2D* specularTexture;
+
+    /// The normal texture of the material, or nullptr.
+    const Texture2D* normalTexture;
+
+    /// The shader permutation, i.e. the material flag.
+    std::uint32_t materialFlag;
+
+    /// The palette of the entity in the SkinningCache, or SkinningCache::kNone.
+    std::uint32_t palette;
+};
+
+/**
+ * @brief Builds a DrawCommand for every draw of a sorted RenderQueue.
+ * @details The draws are split into chunks of DrawCommandBuffer::chunkSize
+ * draws, which are built by a WorkerPool. DrawCommandBuffer::build returns
+ * when every chunk is done. Every packet is written to the position of its
+ * draw in the queue, so the result does not depend on the number of workers
+ * or on the order in which the chunks finish, and the replay on the OpenGL
+ * thread is deterministic.
+ *
+ * The joint matrices of skinned draws are not evaluated here. A packet
+ * only refers to the palette of its entity in a SkinningCache.
+ *
+ * A worker only reads the entities, materials and meshes. They must not
+ * change while a build is running.
+ */
+class DrawCommandBuffer
+{
+  public:
+    /**
+     * @brief Constructor.
+     * @param workers The workers that build the packets.
+     */
+    explicit DrawCommandBuffer(WorkerPool& workers);
+
+    /**
+     * @brief Build the packets of a sorted queue.
+     * @param queue The sorted queue.
+     * @param entities The entities that the indices of the queue refer to.
+     * @param matrixP The projection matrix.
+     * @param matrixV The view matrix.
+     * @param skinning The palettes of the skinned entities of this frame, or
+     * nullptr when nothing is skinned.
+     * @param nonUniformView Whether the view matrix may scale non-uniformly,
+     * see Entity::hasNonUniformScale. When it does not, the normal matrix of
+     * an Entity without a non-uniform scale is a multiple of its `VIEW *
+     * MODEL` matrix.
+     */
+    void build(const RenderQueue& queue, const std::vector<Entity*>& entities,
+               const mat4f& matrixP, const mat4f& matrixV,
+               const SkinningCache* skinning = nullptr,
+               const bool nonUniformView = true);
+
+    /// Get the number of draws per chunk.
+    inline std::size_t chunkSize() const noexcept { return mChunkSize; }
+
+    /// Set the number of draws per chunk. Values below one are clamped.
+    inline void setChunkSize(const std::size_t chunkSize) noexcept
+    {
+        mChunkSize = chunkSize ? chunkSize : 1;
+    }
+
+    /// Get the number of packets.
+    inline std::size_t size() const noexcept { return mCommands.size(); }
+
+    /// Check wether there are no packets.
+    inline bool empty() const noexcept { return mCommands.empty(); }
+
+    /// Get the packet of the draw at the given position in the queue.
+    inline const DrawCommand& operator[](const std::size_t i) const noexcept
+    {
+        return mCommands[i];
+    }
+
+  private:
+    void buildRange(const std::size_t first, const std::size_t last);
+
+    WorkerPool& mWorkers;
+    std::vector<DrawCommand, allocator<DrawCommand>> mCommands;
+    std::size_t mChunkSize = 64;
+
+    // The input of the build that is running.
+    const RenderQueue* mQueue = nullptr;
+    const std::vector<Entity*>* mEntities = nullptr;
+    const SkinningCache* mSkinning = nullptr;
+    mat4f mMatrixP;
+    mat4f mMatrixV;
+    bool mNonUniformView = true;
+};
+
+} // namespace gintonic
@@ -0,0 +1,246 @@
+/**
+ * @file FrameStatistics.hpp
+ * @brief Defines the per-frame render counters and CPU and GPU phase
+ * timings, and a rolling window over them.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include <boost/circular_buffer.hpp>
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+
+namespace gintonic
+{
+
+/**
+ * @brief The counters and CPU and GPU timings of a single rendered frame.
+ */
+struct FrameSample
+{
+    /// The duration type of the timings.
+    typedef std::chrono::high_resolution_clock::duration duration_type;
+
+    /// The phases of Renderer::update that are timed individually.
+    enum Phase
+    {
+        kPhaseEvents = 0,
+        kPhaseCulling,
+        kPhaseSkinning,
+        kPhaseGeometry,
+        kPhaseShadows,
+        kPhasePointLights,
+        kPhaseLights,
+        kPhaseDebug,
+        kPhaseGUI,
+        kPhaseFinalize,
+        kPhaseCount
+    };
+
+    /// The buckets that the Renderer sorts submitted entities into.
+    enum Bucket
+    {
+        kBucketShadowCastingLights = 0,
+        kBucketShadowCastingPointLights,
+        kBucketShadowCastingGeometry,
+        kBucketNonShadowCastingLights,
+        kBucketNonShadowCastingGeometry,
+        kBucketCount
+    };
+
+    /// The wall-clock time between the start of this frame and the previous.
+    duration_type frameTime = duration_type::zero();
+
+    /// The CPU time spent in each Phase.
+    duration_type phaseTime[kPhaseCount] = {};
+
+    /// The GPU time spent in each Phase, as measured by timer queries.
+    /// These lag behind the CPU timings by a few frames; see GPUFrameTimer.
+    duration_type gpuPhaseTime[kPhaseCount] = {};
+
+    /// The number of frames whose GPU timings are in gpuPhaseTime. For a
+    /// single frame this is either 0 or 1.
+    std::size_t gpuSamples = 0;
+
+    /// The number of draw calls.
+    std::size_t drawCalls = 0;
+
+    /// The number of triangles submitted by the draw calls.
+    std::size_t triangles = 0;
+
+    /// The number of times a shader program was bound. Binds that
+    /// OpenGL::StateCache dropped are not counted.
+    std::size_t programBinds = 0;
+
+    /// The number of times a texture was bound. Binds that
+    /// OpenGL::StateCache dropped are not counted.
+    std::size_t textureBinds = 0;
+
+    /// The number of uniform uploads. An upload of a whole
+    /// OpenGL::UniformRingBuffer counts as one.
+    std::size_t uniformUploads = 0;
+
+    /// The number of bytes that were uploaded to uniform buffers.
+    std::size_t uniformBufferBytes = 0;
+
+    /// The number of state changes that OpenGL::StateCache dropped because
+    /// they would not have changed anything.
+    std::size_t elidedStateChanges = 0;
+
+    /// The number of animated entities whose joint palette was shared with
+    /// another entity or kept from an earlier frame; see SkinningCache.
+    std::size_t poseCacheHits = 0;
+
+    /// The number of joint palettes that were evaluated.
+    std::size_t poseCacheMisses = 0;
+
+    /// The number of entities in each Bucket.
+    std::size_t entities[kBucketCount] = {};
+
+    /// The number of entities in each Bucket that were culled. A light is
+    /// culled when its Light::getBoundingSphere is outside of the view.
+    std::size_t culled[kBucketCount] = {};
+
+    /// The number of shadow casters that the shadowing lights drew, summed
+    /// over the lights. A caster that two lights see counts twice. The
+    /// counts of every light are in Renderer::shadowCasterCounts.
+    std::size_t shadowCasters = 0;
+
+    /// The number of those shadow casters that were culled because they
+    /// are outside of the frustum or the sphere of their light; see
+    /// Renderer::cullShadowCasters.
+    std::size_t culledShadowCasters = 0;
+
+    /**
+     * @brief Record a draw call.
+     * @param triangleCount The number of triangles that the draw call
+     * submitted.
+     */
+    inline void addDrawCall(const std::size_t triangleCount) noexcept
+    {
+        ++drawCalls;
+        triangles += triangleCount;
+    }
+
+    /**
+     * @brief Get the total CPU time spent in all phases.
+     * @return The total CPU time spent in all phases.
+     */
+    duration_type totalPhaseTime() const noexcept;
+
+    /**
+     * @brief Get the total GPU time spent in all phases.
+     * @return The total GPU time spent in all phases.
+     */
+    duration_type totalGPUPhaseTime() const noexcept;
+
+    /**
+     * @brief Get the name of a phase.
+     * @param phase The phase.
+     * @return The name of the phase.
+     */
+    static const char* name(const Phase phase) noexcept;
+
+    /**
+     * @brief Get the name of a bucket.
+     * @param bucket The bucket.
+     * @return The name of the bucket.
+     */
+    static const char* name(const Bucket bucket) noexcept;
+
+    /**
+     * @brief Get the sample that is being recorded for the current frame.
+     * @details The OpenGL wrappers (ShaderProgram::activate, the uniform
+     * setters, TextureObject::bind, Mesh::draw and so on) increment the
+     * counters of this sample. The Renderer moves it into its
+     * FrameStatistics at the end of every frame. Only touch this from the
+     * thread that owns the OpenGL context.
+     * @return The sample that is being recorded for the current frame.
+     */
+    inline static FrameSample& current() noexcept { return sCurrent; }
+
+  private:
+    static FrameSample sCurrent;
+};
+
+/**
+ * @brief Output a FrameSample as human readable text.
+ * @param os The output stream.
+ * @param sample The sample.
+ * @return The output stream.
+ */
+std::ostream& operator<<(std::ostream& os, const FrameSample& sample);
+
+/**
+ * @brief A rolling window of FrameSample objects.
+ * @details Keeps the last N samples and the average over them. The average
+ * is updated incrementally, so pushing a sample is O(1).
+ */
+class FrameStatistics
+{
+  public:
+    /**
+     * @brief Constructor.
+     * @param windowSize The number of frames to average over.
+     */
+    FrameStatistics(const std::size_t windowSize = 60);
+
+    /**
+     * @brief Add the sample of a completed frame.
+     * @param sample The sample.
+     */
+    void push(const FrameSample& sample);
+
+    /**
+     * @brief Drop all samples.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Change the number of frames to average over. Drops all samples.
+     * @param windowSize The number of frames to average over.
+     */
+    void setWindowSize(const std::size_t windowSize);
+
+    /**
+     * @brief Get the number of frames to average over.
+     * @return The number of frames to average over.
+     */
+    inline std::size_t windowSize() const noexcept
+    {
+        return mWindow.capacity();
+    }
+
+    /**
+     * @brief Get the number of samples currently in the window.
+     * @return The number of samples currently in the window.
+     */
+    inline std::size_t sampleCount() const noexcept { return mWindow.size(); }
+
+    /**
+     * @brief Get the sample of the last completed frame.
+     * @return The sample of the last completed frame. All zeroes if no
+     * frame has been completed yet.
+     */
+    inline const FrameSample& lastFrame() const noexcept { return mLastFrame; }
+
+    /**
+     * @brief Get the average over the samples in the window.
+     * @details The GPU timings are averaged over the samples that have GPU
+     * timings only.
+     * @return The average over the samples in the window.
+     */
+    inline const FrameSample& average() const noexcept { return mAverage; }
+
+  private:
+    boost::circular_buffer<FrameSample> mWindow;
+    FrameSample mLastFrame;
+    FrameSample mSum;
+    FrameSample mAverage;
+
+    void updateAverage() noexcept;
+};
+
+} // namespace gintonic
@@ -0,0 +1,121 @@
+/**
+ * @file GPUFrameTimer.hpp
+ * @brief Defines a ring of OpenGL timer queries that measures the GPU time
+ * of the phases of a frame without stalling the pipeline.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "FrameStatistics.hpp"
+#include "OpenGL/utilities.hpp"
+
+namespace gintonic
+{
+
+/**
+ * @brief Measures the GPU time of the phases of a frame with OpenGL timer
+ * queries.
+ * @details Every call to begin and end issues a GL_TIMESTAMP query with
+ * glQueryCounter. Timestamps are used instead of GL_TIME_ELAPSED because
+ * GL_TIME_ELAPSED queries cannot nest, and a phase may be entered more than
+ * once per frame.
+ *
+ * The queries of a frame are kept in one of kFrameLatency slots. The results
+ * of a slot are read back when the slot is about to be reused, that is,
+ * kFrameLatency - 1 frames after they were issued. By then the GPU has
+ * almost always finished, so reading them back does not stall. If it has
+ * not, the results of that frame are dropped rather than waited for.
+ *
+ * Calls to begin and end may nest. Only the outermost pair is measured, so
+ * a phase that is entered from within another phase counts towards the
+ * outer one.
+ *
+ * Timer queries are core since OpenGL 3.3, so this also works with Mesa's
+ * software rasterizers. If the query objects cannot be created, the timer
+ * is disabled and begin, end and nextFrame do nothing.
+ *
+ * You need a current OpenGL context to construct and use a GPUFrameTimer.
+ */
+class GPUFrameTimer
+{
+  public:
+    /// The number of frames that are in flight.
+    static constexpr std::size_t kFrameLatency = 3;
+
+    /// The maximum number of begin/end pairs per frame. Further pairs are
+    /// ignored.
+    static constexpr std::size_t kMaxPairsPerFrame = 32;
+
+    /// Constructor.
+    GPUFrameTimer();
+
+    /// Destructor.
+    ~GPUFrameTimer() noexcept;
+
+    /// You cannot copy a GPUFrameTimer.
+    GPUFrameTimer(const GPUFrameTimer&) = delete;
+
+    /// You cannot copy a GPUFrameTimer.
+    GPUFrameTimer& operator=(const GPUFrameTimer&) = delete;
+
+    /**
+     * @brief Query wether the timer could create its query objects.
+     * @return True if the timer measures anything, false if not.
+     */
+    inline bool enabled() const noexcept { return mEnabled; }
+
+    /**
+     * @brief Mark the start of a phase in the OpenGL command stream.
+     * @details Does nothing but count the nesting depth if a phase is
+     * already open.
+     * @param phase The phase.
+     */
+    void begin(const FrameSample::Phase phase) noexcept;
+
+    /**
+     * @brief Mark the end of the phase that was started with begin.
+     * @details Only the end that matches the outermost begin closes the
+     * phase.
+     */
+    void end() noexcept;
+
+    /**
+     * @brief Finish the current frame and collect the results of the
+     * oldest frame in flight.
+     * @details Call this once per frame, after the buffers have been
+     * swapped.
+     * @param [out] sample The sample whose gpuPhaseTime and gpuSamples
+     * receive the results of the oldest frame in flight, if they are
+     * available.
+     * @return True if results were written to the sample, false otherwise.
+     */
+    bool nextFrame(FrameSample& sample) noexcept;
+
+    /**
+     * @brief Get the number of frames whose results were dropped because
+     * the GPU had not finished them in time.
+     * @return The number of dropped frames.
+     */
+    inline std::size_t droppedFrames() const noexcept { return mDropped; }
+
+  private:
+    struct Slot
+    {
+        GLuint queries[2 * kMaxPairsPerFrame] = {};
+        FrameSample::Phase phases[kMaxPairsPerFrame];
+        std::size_t count = 0;
+        bool pending = false;
+    };
+
+    Slot mSlots[kFrameLatency];
+    std::size_t mCurrent = 0;
+    std::size_t mDropped = 0;
+    std::size_t mDepth = 0;
+    bool mOpen = false;
+    bool mEnabled = true;
+
+    void close() noexcept;
+};
+
+} // namespace gintonic
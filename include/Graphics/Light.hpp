@@ -115,6 +115,18 @@ class Light : public Object<Light, std::string>
      */
     inline virtual float getCutoffRadius() const noexcept { return 0.0f; }
 
+    /**
+     * @brief Get a sphere in world space that encloses everything that this
+     * light can light up. The Renderer uses it to cull the light and its
+     * shadow casters.
+     * @param lightEntity The Entity that shines this light.
+     * @param [out] sphere Receives the bounding sphere.
+     * @return False if the light is unbounded, as for an AmbientLight and a
+     * DirectionalLight. The sphere is left untouched in that case.
+     */
+    virtual bool getBoundingSphere(const Entity& lightEntity,
+                                   sphere3f& sphere) const noexcept;
+
     /**
      * @brief Initialize the shadow buffer.
      * @param lightEntity The light entity that is attached
@@ -437,6 +437,19 @@ class Mesh : public Object<Mesh, std::string>
      */
     void set(const boost::filesystem::path& nativeMeshFile);
 
+    /**
+     * @brief Set the joints that move the vertices of a mesh that was made
+     * from manual arrays.
+     * @details Both arrays must have one element per vertex of the
+     * `position_XYZ_uv_X` array. Unused influences have a weight of zero.
+     * @param [in] jointIndices The indices of the four joints of every
+     * vertex.
+     * @param [in] jointWeights The weights of the four joints of every
+     * vertex.
+     */
+    void setJoints(const std::vector<Mesh::vec4i>& jointIndices,
+                   const std::vector<Mesh::vec4f>& jointWeights);
+
     /**
      * @brief Draw the mesh. Uses `GL_TRIANGLES` as draw mode.
      */
@@ -499,6 +512,59 @@ class Mesh : public Object<Mesh, std::string>
         return mJointIndices.empty() == false;
     }
 
+    /**
+     * @brief Get the positions that Mesh::drawAdjacent streams. Equal
+     * positions of the vertices are welded into one.
+     * @return The positions.
+     */
+    inline const std::vector<Mesh::vec3f>& adjacentPositions() const noexcept
+    {
+        return mPositions;
+    }
+
+    /**
+     * @brief Get the adjacency array. Every triangle takes six indices into
+     * Mesh::adjacentPositions; the even ones are the triangle itself.
+     * @return The adjacency array.
+     */
+    inline const std::vector<GLuint>& indicesAdjacent() const noexcept
+    {
+        return mIndicesAdjacent;
+    }
+
+    /**
+     * @brief Get, for every position in Mesh::adjacentPositions, a vertex
+     * with that position. Use it to find the joint weights of the
+     * positions.
+     * @return The vertices.
+     */
+    inline const std::vector<GLuint>& adjacentPositionVertices() const noexcept
+    {
+        return mAdjacentPositionVertices;
+    }
+
+    /// Get the indices of the four joints that move every vertex.
+    inline const std::vector<Mesh::vec4i>& jointIndices() const noexcept
+    {
+        return mJointIndices;
+    }
+
+    /// Get the weights of the four joints that move every vertex.
+    inline const std::vector<Mesh::vec4f>& jointWeights() const noexcept
+    {
+        return mJointWeights;
+    }
+
+    /**
+     * @brief Get the OpenGL buffer of the adjacency array, so that other
+     * position streams can be drawn with it.
+     * @return The name of the buffer.
+     */
+    inline GLuint adjacencyIndexBuffer() const noexcept
+    {
+        return mBuffer[GT_MESH_BUFFER_INDICES_ADJ];
+    }
+
     GINTONIC_DEFINE_SSE_OPERATOR_NEW_DELETE();
 
   private:
@@ -512,6 +578,7 @@ class Mesh : public Object<Mesh, std::string>
     std::vector<Mesh::vec4f> mTangent_XYZ_hand;
 
     std::vector<Mesh::vec3f> mPositions;
+    std::vector<GLuint> mAdjacentPositionVertices;
 
     std::vector<Mesh::vec4i> mJointIndices;
     std::vector<Mesh::vec4f> mJointWeights;
@@ -529,6 +596,7 @@ class Mesh : public Object<Mesh, std::string>
     void computeLocalBoundingBoxFromPositionInformation(
         const std::vector<Mesh::vec4f>& position_XYZ_uv_X);
     void computeAdjacencyFromPositionInformation();
+    void computeAdjacentPositionVertices();
 
     void uploadData();
 
@@ -569,6 +637,7 @@ class Mesh : public Object<Mesh, std::string>
         archive& mJointIndices;
         archive& mJointWeights;
 
+        computeAdjacentPositionVertices();
         uploadData();
     }
 
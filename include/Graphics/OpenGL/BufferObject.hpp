@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include "utilities.hpp"
+#include "StateCache.hpp"
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/split_member.hpp>
 
@@ -122,7 +122,7 @@ public:
 	 */
 	inline ~BufferObject() noexcept
 	{
-		glDeleteBuffers(1, &mHandle);
+		StateCache::deleteBuffers(1, &mHandle);
 	}
 
 	/**
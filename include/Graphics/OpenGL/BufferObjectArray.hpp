@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include "utilities.hpp"
+#include "StateCache.hpp"
 #include <cstring> // for std::memcpy and std::memmove
 
 namespace gintonic {
@@ -31,7 +31,7 @@ public:
 	/// Destructor.
 	inline ~BufferObjectArray() noexcept
 	{
-		glDeleteBuffers(Size, mHandles);
+		StateCache::deleteBuffers(Size, mHandles);
 	}
 
 	/// You cannot copy buffer object arrays.
@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include "utilities.hpp"
+#include "StateCache.hpp"
 
 namespace gintonic {
 namespace OpenGL {
@@ -58,7 +58,7 @@ public:
 	/// Destructor.
 	inline ~Framebuffer()
 	{
-		glDeleteFramebuffers(1, &mHandle);
+		StateCache::deleteFramebuffers(1, &mHandle);
 	}
 
 	/// You cannot copy Framebuffers.
@@ -0,0 +1,168 @@
+/**
+ * @file RecordingContext.hpp
+ * @brief Defines a fake OpenGL context that records every call into a
+ * command log.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gintonic {
+namespace OpenGL {
+
+/**
+ * @brief A fake OpenGL context that records every OpenGL call.
+ *
+ * @details Constructing a RecordingContext loads glad's function pointers
+ * with recording functions instead of the functions of a driver. Every call
+ * is appended to a command log, together with its arguments. Nothing is
+ * rendered. This makes it possible to exercise the renderer and the OpenGL
+ * wrappers without a GPU, and to assert on the number of draw calls and
+ * state changes that a scene produces.
+ *
+ * The recording functions simulate just enough of a driver to keep the rest
+ * of the engine happy:
+ * - glGen* and glCreate* hand out unique, non-zero object names.
+ * - Shaders always compile, programs always link, framebuffers are always
+ *   complete and query results are always available (and zero).
+ * - Every uniform that the source of a shader declares is active in the
+ *   programs that the shader is attached to, so that shader programs find
+ *   their uniforms. Uniform blocks are not listed.
+ * - glGetString reports OpenGL 4.5 and glGetError always returns
+ *   GL_NO_ERROR. Calls to glGetError are not recorded, because glad's debug
+ *   generator calls it after every other call.
+ * - Queries that return a range, like GL_ALIASED_LINE_WIDTH_RANGE and
+ *   GL_DEPTH_RANGE, fill in both ends of it. Queries that return four values,
+ *   like GL_VIEWPORT, fill in all four.
+ * - Every other query writes zeroes.
+ *
+ * Only the functions that the engine uses are loaded. The rest of glad's
+ * function pointers are null.
+ *
+ * There can be at most one RecordingContext at a time.
+ */
+class RecordingContext
+{
+public:
+
+	/// A single recorded OpenGL call.
+	struct Call
+	{
+		/// The name of the OpenGL function, for instance "glUseProgram".
+		const char* name;
+
+		/// The arguments, formatted as a comma-separated list.
+		std::string arguments;
+	};
+
+	/**
+	 * @brief Constructor. Loads glad's function pointers with the
+	 * recording functions.
+	 */
+	RecordingContext();
+
+	/// Destructor. Recording stops, but glad's function pointers are not
+	/// restored.
+	~RecordingContext() noexcept;
+
+	/// You cannot copy a RecordingContext.
+	RecordingContext(const RecordingContext&) = delete;
+
+	/// You cannot copy a RecordingContext.
+	RecordingContext& operator = (const RecordingContext&) = delete;
+
+	/**
+	 * @brief Get the RecordingContext that is currently recording.
+	 * @return The RecordingContext that is currently recording, or nullptr
+	 * if there is none.
+	 */
+	static RecordingContext* current() noexcept;
+
+	/**
+	 * @brief The loader function that is handed to gladLoadGLLoader.
+	 * @param name The name of the OpenGL function.
+	 * @return A pointer to the recording function, or nullptr if the
+	 * function is not recorded.
+	 */
+	static void* getProcAddress(const char* name);
+
+	/**
+	 * @brief Get the command log.
+	 * @return The command log, in the order in which the calls were made.
+	 */
+	inline const std::vector<Call>& calls() const noexcept
+	{
+		return mCalls;
+	}
+
+	/**
+	 * @brief Count how many times an OpenGL function was called.
+	 * @param name The name of the OpenGL function, for instance
+	 * "glDrawElements".
+	 * @return The number of calls to that function in the command log.
+	 */
+	std::size_t count(const char* name) const noexcept;
+
+	/**
+	 * @brief Clear the command log. Object names keep counting up.
+	 */
+	inline void clear() noexcept { mCalls.clear(); }
+
+	/**
+	 * @brief Append a call to the command log. The recording functions
+	 * call this; you should not need to.
+	 * @param name The name of the OpenGL function.
+	 * @param arguments The formatted arguments.
+	 */
+	void record(const char* name, std::string arguments);
+
+	/**
+	 * @brief Generate a new object name. The recording functions call
+	 * this; you should not need to.
+	 * @return A new object name. Names are unique across all object types.
+	 */
+	inline unsigned int generateName() noexcept { return ++mLastName; }
+
+	/**
+	 * @brief Remember the uniforms that the source of a shader declares.
+	 * The recording functions call this; you should not need to.
+	 * @param shader The name of the shader.
+	 * @param source The source code of the shader.
+	 */
+	void setShaderSource(const unsigned int shader, const std::string& source);
+
+	/**
+	 * @brief Make the uniforms of a shader active in a program. The
+	 * recording functions call this; you should not need to.
+	 * @param program The name of the program.
+	 * @param shader The name of the shader.
+	 */
+	void attachShader(const unsigned int program, const unsigned int shader);
+
+	/**
+	 * @brief Get the active uniforms of a program.
+	 * @param program The name of the program.
+	 * @return The names of the uniforms, in the order in which they were
+	 * first declared. The name of an array ends with "[0]", like a driver
+	 * reports it.
+	 */
+	const std::vector<std::string>& activeUniforms(
+		const unsigned int program) const noexcept;
+
+private:
+
+	std::vector<Call> mCalls;
+	unsigned int mLastName = 0;
+
+	// The declared uniforms of every shader and program, by name. Names are
+	// unique across all object types, so one map holds both.
+	std::unordered_map<unsigned int, std::vector<std::string>> mUniforms;
+};
+
+} // namespace OpenGL
+} // namespace gintonic
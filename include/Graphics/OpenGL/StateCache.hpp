@@ -0,0 +1,179 @@
+/**
+ * @file StateCache.hpp
+ * @brief Defines a cache of the OpenGL state that filters out redundant
+ * state changes.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "utilities.hpp"
+
+namespace gintonic {
+namespace OpenGL {
+
+/**
+ * @brief Remembers the OpenGL state and drops state changes that would not
+ * change anything.
+ *
+ * @details Every function of the StateCache mirrors an OpenGL function. It
+ * compares the new state with the state it remembers, and only calls
+ * OpenGL when they differ. Every call that is dropped increments
+ * FrameSample::elidedStateChanges of the current frame.
+ *
+ * The cache tracks:
+ * - the current program and vertex array object,
+ * - the active texture unit and the 2D, cube map and 2D array textures of
+ *   the first StateCache::kMaxTextureUnits units,
+ * - the draw and read framebuffers,
+ * - the buffers (and their ranges) that are bound to the first
+ *   StateCache::kMaxUniformBufferBindings uniform buffer binding points,
+ * - the enable bits of blending, face culling, depth clamping, depth
+ *   testing, polygon offset filling, scissor testing and stencil testing,
+ * - the blend function and equation, the depth function and depth mask, the
+ *   cull face, the front face, the polygon mode and the stencil function and
+ *   operations.
+ * Everything else, and every capability or target that is not in this
+ * list, is passed to OpenGL unconditionally.
+ *
+ * The cache only works when it sees every change to the state that it
+ * tracks. So the OpenGL wrappers (ShaderProgram, TextureObject, Framebuffer,
+ * Mesh and so on) go through it, and so should any other code that touches
+ * the state above. Deleting an object must go through the cache as well,
+ * since OpenGL unbinds deleted objects and their names may be reused. Code
+ * that changes the tracked state behind the cache's back must call
+ * StateCache::invalidate afterwards.
+ *
+ * At first every piece of state is unknown, so the first change always
+ * reaches OpenGL. Only use the cache from the thread that owns the OpenGL
+ * context.
+ */
+class StateCache
+{
+public:
+
+	/// The number of texture units whose bindings are tracked.
+	static constexpr GLuint kMaxTextureUnits = 32;
+
+	/// The number of uniform buffer binding points whose bindings are
+	/// tracked.
+	static constexpr GLuint kMaxUniformBufferBindings = 16;
+
+	/**
+	 * @brief Forget all state. Call this after creating a new context, or
+	 * after code that bypasses the cache has changed the state.
+	 */
+	static void invalidate() noexcept;
+
+	/// glUseProgram.
+	static void useProgram(const GLuint program) noexcept;
+
+	/// glBindVertexArray.
+	static void bindVertexArray(const GLuint vertexArray) noexcept;
+
+	/**
+	 * @brief glActiveTexture.
+	 * @param unit The zero-based texture unit, so without GL_TEXTURE0.
+	 */
+	static void activeTexture(const GLuint unit) noexcept;
+
+	/// glBindTexture on the active texture unit.
+	static void bindTexture(const GLenum target, const GLuint texture) noexcept;
+
+	/**
+	 * @brief glActiveTexture followed by glBindTexture. The active texture
+	 * unit is only changed when the binding changes.
+	 * @param unit The zero-based texture unit, so without GL_TEXTURE0.
+	 * @param target The texture target, for instance GL_TEXTURE_2D.
+	 * @param texture The texture.
+	 */
+	static void bindTexture(const GLuint unit, const GLenum target,
+		const GLuint texture) noexcept;
+
+	/// glBindFramebuffer. GL_FRAMEBUFFER binds both draw and read.
+	static void bindFramebuffer(const GLenum target,
+		const GLuint framebuffer) noexcept;
+
+	/**
+	 * @brief glBindBufferBase. Only GL_UNIFORM_BUFFER is tracked.
+	 * @param target The indexed target, for instance GL_UNIFORM_BUFFER.
+	 * @param index The binding point.
+	 * @param buffer The buffer.
+	 */
+	static void bindBufferBase(const GLenum target, const GLuint index,
+		const GLuint buffer) noexcept;
+
+	/**
+	 * @brief glBindBufferRange. Only GL_UNIFORM_BUFFER is tracked.
+	 * @param target The indexed target, for instance GL_UNIFORM_BUFFER.
+	 * @param index The binding point.
+	 * @param buffer The buffer.
+	 * @param offset The offset of the range, in bytes.
+	 * @param size The size of the range, in bytes.
+	 */
+	static void bindBufferRange(const GLenum target, const GLuint index,
+		const GLuint buffer, const GLintptr offset,
+		const GLsizeiptr size) noexcept;
+
+	/// glEnable.
+	static void enable(const GLenum capability) noexcept;
+
+	/// glDisable.
+	static void disable(const GLenum capability) noexcept;
+
+	/// glBlendFunc.
+	static void blendFunc(const GLenum source,
+		const GLenum destination) noexcept;
+
+	/// glBlendEquation.
+	static void blendEquation(const GLenum mode) noexcept;
+
+	/// glDepthFunc.
+	static void depthFunc(const GLenum function) noexcept;
+
+	/// glDepthMask.
+	static void depthMask(const GLboolean flag) noexcept;
+
+	/// glCullFace.
+	static void cullFace(const GLenum mode) noexcept;
+
+	/// glFrontFace.
+	static void frontFace(const GLenum mode) noexcept;
+
+	/// glPolygonMode. Only GL_FRONT_AND_BACK is tracked.
+	static void polygonMode(const GLenum face, const GLenum mode) noexcept;
+
+	/// glStencilFunc.
+	static void stencilFunc(const GLenum function, const GLint reference,
+		const GLuint mask) noexcept;
+
+	/// glStencilOp.
+	static void stencilOp(const GLenum stencilFail, const GLenum depthFail,
+		const GLenum depthPass) noexcept;
+
+	/// glStencilOpSeparate.
+	static void stencilOpSeparate(const GLenum face, const GLenum stencilFail,
+		const GLenum depthFail, const GLenum depthPass) noexcept;
+
+	/// glDeleteProgram.
+	static void deleteProgram(const GLuint program) noexcept;
+
+	/// glDeleteBuffers.
+	static void deleteBuffers(const GLsizei count,
+		const GLuint* buffers) noexcept;
+
+	/// glDeleteVertexArrays.
+	static void deleteVertexArrays(const GLsizei count,
+		const GLuint* vertexArrays) noexcept;
+
+	/// glDeleteTextures.
+	static void deleteTextures(const GLsizei count,
+		const GLuint* textures) noexcept;
+
+	/// glDeleteFramebuffers.
+	static void deleteFramebuffers(const GLsizei count,
+		const GLuint* framebuffers) noexcept;
+};
+
+} // namespace OpenGL
+} // namespace gintonic
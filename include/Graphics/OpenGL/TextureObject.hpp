@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include "utilities.hpp"
+#include "StateCache.hpp"
 
 namespace gintonic {
 namespace OpenGL {
@@ -49,14 +49,13 @@ public:
 	/// Destructor destroys the OpenGL handle.
 	inline ~TextureObject() noexcept
 	{
-		glDeleteTextures(1, &mHandle);
+		StateCache::deleteTextures(1, &mHandle);
 	}
 
 	/// Bind a texture object to the specified texture unit.
 	inline void bind(const GLenum texture_type, const GLint texture_unit) const noexcept
 	{
-		glActiveTexture(GL_TEXTURE0 + texture_unit);
-		glBindTexture(texture_type, mHandle);
+		StateCache::bindTexture(texture_unit, texture_type, mHandle);
 	}
 };
 
@@ -0,0 +1,170 @@
+/**
+ * @file UniformRingBuffer.hpp
+ * @brief Defines a uniform buffer that is filled once per batch and bound
+ * by offset.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "BufferObject.hpp"
+#include <vector>
+
+namespace gintonic {
+namespace OpenGL {
+
+/**
+ * @brief A large uniform buffer that holds the uniform blocks of many draw
+ * calls, which are bound one range at a time.
+ *
+ * @details Instead of setting the uniforms of every draw call one by one,
+ * you stage the std140 uniform blocks of a whole batch of draw calls with
+ * UniformRingBuffer::stage, send them to the GPU in a single
+ * UniformRingBuffer::upload, and then bind the block of each draw call
+ * with UniformRingBuffer::bindRange before drawing.
+ *
+ * Every staged block starts at a multiple of
+ * GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT. Consecutive uploads are written one
+ * after the other, so that the GPU can still read the blocks of a previous
+ * batch while the next batch is written. When an upload no longer fits at
+ * the end of the buffer, the storage of the buffer is orphaned and writing
+ * starts at the beginning again. When a single upload does not fit at all,
+ * the buffer grows.
+ *
+ * Only use a UniformRingBuffer from the thread that owns the OpenGL context.
+ */
+class UniformRingBuffer
+{
+public:
+
+	/**
+	 * @brief Constructor.
+	 * @param capacity The initial size of the buffer, in bytes.
+	 */
+	explicit UniformRingBuffer(const GLsizeiptr capacity = 1 << 20);
+
+	/// You cannot copy a UniformRingBuffer.
+	UniformRingBuffer(const UniformRingBuffer&) = delete;
+
+	/// You cannot copy a UniformRingBuffer.
+	UniformRingBuffer& operator = (const UniformRingBuffer&) = delete;
+
+	/// Destructor.
+	~UniformRingBuffer() noexcept = default;
+
+	/// You can access the underlying OpenGL handle via a static_cast.
+	inline operator GLuint() const noexcept { return mBuffer; }
+
+	/// The alignment of the offsets that are handed out, in bytes.
+	inline GLintptr alignment() const noexcept { return mAlignment; }
+
+	/// The size of the buffer, in bytes.
+	inline GLsizeiptr capacity() const noexcept { return mCapacity; }
+
+	/// The number of bytes that were staged since the last upload.
+	inline GLsizeiptr size() const noexcept { return mEnd; }
+
+	/// Whether nothing was staged since the last upload.
+	inline bool empty() const noexcept { return mEnd == 0; }
+
+	/**
+	 * @brief Reserve room for a block in the staging area.
+	 * @details The block starts at the next aligned offset. A shader may
+	 * declare a block that is larger than the data that you actually
+	 * stage, for instance an array with room for every joint of which you
+	 * only fill the first few. In that case pass the declared size as the
+	 * reserve, and bind the range with the declared size. The bytes beyond
+	 * the staged data are not yours, but they are guaranteed to be present
+	 * in the buffer.
+	 * @param size The number of bytes that you are going to write.
+	 * @param reserve The number of bytes that the range is bound with. When
+	 * it is less than size, size is used.
+	 * @return The offset of the block, relative to the staging area.
+	 */
+	GLintptr allocate(const GLsizeiptr size, const GLsizeiptr reserve);
+
+	/**
+	 * @brief Get a pointer to a block that you allocated.
+	 * @param offset The offset returned by UniformRingBuffer::allocate.
+	 * @return A pointer into the staging area. It is invalidated by the
+	 * next allocation.
+	 */
+	inline GLubyte* at(const GLintptr offset) noexcept
+	{
+		return mStaging.data() + offset;
+	}
+
+	/**
+	 * @brief Stage a block.
+	 * @param data The block.
+	 * @param size The size of the block, in bytes.
+	 * @param reserve See UniformRingBuffer::allocate.
+	 * @return The offset of the block, relative to the staging area.
+	 */
+	GLintptr stage(const GLvoid* data, const GLsizeiptr size,
+		const GLsizeiptr reserve);
+
+	/**
+	 * @brief Stage a block.
+	 * @tparam Block A type whose memory layout matches the std140 layout
+	 * of the uniform block in the shader.
+	 * @param block The block.
+	 * @return The offset of the block, relative to the staging area.
+	 */
+	template <class Block>
+	inline GLintptr stage(const Block& block)
+	{
+		return stage(&block, sizeof(Block), sizeof(Block));
+	}
+
+	/**
+	 * @brief Send everything that was staged to the GPU, and empty the
+	 * staging area. The offsets that were handed out stay valid for
+	 * UniformRingBuffer::bindRange until the next upload.
+	 */
+	void upload();
+
+	/**
+	 * @brief Bind a block of the last upload to a uniform buffer binding
+	 * point.
+	 * @param index The binding point.
+	 * @param offset The offset of the block, as returned by
+	 * UniformRingBuffer::stage or UniformRingBuffer::allocate.
+	 * @param size The size of the range, in bytes.
+	 */
+	void bindRange(const GLuint index, const GLintptr offset,
+		const GLsizeiptr size) const noexcept;
+
+	/**
+	 * @brief Bind a block of the last upload to a uniform buffer binding
+	 * point.
+	 * @tparam Block The type of block that was staged at the offset.
+	 * @param index The binding point.
+	 * @param offset The offset of the block.
+	 */
+	template <class Block>
+	inline void bindRange(const GLuint index, const GLintptr offset) const
+		noexcept
+	{
+		bindRange(index, offset, sizeof(Block));
+	}
+
+private:
+
+	BufferObject mBuffer;
+	std::vector<GLubyte> mStaging;
+	GLsizeiptr mCapacity;
+	GLintptr mAlignment;
+
+	// The first byte after the blocks that were staged so far, and the
+	// first byte after the bytes that may be bound.
+	GLintptr mNext = 0;
+	GLintptr mEnd = 0;
+
+	// Where the last upload went, and where the next one may go.
+	GLintptr mBase = 0;
+	GLintptr mHead = 0;
+};
+
+} // namespace OpenGL
+} // namespace gintonic
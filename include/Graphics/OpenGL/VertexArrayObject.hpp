@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include "utilities.hpp"
+#include "StateCache.hpp"
 
 namespace gintonic {
 namespace OpenGL {
@@ -33,7 +33,7 @@ public:
 	/// Destructor.
 	inline ~VertexArrayObject() noexcept
 	{
-		glDeleteVertexArrays(1, &mHandle);
+		StateCache::deleteVertexArrays(1, &mHandle);
 	}
 
 	/// You cannot copy vertex array objects.
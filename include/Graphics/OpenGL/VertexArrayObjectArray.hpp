@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include "utilities.hpp"
+#include "StateCache.hpp"
 
 namespace gintonic {
 namespace OpenGL {
@@ -30,7 +30,7 @@ public:
 	/// Destructor.
 	inline ~VertexArrayObjectArray() noexcept
 	{
-		glDeleteVertexArrays(Size, m_handles);
+		StateCache::deleteVertexArrays(Size, m_handles);
 	}
 
 	/// You cannot copy vertex array object arrays.
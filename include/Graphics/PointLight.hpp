@@ -81,6 +81,16 @@ public:
 		return mCutoffRadius;
 	}
 
+	/**
+	 * @brief Get the sphere with the cutoff radius around the light.
+	 * @param lightEntity The Entity that shines this light.
+	 * @param [out] sphere Receives the bounding sphere.
+	 * @return False if the attenuation has no distance terms, in which case
+	 * the light is unbounded.
+	 */
+	virtual bool getBoundingSphere(const Entity& lightEntity,
+		sphere3f& sphere) const noexcept;
+
 	inline virtual float getCosineHalfAngle() const noexcept
 	{
 		return 0.0f;
@@ -0,0 +1,85 @@
+/**
+ * @file PosePool.hpp
+ * @brief Defines a pool of SQTArray buffers for blending poses.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "../Math/SQTArray.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace gintonic
+{
+
+/**
+ * @brief A pool of SQTArray buffers that hold the local pose of a
+ * skeleton while clips are blended.
+ *
+ * @details A buffer is handed out by PosePool::acquire and goes back to the
+ * pool when its handle is destroyed. Once the pool has handed out as many
+ * buffers at once as a blend needs, blending makes no more allocations.
+ * A pool is not safe to use from several threads at once; give every
+ * thread its own.
+ */
+class PosePool
+{
+  public:
+    /// Owns a buffer of the pool until it is destroyed.
+    class Handle
+    {
+      public:
+        /// Default constructor constructs a handle without a buffer.
+        Handle() = default;
+
+        Handle(Handle&& other) noexcept = default;
+        Handle& operator=(Handle&& other) noexcept;
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+
+        /// Gives the buffer back to the pool.
+        ~Handle();
+
+        /// Get the buffer.
+        inline SQTArray& operator*() const noexcept { return *mPose; }
+
+        /// Get the buffer.
+        inline SQTArray* operator->() const noexcept { return mPose.get(); }
+
+      private:
+        friend class PosePool;
+
+        Handle(PosePool& pool, std::unique_ptr<SQTArray> pose) noexcept;
+
+        PosePool* mPool = nullptr;
+        std::unique_ptr<SQTArray> mPose;
+    };
+
+    PosePool() = default;
+    PosePool(const PosePool&) = delete;
+    PosePool& operator=(const PosePool&) = delete;
+
+    /**
+     * @brief Get a buffer from the pool, or a new one if the pool is empty.
+     * @param jointCount The number of joints. The buffer is only resized
+     * when it has a different size; its contents are undefined.
+     * @return The handle of the buffer.
+     */
+    Handle acquire(const std::size_t jointCount);
+
+    /// Get the number of buffers that the pool has made.
+    inline std::size_t size() const noexcept { return mSize; }
+
+    /// Get the number of buffers that are in the pool.
+    inline std::size_t available() const noexcept { return mFree.size(); }
+
+  private:
+    void release(std::unique_ptr<SQTArray> pose);
+
+    std::vector<std::unique_ptr<SQTArray>> mFree;
+    std::size_t mSize = 0;
+};
+
+} // namespace gintonic
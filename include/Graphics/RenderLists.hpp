@@ -0,0 +1,165 @@
+/**
+ * @file RenderLists.hpp
+ * @brief Defines retained render lists that are kept up to date
+ * incrementally.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "FrameStatistics.hpp"
+#include <boost/signals2/connection.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace gintonic
+{
+
+class Entity; // Forward declaration.
+class Light;  // Forward declaration.
+
+/**
+ * @brief Retained render lists.
+ * @details Registered entities are sorted into the same buckets that the
+ * Renderer uses every frame: shadow casting lights, shadow casting point
+ * lights, shadow casting geometry, non-shadow casting lights and non-shadow
+ * casting geometry. An entity stays in its bucket until it changes.
+ *
+ * A RenderLists object listens to the Entity::onRenderStateChange event of
+ * every registered entity. When it fires, the entity is only marked as
+ * changed. The changed entities are moved to their new buckets by
+ * RenderLists::update, so the cost per frame depends on the number of
+ * changes, not on the number of registered entities.
+ *
+ * The kind of the light of an entity is cached, so that the dynamic casts
+ * only happen when the light itself changes. The cache holds on to the
+ * light, so a new light can never be mistaken for a destroyed one that
+ * lived at the same address.
+ *
+ * The order of the entities within a bucket is unspecified. Registered
+ * entities are kept alive until they are removed.
+ */
+class RenderLists
+{
+  public:
+    /// The type of a bucket.
+    typedef std::vector<std::shared_ptr<Entity>> list_type;
+
+    /// The cached kind of a light.
+    enum LightKind
+    {
+        kNoLight = 0,
+        kPointLight,
+        kSpotLight,
+        kOtherLight
+    };
+
+    /// Default constructor.
+    RenderLists() = default;
+
+    /// Destructor. Stops listening to the registered entities.
+    ~RenderLists() noexcept;
+
+    /// You cannot copy RenderLists.
+    RenderLists(const RenderLists&) = delete;
+
+    /// You cannot copy RenderLists.
+    RenderLists& operator=(const RenderLists&) = delete;
+
+    /**
+     * @brief Get the kind of a light.
+     * @param light Pointer to some light. May be null.
+     * @return The kind of the light.
+     */
+    static LightKind lightKind(const Light* light) noexcept;
+
+    /**
+     * @brief Register an entity. Nothing happens if the entity is already
+     * registered. The entity ends up in its bucket on the next call to
+     * RenderLists::update.
+     * @param entity The entity to register.
+     */
+    void add(std::shared_ptr<Entity> entity);
+
+    /**
+     * @brief Register an entity and all of its children.
+     * @param entity The root of the entities to register.
+     */
+    void addRecursive(const std::shared_ptr<Entity>& entity);
+
+    /**
+     * @brief Unregister an entity. It is removed from its bucket
+     * immediately. Nothing happens if the entity is not registered.
+     * @param entity The entity to unregister.
+     */
+    void remove(const Entity* entity);
+
+    /**
+     * @brief Unregister an entity and all of its children.
+     * @param entity The root of the entities to unregister.
+     */
+    void removeRecursive(const std::shared_ptr<Entity>& entity);
+
+    /**
+     * @brief Mark a registered entity as changed. This is what happens
+     * when its Entity::onRenderStateChange event fires.
+     * @param entity The entity that has changed.
+     */
+    void markChanged(const Entity* entity);
+
+    /**
+     * @brief Move every changed entity to its new bucket.
+     * @details This manages the ShadowBuffer of light entities in the same
+     * way as the Renderer does when entities are submitted, so the OpenGL
+     * context must be current if there are shadow casting lights.
+     * @return The number of entities that were moved.
+     */
+    std::size_t update();
+
+    /// Unregister all entities.
+    void clear() noexcept;
+
+    /// Get a bucket.
+    inline const list_type& operator[](const FrameSample::Bucket b) const
+        noexcept
+    {
+        return mBuckets[b];
+    }
+
+    /// Get the number of registered entities.
+    inline std::size_t size() const noexcept { return mRegistrations.size(); }
+
+    /// Check wether there are any registered entities.
+    inline bool empty() const noexcept { return mRegistrations.empty(); }
+
+    /// Get the number of entities that changed since the last update.
+    inline std::size_t changedCount() const noexcept
+    {
+        return mChanged.size();
+    }
+
+  private:
+    struct Registration
+    {
+        std::shared_ptr<Entity> entity;
+        boost::signals2::connection connection;
+        std::shared_ptr<const Light> light;
+        LightKind lightKind = kNoLight;
+        int lightBucket = -1;
+        std::size_t lightIndex = 0;
+        int geometryBucket = -1;
+        std::size_t geometryIndex = 0;
+        bool changed = false;
+    };
+
+    void link(Registration& registration);
+    void unlink(Registration& registration);
+    void erase(const int bucket, const std::size_t index);
+
+    std::unordered_map<const Entity*, Registration> mRegistrations;
+    std::vector<const Entity*> mChanged;
+    list_type mBuckets[FrameSample::kBucketCount];
+};
+
+} // namespace gintonic
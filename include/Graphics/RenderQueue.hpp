@@ -0,0 +1,186 @@
+/**
+ * @file RenderQueue.hpp
+ * @brief Defines a queue of draws that are sorted by a packed 64-bit key.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace gintonic
+{
+
+/**
+ * @brief A queue of draws, sorted by a packed 64-bit key.
+ * @details Every draw is pushed with a key and an index. The index is
+ * opaque to the queue; it usually refers into an array of entities that the
+ * caller keeps alongside the queue. The key packs, from the most significant
+ * bits to the least significant bits:
+ *
+ * | Bits    | Field                                    |
+ * |---------|------------------------------------------|
+ * | 60 - 63 | The pass.                                |
+ * | 52 - 59 | The shader permutation (material flags). |
+ * | 36 - 51 | The material, i.e. the texture set.      |
+ * | 20 - 35 | The mesh.                                |
+ * |  0 - 19 | The quantized view depth.                |
+ *
+ * So after sorting, draws are grouped by pass, then by shader permutation,
+ * then by material, then by mesh. Within such a group, draws are ordered by
+ * increasing depth, i.e. front-to-back. Consecutive draws then share as much
+ * state as possible, and the renderer can skip the binds and uniform uploads
+ * that would not change anything.
+ *
+ * Materials and meshes get a small identifier with RenderQueue::materialId
+ * and RenderQueue::meshId. The identifiers are handed out in order of first
+ * use and are only valid until the queue is cleared.
+ *
+ * The queue is sorted with a least significant digit radix sort. It does not
+ * touch OpenGL.
+ */
+class RenderQueue
+{
+  public:
+    /// The passes. The pass is the most significant field of a key.
+    enum Pass
+    {
+        kPassOpaque = 0,
+        kPassCount
+    };
+
+    /// A draw in the queue.
+    struct Item
+    {
+        /// The packed key.
+        std::uint64_t key;
+
+        /// The index of the draw. Opaque to the queue.
+        std::uint32_t index;
+    };
+
+    /// The number of bits of the quantized view depth.
+    static constexpr int kDepthBits = 20;
+
+    /// The number of bits of the mesh identifier.
+    static constexpr int kMeshBits = 16;
+
+    /// The number of bits of the material identifier.
+    static constexpr int kMaterialBits = 16;
+
+    /// The number of bits of the shader permutation.
+    static constexpr int kPermutationBits = 8;
+
+    /// The number of bits of the pass.
+    static constexpr int kPassBits = 4;
+
+    /**
+     * @brief Pack the fields of a draw into a key. Fields that are too
+     * large for their number of bits are truncated.
+     * @param pass The pass.
+     * @param permutation The shader permutation.
+     * @param material The material identifier.
+     * @param mesh The mesh identifier.
+     * @param depth The quantized view depth.
+     * @return The packed key.
+     */
+    static std::uint64_t makeKey(const Pass pass,
+                                 const std::uint32_t permutation,
+                                 const std::uint32_t material,
+                                 const std::uint32_t mesh,
+                                 const std::uint32_t depth) noexcept;
+
+    /**
+     * @brief Quantize a view depth.
+     * @param depth The distance to the camera along the viewing direction.
+     * @param nearPlane The distance of the near plane.
+     * @param farPlane The distance of the far plane.
+     * @return The depth mapped linearly from [nearPlane, farPlane] to
+     * [0, 2^kDepthBits - 1]. Depths outside the range are clamped.
+     */
+    static std::uint32_t quantizeDepth(const float depth,
+                                       const float nearPlane,
+                                       const float farPlane) noexcept;
+
+    /// Get the pass of a key.
+    static Pass pass(const std::uint64_t key) noexcept;
+
+    /// Get the shader permutation of a key.
+    static std::uint32_t permutation(const std::uint64_t key) noexcept;
+
+    /// Get the material identifier of a key.
+    static std::uint32_t material(const std::uint64_t key) noexcept;
+
+    /// Get the mesh identifier of a key.
+    static std::uint32_t mesh(const std::uint64_t key) noexcept;
+
+    /// Get the quantized view depth of a key.
+    static std::uint32_t depth(const std::uint64_t key) noexcept;
+
+    /**
+     * @brief Get the identifier of a material.
+     * @param material Pointer to some material.
+     * @return The identifier of the material.
+     */
+    std::uint32_t materialId(const void* material);
+
+    /**
+     * @brief Get the identifier of a mesh.
+     * @param mesh Pointer to some mesh.
+     * @return The identifier of the mesh.
+     */
+    std::uint32_t meshId(const void* mesh);
+
+    /**
+     * @brief Push a draw onto the queue.
+     * @param key The packed key.
+     * @param index The index of the draw.
+     */
+    inline void push(const std::uint64_t key, const std::uint32_t index)
+    {
+        mItems.push_back({key, index});
+    }
+
+    /**
+     * @brief Sort the draws by increasing key. The sort is stable, so draws
+     * with equal keys stay in the order in which they were pushed.
+     */
+    void sort();
+
+    /// Remove all draws and forget the material and mesh identifiers.
+    void clear() noexcept;
+
+    /// Get the number of draws.
+    inline std::size_t size() const noexcept { return mItems.size(); }
+
+    /// Check wether the queue is empty.
+    inline bool empty() const noexcept { return mItems.empty(); }
+
+    /// Get the draw at the given position.
+    inline const Item& operator[](const std::size_t i) const noexcept
+    {
+        return mItems[i];
+    }
+
+    /// Iterator to the first draw.
+    inline std::vector<Item>::const_iterator begin() const noexcept
+    {
+        return mItems.begin();
+    }
+
+    /// Iterator to one past the last draw.
+    inline std::vector<Item>::const_iterator end() const noexcept
+    {
+        return mItems.end();
+    }
+
+  private:
+    std::vector<Item> mItems;
+    std::vector<Item> mScratch;
+    std::unordered_map<const void*, std::uint32_t> mMaterialIds;
+    std::unordered_map<const void*, std::uint32_t> mMeshIds;
+};
+
+} // namespace gintonic
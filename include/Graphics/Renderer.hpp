@@ -11,6 +11,7 @@
 #include "ForwardDeclarations.hpp"
 #include "Foundation/WriteLock.hpp"
 #include "Foundation/allocator.hpp"
+#include "FrameStatistics.hpp"
 #include "Math/mat3f.hpp"
 #include "Math/mat4f.hpp"
 #include "Math/vec3f.hpp"
@@ -310,6 +311,183 @@ class Renderer
 
     ///@}
 
+    /**
+     * @name Frame Statistics
+     *
+     * Per-phase CPU timings and render counters of the previous frames.
+     */
+
+    ///@{
+
+    /**
+     * @brief Get the statistics of the previous frames.
+     * @details FrameStatistics::lastFrame holds the counters and timings of
+     * the last completed frame, and FrameStatistics::average holds the
+     * rolling average over the last FrameStatistics::windowSize frames.
+     * @return A constant reference to the frame statistics.
+     */
+    inline static const FrameStatistics& frameStats() noexcept
+    {
+        return sFrameStatistics;
+    }
+
+    /// The shadow casters of one light.
+    struct ShadowCasterCount
+    {
+        /// The light Entity.
+        const Entity* light;
+
+        /// The number of casters that the light draws.
+        std::size_t casters;
+
+        /// The number of casters that were culled for the light.
+        std::size_t culled;
+    };
+
+    /**
+     * @brief Get the number of shadow casters of every light that rendered
+     * shadows in the last frame.
+     * @details Every call to Renderer::cullShadowCasters adds the counts of
+     * its light, in the order in which the lights rendered their shadows.
+     * Unlike Renderer::frameStats, these are the counts of the last frame
+     * only, and they are not averaged; their sums are
+     * FrameSample::shadowCasters and FrameSample::culledShadowCasters.
+     * They are cleared when the lights of the next frame are culled.
+     * @return A constant reference to the counts.
+     */
+    inline static const std::vector<ShadowCasterCount>&
+    shadowCasterCounts() noexcept
+    {
+        return sShadowCasterCounts;
+    }
+
+    /**
+     * @brief Set the number of frames that the rolling averages of
+     * Renderer::frameStats are computed over.
+     * @param frameCount The number of frames.
+     */
+    static void setFrameStatsWindowSize(const std::size_t frameCount);
+
+    /**
+     * @brief Enable or disable the on-screen frame statistics overlay.
+     * @details The overlay prints the rolling averages of
+     * Renderer::frameStats to the Renderer::cout stream every frame.
+     * @param yesOrNo True to show the overlay, false to hide it.
+     */
+    static void setFrameStatsOverlay(const bool yesOrNo) noexcept;
+
+    /**
+     * @brief Query wether the frame statistics overlay is shown.
+     * @return True if the overlay is shown, false if not.
+     */
+    inline static bool getFrameStatsOverlay() noexcept
+    {
+        return sFrameStatsOverlay;
+    }
+
+    ///@}
+
+    /**
+     * @name Culling
+     *
+     * Removal of geometry and lights that are outside the camera's view
+     * frustum, and of shadow casters that are outside the reach of their
+     * light.
+     */
+
+    ///@{
+
+    /**
+     * @brief Enable or disable frustum culling of the geometry pass.
+     * @details The view frustum is extracted from
+     * Renderer::matrix_P * Renderer::matrix_V every frame, and every
+     * geometry Entity whose Entity::globalBoundingBox is outside of it is
+     * not drawn in the geometry pass. A light whose
+     * Light::getBoundingSphere is outside of it does not shine and does not
+     * render its shadows. The shadow passes do not use the view frustum,
+     * because a caster outside the view can cast a shadow into it; instead
+     * every light only sees the casters in its own reach, see
+     * Renderer::cullShadowCasters. The number of culled entities per bucket
+     * ends up in FrameSample::culled. Enabled by default.
+     * @param yesOrNo True to enable, false to disable.
+     */
+    static void setFrustumCulling(const bool yesOrNo) noexcept;
+
+    /**
+     * @brief Query wether frustum culling is enabled.
+     * @return True if frustum culling is enabled, false if not.
+     */
+    inline static bool getFrustumCulling() noexcept { return sFrustumCulling; }
+
+    /**
+     * @brief Use an Octree to find the visible geometry.
+     * @details When set, the culling stage queries the Octree with the view
+     * frustum instead of testing every submitted Entity. Every submitted
+     * geometry Entity must then also be in the Octree; those that are not
+     * are culled.
+     * @param root The root of the Octree, or nullptr to test every
+     * submitted Entity.
+     */
+    inline static void setCullingOctree(const Octree* root) noexcept
+    {
+        sCullingOctree = root;
+    }
+
+    /**
+     * @brief Get the Octree that is used to find the visible geometry.
+     * @return The root of the Octree, or nullptr if there is none.
+     */
+    inline static const Octree* getCullingOctree() noexcept
+    {
+        return sCullingOctree;
+    }
+
+    /**
+     * @brief Get the shadow casters that intersect the frustum of a light.
+     * @details Shadow buffers call this with the projection-view matrix of
+     * their light, so that they only draw the casters that end up in the
+     * shadow map. The numbers of remaining and culled casters are added to
+     * FrameSample::shadowCasters and FrameSample::culledShadowCasters, and
+     * to the counts of the light in Renderer::shadowCasterCounts. When
+     * frustum culling is disabled, this returns the casters unchanged.
+     * @param light The light Entity.
+     * @param frustum The frustum of the light.
+     * @param casters The shadow-casting geometry entities.
+     * @return The casters that intersect the frustum. The result is valid
+     * until the next call.
+     */
+    static const std::vector<std::shared_ptr<Entity>>&
+    cullShadowCasters(const Entity& light, const frustum3f& frustum,
+                      const std::vector<std::shared_ptr<Entity>>& casters);
+
+    /**
+     * @brief Get the shadow casters that intersect the sphere of a light.
+     * @details This is the same as the other overload, but for lights that
+     * shine in every direction, like a PointLight.
+     * @param light The light Entity.
+     * @param sphere The bounding sphere of the light.
+     * @param casters The shadow-casting geometry entities.
+     * @return The casters that intersect the sphere. The result is valid
+     * until the next call.
+     */
+    static const std::vector<std::shared_ptr<Entity>>&
+    cullShadowCasters(const Entity& light, const sphere3f& sphere,
+                      const std::vector<std::shared_ptr<Entity>>& casters);
+
+    /**
+     * @brief Count the shadow casters of a light without a bounding sphere.
+     * @details Such a light reaches every caster, so none are culled, but
+     * they are counted like in the other overloads.
+     * @param light The light Entity.
+     * @param casters The shadow-casting geometry entities.
+     * @return The casters.
+     */
+    static const std::vector<std::shared_ptr<Entity>>&
+    cullShadowCasters(const Entity& light,
+                      const std::vector<std::shared_ptr<Entity>>& casters);
+
+    ///@}
+
     /**
      * @name Camera, Matrices and Viewport Management
      *
@@ -333,6 +511,29 @@ class Renderer
      */
     static void submitEntityRecursive(std::shared_ptr<Entity> toSubmit);
 
+    /**
+     * @brief Register an entity and all of its children for rendering.
+     * @details Registered entities are rendered every frame until they are
+     * unregistered, without having to be submitted. The Renderer keeps
+     * track of them incrementally: when the castShadow flag, the Material,
+     * the Mesh or the Light of a registered entity changes, it fires
+     * Entity::onRenderStateChange and only that entity is looked at again.
+     * Children that are added later are not registered automatically.
+     *
+     * Submitting entities with submitEntityRecursive still works, but that
+     * visits the whole hierarchy every frame. Do not register and submit
+     * the same entity, or it is rendered twice.
+     * @param toRegister The entity to register.
+     */
+    static void registerEntityRecursive(std::shared_ptr<Entity> toRegister);
+
+    /**
+     * @brief Unregister an entity and all of its children.
+     * @param toUnregister The entity to unregister.
+     */
+    static void unregisterEntityRecursive(
+        std::shared_ptr<Entity> toUnregister);
+
     /**
      * @brief Get the current camera Entity.
      * @return A reference to the current camera Entity.
@@ -623,6 +824,100 @@ class Renderer
         return sRenderInWireframeMode;
     }
 
+    /**
+     * @brief Enable or disable automatic instancing.
+     * @details When enabled, consecutive draws of the geometry queue that
+     * share mesh and material are drawn with a single instanced draw call.
+     * Entities with an active animation clip on a skinned mesh are never
+     * instanced. Enabled by default.
+     * @param yesOrNo True to enable, false to disable.
+     */
+    static void setAutomaticInstancing(const bool yesOrNo) noexcept;
+
+    /**
+     * @brief Query wether automatic instancing is enabled.
+     * @return True if automatic instancing is enabled, false if not.
+     */
+    inline static bool getAutomaticInstancing() noexcept
+    {
+        return sAutomaticInstancing;
+    }
+
+    /**
+     * @brief Enable or disable printing the animated entities.
+     * @details When enabled, the name of every entity whose joint palette
+     * is evaluated this frame is printed to Renderer::cerr, along with the
+     * name of its animation clip. Disabled by default.
+     * @param yesOrNo True to enable, false to disable.
+     */
+    static void setDebugSkinning(const bool yesOrNo) noexcept;
+
+    /**
+     * @brief Query wether the animated entities are printed.
+     * @return True if they are printed, false if not.
+     */
+    inline static bool getDebugSkinning() noexcept { return sDebugSkinning; }
+
+    /**
+     * @brief Set the time in seconds to which the phase of an animated
+     * entity is rounded, so that entities that play the same clip at
+     * nearly the same time share one joint palette.
+     * @details Zero shares only between entities that started their clip
+     * at the same time. The default is 1/120 of a second. See
+     * SkinningCache::setQuantum.
+     * @param seconds The quantum.
+     */
+    static void setPoseQuantum(const float seconds) noexcept;
+
+    /**
+     * @brief Get the time to which the phase of an animated entity is
+     * rounded.
+     * @return The quantum in seconds.
+     */
+    inline static float getPoseQuantum() noexcept { return sPoseQuantum; }
+
+    /**
+     * @brief Set the number of joint palettes that are kept across frames.
+     * @details The least recently used palette is dropped first. The
+     * default is 256. See SkinningCache::setCapacity.
+     * @param capacity The number of palettes.
+     */
+    static void setPoseCacheCapacity(const std::size_t capacity) noexcept;
+
+    /**
+     * @brief Get the number of joint palettes that are kept across frames.
+     * @return The number of palettes.
+     */
+    inline static std::size_t getPoseCacheCapacity() noexcept
+    {
+        return sPoseCacheCapacity;
+    }
+
+    /**
+     * @brief Bind the joint palette of an entity to the JointBlock binding
+     * point of the material shaders.
+     * @details The palettes of all animated entities are evaluated once per
+     * frame, before the geometry pass, so every pass that draws the entity
+     * sees the same pose. An entity without a palette gets a block of
+     * zeroes.
+     * @param entity The entity.
+     * @return True if the entity has a palette this frame, false if not.
+     */
+    static bool bindJointBlock(const Entity& entity) noexcept;
+
+    /**
+     * @brief Get the adjacent positions of an entity in its animated pose.
+     * @details When a point light casts shadows, the adjacent positions of
+     * every skinned shadow caster are skinned on the CPU once per frame,
+     * so that its shadow volume follows the animation. Draw them with
+     * SkinnedPositions::drawAdjacent instead of Mesh::drawAdjacent.
+     * @param entity The entity.
+     * @return The skinned positions, or null if the entity has none this
+     * frame.
+     */
+    static const SkinnedPositions*
+    skinnedPositions(const Entity& entity) noexcept;
+
     /**
      * @brief Enable or disable viewing the raw geometry buffers.
      *
@@ -690,6 +985,23 @@ class Renderer
      */
     static void update() noexcept;
 
+    /**
+     * @brief Draw entities with the material shader, exactly the way the
+     * geometry pass of update() draws the visible geometry.
+     * @details The draws are sorted, batched into runs that share mesh and
+     * material, instanced when automatic instancing is enabled, and their
+     * uniform blocks are staged and bound by the same code as in update().
+     * Nothing is culled and no window is needed, so under an
+     * OpenGL::RecordingContext this gives the OpenGL calls that the geometry
+     * pass makes for a scene. A camera entity must be set, and the
+     * MaterialShaderProgram must be initialized. Animated entities use the
+     * joint palettes that the last update() evaluated for them.
+     * @param entities The entities to draw. Every one of them needs a mesh
+     * and a material.
+     */
+    static void renderGeometry(
+        const std::vector<std::shared_ptr<Entity>>& entities) noexcept;
+
     /**
      * @deprecated
      */
@@ -868,6 +1180,12 @@ class Renderer
     static bool sRenderInWireframeMode;
     static bool sViewGeometryBuffers;
     static bool sViewCameraDepthBuffer;
+    static bool sFrameStatsOverlay;
+    static bool sFrustumCulling;
+    static bool sAutomaticInstancing;
+    static bool sDebugSkinning;
+    static float sPoseQuantum;
+    static std::size_t sPoseCacheCapacity;
     static int sWidth;
     static int sHeight;
     static float sAspectRatio;
@@ -876,7 +1194,8 @@ class Renderer
     static duration_type sDeltaTime;
     static duration_type sPrevElapsedTime;
     static duration_type sElapsedTime;
-    static boost::circular_buffer<duration_type> s_circle_buffer;
+    static FrameStatistics sFrameStatistics;
+    static std::vector<ShadowCasterCount> sShadowCasterCounts;
     static vec2f sMouseDelta;
     static vec2f sMouseWheel;
     static vec4f sFingerMotion;
@@ -893,15 +1212,10 @@ class Renderer
     static mat4f sMatrixPVM;
     static mat3f sMatrixN;
 
-    static std::vector<mat4f, allocator<mat4f>> sMatrix44Array;
-    static std::vector<vec4f, allocator<vec4f>> sMatrix33Array;
-
-    static OpenGL::BufferObject* sMatrix44UniformBuffer;
-    static OpenGL::BufferObject* sMatrix33UniformBuffer;
-
     static std::shared_ptr<Entity> sCameraEntity;
     static std::shared_ptr<Entity> sDebugShadowBufferEntity;
     static const Octree* sOctreeRoot;
+    static const Octree* sCullingOctree;
     static vec3f sCameraPosition;
 
     static std::shared_ptr<Mesh> sUnitQuadPUN;
@@ -913,17 +1227,26 @@ class Renderer
     static std::shared_ptr<Mesh> sUnitCylinderPUN;
 
     static void prepareRendering() noexcept;
+    static void collectFrameEntities();
+    static void cullGeometry() noexcept;
+    static void cullLights() noexcept;
+    static void countShadowCasters(const Entity& light,
+                                   const std::size_t casters,
+                                   const std::size_t culled);
+    static void updateSkinning() noexcept;
+    static void updateSkinnedPositions();
     static void renderGeometry() noexcept;
 
-    static void renderGeometry(const std::vector<std::shared_ptr<Entity>>&,
-                               std::vector<mat4f, allocator<mat4f>>&,
-                               std::vector<mat3f>&) noexcept;
+    static void drawGeometryQueue() noexcept;
+    static void stageGeometryQueue() noexcept;
+    static void renderGeometryQueue() noexcept;
 
     static void renderShadows() noexcept;
     static void renderPointLights() noexcept;
     static void renderLights() noexcept;
     static void finalizeRendering() noexcept;
     static void renderGUI() noexcept;
+    static void renderFrameStatsOverlay() noexcept;
     static void processEvents() noexcept;
 };
 
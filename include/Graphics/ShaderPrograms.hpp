@@ -7,6 +7,8 @@
 #pragma once
 
 #include "../Foundation/allocator.hpp"
+#include "../Math/mat4f.hpp"
+#include "../Math/vec4f.hpp"
 
 #include "OpenGL/ShaderProgram.hpp"
 #include "OpenGL/BufferObject.hpp"
@@ -20,6 +22,8 @@ namespace Uniform {
 
 #define GT_PASTE_TOGETHER(x, y) x ## y
 
+#define GT_PASTE_TOGETHER3(x, y, z) x ## y ## z
+
 #define GT_DEFINE_UNIFORM(UNIFORM_TYPE, UNIFORM_NAME, UNIFORM_NAME_WITH_FIRST_CAPITAL)       \
 /** @brief Class that encapsulates a uniform variable in a shader. */                        \
 class UNIFORM_NAME : virtual public OpenGL::ShaderProgram                                    \
@@ -57,6 +61,7 @@ GT_DEFINE_UNIFORM(const Matrix4fArray&, matrixB, MatrixB);
 GT_DEFINE_UNIFORM(const Matrix3fArray&, matrixBN, MatrixBN);
 
 GT_DEFINE_UNIFORM(GLint,        instancedRendering,            InstancedRendering);
+GT_DEFINE_UNIFORM(GLint,        meshHasJoints,                 MeshHasJoints);
 GT_DEFINE_UNIFORM(GLint,        hasTangentsAndBitangents,      HasTangentsAndBitangents);
 
 GT_DEFINE_UNIFORM(GLint,        materialFlag,                  MaterialFlag);
@@ -114,21 +119,28 @@ protected:
 	virtual ~UNIFORM_NAME() noexcept = default;                                              \
 public:                                                                                      \
 	/**                                                                                      \
-	 * @brief Set the value of the UNIFORM_NAME uniform in the shader program.               \
-	 * @param [in] value The value to set.                                                   \
+	 * @brief Get the index of the UNIFORM_NAME uniform block in the shader program.        \
+	 * @return The index of the uniform block.                                               \
 	 */                                                                                      \
 	inline GLuint GT_PASTE_TOGETHER(get, UNIFORM_NAME_WITH_FIRST_CAPITAL)() const noexcept   \
 	{                                                                                        \
 		return mIndex;                                                                       \
 	}                                                                                        \
-	inline void bindBuffer(const OpenGL::BufferObject& buffer) const noexcept                \
+	/**                                                                                      \
+	 * @brief Read the UNIFORM_NAME uniform block from a uniform buffer binding point.       \
+	 * @param [in] bindingPoint The uniform buffer binding point.                            \
+	 */                                                                                      \
+	inline void GT_PASTE_TOGETHER3(set, UNIFORM_NAME_WITH_FIRST_CAPITAL, Binding)            \
+		(const GLuint bindingPoint) const noexcept                                           \
 	{                                                                                        \
-		glUniformBlockBinding(*this, mIndex, buffer);                                        \
+		glUniformBlockBinding(*this, mIndex, bindingPoint);                                  \
 	}                                                                                        \
 };
 
-GT_DEFINE_UNIFORM_BLOCK(Joint44, Joint44);
-GT_DEFINE_UNIFORM_BLOCK(Joint33, Joint33);
+GT_DEFINE_UNIFORM_BLOCK(CameraBlock,   CameraBlock);
+GT_DEFINE_UNIFORM_BLOCK(ObjectBlock,   ObjectBlock);
+GT_DEFINE_UNIFORM_BLOCK(MaterialBlock, MaterialBlock);
+GT_DEFINE_UNIFORM_BLOCK(JointBlock,    JointBlock);
 
 } // namespace Block
 } // namespace Uniform
@@ -146,7 +158,8 @@ public:
 	/**
 	 * @brief Initialize this shader program.
 	 * The Renderer takes care of that.
-	 * @attention Never call this method yourself.
+	 * @attention Never call this method yourself, unless there is no
+	 * Renderer, as in a test under an OpenGL::RecordingContext.
 	 */
 	inline static void initialize()
 	{
@@ -157,7 +170,8 @@ public:
 	/**
 	 * @brief Release this shader.
 	 * The Renderer takes care of that.
-	 * @attention Never call this method yourself.
+	 * @attention Never call this method yourself, unless you initialized
+	 * it yourself.
 	 */
 	inline static void release() noexcept
 	{
@@ -195,25 +209,58 @@ template <class D> D* ShaderProgramBase<D>::sInstance = nullptr;
  */
 class MaterialShaderProgram
 : public ShaderProgramBase<MaterialShaderProgram>
-, public Uniform::matrixPVM
-, public Uniform::matrixVM
-, public Uniform::matrixN
-, public Uniform::matrixB
-, public Uniform::matrixBN
 // , public Uniform::instancedRendering
 // , public Uniform::hasTangentsAndBitangents
-, public Uniform::materialDiffuseColor
-, public Uniform::materialSpecularColor
 , public Uniform::materialDiffuseTexture
 , public Uniform::materialSpecularTexture
 , public Uniform::materialNormalTexture
 , public Uniform::materialFlag
-// , public Uniform::Block::Joint44
-// , public Uniform::Block::Joint33
+, public Uniform::Block::CameraBlock
+, public Uniform::Block::ObjectBlock
+, public Uniform::Block::MaterialBlock
+, public Uniform::Block::JointBlock
 // , public Uniform::debugFlag
 {
 public:
 
+	/// The uniform buffer binding points that the uniform blocks read from.
+	enum BlockBinding
+	{
+		kCameraBlockBinding = 0,
+		kObjectBlockBinding,
+		kMaterialBlockBinding,
+		kJointBlockBinding
+	};
+
+	/// The std140 layout of the CameraBlock. Set once per frame.
+	struct CameraData
+	{
+		mat4f matrixP;
+		mat4f matrixV;
+	};
+
+	/// The std140 layout of the ObjectBlock. Set per draw call.
+	struct ObjectData
+	{
+		mat4f matrixVM;
+		vec4f matrixN[3]; // A mat3 takes three vec4 columns in std140.
+	};
+
+	/// The std140 layout of the MaterialBlock. Set per material.
+	struct MaterialData
+	{
+		vec4f diffuseColor;
+		vec4f specularColor;
+	};
+
+	/// The std140 layout of one element of the joints array of the
+	/// JointBlock. The block has room for GT_SKELETON_MAX_JOINTS of them.
+	struct JointData
+	{
+		mat4f matrixB;
+		vec4f matrixBN[3]; // A mat3 takes three vec4 columns in std140.
+	};
+
 	/// Defaulted constructor.
 	MaterialShaderProgram();
 
@@ -236,6 +283,8 @@ class ShadowShaderProgram
 : public ShaderProgramBase<ShadowShaderProgram>
 , public Uniform::matrixPVM
 , public Uniform::instancedRendering
+, public Uniform::meshHasJoints
+, public Uniform::Block::JointBlock
 {
 public:
 	ShadowShaderProgram();
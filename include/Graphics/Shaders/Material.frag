@@ -18,8 +18,13 @@ in vec3 viewSpaceVertexNormal;
 in vec2 textureCoordinates;
 in mat3 tangentMatrix;
 
-uniform vec4      materialDiffuseColor;
-uniform vec4      materialSpecularColor;
+// Uploaded once per material per frame.
+layout(std140) uniform MaterialBlock
+{
+	vec4 diffuseColor;
+	vec4 specularColor;
+} material;
+
 uniform sampler2D materialDiffuseTexture;
 uniform sampler2D materialSpecularTexture;
 uniform sampler2D materialNormalTexture;
@@ -35,14 +40,14 @@ void main()
 {
 	outPosition = viewSpaceVertexPosition;
 
-	outDiffuse = materialDiffuseColor;
+	outDiffuse = material.diffuseColor;
 
 	if ((materialFlag & HAS_DIFFUSE_TEXTURE) == HAS_DIFFUSE_TEXTURE)
 	{
 		outDiffuse *= texture(materialDiffuseTexture, textureCoordinates);
 	}
 
-	outSpecular = materialSpecularColor;
+	outSpecular = material.specularColor;
 
 	if ((materialFlag & HAS_SPECULAR_TEXTURE) == HAS_SPECULAR_TEXTURE)
 	{
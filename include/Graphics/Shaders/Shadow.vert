@@ -15,18 +15,51 @@
 #define GT_VERTEX_LAYOUT_SLOT_11 11 //   N.00   N.01   N.02 unused <--- instanced rendering
                                     //   N.10   N.11   N.12 unused <--- instanced rendering
                                     //   N.20   N.21   N.22 unused <--- instanced rendering
-#define GT_VERTEX_LAYOUT_SLOT_14 14 //   free   free   free   free
-#define GT_VERTEX_LAYOUT_SLOT_15 15 //   free   free   free   free
+#define GT_VERTEX_LAYOUT_SLOT_14 14 // boneID.x boneID.y boneID.z boneID.w
+#define GT_VERTEX_LAYOUT_SLOT_15 15 // weight.x weight.y weight.z weight.w
 
-layout(location = GT_VERTEX_LAYOUT_SLOT_0)  in vec4 iSlot0;
-layout(location = GT_VERTEX_LAYOUT_SLOT_3)  in mat4 iMatrixPVM;
+#define GT_SKELETON_MAX_JOINTS (1 << 7)
+
+layout(location = GT_VERTEX_LAYOUT_SLOT_0)  in vec4  iSlot0;
+layout(location = GT_VERTEX_LAYOUT_SLOT_3)  in mat4  iMatrixPVM;
+layout(location = GT_VERTEX_LAYOUT_SLOT_14) in ivec4 iBoneID;
+layout(location = GT_VERTEX_LAYOUT_SLOT_15) in vec4  iBoneWeight;
+
+struct Joint
+{
+	mat4 matrixB;
+	mat3 matrixBN;
+};
+
+// The same palette that the geometry pass uses, evaluated once per frame.
+layout(std140) uniform JointBlock
+{
+	Joint joints[GT_SKELETON_MAX_JOINTS];
+} skeleton;
 
 uniform mat4 matrixPVM;
 uniform int  instancedRendering;
+uniform int  meshHasJoints;
+
+vec4 fromBoneSpaceToLocalSpace(in vec4 v)
+{
+	vec4 lTemp = vec4(0.0f, 0.0f, 0.0f, 0.0f);
+
+	lTemp += (skeleton.joints[iBoneID.x].matrixB * v) * iBoneWeight.x;
+	lTemp += (skeleton.joints[iBoneID.y].matrixB * v) * iBoneWeight.y;
+	lTemp += (skeleton.joints[iBoneID.z].matrixB * v) * iBoneWeight.z;
+	lTemp += (skeleton.joints[iBoneID.w].matrixB * v) * iBoneWeight.w;
+
+	return lTemp;
+}
 
 void main()
 {
 	vec4 localPosition = vec4(iSlot0.xyz, 1.0f);
+	if (meshHasJoints != 0)
+	{
+		localPosition = fromBoneSpaceToLocalSpace(localPosition);
+	}
       if (instancedRendering != 0)
       {
             gl_Position = iMatrixPVM * localPosition;
@@ -23,6 +23,8 @@
 namespace gintonic
 {
 
+class SQTArray; // Forward declaration.
+
 class Skeleton
 {
   public:
@@ -96,6 +98,9 @@ class Skeleton
 
     std::vector<Joint, allocator<Joint>> joints;
 
+    /// Default constructor. Makes a skeleton without joints.
+    Skeleton() = default;
+
     using iterator = std::vector<Joint, allocator<Joint>>::iterator;
     using const_iterator = std::vector<Joint, allocator<Joint>>::const_iterator;
 
@@ -138,11 +143,20 @@ class Skeleton
         return joints[jointIndex];
     }
 
+    /**
+     * @brief Turn the local transforms of the joints into a joint palette.
+     * @details Every joint is composed with its parent once, so this is
+     * done once per entity, after the local transforms of all the clips
+     * that play on it have been blended.
+     * @param localPose The transform of every joint relative to its parent.
+     * @param outPalette Receives, for every joint in the pose, its global
+     * transform times its inverse bind pose.
+     */
+    void compose(const SQTArray& localPose, mat4f* outPalette) const noexcept;
+
   private:
     friend class boost::serialization::access;
 
-    Skeleton() = default;
-
     friend std::ostream& operator<<(std::ostream& os, const Skeleton& skeleton);
 
     template <class Archive>
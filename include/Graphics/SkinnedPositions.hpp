@@ -0,0 +1,82 @@
+/**
+ * @file SkinnedPositions.hpp
+ * @brief Defines the positions of a skinned mesh in its animated pose.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "Mesh.hpp"
+
+#include "OpenGL/BufferObject.hpp"
+#include "OpenGL/VertexArrayObject.hpp"
+
+#include <vector>
+
+namespace gintonic
+{
+
+class WorkerPool; // Forward declaration.
+
+/**
+ * @brief The adjacent positions of a skinned mesh, skinned on the CPU.
+ *
+ * @details The vertex shaders skin the vertices of a mesh, but the shadow
+ * volumes and silhouettes are made from Mesh::adjacentPositions, and
+ * picking happens on the CPU. Both need the positions in the animated
+ * pose. SkinnedPositions::update skins them with skinPositions, spread
+ * over a WorkerPool. The result can be queried with
+ * SkinnedPositions::positions, and uploaded and drawn with the adjacency
+ * array of the mesh instead of Mesh::drawAdjacent.
+ */
+class SkinnedPositions
+{
+  public:
+    /// Default constructor.
+    SkinnedPositions() = default;
+
+    /**
+     * @brief Skin the adjacent positions of a mesh.
+     * @param mesh The mesh. Must have joint weights.
+     * @param palette The joint palette of the entity.
+     * @param jointCount The number of matrices in the palette.
+     * @param workers The workers that skin ranges of the positions.
+     */
+    void update(const Mesh& mesh, const mat4f* palette,
+                const std::size_t jointCount, WorkerPool& workers);
+
+    /// Get the skinned positions, in the local space of the mesh.
+    inline const std::vector<Mesh::vec3f>& positions() const noexcept
+    {
+        return mPositions;
+    }
+
+    /// Upload the skinned positions.
+    void upload();
+
+    /**
+     * @brief Draw the skinned positions with the adjacency array of the
+     * mesh that they were updated with. Uses `GL_TRIANGLES_ADJACENCY`, like
+     * Mesh::drawAdjacent.
+     */
+    void drawAdjacent() const noexcept;
+
+    /// Get the number of positions per chunk of work.
+    inline std::size_t chunkSize() const noexcept { return mChunkSize; }
+
+    /// Set the number of positions per chunk of work.
+    inline void setChunkSize(const std::size_t chunkSize) noexcept
+    {
+        mChunkSize = chunkSize ? chunkSize : 1;
+    }
+
+  private:
+    std::vector<Mesh::vec3f> mPositions;
+    const Mesh* mMesh = nullptr;
+    const Mesh* mBoundMesh = nullptr;
+    OpenGL::VertexArrayObject mVertexArrayObject;
+    OpenGL::BufferObject mBuffer;
+    std::size_t mChunkSize = 4096;
+};
+
+} // namespace gintonic
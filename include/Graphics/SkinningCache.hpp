@@ -0,0 +1,253 @@
+/**
+ * @file SkinningCache.hpp
+ * @brief Defines the per-frame cache of the joint palettes of animated
+ * entities.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "../Foundation/allocator.hpp"
+#include "../Math/mat3f.hpp"
+#include "../Math/mat4f.hpp"
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace gintonic
+{
+
+class AnimationBlend; // Forward declaration.
+class AnimationClip;  // Forward declaration.
+class Entity;         // Forward declaration.
+class WorkerPool;     // Forward declaration.
+
+/**
+ * @brief Evaluates the joint palette of every animated entity once per
+ * frame.
+ *
+ * @details Every pass that draws a skinned mesh needs the same joint
+ * matrices. So instead of evaluating the animation clip in each pass, the
+ * animated entities of a frame are collected with SkinningCache::add, and
+ * SkinningCache::evaluate computes the joint matrices and the joint normal
+ * matrices of all of them in one go, spread over a WorkerPool. An entity
+ * that is added more than once gets a single palette. The palettes are
+ * laid out in the order in which the entities were added, so the result
+ * does not depend on the number of workers.
+ *
+ * Entities that play the same clip at nearly the same time share a
+ * palette. The time since the start of the clip is rounded to a multiple
+ * of SkinningCache::quantum, and every entity with the same clip and the
+ * same rounded time gets the same palette, evaluated once. The evaluated
+ * poses are also kept across frames, up to SkinningCache::capacity of
+ * them, and the least recently used pose is dropped first. So a crowd that
+ * plays one clip costs about one evaluation per distinct phase, at the
+ * price of an error of at most half a quantum in the phase of every
+ * entity. A quantum of zero turns this off. An entity that plays an
+ * AnimationBlend always gets a palette of its own.
+ *
+ * Call SkinningCache::clear at the start of every frame.
+ */
+class SkinningCache
+{
+  public:
+    /// The matrices of the joints.
+    using Matrix4fArray = std::vector<mat4f, allocator<mat4f>>;
+
+    /// The normal matrices of the joints.
+    using Matrix3fArray = std::vector<mat3f>;
+
+    /// The index of the palette of an entity that is not skinned.
+    static constexpr std::uint32_t kNone = ~std::uint32_t(0);
+
+    /// The joint palette of one or more entities.
+    struct Palette
+    {
+        /// The first entity that was added with this palette.
+        const Entity* entity;
+
+        /// The first joint of the palette in SkinningCache::jointMatrices.
+        std::uint32_t offset;
+
+        /// The number of joints.
+        std::uint32_t count;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param workers The workers that evaluate the palettes.
+     */
+    explicit SkinningCache(WorkerPool& workers);
+
+    /**
+     * @brief Check whether an entity has a skinned pose.
+     * @return True when the entity plays an animation clip or an animation
+     * blend and its mesh has joint weights.
+     */
+    static bool isSkinned(const Entity& entity) noexcept;
+
+    /**
+     * @brief Forget the palettes of the previous frame and start a new
+     * one. The poses that are kept across frames stay.
+     * @param elapsedTime The time in seconds at which the animations of
+     * this frame are evaluated.
+     */
+    void clear(const float elapsedTime) noexcept;
+
+    /**
+     * @brief Add an entity to the palettes of this frame.
+     * @return The index of the palette of the entity, or
+     * SkinningCache::kNone when the entity is not skinned.
+     */
+    std::uint32_t add(const Entity& entity);
+
+    /// Evaluate every palette that was added.
+    void evaluate();
+
+    /**
+     * @brief Find the palette of an entity. Safe to call from several
+     * threads at once, as long as no entities are added.
+     * @return The index of the palette, or SkinningCache::kNone.
+     */
+    std::uint32_t find(const Entity* entity) const noexcept;
+
+    /// Get the number of palettes.
+    inline std::size_t size() const noexcept { return mPalettes.size(); }
+
+    /// Check whether there are no palettes.
+    inline bool empty() const noexcept { return mPalettes.empty(); }
+
+    /// Get a palette.
+    inline const Palette& operator[](const std::size_t i) const noexcept
+    {
+        return mPalettes[i];
+    }
+
+    /// Get the time in seconds to which the phase of an entity is rounded.
+    inline float quantum() const noexcept { return mQuantum; }
+
+    /**
+     * @brief Set the time in seconds to which the phase of an entity is
+     * rounded. With zero, only the entities that started their clip at
+     * the same time share a palette, and no poses are kept across frames.
+     * Drops the poses that are kept across frames.
+     */
+    void setQuantum(const float quantum);
+
+    /// Get the number of poses that are kept across frames.
+    inline std::size_t capacity() const noexcept { return mCapacity; }
+
+    /**
+     * @brief Set the number of poses that are kept across frames. Zero
+     * keeps none, but entities still share palettes within a frame.
+     */
+    void setCapacity(const std::size_t capacity);
+
+    /**
+     * @brief Drop the poses that are kept across frames.
+     * @details Call this after changing or destroying an animation clip,
+     * since the poses are found by the address of their clip.
+     */
+    void clearPoses() noexcept;
+
+    /**
+     * @brief Get the number of entities of this frame whose palette did
+     * not have to be evaluated, because it was shared with another entity
+     * or kept from an earlier frame.
+     */
+    inline std::size_t hits() const noexcept { return mHits; }
+
+    /// Get the number of palettes that were evaluated this frame.
+    inline std::size_t misses() const noexcept { return mMisses; }
+
+    /// Get the number of palettes per chunk of work.
+    inline std::size_t chunkSize() const noexcept { return mChunkSize; }
+
+    /// Set the number of palettes per chunk of work.
+    inline void setChunkSize(const std::size_t chunkSize) noexcept
+    {
+        mChunkSize = chunkSize ? chunkSize : 1;
+    }
+
+    /// Get the joint matrices of all palettes.
+    inline const Matrix4fArray& jointMatrices() const noexcept
+    {
+        return mJointMatrices;
+    }
+
+    /// Get the joint normal matrices of all palettes.
+    inline const Matrix3fArray& jointNormalMatrices() const noexcept
+    {
+        return mJointNormalMatrices;
+    }
+
+  private:
+    // A clip at a rounded time since its start. The time is a multiple of
+    // the quantum. Without a quantum, the time is the bits of the start
+    // time of the entity, so that only entities that started at the same
+    // time share.
+    struct Key
+    {
+        const AnimationClip* clip;
+        std::int64_t time;
+
+        inline bool operator==(const Key& other) const noexcept
+        {
+            return clip == other.clip && time == other.time;
+        }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const noexcept;
+    };
+
+    // How to fill a palette.
+    struct Source
+    {
+        Key key;
+
+        // The blend to evaluate instead of the clip of the key, or null.
+        const AnimationBlend* blend;
+
+        // The start time to evaluate the clip with.
+        float startTime;
+
+        // The pose of an earlier frame, or null to evaluate the clip.
+        const Matrix4fArray* matrices;
+        const Matrix3fArray* normalMatrices;
+    };
+
+    // A pose that is kept across frames.
+    struct Pose
+    {
+        Key key;
+        Matrix4fArray matrices;
+        Matrix3fArray normalMatrices;
+    };
+
+    using PoseList = std::list<Pose>;
+
+    void evaluateRange(const std::size_t first, const std::size_t last);
+    void keepPose(const Source& source, const Palette& palette);
+
+    WorkerPool& mWorkers;
+    std::vector<Palette> mPalettes;
+    std::vector<Source> mSources;
+    std::unordered_map<const Entity*, std::uint32_t> mIndices;
+    std::unordered_map<Key, std::uint32_t, KeyHash> mShared;
+    PoseList mPoses; // The most recently used pose comes first.
+    std::unordered_map<Key, PoseList::iterator, KeyHash> mPoseIndices;
+    Matrix4fArray mJointMatrices;
+    Matrix3fArray mJointNormalMatrices;
+    std::uint32_t mJointCount = 0;
+    std::size_t mChunkSize = 4;
+    float mElapsedTime = 0.0f;
+    float mQuantum = 1.0f / 120.0f;
+    std::size_t mCapacity = 256;
+    std::size_t mHits = 0;
+    std::size_t mMisses = 0;
+};
+
+} // namespace gintonic
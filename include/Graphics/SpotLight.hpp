@@ -62,6 +62,18 @@ public:
 	virtual void setCosineHalfAngle(const float angle);
 
 	virtual float getCosineHalfAngle() const noexcept;
+
+	/**
+	 * @brief Get the smallest sphere around the cone of the light.
+	 * @details For a narrow cone this is much smaller than the sphere with
+	 * the cutoff radius around the apex.
+	 * @param lightEntity The Entity that shines this light.
+	 * @param [out] sphere Receives the bounding sphere.
+	 * @return False if the attenuation has no distance terms, in which case
+	 * the light is unbounded.
+	 */
+	virtual bool getBoundingSphere(const Entity& lightEntity,
+		sphere3f& sphere) const noexcept;
 	
 	virtual void shine(
 		const Entity& lightEntity, 
@@ -0,0 +1,245 @@
+/**
+ * @file Intersections.hpp
+ * @brief Defines the intersection tests between the geometric primitives.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "box3f.hpp"
+#include "frustum3f.hpp"
+#include "obb3f.hpp"
+#include "plane3f.hpp"
+#include "ray3f.hpp"
+#include "sphere3f.hpp"
+
+namespace gintonic {
+
+/**
+ * @name Intersection tests
+ * @details Every pair of primitives has one test. The arguments are always
+ * in the order ray3f, frustum3f, plane3f, sphere3f, obb3f, box3f, so that
+ * the thing that is tested against comes last. Touching primitives
+ * intersect. A plane only intersects the primitives that it cuts; use
+ * plane3f::distance to find out on which side something is.
+ */
+///@{
+
+/**
+ * @brief Check wether a ray intersects a frustum.
+ * @param ray Some ray.
+ * @param frustum Some frustum.
+ * @param [out] distance Receives the distance along the ray to where it
+ * enters the frustum; zero if it starts inside.
+ * @return True if the ray intersects the frustum, false otherwise.
+ */
+bool intersects(const ray3f& ray, const frustum3f& frustum, float& distance)
+	noexcept;
+
+/**
+ * @brief Check wether a ray intersects a plane.
+ * @param ray Some ray.
+ * @param plane Some plane.
+ * @param [out] distance Receives the distance along the ray to the plane.
+ * @return True if the ray hits the plane, false otherwise. A ray that lies
+ * in the plane hits it at distance zero.
+ */
+bool intersects(const ray3f& ray, const plane3f& plane, float& distance)
+	noexcept;
+
+/**
+ * @brief Check wether a ray intersects a sphere.
+ * @param ray Some ray.
+ * @param sphere Some sphere.
+ * @param [out] distance Receives the distance along the ray to where it
+ * enters the sphere; zero if it starts inside.
+ * @return True if the ray intersects the sphere, false otherwise.
+ */
+bool intersects(const ray3f& ray, const sphere3f& sphere, float& distance)
+	noexcept;
+
+/**
+ * @brief Check wether a ray intersects an oriented box.
+ * @param ray Some ray.
+ * @param box Some oriented box.
+ * @param [out] distance Receives the distance along the ray to where it
+ * enters the box; zero if it starts inside.
+ * @return True if the ray intersects the box, false otherwise.
+ */
+bool intersects(const ray3f& ray, const obb3f& box, float& distance)
+	noexcept;
+
+/**
+ * @brief Check wether a ray intersects a box.
+ * @param ray Some ray.
+ * @param box Some bounding box.
+ * @param [out] distance Receives the distance along the ray to where it
+ * enters the box; zero if it starts inside.
+ * @return True if the ray intersects the box, false otherwise.
+ */
+bool intersects(const ray3f& ray, const box3f& box, float& distance)
+	noexcept;
+
+/**
+ * @brief Check wether two frustums intersect.
+ * @details This test is conservative in the same way as
+ * frustum3f::intersects. Frustums without a far plane always intersect.
+ * @param a Some frustum.
+ * @param b Another frustum.
+ * @return False if the frustums are separated, true otherwise.
+ */
+bool intersects(const frustum3f& a, const frustum3f& b) noexcept;
+
+/**
+ * @brief Check wether a plane cuts a frustum.
+ * @param frustum Some frustum. A frustum without a far plane always
+ * intersects.
+ * @param plane Some plane.
+ * @return True if the plane cuts the frustum, false otherwise.
+ */
+bool intersects(const frustum3f& frustum, const plane3f& plane) noexcept;
+
+/**
+ * @brief Check wether a sphere intersects a frustum.
+ * @details This test is conservative: a sphere near an edge of the frustum
+ * may be reported as intersecting while it is in fact outside.
+ * @param frustum Some frustum.
+ * @param sphere Some sphere.
+ * @return False if the sphere is outside, true otherwise.
+ */
+bool intersects(const frustum3f& frustum, const sphere3f& sphere) noexcept;
+
+/**
+ * @brief Check wether an oriented box intersects a frustum.
+ * @details This test is conservative in the same way as
+ * frustum3f::intersects.
+ * @param frustum Some frustum.
+ * @param box Some oriented box.
+ * @return False if the box is outside, true otherwise.
+ */
+bool intersects(const frustum3f& frustum, const obb3f& box) noexcept;
+
+/**
+ * @brief Check wether a box intersects a frustum.
+ * @details This is frustum3f::intersects.
+ * @param frustum Some frustum.
+ * @param box Some bounding box.
+ * @return False if the box is outside, true otherwise.
+ */
+bool intersects(const frustum3f& frustum, const box3f& box) noexcept;
+
+/**
+ * @brief Check wether two planes intersect.
+ * @param a Some plane.
+ * @param b Another plane.
+ * @return False if the planes are parallel and apart, true otherwise.
+ */
+bool intersects(const plane3f& a, const plane3f& b) noexcept;
+
+/**
+ * @brief Check wether a plane cuts a sphere.
+ * @param plane Some plane.
+ * @param sphere Some sphere.
+ * @return True if the plane cuts the sphere, false otherwise.
+ */
+bool intersects(const plane3f& plane, const sphere3f& sphere) noexcept;
+
+/**
+ * @brief Check wether a plane cuts an oriented box.
+ * @param plane Some plane.
+ * @param box Some oriented box.
+ * @return True if the plane cuts the box, false otherwise.
+ */
+bool intersects(const plane3f& plane, const obb3f& box) noexcept;
+
+/**
+ * @brief Check wether a plane cuts a box.
+ * @param plane Some plane.
+ * @param box Some bounding box.
+ * @return True if the plane cuts the box, false otherwise.
+ */
+bool intersects(const plane3f& plane, const box3f& box) noexcept;
+
+/**
+ * @brief Check wether two spheres intersect.
+ * @param a Some sphere.
+ * @param b Another sphere.
+ * @return True if the spheres intersect, false otherwise.
+ */
+bool intersects(const sphere3f& a, const sphere3f& b) noexcept;
+
+/**
+ * @brief Check wether a sphere intersects an oriented box.
+ * @param sphere Some sphere.
+ * @param box Some oriented box.
+ * @return True if the sphere intersects the box, false otherwise.
+ */
+bool intersects(const sphere3f& sphere, const obb3f& box) noexcept;
+
+/**
+ * @brief Check wether a sphere intersects a box.
+ * @param sphere Some sphere.
+ * @param box Some bounding box.
+ * @return True if the sphere intersects the box, false otherwise.
+ */
+bool intersects(const sphere3f& sphere, const box3f& box) noexcept;
+
+/**
+ * @brief Check wether two oriented boxes intersect.
+ * @details This is the separating axis test with fifteen axes.
+ * @param a Some oriented box.
+ * @param b Another oriented box.
+ * @return True if the boxes intersect, false otherwise.
+ */
+bool intersects(const obb3f& a, const obb3f& b) noexcept;
+
+/**
+ * @brief Check wether an oriented box intersects a box.
+ * @param a Some oriented box.
+ * @param b Some bounding box.
+ * @return True if the boxes intersect, false otherwise.
+ */
+bool intersects(const obb3f& a, const box3f& b) noexcept;
+
+///@}
+
+/**
+ * @name Four boxes at a time
+ * @details These do the same tests as the ones above, but against four
+ * bounding boxes at once. The boxes are transposed in registers, so that
+ * every SSE lane does the test for one box.
+ *
+ * The boxes parameter must point to four boxes. The result has bit i set if
+ * boxes[i] intersects the primitive.
+ */
+///@{
+
+/**
+ * @brief Check wether a ray intersects four boxes.
+ * @param ray Some ray.
+ * @param boxes Pointer to four bounding boxes.
+ * @param [out] distances Receives the distances along the ray to where it
+ * enters each box that it intersects. Must point to four floats.
+ * @return The mask of the boxes that intersect.
+ */
+int intersects4(const ray3f& ray, const box3f* boxes, float* distances)
+	noexcept;
+
+/// Check wether a frustum intersects four boxes.
+int intersects4(const frustum3f& frustum, const box3f* boxes) noexcept;
+
+/// Check wether a plane cuts four boxes.
+int intersects4(const plane3f& plane, const box3f* boxes) noexcept;
+
+/// Check wether a sphere intersects four boxes.
+int intersects4(const sphere3f& sphere, const box3f* boxes) noexcept;
+
+/// Check wether an oriented box intersects four boxes.
+int intersects4(const obb3f& box, const box3f* boxes) noexcept;
+
+/// Check wether a box intersects four boxes.
+int intersects4(const box3f& box, const box3f* boxes) noexcept;
+
+///@}
+
+} // namespace gintonic
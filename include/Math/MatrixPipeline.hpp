@@ -175,7 +175,7 @@ public:
 	{
 		if (mNormalMatrixIsDirty)
 		{
-			mNormalMatrix = getViewModelMatrix().upperLeft33().invert().transpose();
+			mNormalMatrix = getViewModelMatrix().normalMatrix();
 			mNormalMatrixIsDirty = false;
 		}
 		return mNormalMatrix;
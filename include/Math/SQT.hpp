@@ -112,6 +112,19 @@ struct alignas(__m128) SQT
 	 */
 	SQT& invert() noexcept;
 
+	/**
+	 * @brief Check whether the scale differs per axis.
+	 * @details Normals are transformed like directions, up to a factor, by a
+	 * matrix without a non-uniform scale. See mat4f::normalMatrix.
+	 * @return True if the X, Y and Z scales are not all equal.
+	 */
+	inline bool hasNonUniformScale() const noexcept
+	{
+		GT_PROFILE_FUNCTION;
+
+		return scale.x != scale.y || scale.x != scale.z;
+	}
+
 	/**
 	 * @brief Make this SQT look at another SQT.
 	 * @details The rotation quaternion of this SQT is set in such
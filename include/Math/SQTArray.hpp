@@ -0,0 +1,163 @@
+/**
+ * @file SQTArray.hpp
+ * @brief Defines the SQTArray class, which stores many SQTs as a structure
+ * of arrays.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "SQT.hpp"
+
+#include "../Foundation/allocator.hpp"
+
+#include <vector>
+
+namespace gintonic {
+
+/**
+ * @brief An array of SQTs, stored as a structure of arrays.
+ * @details Every component of the SQTs lives in its own array of floats,
+ * called a channel. So the X-components of all the scales are adjacent,
+ * then the Y-components of all the scales, and so on. This lets a single
+ * SSE or AVX instruction work on four or eight SQTs at once.
+ *
+ * Every channel is padded to a multiple of SQTArray::kWidth floats and is
+ * aligned to 32 bytes. The padding holds the identity SQT.
+ */
+class SQTArray
+{
+public:
+
+	/// The channels of an SQTArray.
+	enum Channel
+	{
+		kScaleX = 0,
+		kScaleY,
+		kScaleZ,
+		kRotationX,
+		kRotationY,
+		kRotationZ,
+		kRotationW,
+		kTranslationX,
+		kTranslationY,
+		kTranslationZ,
+		kChannelCount
+	};
+
+	/// Every channel is padded to a multiple of this many floats.
+	static constexpr std::size_t kWidth = 8;
+
+	/// Default constructor constructs an empty array.
+	SQTArray() = default;
+
+	/**
+	 * @brief Constructor.
+	 * @param count The number of SQTs. They start out as the identity.
+	 */
+	explicit SQTArray(const std::size_t count);
+
+	/**
+	 * @brief Change the number of SQTs.
+	 * @details Every SQT becomes the identity.
+	 * @param count The number of SQTs.
+	 */
+	void resize(const std::size_t count);
+
+	/// Get the number of SQTs.
+	inline std::size_t size() const noexcept { return mCount; }
+
+	/// Get the number of floats per channel, including the padding.
+	inline std::size_t stride() const noexcept { return mStride; }
+
+	/// Get a channel.
+	inline float* channel(const Channel c) noexcept
+	{
+		return mData.data() + c * mStride;
+	}
+
+	/// Get a channel.
+	inline const float* channel(const Channel c) const noexcept
+	{
+		return mData.data() + c * mStride;
+	}
+
+	/// Get an SQT.
+	SQT get(const std::size_t index) const noexcept;
+
+	/// Set an SQT.
+	void set(const std::size_t index, const SQT& sqt) noexcept;
+
+private:
+
+	std::vector<float, allocator<float, 32>> mData;
+	std::size_t mCount = 0;
+	std::size_t mStride = 0;
+};
+
+/**
+ * @brief Interpolate two arrays of SQTs.
+ * @details The scales and translations are interpolated linearly. The
+ * rotations are interpolated along the shortest arc and normalized
+ * (nlerp). For keyframes that are close together, as they are in a
+ * sampled animation, this is indistinguishable from a slerp and needs
+ * no trigonometry. Uses AVX when the CPU has it, and SSE otherwise; see
+ * SIMDLevel.
+ * @param u The array at a = 0.
+ * @param v The array at a = 1. Must have the same size as u.
+ * @param a The interpolation parameter.
+ * @param result Receives the interpolation. It is resized to the size
+ * of u. It may be u or v.
+ */
+void mix(const SQTArray& u, const SQTArray& v, const float a,
+	SQTArray& result);
+
+/**
+ * @brief Interpolate two arrays of SQTs, with a weight per SQT.
+ * @details Like the other mix, but SQT i is interpolated with the
+ * parameter a * mask[i].
+ * @param u The array at a = 0.
+ * @param v The array at a = 1. Must have the same size as u.
+ * @param a The interpolation parameter.
+ * @param mask SQTArray::stride of u floats, aligned to 32 bytes, or null
+ * for a mask of ones.
+ * @param result Receives the interpolation. It is resized to the size
+ * of u. It may be u or v.
+ */
+void mix(const SQTArray& u, const SQTArray& v, const float a,
+	const float* mask, SQTArray& result);
+
+/**
+ * @brief Get the difference of two arrays of SQTs, for use as an additive
+ * layer with applyAdditive.
+ * @details The scales are divided, the translations are subtracted and the
+ * rotation is the conjugate of the reference rotation times the pose
+ * rotation. So applying the difference to the reference gives the pose.
+ * @param reference The reference pose.
+ * @param pose The pose. Must have the same size as the reference.
+ * @param result Receives the difference. It is resized to the size of the
+ * pose. It may be the reference or the pose.
+ */
+void difference(const SQTArray& reference, const SQTArray& pose,
+	SQTArray& result);
+
+/**
+ * @brief Apply an additive layer to a pose.
+ * @details The difference is first scaled towards the identity by the
+ * weight a * mask[i]: the scale and translation linearly, the rotation by
+ * an nlerp. Then the scale is multiplied with the scale of the base, the
+ * translation is added to the translation of the base, and the base
+ * rotation is multiplied with the rotation on the right.
+ * @param base The pose to add to.
+ * @param difference The additive layer, as made by difference. Must have
+ * the same size as the base.
+ * @param a The weight of the layer.
+ * @param mask SQTArray::stride of the base floats, aligned to 32 bytes, or
+ * null for a mask of ones.
+ * @param result Receives the pose. It is resized to the size of the base.
+ * It may be the base or the difference.
+ */
+void applyAdditive(const SQTArray& base, const SQTArray& difference,
+	const float a, const float* mask, SQTArray& result);
+
+} // namespace gintonic
@@ -0,0 +1,43 @@
+/**
+ * @file Skinning.hpp
+ * @brief Defines linear blend skinning of positions on the CPU.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "mat4f.hpp"
+
+#include <cstdint>
+
+namespace gintonic {
+
+/**
+ * @brief Move positions by the joints of a skeleton, like the skinning in
+ * the vertex shaders does.
+ * @details Every position is moved by four joints: it is transformed by
+ * the weighted sum of their matrices. The matrices are summed with SSE, or
+ * two columns at a time with AVX when the CPU has it; see SIMDLevel.
+ * Influences with a zero weight or a joint index outside the palette, like
+ * the GT_JOINT_NONE that pads the unused influences of a vertex, are
+ * skipped.
+ * Only the positions in [first, last) are skinned, so that ranges can be
+ * skinned by several threads at once.
+ * @param palette The joint palette, as made by AnimationClip::evaluatePose.
+ * @param jointCount The number of matrices in the palette.
+ * @param positions Three floats per position.
+ * @param vertices For every position, the vertex whose joints move it, or
+ * null when position i is vertex i.
+ * @param jointIndices Four joint indices per vertex.
+ * @param jointWeights Four joint weights per vertex.
+ * @param first The first position to skin.
+ * @param last One past the last position to skin.
+ * @param result Receives three floats per position. Must not be the
+ * positions.
+ */
+void skinPositions(const mat4f* palette, const std::size_t jointCount,
+	const float* positions, const std::uint32_t* vertices,
+	const std::int32_t* jointIndices, const float* jointWeights,
+	const std::size_t first, const std::size_t last, float* result) noexcept;
+
+} // namespace gintonic
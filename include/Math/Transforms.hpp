@@ -0,0 +1,155 @@
+/**
+ * @file Transforms.hpp
+ * @brief Defines functions that transform whole arrays of matrices, points,
+ * directions, SQTs and boxes at once.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "mat4f.hpp"
+
+namespace gintonic {
+
+/**
+ * @name Array kernels
+ * @details These do the same as the operators on single values, but they
+ * keep the constant operands in registers for the whole array, and work on
+ * two values at a time with AVX when the CPU has it; see SIMDLevel. With
+ * FMA, multiplications and additions are fused, so the results may differ
+ * from the single value operators in the last bits.
+ *
+ * Unless noted otherwise, the result may be the same array as an input, but
+ * the arrays must not otherwise overlap.
+ */
+///@{
+
+/**
+ * @brief Multiply one matrix with an array of matrices.
+ * @param lhs The matrix on the left.
+ * @param rhs The matrices on the right.
+ * @param count The number of matrices.
+ * @param result Receives lhs * rhs[i] for every i.
+ */
+void multiply(const mat4f& lhs, const mat4f* rhs, const std::size_t count,
+	mat4f* result) noexcept;
+
+/**
+ * @brief Multiply two arrays of matrices element by element.
+ * @param lhs The matrices on the left.
+ * @param rhs The matrices on the right.
+ * @param count The number of matrices.
+ * @param result Receives lhs[i] * rhs[i] for every i.
+ */
+void multiply(const mat4f* lhs, const mat4f* rhs, const std::size_t count,
+	mat4f* result) noexcept;
+
+/**
+ * @brief Transform an array of vectors.
+ * @param matrix The matrix.
+ * @param vectors The vectors.
+ * @param count The number of vectors.
+ * @param result Receives matrix * vectors[i] for every i.
+ */
+void transform(const mat4f& matrix, const vec4f* vectors,
+	const std::size_t count, vec4f* result) noexcept;
+
+/**
+ * @brief Transform an array of points, like mat4f::apply_to_point.
+ * @param matrix The matrix.
+ * @param points The points. Their w-coordinates are ignored.
+ * @param count The number of points.
+ * @param result Receives the transformed points, with a w-coordinate of 0.
+ */
+void transformPoints(const mat4f& matrix, const vec3f* points,
+	const std::size_t count, vec3f* result) noexcept;
+
+/**
+ * @brief Transform an array of directions, like
+ * mat4f::apply_to_direction.
+ * @param matrix The matrix.
+ * @param directions The directions. Their w-coordinates are ignored.
+ * @param count The number of directions.
+ * @param result Receives the transformed directions, with a w-coordinate
+ * of 0.
+ */
+void transformDirections(const mat4f& matrix, const vec3f* directions,
+	const std::size_t count, vec3f* result) noexcept;
+
+/**
+ * @brief Transform an array of tightly packed points, like the positions
+ * of a Mesh.
+ * @details The floats need no alignment. Four points are deinterleaved and
+ * transformed at a time, eight with AVX.
+ * @param matrix The matrix.
+ * @param points Three floats per point.
+ * @param count The number of points.
+ * @param result Receives three floats per point.
+ */
+void transformPoints(const mat4f& matrix, const float* points,
+	const std::size_t count, float* result) noexcept;
+
+/**
+ * @brief Transform an array of tightly packed directions, like the normals
+ * of a Mesh.
+ * @details The floats need no alignment. Four directions are deinterleaved
+ * and transformed at a time, eight with AVX.
+ * @param matrix The matrix.
+ * @param directions Three floats per direction.
+ * @param count The number of directions.
+ * @param result Receives three floats per direction.
+ */
+void transformDirections(const mat4f& matrix, const float* directions,
+	const std::size_t count, float* result) noexcept;
+
+/**
+ * @brief Build the affine matrices of an array of SQTs, like the mat4f
+ * constructor that takes an SQT.
+ * @details Four SQTs are transposed and converted at a time.
+ * @param transforms The SQTs.
+ * @param count The number of SQTs.
+ * @param result Receives the matrices.
+ */
+void toMatrices(const SQT* transforms, const std::size_t count,
+	mat4f* result) noexcept;
+
+/**
+ * @brief Transform an array of bounding boxes by one affine matrix.
+ * @details Every result is the smallest axis-aligned box that contains the
+ * transformed box, so it is tight for rotations too.
+ * @param matrix The affine matrix.
+ * @param boxes The boxes.
+ * @param count The number of boxes.
+ * @param result Receives the transformed boxes.
+ */
+void transformBoxes(const mat4f& matrix, const box3f* boxes,
+	const std::size_t count, box3f* result) noexcept;
+
+/**
+ * @brief Transform every bounding box of an array by its own affine
+ * matrix.
+ * @param matrices The affine matrices, one per box.
+ * @param boxes The boxes.
+ * @param count The number of boxes.
+ * @param result Receives the smallest axis-aligned box that contains
+ * matrices[i] applied to boxes[i], for every i.
+ */
+void transformBoxes(const mat4f* matrices, const box3f* boxes,
+	const std::size_t count, box3f* result) noexcept;
+
+/**
+ * @brief Get the normal matrices of an array of affine matrices, for
+ * instance of a joint palette.
+ * @details This is mat4f::normalMatrix for matrices that may scale
+ * non-uniformly.
+ * @param matrices The affine matrices.
+ * @param count The number of matrices.
+ * @param result Receives the inverse transpose of the upper-left three by
+ * three part of every matrix.
+ */
+void normalMatrices(const mat4f* matrices, const std::size_t count,
+	mat3f* result) noexcept;
+
+///@}
+
+} // namespace gintonic
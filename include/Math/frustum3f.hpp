@@ -0,0 +1,120 @@
+/**
+ * @file frustum3f.hpp
+ * @brief Defines a view frustum, described by six planes.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "vec4f.hpp"
+#include <cstdint>
+
+namespace gintonic {
+
+struct box3f;   // Forward declaration.
+struct plane3f; // Forward declaration.
+union mat4f;    // Forward declaration.
+
+/**
+ * @brief A view frustum, described by six planes.
+ * @details Every plane is stored as a vec4f (a, b, c, d) with a unit normal
+ * (a, b, c) that points into the frustum. A point p is on the inside of a
+ * plane when a * p.x + b * p.y + c * p.z + d >= 0.
+ */
+struct frustum3f
+{
+	/// The indices of the planes.
+	enum Plane
+	{
+		kLeft = 0,
+		kRight,
+		kBottom,
+		kTop,
+		kNear,
+		kFar,
+		kPlaneCount
+	};
+
+	/// The planes.
+	vec4f planes[kPlaneCount];
+
+	/// Default constructor initializes a frustum that contains everything.
+	frustum3f() noexcept;
+
+	/**
+	 * @brief Extract the planes from a `WORLD->CLIP` matrix.
+	 * @param matrixPV The `WORLD->CLIP` matrix, usually P * V.
+	 */
+	explicit frustum3f(const mat4f& matrixPV) noexcept;
+
+	/**
+	 * @brief Extract the planes from a `WORLD->CLIP` matrix.
+	 * @details This is the method of Gribb and Hartmann. The planes end up
+	 * in the space that the matrix transforms from. If a plane is
+	 * degenerate, as the far plane of an infinite perspective projection is,
+	 * then it is replaced by a plane that contains everything.
+	 * @param matrixPV The `WORLD->CLIP` matrix, usually P * V.
+	 */
+	void set(const mat4f& matrixPV) noexcept;
+
+	/**
+	 * @brief Extract one plane from a `WORLD->CLIP` matrix.
+	 * @details This is the plane that frustum3f::set extracts, for when
+	 * only one plane is needed, for instance the near plane to pick with.
+	 * @param matrixPV The `WORLD->CLIP` matrix, usually P * V.
+	 * @param which The plane to extract.
+	 * @return The plane, facing into the frustum.
+	 */
+	static plane3f extractPlane(const mat4f& matrixPV, const Plane which)
+		noexcept;
+
+	/**
+	 * @brief Get one of the planes.
+	 * @param which The plane to get.
+	 * @return The plane, facing into the frustum.
+	 */
+	plane3f getPlane(const Plane which) const noexcept;
+
+	/**
+	 * @brief Check wether a bounding box intersects this frustum.
+	 * @details This test is conservative: a box that is near a corner of the
+	 * frustum may be reported as intersecting while it is in fact outside.
+	 * A box that is reported as outside is never visible.
+	 * @param box Some bounding box.
+	 * @return True if the box is (partially) inside, false if it is
+	 * outside.
+	 */
+	bool intersects(const box3f& box) const noexcept;
+
+	/**
+	 * @brief Check wether a bounding box is completely inside this frustum.
+	 * @param box Some bounding box.
+	 * @return True if the box is completely inside, false otherwise.
+	 */
+	bool contains(const box3f& box) const noexcept;
+
+	/**
+	 * @brief Test an array of bounding boxes against this frustum.
+	 * @details The same test as frustum3f::intersects, but four boxes are
+	 * tested at a time, eight when the CPU has AVX.
+	 * @param [in] boxes Pointer to the first bounding box.
+	 * @param [in] count The number of bounding boxes.
+	 * @param [out] visible For every box, 1 if it intersects this frustum,
+	 * 0 otherwise. Must point to at least count bytes.
+	 * @return The number of boxes that intersect this frustum.
+	 */
+	std::size_t intersects(const box3f* boxes, const std::size_t count,
+		std::uint8_t* visible) const noexcept;
+
+	GINTONIC_DEFINE_SSE_OPERATOR_NEW_DELETE();
+};
+
+/**
+ * @brief Output stream support for frustum3f.
+ *
+ * @param os An output stream.
+ * @param f Some frustum.
+ */
+std::ostream& operator << (std::ostream& os, const frustum3f& f);
+
+} // namespace gintonic
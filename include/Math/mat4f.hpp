@@ -190,6 +190,45 @@ public:
 	/// Assuming this matrix is an affine transformation, decompose it into its scale, rotation and translation components.
 	void decompose(SQT& sqt) const;
 
+	/**
+	 * @brief Assuming this matrix is a rotation followed by a translation,
+	 * get its inverse.
+	 * @details The inverse of the rotation is its transpose, and the
+	 * translation of the inverse is the negated translation, rotated back.
+	 * The result is wrong when this matrix scales.
+	 * @return The inverse.
+	 * @sa mat4f::inverseAffine
+	 */
+	mat4f inverseRigid() const noexcept;
+
+	/**
+	 * @brief Assuming this matrix is an affine transformation, get its
+	 * inverse.
+	 * @details Any scale and shear in the upper-left three by three part is
+	 * taken into account. The rows of the inverse of that part are the cross
+	 * products of its columns, divided by the determinant. This is cheaper
+	 * than a general four by four inverse.
+	 * @return The inverse. The result is undefined when this matrix is
+	 * singular.
+	 * @sa mat4f::inverseRigid
+	 */
+	mat4f inverseAffine() const noexcept;
+
+	/**
+	 * @brief Get the normal matrix, i.e. the inverse transpose of the
+	 * upper-left three by three part.
+	 * @details When that part is a rotation times a uniform scale s, the
+	 * normal matrix is that part divided by s squared. Otherwise the columns
+	 * of the normal matrix are the cross products of the columns of this
+	 * matrix, divided by the determinant. Neither needs a general three by
+	 * three inverse.
+	 * @param nonUniformScale Whether this matrix may scale non-uniformly or
+	 * shear. If false while it does, the result is wrong. See
+	 * Entity::hasNonUniformScale.
+	 * @return The normal matrix.
+	 */
+	mat3f normalMatrix(const bool nonUniformScale = true) const noexcept;
+
 	static mat4f zero;
 	static mat4f identity;
 
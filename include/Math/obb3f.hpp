@@ -0,0 +1,76 @@
+/**
+ * @file obb3f.hpp
+ * @brief Defines a three-dimensional oriented bounding box.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "vec3f.hpp"
+
+namespace gintonic {
+
+struct box3f; // Forward declaration.
+union mat4f;  // Forward declaration.
+
+/**
+ * @brief A three-dimensional oriented bounding box.
+ * @details Unlike the global box3f of an entity, which grows when the entity
+ * rotates, an obb3f is a box3f in local space that is carried along by the
+ * transform of the entity.
+ */
+struct obb3f
+{
+	/// The center.
+	vec3f center;
+
+	/// The orthonormal axes of the box.
+	vec3f axes[3];
+
+	/// The half extents of the box along each of its axes.
+	vec3f extent;
+
+	/// Default constructor initializes a point at the origin.
+	obb3f() noexcept;
+
+	/**
+	 * @brief Construct an oriented box from an axis-aligned box.
+	 * @param box Some bounding box.
+	 */
+	explicit obb3f(const box3f& box) noexcept;
+
+	/**
+	 * @brief Construct an oriented box from a transformed box.
+	 * @param box The box in local space.
+	 * @param matrix A rotation, uniform or non-uniform scaling, and
+	 * translation, without shear. For instance, the global transform of an
+	 * entity.
+	 */
+	obb3f(const box3f& box, const mat4f& matrix) noexcept;
+
+	/**
+	 * @brief Check wether this box contains a point.
+	 * @param point Some point.
+	 * @return True if the point is inside the box or on its edge, false
+	 * otherwise.
+	 */
+	bool contains(const vec3f& point) const noexcept;
+
+	/**
+	 * @brief Get the axis-aligned box that contains this box.
+	 * @return The tight axis-aligned bounding box.
+	 */
+	box3f bounds() const noexcept;
+
+	GINTONIC_DEFINE_SSE_OPERATOR_NEW_DELETE();
+};
+
+/**
+ * @brief Output stream support for obb3f.
+ *
+ * @param os An output stream.
+ * @param b Some oriented box.
+ */
+std::ostream& operator << (std::ostream& os, const obb3f& b);
+
+} // namespace gintonic
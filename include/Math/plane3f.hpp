@@ -0,0 +1,79 @@
+/**
+ * @file plane3f.hpp
+ * @brief Defines a plane in three-dimensional space.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "vec3f.hpp"
+#include "vec4f.hpp"
+
+namespace gintonic {
+
+/**
+ * @brief A plane in three-dimensional space.
+ * @details The plane is stored as a vec4f (a, b, c, d) with a unit normal
+ * (a, b, c), just like the planes of a frustum3f. The signed distance of a
+ * point p to the plane is a * p.x + b * p.y + c * p.z + d. Points with a
+ * positive distance are in front of the plane.
+ */
+struct plane3f
+{
+	/// The normal in (x, y, z) and the offset in w.
+	vec4f equation;
+
+	/// Default constructor initializes the XY-plane, facing the Z-axis.
+	plane3f() noexcept;
+
+	/**
+	 * @brief Constructor.
+	 * @param normal The normal. It does not need to have unit length.
+	 * @param point A point on the plane.
+	 */
+	plane3f(const vec3f& normal, const vec3f& point) noexcept;
+
+	/**
+	 * @brief Constructor.
+	 * @details The equation is normalized such that the normal has unit
+	 * length. If the normal is (almost) zero, then the plane is replaced by
+	 * a plane that has every point in front of it, just like the degenerate
+	 * planes of a frustum3f.
+	 * @param equation The equation (a, b, c, d) of the plane.
+	 */
+	explicit plane3f(const vec4f& equation) noexcept;
+
+	/// Get the unit normal.
+	inline vec3f normal() const noexcept
+	{
+		GT_PROFILE_FUNCTION;
+
+		return vec3f(equation.x, equation.y, equation.z);
+	}
+
+	/**
+	 * @brief Get the signed distance of a point to this plane.
+	 * @param point Some point.
+	 * @return Positive if the point is in front, negative if it is behind.
+	 */
+	float distance(const vec3f& point) const noexcept;
+
+	/**
+	 * @brief Get the point on this plane that is closest to the given point.
+	 * @param point Some point.
+	 * @return The projection of the point on this plane.
+	 */
+	vec3f project(const vec3f& point) const noexcept;
+
+	GINTONIC_DEFINE_SSE_OPERATOR_NEW_DELETE();
+};
+
+/**
+ * @brief Output stream support for plane3f.
+ *
+ * @param os An output stream.
+ * @param p Some plane.
+ */
+std::ostream& operator << (std::ostream& os, const plane3f& p);
+
+} // namespace gintonic
@@ -372,12 +372,24 @@ inline quatf mix(const quatf& u, const quatf& v, const float a)
  * @param[in] v The second quaternion.
  * @param[in] s Interpolation parameter. Must be a number in the closed interval
  * [0,1].
- * @return      The spherical linear interpolation.
+ * @return      The spherical linear interpolation, along the shortest arc.
  */
 inline quatf slerp(const quatf& u, const quatf& v, const float s)
 {
-    const float theta = std::acos((u * v).w);
-    return (u * std::sin((1.0f - s) * theta) + v * std::sin(s * theta)) /
+    // The four dimensional dot product, not the w of the quaternion product,
+    // is the cosine of the angle between u and v. q and -q are the same
+    // rotation, so take the one that is closest to u.
+    float lCos = u.x * v.x + u.y * v.y + u.z * v.z + u.w * v.w;
+    const float lSign = lCos < 0.0f ? -1.0f : 1.0f;
+    lCos *= lSign;
+
+    // For (nearly) equal rotations sin(theta) vanishes; interpolate
+    // linearly instead.
+    if (lCos > 0.9995f) return mix(u, v * lSign, s).normalize();
+
+    const float theta = std::acos(lCos);
+    return (u * std::sin((1.0f - s) * theta) +
+            v * (lSign * std::sin(s * theta))) /
            std::sin(theta);
 }
 
@@ -0,0 +1,73 @@
+/**
+ * @file ray3f.hpp
+ * @brief Defines a half-line, for instance to pick objects with the mouse.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "vec3f.hpp"
+
+namespace gintonic {
+
+union mat4f; // Forward declaration.
+
+/**
+ * @brief A half-line that starts at an origin and goes in one direction.
+ * @details The points on the ray are origin + t * direction for t >= 0.
+ * The intersection tests report t as the distance along the ray, so the
+ * direction must have unit length.
+ */
+struct ray3f
+{
+	/// The origin.
+	vec3f origin;
+
+	/// The direction, of unit length.
+	vec3f direction;
+
+	/// Default constructor initializes a ray along the negative Z-axis.
+	ray3f() noexcept;
+
+	/**
+	 * @brief Constructor.
+	 * @param origin The origin.
+	 * @param direction The direction. It does not need to have unit length.
+	 */
+	ray3f(const vec3f& origin, const vec3f& direction) noexcept;
+
+	/**
+	 * @brief Construct the ray through a point on the screen.
+	 * @param inverseMatrixPV The inverse of the `WORLD->CLIP` matrix.
+	 * @param ndcX The X-coordinate of the point in normalized device
+	 * coordinates, from -1 (left) to 1 (right).
+	 * @param ndcY The Y-coordinate of the point in normalized device
+	 * coordinates, from -1 (bottom) to 1 (top).
+	 */
+	ray3f(const mat4f& inverseMatrixPV, const float ndcX, const float ndcY)
+		noexcept;
+
+	/**
+	 * @brief Get a point on this ray.
+	 * @param t The distance along the ray.
+	 * @return origin + t * direction.
+	 */
+	inline vec3f at(const float t) const noexcept
+	{
+		GT_PROFILE_FUNCTION;
+
+		return origin + t * direction;
+	}
+
+	GINTONIC_DEFINE_SSE_OPERATOR_NEW_DELETE();
+};
+
+/**
+ * @brief Output stream support for ray3f.
+ *
+ * @param os An output stream.
+ * @param r Some ray.
+ */
+std::ostream& operator << (std::ostream& os, const ray3f& r);
+
+} // namespace gintonic
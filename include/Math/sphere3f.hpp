@@ -0,0 +1,52 @@
+/**
+ * @file sphere3f.hpp
+ * @brief Defines a bounding sphere.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "vec3f.hpp"
+
+namespace gintonic {
+
+/**
+ * @brief A bounding sphere, for instance the volume of a point light.
+ */
+struct sphere3f
+{
+	/// The center.
+	vec3f center;
+
+	/// The radius.
+	float radius;
+
+	/// Default constructor initializes a point at the origin.
+	sphere3f() noexcept;
+
+	/**
+	 * @brief Constructor.
+	 * @param center The center.
+	 * @param radius The radius.
+	 */
+	sphere3f(const vec3f& center, const float radius) noexcept;
+
+	/**
+	 * @brief Check wether this sphere contains a point.
+	 * @param point Some point.
+	 * @return True if the point is inside or on the sphere, false otherwise.
+	 */
+	bool contains(const vec3f& point) const noexcept;
+
+	GINTONIC_DEFINE_SSE_OPERATOR_NEW_DELETE();
+};
+
+/**
+ * @brief Output stream support for sphere3f.
+ *
+ * @param os An output stream.
+ * @param s Some sphere.
+ */
+std::ostream& operator << (std::ostream& os, const sphere3f& s);
+
+} // namespace gintonic
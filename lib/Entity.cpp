@@ -2,13 +2,18 @@
 
 // #include "Foundation/Octree.hpp"
 
+#include "Foundation/allocator.hpp"
+
 #include "Graphics/Mesh.hpp"
 #include "Graphics/ShadowBuffer.hpp"
 
 #include "Math/SQTstack.hpp"
+#include "Math/Transforms.hpp"
 #include "Math/mat4fstack.hpp"
 #include "Math/vec4f.hpp"
 
+#include <vector>
+
 namespace gintonic
 {
 
@@ -54,14 +59,20 @@ void Entity::lateUpdate()
 
 Entity::Entity(std::string name, const SQT& localTransform)
     : Super(std::move(name)), mLocalTransform(localTransform),
-      mGlobalTransform(mLocalTransform)
+      mGlobalTransform(mLocalTransform),
+      mViewMatrix(mGlobalTransform.inverseAffine()),
+      mNonUniformScale(mLocalTransform.hasNonUniformScale())
 {
-    /* Empty on purpose. */
+    updateGlobalBoundingBox();
 }
 
 Entity::Entity(const Entity& other)
     : Super(other), mLocalTransform(other.mLocalTransform),
-      mGlobalTransform(other.mGlobalTransform)
+      mGlobalTransform(other.mGlobalTransform),
+      mViewMatrix(other.mViewMatrix),
+      mNonUniformScale(other.mNonUniformScale),
+      mGlobalBoundingBox(other.mGlobalBoundingBox),
+      mLocalBoundingBox(other.mLocalBoundingBox)
       // , mOctree(other.mOctree)
       // , mOctreeListIter(other.mOctreeListIter)
       ,
@@ -77,6 +88,10 @@ Entity::Entity(Entity&& other) noexcept
     : Super(std::move(other)),
       mLocalTransform(std::move(other.mLocalTransform)),
       mGlobalTransform(std::move(other.mGlobalTransform)),
+      mViewMatrix(std::move(other.mViewMatrix)),
+      mNonUniformScale(other.mNonUniformScale),
+      mGlobalBoundingBox(other.mGlobalBoundingBox),
+      mLocalBoundingBox(other.mLocalBoundingBox),
       mChildren(std::move(other.mChildren)), mParent(std::move(other.mParent))
       // , mOctree(std::move(other.mOctree))
       // , mOctreeListIter(std::move(other.mOctreeListIter))
@@ -96,6 +111,10 @@ Entity& Entity::operator=(const Entity& other)
     Super::operator=(other);
     mLocalTransform = other.mLocalTransform;
     mGlobalTransform = other.mGlobalTransform;
+    mViewMatrix = other.mViewMatrix;
+    mNonUniformScale = other.mNonUniformScale;
+    mGlobalBoundingBox = other.mGlobalBoundingBox;
+    mLocalBoundingBox = other.mLocalBoundingBox;
     // mOctree = other.mOctree;
     // mOctreeListIter = other.mOctreeListIter;
     castShadow = other.castShadow;
@@ -116,6 +135,10 @@ Entity& Entity::operator=(Entity&& other) noexcept
     Super::operator=(std::move(other));
     mLocalTransform = std::move(other.mLocalTransform);
     mGlobalTransform = std::move(other.mGlobalTransform);
+    mViewMatrix = std::move(other.mViewMatrix);
+    mNonUniformScale = other.mNonUniformScale;
+    mGlobalBoundingBox = other.mGlobalBoundingBox;
+    mLocalBoundingBox = other.mLocalBoundingBox;
     mChildren = std::move(other.mChildren);
     mParent = std::move(other.mParent);
     // mOctree = std::move(other.mOctree);
@@ -136,27 +159,76 @@ Entity& Entity::operator=(Entity&& other) noexcept
 
 box3f Entity::globalBoundingBox() const noexcept
 {
-    box3f lGlobalBoundingBox(mGlobalTransform.data[3],
-                             mGlobalTransform.data[3]);
-    if (mesh)
+    const auto& lLocal = mesh ? mesh->getLocalBoundingBox() : box3f();
+    if (lLocal.minCorner == mLocalBoundingBox.minCorner &&
+        lLocal.maxCorner == mLocalBoundingBox.maxCorner)
+    {
+        return mGlobalBoundingBox;
+    }
+    box3f lResult;
+    transformBoxes(mGlobalTransform, &lLocal, 1, &lResult);
+    return lResult;
+}
+
+void Entity::globalBoundingBoxes(const SharedPtr* entities,
+                                 const std::size_t count, box3f* result)
+{
+    // The entities whose box is not cached.
+    thread_local std::vector<std::size_t> lIndices;
+    thread_local std::vector<mat4f, allocator<mat4f>> lMatrices;
+    thread_local std::vector<box3f, allocator<box3f>> lBoxes;
+    lIndices.clear();
+    lMatrices.clear();
+    lBoxes.clear();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto& lEntity = *entities[i];
+        const auto& lLocal =
+            lEntity.mesh ? lEntity.mesh->getLocalBoundingBox() : box3f();
+        if (lLocal.minCorner == lEntity.mLocalBoundingBox.minCorner &&
+            lLocal.maxCorner == lEntity.mLocalBoundingBox.maxCorner)
+        {
+            result[i] = lEntity.mGlobalBoundingBox;
+        }
+        else
+        {
+            lIndices.push_back(i);
+            lMatrices.push_back(lEntity.mGlobalTransform);
+            lBoxes.push_back(lLocal);
+        }
+    }
+    if (lIndices.empty()) return;
+
+    transformBoxes(lMatrices.data(), lBoxes.data(), lBoxes.size(),
+                   lBoxes.data());
+    for (std::size_t k = 0; k < lIndices.size(); ++k)
     {
-        const auto& lBBox = mesh->getLocalBoundingBox();
-        lGlobalBoundingBox.minCorner += lBBox.minCorner;
-        lGlobalBoundingBox.maxCorner += lBBox.maxCorner;
+        result[lIndices[k]] = lBoxes[k];
     }
-    return lGlobalBoundingBox;
+}
+
+void Entity::updateGlobalBoundingBox() noexcept
+{
+    mLocalBoundingBox = mesh ? mesh->getLocalBoundingBox() : box3f();
+    transformBoxes(mGlobalTransform, &mLocalBoundingBox, 1,
+                   &mGlobalBoundingBox);
 }
 
 void Entity::updateGlobalInfo() noexcept
 {
+    mNonUniformScale = mLocalTransform.hasNonUniformScale();
     if (auto lParent = mParent.lock())
     {
         mGlobalTransform = lParent->mGlobalTransform * mat4f(mLocalTransform);
+        mNonUniformScale = mNonUniformScale || lParent->mNonUniformScale;
     }
     else
     {
         mGlobalTransform = mat4f(mLocalTransform);
     }
+    mViewMatrix = mGlobalTransform.inverseAffine();
+    updateGlobalBoundingBox();
     for (auto lChild : mChildren)
     {
         lChild->updateGlobalInfo();
@@ -313,6 +385,31 @@ void Entity::moveDown(const float amount) noexcept
 //  }
 // }
 
+void Entity::setCastShadow(const bool yesOrNo)
+{
+    castShadow = yesOrNo;
+    onRenderStateChange(this);
+}
+
+void Entity::setMaterial(std::shared_ptr<Material> newMaterial)
+{
+    material = std::move(newMaterial);
+    onRenderStateChange(this);
+}
+
+void Entity::setMesh(std::shared_ptr<Mesh> newMesh)
+{
+    mesh = std::move(newMesh);
+    updateGlobalBoundingBox();
+    onRenderStateChange(this);
+}
+
+void Entity::setLight(std::shared_ptr<Light> newLight)
+{
+    light = std::move(newLight);
+    onRenderStateChange(this);
+}
+
 void Entity::addChild(std::shared_ptr<Entity> child)
 {
     if (child->mParent.lock())
@@ -398,86 +495,12 @@ void Entity::unsetParent()
 
 void Entity::getViewMatrix(mat4f& result) const noexcept
 {
-    const auto lRight = globalTransform() * vec4f(1.0f, 0.0f, 0.0f, 0.0f);
-    const auto lUp = globalTransform() * vec4f(0.0f, 1.0f, 0.0f, 0.0f);
-    const auto lForward = globalTransform() * vec4f(0.0f, 0.0f, -1.0f, 0.0f);
-    const auto lEye = globalTransform() * vec4f(0.0f, 0.0f, 0.0f, 1.0f);
-
-    result.m00 = lRight.x;
-    result.m10 = lUp.x;
-    result.m20 = -lForward.x;
-    result.m30 = 0.0f;
-
-    result.m01 = lRight.y;
-    result.m11 = lUp.y;
-    result.m21 = -lForward.y;
-    result.m31 = 0.0f;
-
-    result.m02 = lRight.z;
-    result.m12 = lUp.z;
-    result.m22 = -lForward.z;
-    result.m32 = 0.0f;
-
-    result.m03 = -dot(lRight, lEye);
-    result.m13 = -dot(lUp, lEye);
-    result.m23 = dot(lForward, lEye);
-    result.m33 = 1.0f;
+    result = mViewMatrix;
 }
 
 void Entity::updateViewMatrix(mat4f& alreadyAffineMatrix) const noexcept
 {
-    const auto lRight = globalTransform() * vec4f(1.0f, 0.0f, 0.0f, 0.0f);
-    const auto lUp = globalTransform() * vec4f(0.0f, 1.0f, 0.0f, 0.0f);
-    const auto lForward = globalTransform() * vec4f(0.0f, 0.0f, -1.0f, 0.0f);
-    const auto lEye = globalTransform() * vec4f(0.0f, 0.0f, 0.0f, 1.0f);
-
-    alreadyAffineMatrix.m00 = lRight.x;
-    alreadyAffineMatrix.m10 = lUp.x;
-    alreadyAffineMatrix.m20 = -lForward.x;
-
-    alreadyAffineMatrix.m01 = lRight.y;
-    alreadyAffineMatrix.m11 = lUp.y;
-    alreadyAffineMatrix.m21 = -lForward.y;
-
-    alreadyAffineMatrix.m02 = lRight.z;
-    alreadyAffineMatrix.m12 = lUp.z;
-    alreadyAffineMatrix.m22 = -lForward.z;
-
-    alreadyAffineMatrix.m03 = -dot(lRight, lEye);
-    alreadyAffineMatrix.m13 = -dot(lUp, lEye);
-    alreadyAffineMatrix.m23 = dot(lForward, lEye);
-}
-
-mat4f Entity::getViewMatrix() const noexcept
-{
-    const auto lRight = globalTransform() * vec4f(1.0f, 0.0f, 0.0f, 0.0f);
-    const auto lUp = globalTransform() * vec4f(0.0f, 1.0f, 0.0f, 0.0f);
-    const auto lForward = globalTransform() * vec4f(0.0f, 0.0f, -1.0f, 0.0f);
-    const auto lEye = globalTransform() * vec4f(0.0f, 0.0f, 0.0f, 1.0f);
-
-    mat4f lResult;
-
-    lResult.m00 = lRight.x;
-    lResult.m10 = lUp.x;
-    lResult.m20 = -lForward.x;
-    lResult.m30 = 0.0f;
-
-    lResult.m01 = lRight.y;
-    lResult.m11 = lUp.y;
-    lResult.m21 = -lForward.y;
-    lResult.m31 = 0.0f;
-
-    lResult.m02 = lRight.z;
-    lResult.m12 = lUp.z;
-    lResult.m22 = -lForward.z;
-    lResult.m32 = 0.0f;
-
-    lResult.m03 = -dot(lRight, lEye);
-    lResult.m13 = -dot(lUp, lEye);
-    lResult.m23 = dot(lForward, lEye);
-    lResult.m33 = 1.0f;
-
-    return lResult;
+    alreadyAffineMatrix = mViewMatrix;
 }
 
 Entity::~Entity() noexcept
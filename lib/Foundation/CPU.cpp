@@ -0,0 +1,116 @@
+#include "Foundation/CPU.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace gintonic {
+
+namespace {
+
+SIMDLevel detect() noexcept
+{
+	#if defined(_MSC_VER)
+
+	int lInfo[4];
+	__cpuid(lInfo, 0);
+	const auto lMaxLeaf = lInfo[0];
+	__cpuid(lInfo, 1);
+	const bool lOSXSAVE = (lInfo[2] & (1 << 27)) != 0;
+	const bool lAVX = (lInfo[2] & (1 << 28)) != 0;
+	const bool lFMA = (lInfo[2] & (1 << 12)) != 0;
+
+	// The operating system must save the upper halves of the registers.
+	if (!lOSXSAVE || !lAVX || (_xgetbv(0) & 6) != 6) return SIMDLevel::kSSE3;
+
+	bool lAVX2 = false;
+	if (lMaxLeaf >= 7)
+	{
+		__cpuidex(lInfo, 7, 0);
+		lAVX2 = (lInfo[1] & (1 << 5)) != 0;
+	}
+	return lAVX2 && lFMA ? SIMDLevel::kAVX2 : SIMDLevel::kAVX;
+
+	#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+	// These check the operating system support too.
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+	{
+		return SIMDLevel::kAVX2;
+	}
+	if (__builtin_cpu_supports("avx")) return SIMDLevel::kAVX;
+	return SIMDLevel::kSSE3;
+
+	#else
+
+	return SIMDLevel::kSSE3;
+
+	#endif
+}
+
+SIMDLevel lower(const SIMDLevel a, const SIMDLevel b) noexcept
+{
+	return static_cast<int>(a) < static_cast<int>(b) ? a : b;
+}
+
+SIMDLevel initialLevel() noexcept
+{
+	const auto lSupported = supportedSIMDLevel();
+	const char* lRequested = std::getenv("GINTONIC_SIMD");
+	if (!lRequested) return lSupported;
+	if (std::strcmp(lRequested, "sse3") == 0) return SIMDLevel::kSSE3;
+	if (std::strcmp(lRequested, "avx") == 0)
+	{
+		return lower(SIMDLevel::kAVX, lSupported);
+	}
+	return lSupported;
+}
+
+// -1 until the first call to activeSIMDLevel.
+std::atomic<int> sActiveLevel(-1);
+
+} // anonymous namespace
+
+SIMDLevel supportedSIMDLevel() noexcept
+{
+	static const SIMDLevel sSupported = detect();
+	return sSupported;
+}
+
+SIMDLevel activeSIMDLevel() noexcept
+{
+	auto lLevel = sActiveLevel.load(std::memory_order_relaxed);
+	if (lLevel < 0)
+	{
+		// Every thread computes the same value, so a race is harmless.
+		lLevel = static_cast<int>(initialLevel());
+		sActiveLevel.store(lLevel, std::memory_order_relaxed);
+	}
+	return static_cast<SIMDLevel>(lLevel);
+}
+
+SIMDLevel forceSIMDLevel(const SIMDLevel level) noexcept
+{
+	const auto lLevel = lower(level, supportedSIMDLevel());
+	sActiveLevel.store(static_cast<int>(lLevel), std::memory_order_relaxed);
+	return lLevel;
+}
+
+std::ostream& operator << (std::ostream& os, const SIMDLevel level)
+{
+	switch (level)
+	{
+		case SIMDLevel::kSSE3: return os << "SSE3";
+		case SIMDLevel::kAVX:  return os << "AVX";
+		case SIMDLevel::kAVX2: return os << "AVX2+FMA";
+	}
+	return os << "unknown";
+}
+
+} // namespace gintonic
@@ -0,0 +1,275 @@
+#include "Foundation/MemoryProfiler.hpp"
+#include "Foundation/simd.hpp"
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <new>
+
+namespace { // anonymous namespace
+
+using Subsystem = gintonic::MemoryProfiler::Subsystem;
+
+/*
+ * Every allocation is prefixed with this header. It sits directly in front
+ * of the pointer that is handed out. The offset is the distance from the
+ * start of the underlying _mm_malloc block to the handed out pointer.
+ */
+struct Header
+{
+	std::size_t bytes;
+	std::uint32_t offset;
+	Subsystem subsystem;
+};
+
+static_assert(sizeof(Header) <= 16, "Allocation header does not fit in 16 bytes.");
+
+struct Counters
+{
+	std::atomic<std::size_t> allocations;
+	std::atomic<std::size_t> deallocations;
+	std::atomic<std::size_t> totalBytes;
+	std::atomic<std::size_t> liveBytes;
+	std::atomic<std::size_t> peakBytes;
+	std::atomic<std::size_t> frameAllocations;
+	std::atomic<std::size_t> frameBytes;
+	std::atomic<std::size_t> allocationsLastFrame;
+	std::atomic<std::size_t> bytesLastFrame;
+	std::atomic<std::size_t> maxAllocationsPerFrame;
+};
+
+constexpr std::size_t kSubsystemCount = static_cast<std::size_t>(Subsystem::Count);
+
+// These have static storage duration and are therefore zero-initialized
+// before any dynamic initialization takes place. This is important, because
+// the global operator new may be called before main.
+Counters sCounters[kSubsystemCount];
+std::atomic<std::size_t> sFrames;
+
+thread_local Subsystem sCurrentSubsystem = Subsystem::General;
+
+const char* sSubsystemNames[kSubsystemCount] =
+{
+	"General",
+	"Renderer",
+	"Octree",
+	"Mesh",
+	"Asset",
+	"Animation"
+};
+
+inline Counters& countersOf(const Subsystem subsystem) noexcept
+{
+	return sCounters[static_cast<std::size_t>(subsystem)];
+}
+
+void updateMaximum(std::atomic<std::size_t>& maximum, const std::size_t value) noexcept
+{
+	auto lPrevious = maximum.load(std::memory_order_relaxed);
+	while (lPrevious < value && !maximum.compare_exchange_weak(lPrevious, value, std::memory_order_relaxed))
+	{
+		// try again
+	}
+}
+
+} // anonymous namespace
+
+namespace gintonic {
+
+double MemoryProfiler::Statistics::averageAllocationsPerFrame() const noexcept
+{
+	if (frames == 0) return 0.0;
+	return static_cast<double>(allocations) / static_cast<double>(frames);
+}
+
+MemoryProfiler::Scope::Scope(const Subsystem subsystem) noexcept
+: mPrevious(sCurrentSubsystem)
+{
+	sCurrentSubsystem = subsystem;
+}
+
+MemoryProfiler::Scope::~Scope() noexcept
+{
+	sCurrentSubsystem = mPrevious;
+}
+
+MemoryProfiler::Subsystem MemoryProfiler::current() noexcept
+{
+	return sCurrentSubsystem;
+}
+
+void* MemoryProfiler::allocate(const std::size_t bytes, const std::size_t alignment) noexcept
+{
+	const std::size_t lOffset = alignment < 16 ? 16 : alignment;
+	auto lBlock = static_cast<char*>(_mm_malloc(bytes + lOffset, lOffset));
+	if (!lBlock) return nullptr;
+
+	auto lResult = lBlock + lOffset;
+	auto lHeader = reinterpret_cast<Header*>(lResult - 16);
+	lHeader->bytes = bytes;
+	lHeader->offset = static_cast<std::uint32_t>(lOffset);
+	lHeader->subsystem = sCurrentSubsystem;
+
+	auto& lCounters = countersOf(lHeader->subsystem);
+	lCounters.allocations.fetch_add(1, std::memory_order_relaxed);
+	lCounters.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+	lCounters.totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+	lCounters.frameBytes.fetch_add(bytes, std::memory_order_relaxed);
+	const auto lLive = lCounters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	updateMaximum(lCounters.peakBytes, lLive);
+
+	return lResult;
+}
+
+void MemoryProfiler::deallocate(void* ptr) noexcept
+{
+	if (!ptr) return;
+	auto lResult = static_cast<char*>(ptr);
+	auto lHeader = reinterpret_cast<const Header*>(lResult - 16);
+	auto& lCounters = countersOf(lHeader->subsystem);
+	lCounters.deallocations.fetch_add(1, std::memory_order_relaxed);
+	lCounters.liveBytes.fetch_sub(lHeader->bytes, std::memory_order_relaxed);
+	_mm_free(lResult - lHeader->offset);
+}
+
+void MemoryProfiler::nextFrame() noexcept
+{
+	for (auto& lCounters : sCounters)
+	{
+		const auto lAllocations = lCounters.frameAllocations.exchange(0, std::memory_order_relaxed);
+		const auto lBytes = lCounters.frameBytes.exchange(0, std::memory_order_relaxed);
+		lCounters.allocationsLastFrame.store(lAllocations, std::memory_order_relaxed);
+		lCounters.bytesLastFrame.store(lBytes, std::memory_order_relaxed);
+		updateMaximum(lCounters.maxAllocationsPerFrame, lAllocations);
+	}
+	sFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+MemoryProfiler::Statistics MemoryProfiler::get(const Subsystem subsystem) noexcept
+{
+	const auto& lCounters = countersOf(subsystem);
+	Statistics lStats;
+	lStats.allocations = lCounters.allocations.load(std::memory_order_relaxed);
+	lStats.deallocations = lCounters.deallocations.load(std::memory_order_relaxed);
+	lStats.totalBytes = lCounters.totalBytes.load(std::memory_order_relaxed);
+	lStats.liveBytes = lCounters.liveBytes.load(std::memory_order_relaxed);
+	lStats.peakBytes = lCounters.peakBytes.load(std::memory_order_relaxed);
+	lStats.allocationsLastFrame = lCounters.allocationsLastFrame.load(std::memory_order_relaxed);
+	lStats.bytesLastFrame = lCounters.bytesLastFrame.load(std::memory_order_relaxed);
+	lStats.maxAllocationsPerFrame = lCounters.maxAllocationsPerFrame.load(std::memory_order_relaxed);
+	lStats.frames = sFrames.load(std::memory_order_relaxed);
+	return lStats;
+}
+
+const char* MemoryProfiler::name(const Subsystem subsystem) noexcept
+{
+	const auto lIndex = static_cast<std::size_t>(subsystem);
+	return lIndex < kSubsystemCount ? sSubsystemNames[lIndex] : "Unknown";
+}
+
+void MemoryProfiler::reset() noexcept
+{
+	for (auto& lCounters : sCounters)
+	{
+		lCounters.allocations.store(0, std::memory_order_relaxed);
+		lCounters.deallocations.store(0, std::memory_order_relaxed);
+		lCounters.totalBytes.store(0, std::memory_order_relaxed);
+		lCounters.peakBytes.store(lCounters.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		lCounters.frameAllocations.store(0, std::memory_order_relaxed);
+		lCounters.frameBytes.store(0, std::memory_order_relaxed);
+		lCounters.allocationsLastFrame.store(0, std::memory_order_relaxed);
+		lCounters.bytesLastFrame.store(0, std::memory_order_relaxed);
+		lCounters.maxAllocationsPerFrame.store(0, std::memory_order_relaxed);
+	}
+	sFrames.store(0, std::memory_order_relaxed);
+}
+
+void MemoryProfiler::writeLogToFile(const char* logFile)
+{
+	std::cerr << "Writing memory profiling information to " << logFile << " ...\n";
+	std::cerr << "Please wait ... ";
+
+	std::ofstream lOutput(logFile);
+
+	// Write the headers.
+	lOutput << "Subsystem,Allocations,Deallocations,Total Bytes,Live Bytes,"
+		"Peak Bytes,Frames,Average Allocations per Frame,"
+		"Maximum Allocations per Frame\n";
+
+	// Write the data.
+	for (std::size_t i = 0; i < kSubsystemCount; ++i)
+	{
+		const auto lSubsystem = static_cast<Subsystem>(i);
+		const auto lStats = get(lSubsystem);
+		lOutput << name(lSubsystem) << ',' << lStats.allocations << ','
+			<< lStats.deallocations << ',' << lStats.totalBytes << ','
+			<< lStats.liveBytes << ',' << lStats.peakBytes << ','
+			<< lStats.frames << ',' << lStats.averageAllocationsPerFrame()
+			<< ',' << lStats.maxAllocationsPerFrame << '\n';
+	}
+
+	std::cerr << "Done!\n";
+}
+
+} // namespace gintonic
+
+#ifdef gintonic_WITH_MEMORY_PROFILING
+
+// Replacements of the global allocation functions. The (unsized) alignment
+// of the default operator new is that of the largest fundamental type, and
+// 16 bytes covers that on every platform we support.
+
+void* operator new(std::size_t count)
+{
+	auto lResult = gintonic::MemoryProfiler::allocate(count, 16);
+	if (!lResult) throw std::bad_alloc();
+	return lResult;
+}
+
+void* operator new[](std::size_t count)
+{
+	auto lResult = gintonic::MemoryProfiler::allocate(count, 16);
+	if (!lResult) throw std::bad_alloc();
+	return lResult;
+}
+
+void* operator new(std::size_t count, const std::nothrow_t&) noexcept
+{
+	return gintonic::MemoryProfiler::allocate(count, 16);
+}
+
+void* operator new[](std::size_t count, const std::nothrow_t&) noexcept
+{
+	return gintonic::MemoryProfiler::allocate(count, 16);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	gintonic::MemoryProfiler::deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	gintonic::MemoryProfiler::deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	gintonic::MemoryProfiler::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	gintonic::MemoryProfiler::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	gintonic::MemoryProfiler::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	gintonic::MemoryProfiler::deallocate(ptr);
+}
+
+#endif // gintonic_WITH_MEMORY_PROFILING
@@ -48,7 +48,7 @@ Octree::Octree(const Octree& other)
 {
 	if (other.mAllocationPlace)
 	{
-		mAllocationPlace = _mm_malloc(sizeof(Octree) * 8, 16);
+		mAllocationPlace = GINTONIC_ALIGNED_MALLOC(sizeof(Octree) * 8, 16);
 		assert(mAllocationPlace != nullptr);
 		for (std::size_t c = 0; c < 8; ++c)
 		{
@@ -111,7 +111,7 @@ Octree& Octree::operator = (const Octree& other)
 
 	if (other.mAllocationPlace != nullptr)
 	{
-		mAllocationPlace = _mm_malloc(sizeof(Octree) * 8, 16);
+		mAllocationPlace = GINTONIC_ALIGNED_MALLOC(sizeof(Octree) * 8, 16);
 		assert(mAllocationPlace != nullptr);
 		for (std::size_t c = 0; c < 8; ++c)
 		{
@@ -179,7 +179,7 @@ Octree::~Octree()
 			lChild->~Octree();
 			lChild = nullptr;
 		}
-		_mm_free(mAllocationPlace);
+		GINTONIC_ALIGNED_FREE(mAllocationPlace);
 		mAllocationPlace = nullptr;
 	}
 }
@@ -205,7 +205,10 @@ std::size_t Octree::count() const
 
 void Octree::insert(std::shared_ptr<Entity> entity)
 {
-	if (mBounds.contains(entity->globalBoundingBox()) == false)
+	GT_PROFILE_MEMORY(Octree);
+
+	const auto lBounds = entity->globalBoundingBox();
+	if (mBounds.contains(lBounds) == false)
 	{
 		throw EntityNotContainedInOctreeBoundingBox(this, std::move(entity));
 	}
@@ -223,7 +226,7 @@ void Octree::insert(std::shared_ptr<Entity> entity)
 	{
 		for (auto* lChildNode : mChild)
 		{
-			if (lChildNode->mBounds.contains(entity->globalBoundingBox()))
+			if (lChildNode->mBounds.contains(lBounds))
 			{
 				lChildNode->insert(std::move(entity));
 				return;
@@ -417,7 +420,7 @@ Octree* Octree::backRecursiveDelete()
 			lChildNode = nullptr;
 		}
 		// DEBUG_PRINT;
-		_mm_free(mAllocationPlace);
+		GINTONIC_ALIGNED_FREE(mAllocationPlace);
 		// DEBUG_PRINT;
 		mAllocationPlace = nullptr;
 	}
@@ -448,6 +451,7 @@ Octree::Octree(const float subdivisionThreshold, Octree* parent, const vec3f& mi
 
 void Octree::subdivide()
 {
+	GT_PROFILE_MEMORY(Octree);
 	// DEBUG_PRINT;
 	auto lMin = mBounds.minCorner;
 	// DEBUG_PRINT;
@@ -464,7 +468,7 @@ void Octree::subdivide()
 
 	assert(mAllocationPlace == nullptr);
 
-	mAllocationPlace = _mm_malloc(sizeof(Octree) * 8, 16);
+	mAllocationPlace = GINTONIC_ALIGNED_MALLOC(sizeof(Octree) * 8, 16);
 
 	mChild[0] = new ((Octree*)mAllocationPlace + 0) Octree(subdivisionThreshold, this, lMin, lMin + lHalf);
 	lMin.x += lHalf.x;
@@ -0,0 +1,93 @@
+#include "Foundation/WorkerPool.hpp"
+#include <algorithm>
+
+namespace gintonic {
+
+WorkerPool::WorkerPool(const std::size_t workerCount)
+: mNextChunk(0)
+{
+	mWorkers.reserve(workerCount);
+	for (std::size_t i = 0; i < workerCount; ++i)
+	{
+		mWorkers.emplace_back([this]() { workerLoop(); });
+	}
+}
+
+WorkerPool::~WorkerPool() noexcept
+{
+	{
+		std::lock_guard<std::mutex> lLock(mMutex);
+		mQuit = true;
+	}
+	mWake.notify_all();
+	for (auto& lWorker : mWorkers) lWorker.join();
+}
+
+std::size_t WorkerPool::defaultWorkerCount() noexcept
+{
+	const auto lHardwareThreads = std::thread::hardware_concurrency();
+	return lHardwareThreads > 1 ? lHardwareThreads - 1 : 0;
+}
+
+void WorkerPool::run(const std::size_t count, const std::size_t chunkSize,
+	const Task& task)
+{
+	mTask = &task;
+	mCount = count;
+	mChunkSize = chunkSize ? chunkSize : 1;
+	mChunkCount = (count + mChunkSize - 1) / mChunkSize;
+	mNextChunk.store(0);
+
+	if (mWorkers.empty() || mChunkCount < 2)
+	{
+		runChunks();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lLock(mMutex);
+		++mGeneration;
+		mBusyWorkers = mWorkers.size();
+	}
+	mWake.notify_all();
+
+	// The calling thread takes chunks too.
+	runChunks();
+
+	std::unique_lock<std::mutex> lLock(mMutex);
+	mDone.wait(lLock, [this]() { return mBusyWorkers == 0; });
+}
+
+void WorkerPool::workerLoop()
+{
+	std::size_t lGeneration = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lLock(mMutex);
+			mWake.wait(lLock, [this, lGeneration]() {
+				return mQuit || mGeneration != lGeneration;
+			});
+			if (mQuit) return;
+			lGeneration = mGeneration;
+		}
+		runChunks();
+		{
+			std::lock_guard<std::mutex> lLock(mMutex);
+			--mBusyWorkers;
+		}
+		mDone.notify_one();
+	}
+}
+
+void WorkerPool::runChunks()
+{
+	for (auto lChunk = mNextChunk++; lChunk < mChunkCount;
+		lChunk = mNextChunk++)
+	{
+		const auto lFirst = lChunk * mChunkSize;
+		(*mTask)(lFirst, std::min(lFirst + mChunkSize, mCount));
+	}
+}
+
+} // namespace gintonic
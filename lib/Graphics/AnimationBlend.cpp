@@ -0,0 +1,64 @@
+#include "Graphics/AnimationBlend.hpp"
+#include "Graphics/AnimationClip.hpp"
+#include "Graphics/PosePool.hpp"
+#include "Graphics/Skeleton.hpp"
+#include <algorithm>
+
+namespace gintonic
+{
+
+AnimationBlend::JointMask AnimationBlend::makeMask(const std::size_t jointCount,
+                                                   const float value)
+{
+    const auto lStride =
+        (jointCount + SQTArray::kWidth - 1) / SQTArray::kWidth *
+        SQTArray::kWidth;
+    JointMask lResult(lStride, 0.0f);
+    std::fill_n(lResult.begin(), jointCount, value);
+    return lResult;
+}
+
+std::uint8_t AnimationBlend::jointCount() const noexcept
+{
+    return layers.empty() ? 0 : layers.front().clip->jointCount();
+}
+
+void AnimationBlend::samplePose(const float currentTime, PosePool& pool,
+                                SQTArray& outPose) const
+{
+    GT_PROFILE_FUNCTION;
+
+    if (layers.empty()) return;
+    const auto& lBase = layers.front();
+    lBase.clip->samplePose(lBase.startTime, currentTime, outPose);
+
+    const auto lPose = pool.acquire(outPose.size());
+    for (auto lIter = layers.begin() + 1; lIter != layers.end(); ++lIter)
+    {
+        if (lIter->weight <= 0.0f) continue;
+        const auto lMask = lIter->mask ? lIter->mask->data() : nullptr;
+        lIter->clip->samplePose(lIter->startTime, currentTime, *lPose);
+        if (lIter->additive)
+        {
+            const auto lReference = pool.acquire(outPose.size());
+            lIter->clip->samplePose(0.0f, 0.0f, *lReference);
+            difference(*lReference, *lPose, *lPose);
+            applyAdditive(outPose, *lPose, lIter->weight, lMask, outPose);
+        }
+        else
+        {
+            mix(outPose, *lPose, lIter->weight, lMask, outPose);
+        }
+    }
+}
+
+void AnimationBlend::evaluatePose(const float currentTime, PosePool& pool,
+                                  mat4f* outPalette) const
+{
+    if (layers.empty()) return;
+    const auto lPose = pool.acquire(jointCount());
+    samplePose(currentTime, pool, *lPose);
+    layers.front().clip->skeleton->compose(*lPose, outPalette);
+}
+
+} // namespace gintonic
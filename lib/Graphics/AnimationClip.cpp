@@ -5,14 +5,15 @@
 namespace gintonic
 {
 
-mat4f AnimationClip::evaluate(const uint8_t jointIndex, const float startTime,
-                              const float currentTime) const noexcept
+void AnimationClip::sampleTime(const std::size_t frameCount,
+                               const float startTime, const float currentTime,
+                               std::size_t& lowerFrame,
+                               std::size_t& upperFrame,
+                               float& lambda) const noexcept
 {
     float lExactFrame;
-    std::size_t lLowerFrame;
-    std::size_t lUpperFrame;
 
-#define FRAMECOUNTi frames[jointIndex].size()
+#define FRAMECOUNTi frameCount
 #define FRAMECOUNTf static_cast<float>(FRAMECOUNTi)
 #define FRAMES_PER_SECOND 24.0f
 
@@ -20,25 +21,63 @@ mat4f AnimationClip::evaluate(const uint8_t jointIndex, const float startTime,
     {
         lExactFrame = std::fmod(FRAMES_PER_SECOND * (currentTime - startTime),
                                 FRAMECOUNTf);
-        lLowerFrame = static_cast<std::size_t>(lExactFrame);
-        lUpperFrame = (lLowerFrame + 1) % FRAMECOUNTi;
+        lowerFrame = static_cast<std::size_t>(lExactFrame);
+        upperFrame = (lowerFrame + 1) % FRAMECOUNTi;
     }
     else
     {
         lExactFrame = std::min(FRAMES_PER_SECOND * (currentTime - startTime),
                                FRAMECOUNTf - 1.0f);
-        lLowerFrame = static_cast<std::size_t>(lExactFrame);
-        lUpperFrame = std::min(lLowerFrame + 1,
-                               static_cast<std::size_t>(FRAMECOUNTi - 1));
+        lowerFrame = static_cast<std::size_t>(lExactFrame);
+        upperFrame = std::min(lowerFrame + 1,
+                              static_cast<std::size_t>(FRAMECOUNTi - 1));
     }
 
+#undef FRAMECOUNTi
+#undef FRAMECOUNTf
+#undef FRAMES_PER_SECOND
+
+    lambda = lExactFrame - static_cast<float>(lowerFrame);
+}
+
+float AnimationClip::duration() const noexcept
+{
+    std::size_t lFrameCount = 0;
+    if (isCompressed())
+    {
+        lFrameCount = mCompressed.frameCount();
+    }
+    else
+    {
+        for (const auto& lFrames : frames)
+        {
+            lFrameCount = std::max(lFrameCount, lFrames.size());
+        }
+    }
+    // The same rate as in AnimationClip::sampleTime.
+    return static_cast<float>(lFrameCount) / 24.0f;
+}
+
+mat4f AnimationClip::evaluate(const uint8_t jointIndex, const float startTime,
+                              const float currentTime) const noexcept
+{
+    std::size_t lLowerFrame;
+    std::size_t lUpperFrame;
+    float lLambda;
+    sampleTime(isCompressed() ? mCompressed.frameCount()
+                              : frames[jointIndex].size(),
+               startTime, currentTime, lLowerFrame, lUpperFrame, lLambda);
+
     mat4f lResult(skeleton->joints[jointIndex].inverseBindPose);
-    const float lLambda = lExactFrame - static_cast<float>(lLowerFrame);
     uint8_t j = jointIndex;
     while (j != GT_JOINT_NONE)
     {
         const auto lCurrent =
-            mat4f(mix(frames[j][lLowerFrame], frames[j][lUpperFrame], lLambda));
+            isCompressed()
+                ? mat4f(mCompressed.sample(j, lLowerFrame, lUpperFrame,
+                                           lLambda))
+                : mat4f(mix(frames[j][lLowerFrame], frames[j][lUpperFrame],
+                            lLambda));
         // const auto lCurrent = mat4f(frames[j][lLowerFrame]);
         lResult = lCurrent * lResult;
         j = skeleton->joints[j].parent;
@@ -48,4 +87,81 @@ mat4f AnimationClip::evaluate(const uint8_t jointIndex, const float startTime,
     return lResult;
 }
 
+void AnimationClip::samplePose(const float startTime, const float currentTime,
+                               SQTArray& outPose) const
+{
+    std::size_t lLowerFrame;
+    std::size_t lUpperFrame;
+    float lLambda;
+    if (isCompressed())
+    {
+        sampleTime(mCompressed.frameCount(), startTime, currentTime,
+                   lLowerFrame, lUpperFrame, lLambda);
+        mCompressed.sample(lLowerFrame, lUpperFrame, lLambda, outPose);
+    }
+    else if (isPacked())
+    {
+        sampleTime(mPackedFrames.size(), startTime, currentTime, lLowerFrame,
+                   lUpperFrame, lLambda);
+        mix(mPackedFrames[lLowerFrame], mPackedFrames[lUpperFrame], lLambda,
+            outPose);
+    }
+    else
+    {
+        const auto lJointCount = jointCount();
+        if (outPose.size() != lJointCount) outPose.resize(lJointCount);
+        for (uint8_t j = 0; j < lJointCount; ++j)
+        {
+            sampleTime(frames[j].size(), startTime, currentTime, lLowerFrame,
+                       lUpperFrame, lLambda);
+            outPose.set(j, mix(frames[j][lLowerFrame], frames[j][lUpperFrame],
+                               lLambda));
+        }
+    }
+}
+
+void AnimationClip::evaluatePose(const float startTime, const float currentTime,
+                                 mat4f* outPalette) const noexcept
+{
+    // Scratch space, so that the workers do not allocate every frame.
+    thread_local SQTArray lPose;
+    samplePose(startTime, currentTime, lPose);
+    skeleton->compose(lPose, outPalette);
+}
+
+void AnimationClip::pack()
+{
+    GT_PROFILE_MEMORY(Animation);
+
+    std::size_t lFrameCount = 0;
+    for (const auto& lFrames : frames)
+    {
+        lFrameCount = std::max(lFrameCount, lFrames.size());
+    }
+    mPackedFrames.assign(lFrameCount, SQTArray(frames.size()));
+    for (std::size_t f = 0; f < lFrameCount; ++f)
+    {
+        for (std::size_t j = 0; j < frames.size(); ++j)
+        {
+            if (frames[j].empty()) continue;
+            mPackedFrames[f].set(j,
+                                 frames[j][std::min(f, frames[j].size() - 1)]);
+        }
+    }
+}
+
+void AnimationClip::compress(const CompressedAnimation::Settings& settings)
+{
+    GT_PROFILE_MEMORY(Animation);
+
+    // Compressing twice would throw away the compressed frames.
+    if (isCompressed() && frames.empty()) return;
+
+    mCompressed = CompressedAnimation(frames, settings);
+    frames.clear();
+    frames.shrink_to_fit();
+    mPackedFrames.clear();
+    mPackedFrames.shrink_to_fit();
+}
+
 } // namespace gintonic
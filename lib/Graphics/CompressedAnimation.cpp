@@ -0,0 +1,405 @@
+#include "Graphics/CompressedAnimation.hpp"
+#include "Math/SQTArray.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace gintonic
+{
+
+namespace
+{
+
+constexpr float kSqrtTwo = 1.41421356f;
+
+std::uint16_t quantize(const float value, const float minimum,
+                       const float extent) noexcept
+{
+    if (extent <= 0.0f) return 0;
+    const auto lNormalized = std::min(
+        std::max((value - minimum) / extent, 0.0f), 1.0f);
+    return static_cast<std::uint16_t>(lNormalized * 65535.0f + 0.5f);
+}
+
+float dequantize(const std::uint16_t value, const float minimum,
+                 const float extent) noexcept
+{
+    return minimum + extent * (static_cast<float>(value) / 65535.0f);
+}
+
+// Smallest three: the largest component is dropped, since it follows from
+// the other three. It is made positive first, which is allowed because q
+// and -q are the same rotation. The other three are then in
+// [-1/sqrt(2), 1/sqrt(2)] and are stored in 15 bits each. The two bits of
+// the index of the dropped component go in the top bits of the first two
+// values.
+void encodeRotation(const quatf& rotation, std::uint16_t* out) noexcept
+{
+    const float lComponents[4] = {rotation.x, rotation.y, rotation.z,
+                                  rotation.w};
+    int lLargest = 0;
+    for (int i = 1; i < 4; ++i)
+    {
+        if (std::abs(lComponents[i]) > std::abs(lComponents[lLargest]))
+        {
+            lLargest = i;
+        }
+    }
+    const float lSign = lComponents[lLargest] < 0.0f ? -1.0f : 1.0f;
+    for (int i = 0, k = 0; i < 4; ++i)
+    {
+        if (i == lLargest) continue;
+        const auto lValue = lSign * lComponents[i] * kSqrtTwo * 0.5f + 0.5f;
+        out[k++] = static_cast<std::uint16_t>(
+            std::min(std::max(lValue, 0.0f), 1.0f) * 32767.0f + 0.5f);
+    }
+    out[0] |= static_cast<std::uint16_t>((lLargest & 1) << 15);
+    out[1] |= static_cast<std::uint16_t>((lLargest >> 1) << 15);
+}
+
+quatf decodeRotation(const std::uint16_t* in) noexcept
+{
+    const int lLargest = (in[0] >> 15) | ((in[1] >> 15) << 1);
+    float lComponents[4];
+    float lLength2 = 0.0f;
+    for (int i = 0, k = 0; i < 4; ++i)
+    {
+        if (i == lLargest) continue;
+        const auto lValue =
+            static_cast<float>(in[k++] & 0x7fff) / 32767.0f * 2.0f - 1.0f;
+        lComponents[i] = lValue / kSqrtTwo;
+        lLength2 += lComponents[i] * lComponents[i];
+    }
+    lComponents[lLargest] = std::sqrt(std::max(1.0f - lLength2, 0.0f));
+    return quatf(lComponents[3], lComponents[0], lComponents[1],
+                 lComponents[2]);
+}
+
+float dot(const quatf& u, const quatf& v) noexcept
+{
+    return u.x * v.x + u.y * v.y + u.z * v.z + u.w * v.w;
+}
+
+// Interpolates along the shortest arc and normalizes.
+quatf nlerp(const quatf& u, const quatf& v, const float a) noexcept
+{
+    const auto lV = dot(u, v) < 0.0f ? v * -1.0f : v;
+    const auto lResult = u * (1.0f - a) + lV * a;
+    return lResult * (1.0f / std::sqrt(lResult.length2()));
+}
+
+// The largest difference of the components of two rotations, taking into
+// account that q and -q are the same rotation.
+float rotationError(const quatf& u, const quatf& v) noexcept
+{
+    const auto lV = dot(u, v) < 0.0f ? v * -1.0f : v;
+    return std::max(std::max(std::abs(u.x - lV.x), std::abs(u.y - lV.y)),
+                    std::max(std::abs(u.z - lV.z), std::abs(u.w - lV.w)));
+}
+
+// Picks the keys of a track greedily: from every key, the next key is the
+// furthest frame such that every frame in between is reconstructed within
+// the tolerance. withinTolerance(i, j) checks the frames strictly between
+// the keys i and j. The first and the last frame are always keys.
+template <class WithinTolerance>
+std::vector<std::uint16_t> reduceKeys(const std::size_t frameCount,
+                                      WithinTolerance withinTolerance)
+{
+    std::vector<std::uint16_t> lKeys(1, 0);
+    std::size_t i = 0;
+    while (i + 1 < frameCount)
+    {
+        auto lNext = i + 1;
+        for (auto j = i + 2; j < frameCount && withinTolerance(i, j); ++j)
+        {
+            lNext = j;
+        }
+        lKeys.push_back(static_cast<std::uint16_t>(lNext));
+        i = lNext;
+    }
+    return lKeys;
+}
+
+// Finds the key at or before a frame.
+std::size_t findKey(const std::uint16_t* frames, const std::size_t count,
+                    const float frame) noexcept
+{
+    const auto lIter = std::upper_bound(frames, frames + count, frame);
+    return lIter == frames ? 0 : static_cast<std::size_t>(lIter - frames) - 1;
+}
+
+} // anonymous namespace
+
+CompressedAnimation::CompressedAnimation(const Frames& frames,
+                                         const Settings& settings)
+{
+    std::size_t lFrameCount = 0;
+    for (const auto& lFrames : frames)
+    {
+        lFrameCount = std::max(lFrameCount, lFrames.size());
+    }
+    if (lFrameCount > 65536) throw TooManyFramesException();
+    mFrameCount = static_cast<std::uint32_t>(lFrameCount);
+
+    for (std::size_t j = 0; j < frames.size(); ++j)
+    {
+        compressVectorTrack(frames, j, true, settings.scaleTolerance);
+        compressRotationTrack(frames, j, settings.rotationTolerance);
+        compressVectorTrack(frames, j, false, settings.translationTolerance);
+    }
+}
+
+void CompressedAnimation::compressVectorTrack(const Frames& frames,
+                                              const std::size_t joint,
+                                              const bool isScale,
+                                              const float tolerance)
+{
+    auto& lTracks = isScale ? mScaleTracks : mTranslationTracks;
+    auto& lRanges = isScale ? mScaleRanges : mTranslationRanges;
+    auto& lFrames = isScale ? mScaleFrames : mTranslationFrames;
+    auto& lKeys = isScale ? mScaleKeys : mTranslationKeys;
+
+    const auto& lSource = frames[joint];
+    const auto lValue = [&](const std::size_t f, const int c) {
+        if (lSource.empty()) return isScale ? 1.0f : 0.0f;
+        const auto& lSQT = lSource[std::min(f, lSource.size() - 1)];
+        const auto& lVector = isScale ? lSQT.scale : lSQT.translation;
+        return c == 0 ? lVector.x : c == 1 ? lVector.y : lVector.z;
+    };
+    const std::size_t lCount = std::max<std::size_t>(mFrameCount, 1);
+
+    Range lRange;
+    bool lConstant = true;
+    for (int c = 0; c < 3; ++c)
+    {
+        float lMin = lValue(0, c);
+        float lMax = lMin;
+        for (std::size_t f = 1; f < lCount; ++f)
+        {
+            lMin = std::min(lMin, lValue(f, c));
+            lMax = std::max(lMax, lValue(f, c));
+            if (std::abs(lValue(f, c) - lValue(0, c)) > tolerance)
+            {
+                lConstant = false;
+            }
+        }
+        lRange.minimum[c] = lMin;
+        lRange.extent[c] = lMax - lMin;
+    }
+
+    Track lTrack;
+    lTrack.first = static_cast<std::uint32_t>(lFrames.size());
+
+    if (lConstant)
+    {
+        // A constant track is a single key that is stored exactly.
+        for (int c = 0; c < 3; ++c)
+        {
+            lRange.minimum[c] = lValue(0, c);
+            lRange.extent[c] = 0.0f;
+        }
+        lTrack.count = 1;
+        lFrames.push_back(0);
+        lKeys.insert(lKeys.end(), 3, 0);
+        lTracks.push_back(lTrack);
+        lRanges.push_back(lRange);
+        return;
+    }
+
+    // The error is measured against the quantized values, so that it
+    // includes the quantization error.
+    std::vector<std::uint16_t> lQuantized(3 * lCount);
+    std::vector<float> lDecoded(3 * lCount);
+    for (std::size_t f = 0; f < lCount; ++f)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            lQuantized[3 * f + c] =
+                quantize(lValue(f, c), lRange.minimum[c], lRange.extent[c]);
+            lDecoded[3 * f + c] = dequantize(
+                lQuantized[3 * f + c], lRange.minimum[c], lRange.extent[c]);
+        }
+    }
+
+    const auto lKeyFrames =
+        reduceKeys(lCount, [&](const std::size_t i, const std::size_t j) {
+            for (auto k = i + 1; k < j; ++k)
+            {
+                const auto t = float(k - i) / float(j - i);
+                for (int c = 0; c < 3; ++c)
+                {
+                    const auto lInterpolated =
+                        lDecoded[3 * i + c] +
+                        (lDecoded[3 * j + c] - lDecoded[3 * i + c]) * t;
+                    if (std::abs(lInterpolated - lValue(k, c)) > tolerance)
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        });
+
+    lTrack.count = static_cast<std::uint32_t>(lKeyFrames.size());
+    for (const auto f : lKeyFrames)
+    {
+        lFrames.push_back(f);
+        lKeys.insert(lKeys.end(), lQuantized.begin() + 3 * f,
+                     lQuantized.begin() + 3 * f + 3);
+    }
+    lTracks.push_back(lTrack);
+    lRanges.push_back(lRange);
+}
+
+void CompressedAnimation::compressRotationTrack(const Frames& frames,
+                                                const std::size_t joint,
+                                                const float tolerance)
+{
+    const auto& lSource = frames[joint];
+    const std::size_t lCount = std::max<std::size_t>(mFrameCount, 1);
+
+    std::vector<quatf, allocator<quatf>> lRaw(lCount);
+    std::vector<std::uint16_t> lQuantized(3 * lCount);
+    std::vector<quatf, allocator<quatf>> lDecoded(lCount);
+    bool lConstant = true;
+    for (std::size_t f = 0; f < lCount; ++f)
+    {
+        if (!lSource.empty())
+        {
+            lRaw[f] = lSource[std::min(f, lSource.size() - 1)].rotation;
+            lRaw[f] = lRaw[f] * (1.0f / std::sqrt(lRaw[f].length2()));
+        }
+        encodeRotation(lRaw[f], &lQuantized[3 * f]);
+        lDecoded[f] = decodeRotation(&lQuantized[3 * f]);
+        if (rotationError(lDecoded[0], lRaw[f]) > tolerance) lConstant = false;
+    }
+
+    Track lTrack;
+    lTrack.first = static_cast<std::uint32_t>(mRotationFrames.size());
+
+    std::vector<std::uint16_t> lKeyFrames(1, 0);
+    if (!lConstant)
+    {
+        lKeyFrames =
+            reduceKeys(lCount, [&](const std::size_t i, const std::size_t j) {
+                for (auto k = i + 1; k < j; ++k)
+                {
+                    const auto t = float(k - i) / float(j - i);
+                    const auto lInterpolated =
+                        nlerp(lDecoded[i], lDecoded[j], t);
+                    if (rotationError(lInterpolated, lRaw[k]) > tolerance)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            });
+    }
+
+    lTrack.count = static_cast<std::uint32_t>(lKeyFrames.size());
+    for (const auto f : lKeyFrames)
+    {
+        mRotationFrames.push_back(f);
+        mRotationKeys.insert(mRotationKeys.end(), lQuantized.begin() + 3 * f,
+                             lQuantized.begin() + 3 * f + 3);
+    }
+    mRotationTracks.push_back(lTrack);
+}
+
+std::size_t CompressedAnimation::byteSize() const noexcept
+{
+    return sizeof(*this) +
+           sizeof(Track) * (mScaleTracks.size() + mRotationTracks.size() +
+                            mTranslationTracks.size()) +
+           sizeof(Range) * (mScaleRanges.size() + mTranslationRanges.size()) +
+           sizeof(std::uint16_t) *
+               (mScaleFrames.size() + mScaleKeys.size() +
+                mRotationFrames.size() + mRotationKeys.size() +
+                mTranslationFrames.size() + mTranslationKeys.size());
+}
+
+vec3f CompressedAnimation::sampleVector(
+    const Track& track, const Range& range,
+    const std::vector<std::uint16_t>& frames,
+    const std::vector<std::uint16_t>& keys, const float frame) const noexcept
+{
+    const auto lDecode = [&](const std::size_t k) {
+        const auto lKey = &keys[3 * (track.first + k)];
+        return vec3f(dequantize(lKey[0], range.minimum[0], range.extent[0]),
+                     dequantize(lKey[1], range.minimum[1], range.extent[1]),
+                     dequantize(lKey[2], range.minimum[2], range.extent[2]));
+    };
+    const auto lFrames = &frames[track.first];
+    const auto k = findKey(lFrames, track.count, frame);
+    if (k + 1 >= track.count) return lDecode(k);
+    const auto t = (frame - float(lFrames[k])) /
+                   float(lFrames[k + 1] - lFrames[k]);
+    return mix(lDecode(k), lDecode(k + 1), t);
+}
+
+quatf CompressedAnimation::sampleRotation(const Track& track,
+                                          const float frame) const noexcept
+{
+    const auto lFrames = &mRotationFrames[track.first];
+    const auto lKeys = &mRotationKeys[3 * track.first];
+    const auto k = findKey(lFrames, track.count, frame);
+    if (k + 1 >= track.count) return decodeRotation(lKeys + 3 * k);
+    const auto t = (frame - float(lFrames[k])) /
+                   float(lFrames[k + 1] - lFrames[k]);
+    return nlerp(decodeRotation(lKeys + 3 * k),
+                 decodeRotation(lKeys + 3 * (k + 1)), t);
+}
+
+SQT CompressedAnimation::sample(const std::size_t joint,
+                                const std::size_t lowerFrame,
+                                const std::size_t upperFrame,
+                                const float lambda) const noexcept
+{
+    const auto& lScale = mScaleTracks[joint];
+    const auto& lRotation = mRotationTracks[joint];
+    const auto& lTranslation = mTranslationTracks[joint];
+    const auto& lScaleRange = mScaleRanges[joint];
+    const auto& lTranslationRange = mTranslationRanges[joint];
+
+    // Adjacent frames lie on the same segment of every track, so the
+    // fractional frame can be sampled directly.
+    if (upperFrame == lowerFrame + 1)
+    {
+        const auto lFrame = static_cast<float>(lowerFrame) + lambda;
+        return SQT(sampleVector(lScale, lScaleRange, mScaleFrames,
+                                mScaleKeys, lFrame),
+                   sampleRotation(lRotation, lFrame),
+                   sampleVector(lTranslation, lTranslationRange,
+                                mTranslationFrames, mTranslationKeys,
+                                lFrame));
+    }
+
+    // The last frame of a looping clip blends into the first one.
+    const auto lLower = static_cast<float>(lowerFrame);
+    const auto lUpper = static_cast<float>(upperFrame);
+    return SQT(
+        mix(sampleVector(lScale, lScaleRange, mScaleFrames, mScaleKeys,
+                         lLower),
+            sampleVector(lScale, lScaleRange, mScaleFrames, mScaleKeys,
+                         lUpper),
+            lambda),
+        nlerp(sampleRotation(lRotation, lLower),
+              sampleRotation(lRotation, lUpper), lambda),
+        mix(sampleVector(lTranslation, lTranslationRange, mTranslationFrames,
+                         mTranslationKeys, lLower),
+            sampleVector(lTranslation, lTranslationRange, mTranslationFrames,
+                         mTranslationKeys, lUpper),
+            lambda));
+}
+
+void CompressedAnimation::sample(const std::size_t lowerFrame,
+                                 const std::size_t upperFrame,
+                                 const float lambda, SQTArray& result) const
+{
+    if (result.size() != jointCount()) result.resize(jointCount());
+    for (std::size_t j = 0; j < jointCount(); ++j)
+    {
+        result.set(j, sample(j, lowerFrame, upperFrame, lambda));
+    }
+}
+
+} // namespace gintonic
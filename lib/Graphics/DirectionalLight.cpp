@@ -66,7 +66,7 @@ void DirectionalLight::shine(
 
 	#endif
 
-	glCullFace(GL_BACK);
+	OpenGL::StateCache::cullFace(GL_BACK);
 	Renderer::getUnitQuad()->draw();
 }
 
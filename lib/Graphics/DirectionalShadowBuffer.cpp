@@ -4,6 +4,7 @@
 
 #include "Math/vec4f.hpp"
 #include "Math/mat4f.hpp"
+#include "Math/frustum3f.hpp"
 
 #include "Graphics/Renderer.hpp"
 #include "Graphics/ShaderPrograms.hpp"
@@ -19,7 +20,7 @@ namespace gintonic {
 DirectionalShadowBuffer::DirectionalShadowBuffer()
 {
 	mFramebuffer.bind(GL_DRAW_FRAMEBUFFER);
-	glBindTexture(GL_TEXTURE_2D, mTexture);
+	OpenGL::StateCache::bindTexture(GL_TEXTURE_2D, mTexture);
 	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -43,14 +44,26 @@ void DirectionalShadowBuffer::collect(
 	mFramebuffer.bind(GL_DRAW_FRAMEBUFFER);
 	glViewport(0, 0, SHADOW_QUALITY, SHADOW_QUALITY);
 	glClear(GL_DEPTH_BUFFER_BIT);
-	glCullFace(GL_FRONT);
+	OpenGL::StateCache::cullFace(GL_FRONT);
 
 	const auto lProjectionViewMatrix = mProjectionMatrix * lightEntity.getViewMatrix();
 	const auto& lProgram = ShadowShaderProgram::get();
 	lProgram.activate();
 
-	for (const auto lGeometryEntity : shadowCastingGeometryEntities)
+	// Only the casters in the frustum of the light end up in the shadow map.
+	const auto& lCasters = Renderer::cullShadowCasters(lightEntity,
+		frustum3f(lProjectionViewMatrix), shadowCastingGeometryEntities);
+
+	GLint lLastMeshHasJoints = -1;
+	for (const auto lGeometryEntity : lCasters)
 	{
+		// The joint palettes were evaluated before the geometry pass.
+		const GLint lMeshHasJoints = Renderer::bindJointBlock(*lGeometryEntity);
+		if (lMeshHasJoints != lLastMeshHasJoints)
+		{
+			lProgram.setMeshHasJoints(lMeshHasJoints);
+			lLastMeshHasJoints = lMeshHasJoints;
+		}
 		lProgram.setMatrixPVM(lProjectionViewMatrix * lGeometryEntity->globalTransform());
 		lGeometryEntity->mesh->draw();
 	}
@@ -0,0 +1,63 @@
+#include "Graphics/DrawCommands.hpp"
+#include "Entity.hpp"
+#include "Foundation/WorkerPool.hpp"
+#include "Graphics/Material.hpp"
+#include "Graphics/Mesh.hpp"
+#include "Graphics/RenderQueue.hpp"
+#include "Graphics/SkinningCache.hpp"
+
+namespace gintonic
+{
+
+DrawCommandBuffer::DrawCommandBuffer(WorkerPool& workers) : mWorkers(workers)
+{
+    /* Empty on purpose. */
+}
+
+void DrawCommandBuffer::build(const RenderQueue& queue,
+                              const std::vector<Entity*>& entities,
+                              const mat4f& matrixP, const mat4f& matrixV,
+                              const SkinningCache* skinning,
+                              const bool nonUniformView)
+{
+    mCommands.resize(queue.size());
+    mQueue = &queue;
+    mEntities = &entities;
+    mSkinning = skinning;
+    mMatrixP = matrixP;
+    mMatrixV = matrixV;
+    mNonUniformView = nonUniformView;
+    mWorkers.run(mCommands.size(), mChunkSize,
+                 [this](const std::size_t first, const std::size_t last) {
+                     buildRange(first, last);
+                 });
+}
+
+void DrawCommandBuffer::buildRange(const std::size_t first,
+                                   const std::size_t last)
+{
+    for (auto i = first; i < last; ++i)
+    {
+        const auto& lItem = (*mQueue)[i];
+        const auto lEntity = (*mEntities)[lItem.index];
+        const auto lMaterial = lEntity->material.get();
+        auto& lCommand = mCommands[i];
+
+        lCommand.entity = lEntity;
+        lCommand.mesh = lEntity->mesh.get();
+        lCommand.material = lMaterial;
+        lCommand.diffuseTexture = lMaterial->diffuseTexture.get();
+        lCommand.specularTexture = lMaterial->specularTexture.get();
+        lCommand.normalTexture = lMaterial->normalTexture.get();
+        lCommand.materialFlag = RenderQueue::permutation(lItem.key);
+        lCommand.palette =
+            mSkinning ? mSkinning->find(lEntity) : SkinningCache::kNone;
+
+        lCommand.matrixVM = mMatrixV * lEntity->globalTransform();
+        lCommand.matrixPVM = mMatrixP * lCommand.matrixVM;
+        lCommand.matrixN = lCommand.matrixVM.normalMatrix(
+            mNonUniformView || lEntity->hasNonUniformScale());
+    }
+}
+
+} // namespace gintonic
@@ -37,13 +37,13 @@ Font::Font(boost::filesystem::path filename, const unsigned int pointsize)
 	}
 	const auto lGlyph = lFace->glyph;
 	FT_Set_Pixel_Sizes(lFace, 0, mPointSize);
-	glBindTexture(GL_TEXTURE_2D, mTextureObject);
+	OpenGL::StateCache::bindTexture(GL_TEXTURE_2D, mTextureObject);
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glBindVertexArray(mVertexArrayObject);
+	OpenGL::StateCache::bindVertexArray(mVertexArrayObject);
 	glBindBuffer(GL_ARRAY_BUFFER, mBufferObject);
 	OpenGL::vertex_text2d::enable_attributes();
 	for (int i = 32; i < 128; ++i)
@@ -119,11 +119,11 @@ vec2f Font::draw(const char* text, const std::size_t length, const vec2f& in_pos
 		lCoords[n++] = vert(x2 + w,  y2 - h, mChar[i-32].tx + mChar[i-32].bw / aw, mChar[i-32].bh / ah);
 	}
 
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, mTextureObject);
-	glBindVertexArray(mVertexArrayObject);
+	mTextureObject.bind(GL_TEXTURE_2D, 0);
+	OpenGL::StateCache::bindVertexArray(mVertexArrayObject);
 	glBindBuffer(GL_ARRAY_BUFFER, mBufferObject);
 	gtBufferData(GL_ARRAY_BUFFER, lCoords, GL_DYNAMIC_DRAW);
+	FrameSample::current().addDrawCall(n / 3);
 	glDrawArrays(GL_TRIANGLES, 0, n);
 
 	return lPosition;
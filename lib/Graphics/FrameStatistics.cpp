@@ -0,0 +1,206 @@
+#include "Graphics/FrameStatistics.hpp"
+#include <iomanip>
+#include <ostream>
+
+namespace
+{
+
+const char* sPhaseNames[gintonic::FrameSample::kPhaseCount] = {
+    "Events",      "Culling", "Skinning", "Geometry", "Shadows",
+    "PointLights", "Lights",  "Debug",    "GUI",      "Finalize"};
+
+const char* sBucketNames[gintonic::FrameSample::kBucketCount] = {
+    "ShadowCastingLights", "ShadowCastingPointLights",
+    "ShadowCastingGeometry", "NonShadowCastingLights",
+    "NonShadowCastingGeometry"};
+
+double toMilliseconds(const gintonic::FrameSample::duration_type d) noexcept
+{
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+// Adds (sign == +1) or subtracts (sign == -1) every field of a sample.
+void accumulate(gintonic::FrameSample& sum,
+                const gintonic::FrameSample& sample, const int sign) noexcept
+{
+    using gintonic::FrameSample;
+    const auto lSign = static_cast<FrameSample::duration_type::rep>(sign);
+    const auto add = [sign](std::size_t& lhs, const std::size_t rhs) {
+        if (sign > 0)
+            lhs += rhs;
+        else
+            lhs -= rhs;
+    };
+    sum.frameTime += lSign * sample.frameTime;
+    for (int i = 0; i < FrameSample::kPhaseCount; ++i)
+    {
+        sum.phaseTime[i] += lSign * sample.phaseTime[i];
+        sum.gpuPhaseTime[i] += lSign * sample.gpuPhaseTime[i];
+    }
+    add(sum.gpuSamples, sample.gpuSamples);
+    add(sum.drawCalls, sample.drawCalls);
+    add(sum.triangles, sample.triangles);
+    add(sum.programBinds, sample.programBinds);
+    add(sum.textureBinds, sample.textureBinds);
+    add(sum.uniformUploads, sample.uniformUploads);
+    add(sum.uniformBufferBytes, sample.uniformBufferBytes);
+    add(sum.elidedStateChanges, sample.elidedStateChanges);
+    add(sum.poseCacheHits, sample.poseCacheHits);
+    add(sum.poseCacheMisses, sample.poseCacheMisses);
+    add(sum.shadowCasters, sample.shadowCasters);
+    add(sum.culledShadowCasters, sample.culledShadowCasters);
+    for (int i = 0; i < FrameSample::kBucketCount; ++i)
+    {
+        add(sum.entities[i], sample.entities[i]);
+        add(sum.culled[i], sample.culled[i]);
+    }
+}
+
+} // anonymous namespace
+
+namespace gintonic
+{
+
+FrameSample FrameSample::sCurrent = FrameSample();
+
+FrameSample::duration_type FrameSample::totalPhaseTime() const noexcept
+{
+    auto lResult = duration_type::zero();
+    for (const auto& lPhaseTime : phaseTime) lResult += lPhaseTime;
+    return lResult;
+}
+
+FrameSample::duration_type FrameSample::totalGPUPhaseTime() const noexcept
+{
+    auto lResult = duration_type::zero();
+    for (const auto& lPhaseTime : gpuPhaseTime) lResult += lPhaseTime;
+    return lResult;
+}
+
+const char* FrameSample::name(const Phase phase) noexcept
+{
+    return phase < kPhaseCount ? sPhaseNames[phase] : "Unknown";
+}
+
+const char* FrameSample::name(const Bucket bucket) noexcept
+{
+    return bucket < kBucketCount ? sBucketNames[bucket] : "Unknown";
+}
+
+std::ostream& operator<<(std::ostream& os, const FrameSample& sample)
+{
+    const auto lFlags = os.flags();
+    const auto lPrecision = os.precision();
+    os << std::fixed << std::setprecision(2);
+    os << "Frame: " << toMilliseconds(sample.frameTime) << " ms (CPU "
+       << toMilliseconds(sample.totalPhaseTime()) << " ms";
+    if (sample.gpuSamples)
+    {
+        os << ", GPU " << toMilliseconds(sample.totalGPUPhaseTime()) << " ms";
+    }
+    os << ")\n";
+    for (int i = 0; i < FrameSample::kPhaseCount; ++i)
+    {
+        const auto lPhase = static_cast<FrameSample::Phase>(i);
+        os << "  " << FrameSample::name(lPhase) << ": "
+           << toMilliseconds(sample.phaseTime[i]) << " ms";
+        if (sample.gpuSamples)
+        {
+            os << " (GPU " << toMilliseconds(sample.gpuPhaseTime[i])
+               << " ms)";
+        }
+        os << '\n';
+    }
+    os << "Draw calls: " << sample.drawCalls
+       << ", triangles: " << sample.triangles << '\n'
+       << "Program binds: " << sample.programBinds
+       << ", texture binds: " << sample.textureBinds
+       << ", uniform uploads: " << sample.uniformUploads
+       << " (" << sample.uniformBufferBytes << " bytes in uniform buffers)\n"
+       << "Elided state changes: " << sample.elidedStateChanges << '\n'
+       << "Pose cache: " << sample.poseCacheHits << " hits, "
+       << sample.poseCacheMisses << " misses\n"
+       << "Shadow casters: " << sample.shadowCasters << " ("
+       << sample.culledShadowCasters << " culled)\n";
+    for (int i = 0; i < FrameSample::kBucketCount; ++i)
+    {
+        const auto lBucket = static_cast<FrameSample::Bucket>(i);
+        os << "  " << FrameSample::name(lBucket) << ": " << sample.entities[i]
+           << " (" << sample.culled[i] << " culled)\n";
+    }
+    os.flags(lFlags);
+    os.precision(lPrecision);
+    return os;
+}
+
+FrameStatistics::FrameStatistics(const std::size_t windowSize)
+    : mWindow(windowSize)
+{
+    /* Empty on purpose. */
+}
+
+void FrameStatistics::push(const FrameSample& sample)
+{
+    if (mWindow.capacity() == 0) return;
+    if (mWindow.full()) accumulate(mSum, mWindow.front(), -1);
+    mWindow.push_back(sample);
+    mLastFrame = sample;
+    accumulate(mSum, sample, +1);
+    updateAverage();
+}
+
+void FrameStatistics::clear() noexcept
+{
+    mWindow.clear();
+    mLastFrame = FrameSample();
+    mSum = FrameSample();
+    mAverage = FrameSample();
+}
+
+void FrameStatistics::setWindowSize(const std::size_t windowSize)
+{
+    mWindow.set_capacity(windowSize);
+    clear();
+}
+
+void FrameStatistics::updateAverage() noexcept
+{
+    const auto n = mWindow.size();
+    if (n == 0)
+    {
+        mAverage = FrameSample();
+        return;
+    }
+    const auto lCount = static_cast<FrameSample::duration_type::rep>(n);
+    mAverage.frameTime = mSum.frameTime / lCount;
+    for (int i = 0; i < FrameSample::kPhaseCount; ++i)
+    {
+        mAverage.phaseTime[i] = mSum.phaseTime[i] / lCount;
+    }
+    const auto lGPUCount =
+        static_cast<FrameSample::duration_type::rep>(mSum.gpuSamples);
+    for (int i = 0; i < FrameSample::kPhaseCount; ++i)
+    {
+        mAverage.gpuPhaseTime[i] = lGPUCount ? mSum.gpuPhaseTime[i] / lGPUCount
+                                             : FrameSample::duration_type::zero();
+    }
+    mAverage.gpuSamples = mSum.gpuSamples ? 1 : 0;
+    mAverage.drawCalls = mSum.drawCalls / n;
+    mAverage.triangles = mSum.triangles / n;
+    mAverage.programBinds = mSum.programBinds / n;
+    mAverage.textureBinds = mSum.textureBinds / n;
+    mAverage.uniformUploads = mSum.uniformUploads / n;
+    mAverage.uniformBufferBytes = mSum.uniformBufferBytes / n;
+    mAverage.elidedStateChanges = mSum.elidedStateChanges / n;
+    mAverage.poseCacheHits = mSum.poseCacheHits / n;
+    mAverage.poseCacheMisses = mSum.poseCacheMisses / n;
+    mAverage.shadowCasters = mSum.shadowCasters / n;
+    mAverage.culledShadowCasters = mSum.culledShadowCasters / n;
+    for (int i = 0; i < FrameSample::kBucketCount; ++i)
+    {
+        mAverage.entities[i] = mSum.entities[i] / n;
+        mAverage.culled[i] = mSum.culled[i] / n;
+    }
+}
+
+} // namespace gintonic
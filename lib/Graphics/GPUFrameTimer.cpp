@@ -0,0 +1,104 @@
+#include "Graphics/GPUFrameTimer.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace gintonic
+{
+
+constexpr std::size_t GPUFrameTimer::kFrameLatency;
+constexpr std::size_t GPUFrameTimer::kMaxPairsPerFrame;
+
+GPUFrameTimer::GPUFrameTimer()
+{
+    for (auto& lSlot : mSlots)
+    {
+        glGenQueries(2 * kMaxPairsPerFrame, lSlot.queries);
+        for (const auto lQuery : lSlot.queries) mEnabled &= lQuery != 0;
+    }
+    if (mEnabled) return;
+
+    // Without timer queries there are simply no GPU timings.
+    for (auto& lSlot : mSlots)
+    {
+        glDeleteQueries(2 * kMaxPairsPerFrame, lSlot.queries);
+        std::fill(std::begin(lSlot.queries), std::end(lSlot.queries), 0);
+    }
+}
+
+GPUFrameTimer::~GPUFrameTimer() noexcept
+{
+    if (!mEnabled) return;
+    for (auto& lSlot : mSlots)
+    {
+        glDeleteQueries(2 * kMaxPairsPerFrame, lSlot.queries);
+    }
+}
+
+void GPUFrameTimer::begin(const FrameSample::Phase phase) noexcept
+{
+    if (!mEnabled || mDepth++ != 0) return;
+    auto& lSlot = mSlots[mCurrent];
+    if (lSlot.count == kMaxPairsPerFrame) return;
+    lSlot.phases[lSlot.count] = phase;
+    glQueryCounter(lSlot.queries[2 * lSlot.count], GL_TIMESTAMP);
+    mOpen = true;
+}
+
+void GPUFrameTimer::end() noexcept
+{
+    if (mDepth == 0 || --mDepth != 0) return;
+    if (mOpen) close();
+}
+
+void GPUFrameTimer::close() noexcept
+{
+    auto& lSlot = mSlots[mCurrent];
+    glQueryCounter(lSlot.queries[2 * lSlot.count + 1], GL_TIMESTAMP);
+    ++lSlot.count;
+    mOpen = false;
+}
+
+bool GPUFrameTimer::nextFrame(FrameSample& sample) noexcept
+{
+    if (!mEnabled) return false;
+    if (mOpen) close();
+    mDepth = 0;
+    mSlots[mCurrent].pending = mSlots[mCurrent].count != 0;
+    mCurrent = (mCurrent + 1) % kFrameLatency;
+
+    // This is the oldest frame in flight. Its queries are reused from now on,
+    // so this is the last chance to read them.
+    auto& lSlot = mSlots[mCurrent];
+    const auto lCount = lSlot.count;
+    const auto lPending = lSlot.pending;
+    lSlot.count = 0;
+    lSlot.pending = false;
+    if (!lPending) return false;
+
+    // Timestamps complete in order, so if the last one is available then
+    // so are all the others.
+    GLint lAvailable = GL_FALSE;
+    glGetQueryObjectiv(lSlot.queries[2 * lCount - 1],
+                       GL_QUERY_RESULT_AVAILABLE, &lAvailable);
+    if (lAvailable == GL_FALSE)
+    {
+        ++mDropped;
+        return false;
+    }
+
+    for (std::size_t i = 0; i < lCount; ++i)
+    {
+        GLuint64 lBegin, lEnd;
+        glGetQueryObjectui64v(lSlot.queries[2 * i], GL_QUERY_RESULT, &lBegin);
+        glGetQueryObjectui64v(lSlot.queries[2 * i + 1], GL_QUERY_RESULT,
+                              &lEnd);
+        if (lEnd < lBegin) continue;
+        sample.gpuPhaseTime[lSlot.phases[i]] +=
+            std::chrono::duration_cast<FrameSample::duration_type>(
+                std::chrono::nanoseconds(lEnd - lBegin));
+    }
+    sample.gpuSamples = 1;
+    return true;
+}
+
+} // namespace gintonic
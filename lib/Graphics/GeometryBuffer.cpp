@@ -64,10 +64,10 @@ GeometryBuffer::GeometryBuffer(const int width, const int height)
 
 void GeometryBuffer::resize(const int width, const int height)
 {
-	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFramebuffer);
+	OpenGL::StateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, mFramebuffer);
 	for (unsigned int i = 0 ; i < kCount; ++i) 
 	{
-		glBindTexture(GL_TEXTURE_2D, mTextures[i]);
+		OpenGL::StateCache::bindTexture(GL_TEXTURE_2D, mTextures[i]);
 		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 		glTexImage2D(GL_TEXTURE_2D, 0, sTextureInternal[i], width, height, 0, sTextureFormat[i], sTextureType[i], nullptr);
@@ -78,14 +78,14 @@ void GeometryBuffer::resize(const int width, const int height)
 
 void GeometryBuffer::prepareGeometryPhase() const noexcept
 {
-	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFramebuffer);
+	OpenGL::StateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, mFramebuffer);
 	glDrawBuffers(kPostProcessing, sDrawBuffers);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 }
 
 void GeometryBuffer::prepareLightingPhase() const noexcept
 {
-	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFramebuffer);
+	OpenGL::StateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, mFramebuffer);
 	glDrawBuffer(GL_COLOR_ATTACHMENT0 + kPostProcessing);
 	glClear(GL_COLOR_BUFFER_BIT);
 	for (unsigned int i = 0; i < kPostProcessing; ++i) mTextures[i].bind(GL_TEXTURE_2D, i);
@@ -108,8 +108,8 @@ void GeometryBuffer::endStencilPass() const noexcept
 
 void GeometryBuffer::blitDrawbuffersToScreen(const int width, const int height) const noexcept
 {
-	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
-	glBindFramebuffer(GL_READ_FRAMEBUFFER, mFramebuffer);
+	OpenGL::StateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+	OpenGL::StateCache::bindFramebuffer(GL_READ_FRAMEBUFFER, mFramebuffer);
 
 	const GLsizei halfwidth = (GLsizei)(width / 2.0f);
 	const GLsizei halfheight = (GLsizei)(height / 2.0f);
@@ -136,8 +136,8 @@ void GeometryBuffer::bindDepthTexture(const GLint textureUnit) const noexcept
 
 void GeometryBuffer::finalize(const int width, const int height) const noexcept
 {
-	glBindFramebuffer(GL_READ_FRAMEBUFFER, mFramebuffer);
-	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0); // <-- The screen
+	OpenGL::StateCache::bindFramebuffer(GL_READ_FRAMEBUFFER, mFramebuffer);
+	OpenGL::StateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0); // <-- The screen
 	glReadBuffer(GL_COLOR_ATTACHMENT0 + kPostProcessing);
 	glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
 }
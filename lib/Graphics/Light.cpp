@@ -21,6 +21,12 @@ void Light::setBrightness(const float brightness) { mIntensity.w = brightness; }
 
 float Light::getBrightness() const noexcept { return mIntensity.w; }
 
+bool Light::getBoundingSphere(const Entity& /*lightEntity*/,
+                              sphere3f& /*sphere*/) const noexcept
+{
+    return false;
+}
+
 std::ostream& operator<<(std::ostream& os, const Light* l)
 {
     return l->prettyPrint(os);
@@ -3,6 +3,7 @@
 #include "Foundation/exception.hpp"
 #include "Foundation/tuple.hpp"
 
+#include "Graphics/FrameStatistics.hpp"
 #include "Graphics/Skeleton.hpp"
 
 #include <set>
@@ -266,11 +267,13 @@ void Mesh::set(const std::vector<GLuint>& indices,
                const std::vector<Mesh::vec4f>& position_XYZ_uv_X,
                const std::vector<Mesh::vec4f>& normal_XYZ_uv_Y)
 {
+    GT_PROFILE_MEMORY(Mesh);
     mIndices = indices;
     mPosition_XYZ_uv_X = position_XYZ_uv_X;
     mNormal_XYZ_uv_Y = normal_XYZ_uv_Y;
     mTangent_XYZ_hand.clear();
     computeAdjacencyFromPositionInformation();
+    computeAdjacentPositionVertices();
     computeLocalBoundingBoxFromPositionInformation(mPosition_XYZ_uv_X);
     uploadData();
 }
@@ -280,11 +283,13 @@ void Mesh::set(const std::vector<GLuint>& indices,
                const std::vector<Mesh::vec4f>& normal_XYZ_uv_Y,
                const std::vector<Mesh::vec4f>& tangent_XYZ_handedness)
 {
+    GT_PROFILE_MEMORY(Mesh);
     mIndices = indices;
     mPosition_XYZ_uv_X = position_XYZ_uv_X;
     mNormal_XYZ_uv_Y = normal_XYZ_uv_Y;
     mTangent_XYZ_hand = tangent_XYZ_handedness;
     computeAdjacencyFromPositionInformation();
+    computeAdjacentPositionVertices();
     computeLocalBoundingBoxFromPositionInformation(mPosition_XYZ_uv_X);
     uploadData();
 }
@@ -294,15 +299,26 @@ void Mesh::set(const boost::filesystem::path& nativeMeshFile)
     THROW_NOT_IMPLEMENTED_EXCEPTION();
 }
 
+void Mesh::setJoints(const std::vector<Mesh::vec4i>& jointIndices,
+                     const std::vector<Mesh::vec4f>& jointWeights)
+{
+    GT_PROFILE_MEMORY(Mesh);
+    mJointIndices = jointIndices;
+    mJointWeights = jointWeights;
+    uploadData();
+}
+
 void Mesh::draw() const noexcept
 {
-    glBindVertexArray(mVertexArrayObject);
+    FrameSample::current().addDrawCall(numIndices() / 3);
+    OpenGL::StateCache::bindVertexArray(mVertexArrayObject);
     glDrawElements(GL_TRIANGLES, numIndices(), GL_UNSIGNED_INT, nullptr);
 }
 
 void Mesh::drawAdjacent() const noexcept
 {
-    glBindVertexArray(mVertexArrayObjectAdjacencies);
+    FrameSample::current().addDrawCall(numIndicesAdjacent() / 6);
+    OpenGL::StateCache::bindVertexArray(mVertexArrayObjectAdjacencies);
     glDrawElements(GL_TRIANGLES_ADJACENCY, numIndicesAdjacent(),
                    GL_UNSIGNED_INT, nullptr);
 }
@@ -311,7 +327,7 @@ void Mesh::draw(const std::vector<mat4f, allocator<mat4f>>& PVM_matrices,
                 const std::vector<mat4f, allocator<mat4f>>& VM_matrices,
                 const std::vector<mat3f, allocator<mat3f>>& N_matrices)
 {
-    glBindVertexArray(mVertexArrayObject);
+    OpenGL::StateCache::bindVertexArray(mVertexArrayObject);
 
     mMatrixBuffer.bind(0);
     mMatrixBuffer.set(0, PVM_matrices, GL_DYNAMIC_DRAW);
@@ -322,13 +338,15 @@ void Mesh::draw(const std::vector<mat4f, allocator<mat4f>>& PVM_matrices,
     mNormalMatrixBuffer.bind();
     mNormalMatrixBuffer.set(N_matrices, GL_DYNAMIC_DRAW);
 
+    FrameSample::current().addDrawCall(numIndices() / 3 *
+                                       mMatrixBuffer.size(0));
     glDrawElementsInstanced(GL_TRIANGLES, numIndices(), GL_UNSIGNED_INT,
                             nullptr, mMatrixBuffer.size(0));
 }
 
 void Mesh::setupInstancedRenderingMatrices() noexcept
 {
-    glBindVertexArray(mVertexArrayObject);
+    OpenGL::StateCache::bindVertexArray(mVertexArrayObject);
     mMatrixBuffer.bind(0);
     for (GLuint i = 0; i < 4; ++i)
     {
@@ -460,11 +478,31 @@ void Mesh::computeAdjacencyFromPositionInformation()
     }
 }
 
+void Mesh::computeAdjacentPositionVertices()
+{
+    std::map<Mesh::vec3f, GLuint> lPositionToIndexMap;
+    for (GLuint i = 0; i < mPositions.size(); ++i)
+    {
+        lPositionToIndexMap.emplace(mPositions[i], i);
+    }
+    mAdjacentPositionVertices.assign(mPositions.size(), 0);
+    for (auto v = static_cast<GLuint>(mPosition_XYZ_uv_X.size()); v-- > 0;)
+    {
+        const auto& lPosition4 = mPosition_XYZ_uv_X[v];
+        const Mesh::vec3f lPosition(lPosition4.x, lPosition4.y, lPosition4.z);
+        const auto lIter = lPositionToIndexMap.find(lPosition);
+        if (lIter != lPositionToIndexMap.end())
+        {
+            mAdjacentPositionVertices[lIter->second] = v;
+        }
+    }
+}
+
 void Mesh::uploadData()
 {
     constexpr GLenum lUsageHint = GL_STATIC_DRAW;
 
-    glBindVertexArray(mVertexArrayObject);
+    OpenGL::StateCache::bindVertexArray(mVertexArrayObject);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffer[GT_MESH_BUFFER_INDICES]);
     gtBufferData(GL_ELEMENT_ARRAY_BUFFER, mIndices, lUsageHint);
 
@@ -493,7 +531,7 @@ void Mesh::uploadData()
         Mesh::vec4f::enableAttribute(GT_VERTEX_LAYOUT_SLOT_15);
     }
 
-    glBindVertexArray(mVertexArrayObjectAdjacencies);
+    OpenGL::StateCache::bindVertexArray(mVertexArrayObjectAdjacencies);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffer[GT_MESH_BUFFER_INDICES_ADJ]);
     gtBufferData(GL_ELEMENT_ARRAY_BUFFER, mIndicesAdjacent, lUsageHint);
 
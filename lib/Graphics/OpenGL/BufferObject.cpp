@@ -55,7 +55,7 @@ BufferObject& BufferObject::operator=(const BufferObject& other)
 }
 BufferObject& BufferObject::operator=(BufferObject&& other) noexcept
 {
-	glDeleteBuffers(1, &mHandle);
+	StateCache::deleteBuffers(1, &mHandle);
 	mHandle = other.mHandle;
 	other.mHandle = 0;
 	return *this;
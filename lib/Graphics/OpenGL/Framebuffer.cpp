@@ -36,7 +36,7 @@ Framebuffer& Framebuffer::operator = (Framebuffer&& other)
 
 void Framebuffer::bind(const GLenum token) const noexcept
 {
-	glBindFramebuffer(token, mHandle);
+	StateCache::bindFramebuffer(token, mHandle);
 }
 
 void Framebuffer::checkStatus() const
@@ -0,0 +1,605 @@
+#include "Graphics/OpenGL/RecordingContext.hpp"
+#include "Graphics/OpenGL/StateCache.hpp"
+#include "Graphics/OpenGL/utilities.hpp"
+#include <cassert>
+#include <algorithm>
+#include <cstring>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+namespace { // anonymous namespace
+
+using gintonic::OpenGL::RecordingContext;
+
+RecordingContext* sCurrent = nullptr;
+
+/*****************************************************************************
+* Formatting of arguments.                                                   *
+*****************************************************************************/
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value>::type
+format(std::ostream& os, const T value)
+{
+	// The unary plus makes sure that GLboolean and GLubyte print as numbers.
+	os << +value;
+}
+
+template <class T>
+typename std::enable_if<std::is_floating_point<T>::value>::type
+format(std::ostream& os, const T value)
+{
+	os << value;
+}
+
+template <class T>
+void format(std::ostream& os, const T* value)
+{
+	os << static_cast<const void*>(value);
+}
+
+template <class T>
+void format(std::ostream& os, T* const* value)
+{
+	os << static_cast<const void*>(value);
+}
+
+inline void formatAll(std::ostream&)
+{
+	/* Empty on purpose. */
+}
+
+template <class Head, class... Tail>
+void formatAll(std::ostream& os, const Head head, const Tail... tail)
+{
+	format(os, head);
+	if (sizeof...(Tail)) os << ", ";
+	formatAll(os, tail...);
+}
+
+template <class... Args>
+void record(const char* name, const Args... args)
+{
+	if (!sCurrent) return;
+	std::ostringstream lStream;
+	formatAll(lStream, args...);
+	sCurrent->record(name, lStream.str());
+}
+
+inline GLuint generateName() noexcept
+{
+	return sCurrent ? sCurrent->generateName() : 0;
+}
+
+/*****************************************************************************
+* Functions that only record.                                                *
+*****************************************************************************/
+
+template <class Tag, class Function> struct Recorder;
+
+template <class Tag, class R, class... Args>
+struct Recorder<Tag, R (APIENTRY *)(Args...)>
+{
+	static R APIENTRY call(Args... args)
+	{
+		record(Tag::get(), args...);
+		return R();
+	}
+};
+
+#define GT_RECORDED_FUNCTIONS(X) \
+	X(glActiveTexture) \
+	X(glBindBuffer) \
+	X(glBindBufferBase) \
+	X(glBindBufferRange) \
+	X(glBindFramebuffer) \
+	X(glBindTexture) \
+	X(glBindVertexArray) \
+	X(glBlendEquation) \
+	X(glBlendFunc) \
+	X(glBlitFramebuffer) \
+	X(glBufferData) \
+	X(glBufferSubData) \
+	X(glClear) \
+	X(glClearColor) \
+	X(glClearDepth) \
+	X(glClearStencil) \
+	X(glColorMask) \
+	X(glCompileShader) \
+	X(glCopyBufferSubData) \
+	X(glCullFace) \
+	X(glDeleteBuffers) \
+	X(glDeleteFramebuffers) \
+	X(glDeleteProgram) \
+	X(glDeleteQueries) \
+	X(glDeleteShader) \
+	X(glDeleteTextures) \
+	X(glDeleteVertexArrays) \
+	X(glDepthFunc) \
+	X(glDepthMask) \
+	X(glDetachShader) \
+	X(glDisable) \
+	X(glDisableVertexAttribArray) \
+	X(glDrawArrays) \
+	X(glDrawArraysInstanced) \
+	X(glDrawBuffer) \
+	X(glDrawBuffers) \
+	X(glDrawElements) \
+	X(glDrawElementsInstanced) \
+	X(glEnable) \
+	X(glEnableVertexAttribArray) \
+	X(glFramebufferTexture2D) \
+	X(glFrontFace) \
+	X(glGenerateMipmap) \
+	X(glLineWidth) \
+	X(glLinkProgram) \
+	X(glPixelStorei) \
+	X(glPolygonMode) \
+	X(glPolygonOffset) \
+	X(glQueryCounter) \
+	X(glReadBuffer) \
+	X(glScissor) \
+	X(glStencilFunc) \
+	X(glStencilMask) \
+	X(glStencilOp) \
+	X(glStencilOpSeparate) \
+	X(glTexImage2D) \
+	X(glTexParameterf) \
+	X(glTexParameteri) \
+	X(glTexSubImage2D) \
+	X(glUniform1f) \
+	X(glUniform1fv) \
+	X(glUniform1i) \
+	X(glUniform1iv) \
+	X(glUniform1ui) \
+	X(glUniform1uiv) \
+	X(glUniform2f) \
+	X(glUniform2fv) \
+	X(glUniform2i) \
+	X(glUniform2iv) \
+	X(glUniform2ui) \
+	X(glUniform2uiv) \
+	X(glUniform3f) \
+	X(glUniform3fv) \
+	X(glUniform3i) \
+	X(glUniform3iv) \
+	X(glUniform3ui) \
+	X(glUniform3uiv) \
+	X(glUniform4f) \
+	X(glUniform4fv) \
+	X(glUniform4i) \
+	X(glUniform4iv) \
+	X(glUniform4ui) \
+	X(glUniform4uiv) \
+	X(glUniformBlockBinding) \
+	X(glUniformMatrix3fv) \
+	X(glUniformMatrix4fv) \
+	X(glUseProgram) \
+	X(glVertexAttribDivisor) \
+	X(glVertexAttribIPointer) \
+	X(glVertexAttribPointer) \
+	X(glViewport)
+
+/*
+ * The name is stringized and pasted before it is macro-expanded, so these
+ * work both when gl* is a function and when it is one of glad's macros.
+ */
+#define GT_DEFINE_TAG(name) \
+	struct name##Tag { static const char* get() noexcept { return #name; } };
+
+#define GT_INSERT_RECORDER(name) \
+	lTable[#name] = reinterpret_cast<void*>( \
+		&Recorder<name##Tag, typename std::decay<decltype(name)>::type>::call);
+
+GT_RECORDED_FUNCTIONS(GT_DEFINE_TAG)
+
+/*****************************************************************************
+* Functions that simulate a driver.                                          *
+*****************************************************************************/
+
+#define GT_DEFINE_GEN(name) \
+	void APIENTRY name##Simulated(GLsizei n, GLuint* names) \
+	{ \
+		for (GLsizei i = 0; i < n; ++i) names[i] = generateName(); \
+		record(#name, n, names); \
+	}
+
+GT_DEFINE_GEN(glGenBuffers)
+GT_DEFINE_GEN(glGenFramebuffers)
+GT_DEFINE_GEN(glGenQueries)
+GT_DEFINE_GEN(glGenTextures)
+GT_DEFINE_GEN(glGenVertexArrays)
+
+GLuint APIENTRY glCreateProgramSimulated()
+{
+	record("glCreateProgram");
+	return generateName();
+}
+
+GLuint APIENTRY glCreateShaderSimulated(GLenum type)
+{
+	record("glCreateShader", type);
+	return generateName();
+}
+
+void APIENTRY glShaderSourceSimulated(GLuint shader, GLsizei count,
+	const GLchar* const* string, const GLint* length)
+{
+	record("glShaderSource", shader, count, string, length);
+	if (!sCurrent) return;
+	std::string lSource;
+	for (GLsizei i = 0; i < count; ++i)
+	{
+		if (length && length[i] >= 0) lSource.append(string[i], length[i]);
+		else lSource.append(string[i]);
+	}
+	sCurrent->setShaderSource(shader, lSource);
+}
+
+void APIENTRY glAttachShaderSimulated(GLuint program, GLuint shader)
+{
+	record("glAttachShader", program, shader);
+	if (sCurrent) sCurrent->attachShader(program, shader);
+}
+
+GLenum APIENTRY glGetErrorSimulated()
+{
+	return GL_NO_ERROR;
+}
+
+const GLubyte* APIENTRY glGetStringSimulated(GLenum name)
+{
+	record("glGetString", name);
+	const char* lResult;
+	switch (name)
+	{
+		case GL_VENDOR: lResult = "gintonic"; break;
+		case GL_RENDERER: lResult = "gintonic recording context"; break;
+		case GL_VERSION: lResult = "4.5"; break;
+		case GL_SHADING_LANGUAGE_VERSION: lResult = "4.50"; break;
+		default: lResult = ""; break;
+	}
+	return reinterpret_cast<const GLubyte*>(lResult);
+}
+
+const GLubyte* APIENTRY glGetStringiSimulated(GLenum name, GLuint index)
+{
+	record("glGetStringi", name, index);
+	return reinterpret_cast<const GLubyte*>("");
+}
+
+void APIENTRY glGetIntegervSimulated(GLenum pname, GLint* data)
+{
+	record("glGetIntegerv", pname, data);
+	switch (pname)
+	{
+		case GL_MAJOR_VERSION: data[0] = 4; break;
+		case GL_MINOR_VERSION: data[0] = 5; break;
+		case GL_MAX_VERTEX_ATTRIBS: data[0] = 16; break;
+		case GL_MAX_TEXTURE_IMAGE_UNITS: data[0] = 16; break;
+		case GL_MAX_UNIFORM_BUFFER_BINDINGS: data[0] = 36; break;
+		case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT: data[0] = 256; break;
+		case GL_MAX_UNIFORM_BLOCK_SIZE: data[0] = 16384; break;
+		case GL_ALIASED_LINE_WIDTH_RANGE: data[0] = data[1] = 1; break;
+		case GL_DEPTH_RANGE: data[0] = 0; data[1] = 1; break;
+		case GL_MAX_VIEWPORT_DIMS: data[0] = data[1] = 16384; break;
+		case GL_SCISSOR_BOX: // fall through
+		case GL_VIEWPORT: data[0] = data[1] = data[2] = data[3] = 0; break;
+		default: data[0] = 0; break;
+	}
+}
+
+void APIENTRY glGetFloatvSimulated(GLenum pname, GLfloat* data)
+{
+	record("glGetFloatv", pname, data);
+	switch (pname)
+	{
+		case GL_ALIASED_LINE_WIDTH_RANGE: // fall through
+		case GL_SMOOTH_LINE_WIDTH_RANGE: // fall through
+		case GL_POINT_SIZE_RANGE: data[0] = data[1] = 1.0f; break;
+		case GL_DEPTH_RANGE: data[0] = 0.0f; data[1] = 1.0f; break;
+		case GL_BLEND_COLOR: // fall through
+		case GL_COLOR_CLEAR_VALUE: // fall through
+		case GL_VIEWPORT: data[0] = data[1] = data[2] = data[3] = 0.0f; break;
+		default: data[0] = 0.0f; break;
+	}
+}
+
+void APIENTRY glGetBooleanvSimulated(GLenum pname, GLboolean* data)
+{
+	record("glGetBooleanv", pname, data);
+	switch (pname)
+	{
+		case GL_COLOR_WRITEMASK:
+			data[0] = data[1] = data[2] = data[3] = GL_TRUE;
+			break;
+		default: data[0] = GL_FALSE; break;
+	}
+}
+
+void APIENTRY glGetProgramivSimulated(GLuint program, GLenum pname, GLint* params)
+{
+	record("glGetProgramiv", program, pname, params);
+	switch (pname)
+	{
+		case GL_LINK_STATUS: // fall through
+		case GL_VALIDATE_STATUS: params[0] = GL_TRUE; break;
+		case GL_ACTIVE_UNIFORMS:
+			params[0] = sCurrent ? static_cast<GLint>(
+				sCurrent->activeUniforms(program).size()) : 0;
+			break;
+		case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+		{
+			// Including the terminator.
+			std::size_t lLength = 0;
+			if (sCurrent)
+			{
+				for (const auto& lName : sCurrent->activeUniforms(program))
+				{
+					lLength = std::max(lLength, lName.size() + 1);
+				}
+			}
+			params[0] = static_cast<GLint>(lLength);
+			break;
+		}
+		default: params[0] = 0; break;
+	}
+}
+
+void APIENTRY glGetShaderivSimulated(GLuint shader, GLenum pname, GLint* params)
+{
+	record("glGetShaderiv", shader, pname, params);
+	params[0] = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+void APIENTRY glGetProgramInfoLogSimulated(GLuint program, GLsizei bufSize,
+	GLsizei* length, GLchar* infoLog)
+{
+	record("glGetProgramInfoLog", program, bufSize, length, infoLog);
+	if (length) *length = 0;
+	if (bufSize > 0) infoLog[0] = '\0';
+}
+
+void APIENTRY glGetShaderInfoLogSimulated(GLuint shader, GLsizei bufSize,
+	GLsizei* length, GLchar* infoLog)
+{
+	record("glGetShaderInfoLog", shader, bufSize, length, infoLog);
+	if (length) *length = 0;
+	if (bufSize > 0) infoLog[0] = '\0';
+}
+
+#define GT_DEFINE_GET_ACTIVE(name) \
+	void APIENTRY name##Simulated(GLuint program, GLuint index, \
+		GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, \
+		GLchar* nameOut) \
+	{ \
+		record(#name, program, index, bufSize, length, size, type, nameOut); \
+		if (length) *length = 0; \
+		*size = 1; \
+		*type = GL_FLOAT; \
+		if (bufSize > 0) nameOut[0] = '\0'; \
+	}
+
+GT_DEFINE_GET_ACTIVE(glGetActiveAttrib)
+
+void APIENTRY glGetActiveUniformSimulated(GLuint program, GLuint index,
+	GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type,
+	GLchar* nameOut)
+{
+	record("glGetActiveUniform", program, index, bufSize, length, size, type,
+		nameOut);
+	std::string lName;
+	if (sCurrent && index < sCurrent->activeUniforms(program).size())
+	{
+		lName = sCurrent->activeUniforms(program)[index];
+	}
+	const auto lLength = bufSize > 0 ? std::min(lName.size(),
+		static_cast<std::size_t>(bufSize - 1)) : std::size_t(0);
+	if (length) *length = static_cast<GLsizei>(lLength);
+	*size = 1;
+	*type = GL_FLOAT;
+	if (bufSize > 0)
+	{
+		std::memcpy(nameOut, lName.data(), lLength);
+		nameOut[lLength] = '\0';
+	}
+}
+
+GLint APIENTRY glGetAttribLocationSimulated(GLuint program, const GLchar* name)
+{
+	record("glGetAttribLocation", program, name);
+	return static_cast<GLint>(generateName());
+}
+
+GLint APIENTRY glGetUniformLocationSimulated(GLuint program, const GLchar* name)
+{
+	record("glGetUniformLocation", program, name);
+	return static_cast<GLint>(generateName());
+}
+
+GLuint APIENTRY glGetUniformBlockIndexSimulated(GLuint program,
+	const GLchar* uniformBlockName)
+{
+	record("glGetUniformBlockIndex", program, uniformBlockName);
+	return 0;
+}
+
+void APIENTRY glGetBufferParameterivSimulated(GLenum target, GLenum pname,
+	GLint* params)
+{
+	record("glGetBufferParameteriv", target, pname, params);
+	params[0] = 0;
+}
+
+void APIENTRY glGetBufferSubDataSimulated(GLenum target, GLintptr offset,
+	GLsizeiptr size, void* data)
+{
+	record("glGetBufferSubData", target, offset, size, data);
+	std::memset(data, 0, static_cast<std::size_t>(size));
+}
+
+GLenum APIENTRY glCheckFramebufferStatusSimulated(GLenum target)
+{
+	record("glCheckFramebufferStatus", target);
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+void APIENTRY glGetQueryObjectivSimulated(GLuint id, GLenum pname, GLint* params)
+{
+	record("glGetQueryObjectiv", id, pname, params);
+	params[0] = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+}
+
+void APIENTRY glGetQueryObjectui64vSimulated(GLuint id, GLenum pname,
+	GLuint64* params)
+{
+	record("glGetQueryObjectui64v", id, pname, params);
+	params[0] = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+}
+
+#define GT_SIMULATED_FUNCTIONS(X) \
+	X(glAttachShader) \
+	X(glCheckFramebufferStatus) \
+	X(glCreateProgram) \
+	X(glCreateShader) \
+	X(glGenBuffers) \
+	X(glGenFramebuffers) \
+	X(glGenQueries) \
+	X(glGenTextures) \
+	X(glGenVertexArrays) \
+	X(glGetActiveAttrib) \
+	X(glGetActiveUniform) \
+	X(glGetAttribLocation) \
+	X(glGetBooleanv) \
+	X(glGetBufferParameteriv) \
+	X(glGetBufferSubData) \
+	X(glGetError) \
+	X(glGetFloatv) \
+	X(glGetIntegerv) \
+	X(glGetProgramInfoLog) \
+	X(glGetProgramiv) \
+	X(glGetQueryObjectiv) \
+	X(glGetQueryObjectui64v) \
+	X(glGetShaderInfoLog) \
+	X(glGetShaderiv) \
+	X(glGetString) \
+	X(glGetStringi) \
+	X(glGetUniformBlockIndex) \
+	X(glGetUniformLocation) \
+	X(glShaderSource)
+
+#define GT_INSERT_SIMULATED(name) \
+	lTable[#name] = reinterpret_cast<void*>(&name##Simulated);
+
+typedef std::unordered_map<std::string, void*> TableType;
+
+const TableType& table()
+{
+	static const TableType sTable = []()
+	{
+		TableType lTable;
+		GT_RECORDED_FUNCTIONS(GT_INSERT_RECORDER)
+		GT_SIMULATED_FUNCTIONS(GT_INSERT_SIMULATED)
+		return lTable;
+	}();
+	return sTable;
+}
+
+} // anonymous namespace
+
+namespace gintonic {
+namespace OpenGL {
+
+RecordingContext::RecordingContext()
+{
+	assert(sCurrent == nullptr);
+	sCurrent = this;
+	if (!gladLoadGLLoader(&RecordingContext::getProcAddress))
+	{
+		sCurrent = nullptr;
+		throw std::runtime_error("Failed to load the recording functions.");
+	}
+	// Loading queries the version and extensions; that is not interesting.
+	mCalls.clear();
+	// Nothing is known about the state of a fresh context.
+	gintonic::OpenGL::StateCache::invalidate();
+}
+
+RecordingContext::~RecordingContext() noexcept
+{
+	if (sCurrent == this) sCurrent = nullptr;
+}
+
+RecordingContext* RecordingContext::current() noexcept
+{
+	return sCurrent;
+}
+
+void* RecordingContext::getProcAddress(const char* name)
+{
+	const auto& lTable = table();
+	const auto lIter = lTable.find(name);
+	return lIter == lTable.end() ? nullptr : lIter->second;
+}
+
+std::size_t RecordingContext::count(const char* name) const noexcept
+{
+	std::size_t lResult = 0;
+	for (const auto& lCall : mCalls)
+	{
+		if (std::strcmp(lCall.name, name) == 0) ++lResult;
+	}
+	return lResult;
+}
+
+void RecordingContext::record(const char* name, std::string arguments)
+{
+	mCalls.push_back({name, std::move(arguments)});
+}
+
+void RecordingContext::setShaderSource(const unsigned int shader,
+	const std::string& source)
+{
+	// A uniform of a basic type, possibly an array. A uniform block has no
+	// name between its block name and its opening brace, so it does not
+	// match.
+	static const std::regex sDeclaration(
+		R"(\buniform\s+\w+\s+(\w+)\s*(\[[^\]]*\])?\s*;)");
+	auto& lUniforms = mUniforms[shader];
+	lUniforms.clear();
+	for (std::sregex_iterator lIter(source.begin(), source.end(),
+		sDeclaration), lEnd; lIter != lEnd; ++lIter)
+	{
+		lUniforms.push_back((*lIter)[1].str() + ((*lIter)[2].matched ? "[0]"
+			: ""));
+	}
+}
+
+void RecordingContext::attachShader(const unsigned int program,
+	const unsigned int shader)
+{
+	// A uniform that both stages declare is one uniform of the program.
+	auto& lProgram = mUniforms[program];
+	for (const auto& lName : mUniforms[shader])
+	{
+		if (std::find(lProgram.begin(), lProgram.end(), lName)
+			== lProgram.end())
+		{
+			lProgram.push_back(lName);
+		}
+	}
+}
+
+const std::vector<std::string>& RecordingContext::activeUniforms(
+	const unsigned int program) const noexcept
+{
+	static const std::vector<std::string> sNone;
+	const auto lIter = mUniforms.find(program);
+	return lIter == mUniforms.end() ? sNone : lIter->second;
+}
+
+} // namespace OpenGL
+} // namespace gintonic
@@ -1,5 +1,7 @@
 #include "Graphics/OpenGL/ShaderProgram.hpp"
 #include "Graphics/OpenGL/Shader.hpp"
+#include "Graphics/OpenGL/StateCache.hpp"
+#include "Graphics/FrameStatistics.hpp"
 #include "Math/vec2f.hpp"
 #include "Math/vec3f.hpp"
 #include "Math/vec4f.hpp"
@@ -37,7 +39,7 @@ ShaderProgram::ShaderProgram(
 		glGetProgramiv(*this, GL_INFO_LOG_LENGTH, &r);
 		infolog.resize(r);
 		glGetProgramInfoLog(*this, r, nullptr, &infolog[0]);
-		glDeleteProgram(mHandle);
+		StateCache::deleteProgram(mHandle);
 		mHandle = 0;
 		throw exception(std::move(infolog));
 	}
@@ -75,7 +77,7 @@ ShaderProgram::ShaderProgram(
 		glGetProgramiv(*this, GL_INFO_LOG_LENGTH, &r);
 		infolog.resize(r);
 		glGetProgramInfoLog(*this, r, nullptr, &infolog[0]);
-		glDeleteProgram(mHandle);
+		StateCache::deleteProgram(mHandle);
 		mHandle = 0;
 		throw exception(std::move(infolog));
 	}
@@ -163,10 +165,13 @@ ShaderProgram& ShaderProgram::operator = (ShaderProgram&& other)
 	return *this;
 }
 
-ShaderProgram::~ShaderProgram() noexcept { glDeleteProgram(*this); }
+ShaderProgram::~ShaderProgram() noexcept { StateCache::deleteProgram(*this); }
 
-void ShaderProgram::activate() const noexcept { glUseProgram(mHandle); }
-void ShaderProgram::deactivate() noexcept { glUseProgram(0); }
+void ShaderProgram::activate() const noexcept
+{
+	StateCache::useProgram(mHandle);
+}
+void ShaderProgram::deactivate() noexcept { StateCache::useProgram(0); }
 
 GLint ShaderProgram::getUniformLocation(const GLchar* name) const
 {
@@ -241,22 +246,27 @@ bool ShaderProgram::getAttributeLocation(const GLchar* name, GLint& location) co
 
 void ShaderProgram::setUniform(const char* uniformName, const GLfloat value) const
 {
+	++FrameSample::current().uniformUploads;
 	glUniform1f(getUniformLocation(uniformName), value);
 }
 void ShaderProgram::setUniform(const char* uniformName, const vec2f& v) const
 {
+	++FrameSample::current().uniformUploads;
 	glUniform2f(getUniformLocation(uniformName), v.x, v.y);
 }
 void ShaderProgram::setUniform(const char* uniformName, const vec3f& v) const
 {
+	++FrameSample::current().uniformUploads;
 	glUniform3f(getUniformLocation(uniformName), v.x, v.y, v.z);
 }
 void ShaderProgram::setUniform(const char* uniformName, const vec4f& v) const
 {
+	++FrameSample::current().uniformUploads;
 	glUniform4f(getUniformLocation(uniformName), v.x, v.y, v.z, v.w);
 }
 void ShaderProgram::setUniform(const char* uniformName, const mat3f& m) const
 {
+	++FrameSample::current().uniformUploads;
 	// float temp[9];
 	// const float* ptr = m.value_ptr();
 	// temp[0] = ptr[0];
@@ -275,30 +285,37 @@ void ShaderProgram::setUniform(const char* uniformName, const mat3f& m) const
 }
 void ShaderProgram::setUniform(const char* uniformName, const mat4f& m) const
 {
+	++FrameSample::current().uniformUploads;
 	glUniformMatrix4fv(getUniformLocation(uniformName), 1, GL_FALSE, m.value_ptr());
 }
 void ShaderProgram::setUniform(const char* uniformName, const GLint i) const
 {
+	++FrameSample::current().uniformUploads;
 	glUniform1i(getUniformLocation(uniformName), i);
 }
 void ShaderProgram::setUniform(const GLint location, const GLfloat value) noexcept
 {
+	++FrameSample::current().uniformUploads;
 	glUniform1f(location, value);
 }
 void ShaderProgram::setUniform(const GLint location, const vec2f& v) noexcept
 {
+	++FrameSample::current().uniformUploads;
 	glUniform2f(location, v.x, v.y);
 }
 void ShaderProgram::setUniform(const GLint location, const vec3f& v) noexcept
 {
+	++FrameSample::current().uniformUploads;
 	glUniform3f(location, v.x, v.y, v.z);
 }
 void ShaderProgram::setUniform(const GLint location, const vec4f& v) noexcept
 {
+	++FrameSample::current().uniformUploads;
 	glUniform4f(location, v.x, v.y, v.z, v.w);
 }
 void ShaderProgram::setUniform(const GLint location, const mat3f& m) noexcept
 {
+	++FrameSample::current().uniformUploads;
 	// float temp[9];
 	// const float* ptr = m.value_ptr();
 	// temp[0] = ptr[0];
@@ -317,18 +334,22 @@ void ShaderProgram::setUniform(const GLint location, const mat3f& m) noexcept
 }
 void ShaderProgram::setUniform(const GLint location, const mat4f& m) noexcept
 {
+	++FrameSample::current().uniformUploads;
 	glUniformMatrix4fv(location, 1, GL_FALSE, m.value_ptr());
 }
 void ShaderProgram::setUniform(const GLint location, const GLint i) noexcept
 {
+	++FrameSample::current().uniformUploads;
 	glUniform1i(location, i);
 }
 void ShaderProgram::setUniform(const GLint location, const std::vector<GLfloat>& values) noexcept
 {
+	++FrameSample::current().uniformUploads;
 	glUniform1fv(location, values.size(), values.data());
 }
 void ShaderProgram::setUniform(const GLint location, const std::vector<GLint>& values) noexcept
 {
+	++FrameSample::current().uniformUploads;
 	glUniform1iv(location, values.size(), values.data());
 }
 
@@ -0,0 +1,425 @@
+#include "Graphics/OpenGL/StateCache.hpp"
+#include "Graphics/FrameStatistics.hpp"
+
+namespace { // anonymous namespace
+
+using gintonic::OpenGL::StateCache;
+
+// Every piece of state starts out as unknown, so that the first change
+// always goes through.
+constexpr GLuint kUnknown = ~GLuint(0);
+
+// The tracked texture targets.
+const GLenum sTextureTargets[] = {GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP,
+	GL_TEXTURE_2D_ARRAY};
+constexpr int kTextureTargetCount = 3;
+
+// The tracked capabilities.
+const GLenum sCapabilities[] = {GL_BLEND, GL_CULL_FACE, GL_DEPTH_CLAMP,
+	GL_DEPTH_TEST, GL_POLYGON_OFFSET_FILL, GL_SCISSOR_TEST, GL_STENCIL_TEST};
+constexpr int kCapabilityCount = 7;
+
+struct State
+{
+	GLuint program;
+	GLuint vertexArray;
+	GLuint activeTexture;
+	GLuint textures[StateCache::kMaxTextureUnits][kTextureTargetCount];
+	GLuint drawFramebuffer;
+	GLuint readFramebuffer;
+	// buffer, offset, size
+	GLuint uniformBuffers[StateCache::kMaxUniformBufferBindings][3];
+	GLuint capabilities[kCapabilityCount];
+	GLuint blendSource;
+	GLuint blendDestination;
+	GLuint blendEquation;
+	GLuint depthFunc;
+	GLuint depthMask;
+	GLuint cullFace;
+	GLuint frontFace;
+	GLuint polygonMode;
+	GLuint stencilFunc;
+	GLuint stencilReference;
+	GLuint stencilMask;
+	GLuint stencilOps[2][3]; // front, back
+};
+
+State sState;
+
+// Returns true when the cached value differs (and updates it), and counts
+// an elided change when it does not.
+inline bool change(GLuint& cached, const GLuint value) noexcept
+{
+	if (cached == value)
+	{
+		++gintonic::FrameSample::current().elidedStateChanges;
+		return false;
+	}
+	cached = value;
+	return true;
+}
+
+inline int textureTargetIndex(const GLenum target) noexcept
+{
+	for (int i = 0; i < kTextureTargetCount; ++i)
+	{
+		if (sTextureTargets[i] == target) return i;
+	}
+	return -1;
+}
+
+inline GLuint* capability(const GLenum cap) noexcept
+{
+	for (int i = 0; i < kCapabilityCount; ++i)
+	{
+		if (sCapabilities[i] == cap) return &sState.capabilities[i];
+	}
+	return nullptr;
+}
+
+void setStencilOp(const int face, const GLenum stencilFail,
+	const GLenum depthFail, const GLenum depthPass) noexcept
+{
+	sState.stencilOps[face][0] = stencilFail;
+	sState.stencilOps[face][1] = depthFail;
+	sState.stencilOps[face][2] = depthPass;
+}
+
+inline bool sameStencilOp(const int face, const GLenum stencilFail,
+	const GLenum depthFail, const GLenum depthPass) noexcept
+{
+	return sState.stencilOps[face][0] == stencilFail
+		&& sState.stencilOps[face][1] == depthFail
+		&& sState.stencilOps[face][2] == depthPass;
+}
+
+// Uniform buffers are far smaller than 4 GiB, so their offsets and sizes fit
+// in the GLuint fields of the State. A size of zero means that the whole
+// buffer is bound, since a range can never be empty.
+inline bool changeUniformBuffer(const GLuint index, const GLuint buffer,
+	const GLintptr offset, const GLsizeiptr size) noexcept
+{
+	auto& lBinding = sState.uniformBuffers[index];
+	const auto lOffset = static_cast<GLuint>(offset);
+	const auto lSize = static_cast<GLuint>(size);
+	if (lBinding[0] == buffer && lBinding[1] == lOffset && lBinding[2] == lSize)
+	{
+		++gintonic::FrameSample::current().elidedStateChanges;
+		return false;
+	}
+	lBinding[0] = buffer;
+	lBinding[1] = lOffset;
+	lBinding[2] = lSize;
+	return true;
+}
+
+struct Invalidator
+{
+	Invalidator() noexcept { StateCache::invalidate(); }
+};
+
+Invalidator sInvalidator;
+
+} // anonymous namespace
+
+namespace gintonic {
+namespace OpenGL {
+
+constexpr GLuint StateCache::kMaxTextureUnits;
+constexpr GLuint StateCache::kMaxUniformBufferBindings;
+
+void StateCache::invalidate() noexcept
+{
+	auto lData = reinterpret_cast<GLuint*>(&sState);
+	for (std::size_t i = 0; i < sizeof(State) / sizeof(GLuint); ++i)
+	{
+		lData[i] = kUnknown;
+	}
+}
+
+void StateCache::useProgram(const GLuint program) noexcept
+{
+	if (change(sState.program, program))
+	{
+		++FrameSample::current().programBinds;
+		glUseProgram(program);
+	}
+}
+
+void StateCache::bindVertexArray(const GLuint vertexArray) noexcept
+{
+	if (change(sState.vertexArray, vertexArray))
+	{
+		glBindVertexArray(vertexArray);
+	}
+}
+
+void StateCache::activeTexture(const GLuint unit) noexcept
+{
+	if (change(sState.activeTexture, unit))
+	{
+		glActiveTexture(GL_TEXTURE0 + unit);
+	}
+}
+
+void StateCache::bindTexture(const GLenum target, const GLuint texture) noexcept
+{
+	const auto lTarget = textureTargetIndex(target);
+	const auto lUnit = sState.activeTexture;
+	if (lTarget < 0 || lUnit >= kMaxTextureUnits)
+	{
+		++FrameSample::current().textureBinds;
+		glBindTexture(target, texture);
+		return;
+	}
+	if (change(sState.textures[lUnit][lTarget], texture))
+	{
+		++FrameSample::current().textureBinds;
+		glBindTexture(target, texture);
+	}
+}
+
+void StateCache::bindTexture(const GLuint unit, const GLenum target,
+	const GLuint texture) noexcept
+{
+	const auto lTarget = textureTargetIndex(target);
+	if (lTarget >= 0 && unit < kMaxTextureUnits
+		&& sState.textures[unit][lTarget] == texture)
+	{
+		++FrameSample::current().elidedStateChanges;
+		return;
+	}
+	activeTexture(unit);
+	bindTexture(target, texture);
+}
+
+void StateCache::bindFramebuffer(const GLenum target,
+	const GLuint framebuffer) noexcept
+{
+	switch (target)
+	{
+		case GL_DRAW_FRAMEBUFFER:
+			if (change(sState.drawFramebuffer, framebuffer))
+			{
+				glBindFramebuffer(target, framebuffer);
+			}
+			break;
+		case GL_READ_FRAMEBUFFER:
+			if (change(sState.readFramebuffer, framebuffer))
+			{
+				glBindFramebuffer(target, framebuffer);
+			}
+			break;
+		default:
+			if (sState.drawFramebuffer == framebuffer
+				&& sState.readFramebuffer == framebuffer)
+			{
+				++FrameSample::current().elidedStateChanges;
+				break;
+			}
+			sState.drawFramebuffer = sState.readFramebuffer = framebuffer;
+			glBindFramebuffer(target, framebuffer);
+	}
+}
+
+void StateCache::bindBufferBase(const GLenum target, const GLuint index,
+	const GLuint buffer) noexcept
+{
+	if (target != GL_UNIFORM_BUFFER || index >= kMaxUniformBufferBindings
+		|| changeUniformBuffer(index, buffer, 0, 0))
+	{
+		glBindBufferBase(target, index, buffer);
+	}
+}
+
+void StateCache::bindBufferRange(const GLenum target, const GLuint index,
+	const GLuint buffer, const GLintptr offset, const GLsizeiptr size) noexcept
+{
+	if (target != GL_UNIFORM_BUFFER || index >= kMaxUniformBufferBindings
+		|| changeUniformBuffer(index, buffer, offset, size))
+	{
+		glBindBufferRange(target, index, buffer, offset, size);
+	}
+}
+
+void StateCache::enable(const GLenum cap) noexcept
+{
+	const auto lCapability = capability(cap);
+	if (!lCapability || change(*lCapability, GL_TRUE)) glEnable(cap);
+}
+
+void StateCache::disable(const GLenum cap) noexcept
+{
+	const auto lCapability = capability(cap);
+	if (!lCapability || change(*lCapability, GL_FALSE)) glDisable(cap);
+}
+
+void StateCache::blendFunc(const GLenum source,
+	const GLenum destination) noexcept
+{
+	if (sState.blendSource == source && sState.blendDestination == destination)
+	{
+		++FrameSample::current().elidedStateChanges;
+		return;
+	}
+	sState.blendSource = source;
+	sState.blendDestination = destination;
+	glBlendFunc(source, destination);
+}
+
+void StateCache::blendEquation(const GLenum mode) noexcept
+{
+	if (change(sState.blendEquation, mode)) glBlendEquation(mode);
+}
+
+void StateCache::depthFunc(const GLenum function) noexcept
+{
+	if (change(sState.depthFunc, function)) glDepthFunc(function);
+}
+
+void StateCache::depthMask(const GLboolean flag) noexcept
+{
+	if (change(sState.depthMask, flag)) glDepthMask(flag);
+}
+
+void StateCache::cullFace(const GLenum mode) noexcept
+{
+	if (change(sState.cullFace, mode)) glCullFace(mode);
+}
+
+void StateCache::frontFace(const GLenum mode) noexcept
+{
+	if (change(sState.frontFace, mode)) glFrontFace(mode);
+}
+
+void StateCache::polygonMode(const GLenum face, const GLenum mode) noexcept
+{
+	if (face != GL_FRONT_AND_BACK)
+	{
+		sState.polygonMode = kUnknown;
+		glPolygonMode(face, mode);
+	}
+	else if (change(sState.polygonMode, mode))
+	{
+		glPolygonMode(face, mode);
+	}
+}
+
+void StateCache::stencilFunc(const GLenum function, const GLint reference,
+	const GLuint mask) noexcept
+{
+	const auto lReference = static_cast<GLuint>(reference);
+	if (sState.stencilFunc == function && sState.stencilReference == lReference
+		&& sState.stencilMask == mask)
+	{
+		++FrameSample::current().elidedStateChanges;
+		return;
+	}
+	sState.stencilFunc = function;
+	sState.stencilReference = lReference;
+	sState.stencilMask = mask;
+	glStencilFunc(function, reference, mask);
+}
+
+void StateCache::stencilOp(const GLenum stencilFail, const GLenum depthFail,
+	const GLenum depthPass) noexcept
+{
+	if (sameStencilOp(0, stencilFail, depthFail, depthPass)
+		&& sameStencilOp(1, stencilFail, depthFail, depthPass))
+	{
+		++FrameSample::current().elidedStateChanges;
+		return;
+	}
+	setStencilOp(0, stencilFail, depthFail, depthPass);
+	setStencilOp(1, stencilFail, depthFail, depthPass);
+	glStencilOp(stencilFail, depthFail, depthPass);
+}
+
+void StateCache::stencilOpSeparate(const GLenum face, const GLenum stencilFail,
+	const GLenum depthFail, const GLenum depthPass) noexcept
+{
+	const bool lFront = face == GL_FRONT || face == GL_FRONT_AND_BACK;
+	const bool lBack = face == GL_BACK || face == GL_FRONT_AND_BACK;
+	if ((!lFront || sameStencilOp(0, stencilFail, depthFail, depthPass))
+		&& (!lBack || sameStencilOp(1, stencilFail, depthFail, depthPass)))
+	{
+		++FrameSample::current().elidedStateChanges;
+		return;
+	}
+	if (lFront) setStencilOp(0, stencilFail, depthFail, depthPass);
+	if (lBack) setStencilOp(1, stencilFail, depthFail, depthPass);
+	glStencilOpSeparate(face, stencilFail, depthFail, depthPass);
+}
+
+void StateCache::deleteProgram(const GLuint program) noexcept
+{
+	// A program that is in use is only deleted once it is no longer in
+	// use, after which its name can be reused.
+	if (program && sState.program == program) sState.program = kUnknown;
+	glDeleteProgram(program);
+}
+
+void StateCache::deleteBuffers(const GLsizei count,
+	const GLuint* buffers) noexcept
+{
+	for (GLsizei i = 0; i < count; ++i)
+	{
+		if (!buffers[i]) continue;
+		for (auto& lBinding : sState.uniformBuffers)
+		{
+			if (lBinding[0] == buffers[i]) lBinding[0] = 0;
+		}
+	}
+	glDeleteBuffers(count, buffers);
+}
+
+void StateCache::deleteVertexArrays(const GLsizei count,
+	const GLuint* vertexArrays) noexcept
+{
+	for (GLsizei i = 0; i < count; ++i)
+	{
+		if (vertexArrays[i] && sState.vertexArray == vertexArrays[i])
+		{
+			sState.vertexArray = 0;
+		}
+	}
+	glDeleteVertexArrays(count, vertexArrays);
+}
+
+void StateCache::deleteTextures(const GLsizei count,
+	const GLuint* textures) noexcept
+{
+	for (GLsizei i = 0; i < count; ++i)
+	{
+		if (!textures[i]) continue;
+		for (auto& lUnit : sState.textures)
+		{
+			for (auto& lBinding : lUnit)
+			{
+				if (lBinding == textures[i]) lBinding = 0;
+			}
+		}
+	}
+	glDeleteTextures(count, textures);
+}
+
+void StateCache::deleteFramebuffers(const GLsizei count,
+	const GLuint* framebuffers) noexcept
+{
+	for (GLsizei i = 0; i < count; ++i)
+	{
+		if (!framebuffers[i]) continue;
+		if (sState.drawFramebuffer == framebuffers[i])
+		{
+			sState.drawFramebuffer = 0;
+		}
+		if (sState.readFramebuffer == framebuffers[i])
+		{
+			sState.readFramebuffer = 0;
+		}
+	}
+	glDeleteFramebuffers(count, framebuffers);
+}
+
+} // namespace OpenGL
+} // namespace gintonic
@@ -11,7 +11,7 @@ TextureObject::TextureObject() : mHandle(0)
 
 TextureObject& TextureObject::operator=(TextureObject&& other) noexcept
 {
-	glDeleteTextures(1, &mHandle);
+	StateCache::deleteTextures(1, &mHandle);
 	mHandle = other.mHandle;
 	other.mHandle = 0;
 	return *this;
@@ -0,0 +1,95 @@
+#include "Graphics/OpenGL/UniformRingBuffer.hpp"
+#include "Graphics/OpenGL/StateCache.hpp"
+#include "Graphics/FrameStatistics.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace { // anonymous namespace
+
+inline GLintptr alignUp(const GLintptr value, const GLintptr alignment) noexcept
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+} // anonymous namespace
+
+namespace gintonic {
+namespace OpenGL {
+
+UniformRingBuffer::UniformRingBuffer(const GLsizeiptr capacity)
+: mBuffer(GL_UNIFORM_BUFFER, static_cast<GLsizei>(capacity), nullptr,
+	GL_STREAM_DRAW)
+, mCapacity(capacity)
+{
+	GLint lAlignment = 0;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &lAlignment);
+
+	// std140 blocks are aligned to a vec4 anyway.
+	mAlignment = lAlignment < 16 ? 16 : lAlignment;
+}
+
+GLintptr UniformRingBuffer::allocate(const GLsizeiptr size,
+	const GLsizeiptr reserve)
+{
+	const auto lOffset = alignUp(mNext, mAlignment);
+	mNext = lOffset + size;
+	const auto lEnd = lOffset + std::max(size, reserve);
+	if (mEnd < lEnd)
+	{
+		mEnd = lEnd;
+		// Newly reserved bytes are zero, so that a shader never reads
+		// garbage beyond the staged data.
+		mStaging.resize(static_cast<std::size_t>(mEnd), 0);
+	}
+	return lOffset;
+}
+
+GLintptr UniformRingBuffer::stage(const GLvoid* data, const GLsizeiptr size,
+	const GLsizeiptr reserve)
+{
+	const auto lOffset = allocate(size, reserve);
+	std::memcpy(at(lOffset), data, static_cast<std::size_t>(size));
+	return lOffset;
+}
+
+void UniformRingBuffer::upload()
+{
+	if (!mEnd) return;
+
+	glBindBuffer(GL_UNIFORM_BUFFER, mBuffer);
+	mHead = alignUp(mHead, mAlignment);
+	if (mCapacity < mEnd)
+	{
+		while (mCapacity < mEnd) mCapacity *= 2;
+		glBufferData(GL_UNIFORM_BUFFER, mCapacity, nullptr, GL_STREAM_DRAW);
+		mHead = 0;
+	}
+	else if (mCapacity < mHead + mEnd)
+	{
+		// Orphan the storage. The GPU keeps reading the old storage for
+		// the draw calls that are in flight.
+		glBufferData(GL_UNIFORM_BUFFER, mCapacity, nullptr, GL_STREAM_DRAW);
+		mHead = 0;
+	}
+	glBufferSubData(GL_UNIFORM_BUFFER, mHead, mEnd, mStaging.data());
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	auto& lSample = FrameSample::current();
+	++lSample.uniformUploads;
+	lSample.uniformBufferBytes += static_cast<std::size_t>(mEnd);
+
+	mBase = mHead;
+	mHead += mEnd;
+	mNext = mEnd = 0;
+	mStaging.clear();
+}
+
+void UniformRingBuffer::bindRange(const GLuint index, const GLintptr offset,
+	const GLsizeiptr size) const noexcept
+{
+	StateCache::bindBufferRange(GL_UNIFORM_BUFFER, index, mBuffer,
+		mBase + offset, size);
+}
+
+} // namespace OpenGL
+} // namespace gintonic
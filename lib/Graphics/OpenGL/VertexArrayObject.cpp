@@ -12,7 +12,7 @@ VertexArrayObject::VertexArrayObject() : mHandle(0)
 VertexArrayObject& VertexArrayObject::operator = (VertexArrayObject&& other)
 	noexcept
 {
-	glDeleteVertexArrays(1, &mHandle);
+	StateCache::deleteVertexArrays(1, &mHandle);
 	mHandle = other.mHandle;
 	other.mHandle = 0;
 	return *this;
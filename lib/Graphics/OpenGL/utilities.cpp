@@ -1,4 +1,5 @@
 #include "Graphics/OpenGL/utilities.hpp"
+#include "Graphics/FrameStatistics.hpp"
 #include "Math/mat2f.hpp"
 #include "Math/mat3f.hpp"
 #include "Math/mat4f.hpp"
@@ -13,26 +14,31 @@ namespace OpenGL
 
 void setUniform(const GLint location, const GLint value) noexcept
 {
+    ++FrameSample::current().uniformUploads;
     glUniform1i(location, value);
 }
 
 void setUniform(const GLint location, const GLfloat value) noexcept
 {
+    ++FrameSample::current().uniformUploads;
     glUniform1f(location, value);
 }
 
 void setUniform(const GLint location, const vec2f& value) noexcept
 {
+    ++FrameSample::current().uniformUploads;
     glUniform2f(location, value.x, value.y);
 }
 
 void setUniform(const GLint location, const vec3f& value) noexcept
 {
+    ++FrameSample::current().uniformUploads;
     glUniform3f(location, value.x, value.y, value.z);
 }
 
 void setUniform(const GLint location, const vec4f& value) noexcept
 {
+    ++FrameSample::current().uniformUploads;
     glUniform4f(location, value.x, value.y, value.z, value.w);
 }
 
@@ -43,34 +49,40 @@ void setUniform(const GLint location, const mat2f& value) noexcept
 
 void setUniform(const GLint location, const mat3f& value) noexcept
 {
+    ++FrameSample::current().uniformUploads;
     glUniformMatrix3fv(location, 1, GL_FALSE, value.value_ptr());
 }
 
 void setUniform(const GLint location, const mat4f& value) noexcept
 {
+    ++FrameSample::current().uniformUploads;
     glUniformMatrix4fv(location, 1, GL_FALSE, value.value_ptr());
 }
 
 void setUniform(const GLint location,
                 const std::vector<GLfloat>& values) noexcept
 {
+    ++FrameSample::current().uniformUploads;
     glUniform1fv(location, static_cast<GLsizei>(values.size()), values.data());
 }
 
 void setUniform(const GLint location, const std::vector<GLint>& values) noexcept
 {
+    ++FrameSample::current().uniformUploads;
     glUniform1iv(location, static_cast<GLsizei>(values.size()), values.data());
 }
 
 void setUniform(const GLint location,
                 const std::vector<mat4f, allocator<mat4f>>& values) noexcept
 {
+    ++FrameSample::current().uniformUploads;
     glUniformMatrix4fv(location, static_cast<GLsizei>(values.size()), GL_FALSE,
                        (const GLfloat*)values[0].value_ptr());
 }
 
 void setUniform(const GLint location, const std::vector<mat3f>& values) noexcept
 {
+    ++FrameSample::current().uniformUploads;
     glUniformMatrix3fv(location, static_cast<GLsizei>(values.size()), GL_FALSE,
                        (const GLfloat*)values[0].value_ptr());
 }
@@ -1,11 +1,13 @@
 #include "Graphics/PointLight.hpp"
 
 #include "Math/SQT.hpp"
+#include "Math/sphere3f.hpp"
 
 #include "Graphics/Mesh.hpp"
 #include "Graphics/PointShadowBuffer.hpp"
 #include "Graphics/Renderer.hpp"
 #include "Graphics/ShaderPrograms.hpp"
+#include "Graphics/SkinnedPositions.hpp"
 
 #include "Camera.hpp"
 #include "Entity.hpp"
@@ -41,6 +43,16 @@ void PointLight::setAttenuation(const vec4f& att)
 
 vec4f PointLight::getAttenuation() const noexcept { return mAttenuation; }
 
+bool PointLight::getBoundingSphere(const Entity& lightEntity,
+                                   sphere3f& sphere) const noexcept
+{
+    if (mCutoffRadius <= 0.0f) return false;
+    sphere.center =
+        (lightEntity.globalTransform() * vec4f(0.0f, 0.0f, 0.0f, 1.0f)).data;
+    sphere.radius = mCutoffRadius;
+    return true;
+}
+
 void PointLight::shine(const Entity& lightEntity,
                        const std::vector<std::shared_ptr<Entity>>&
                            shadowCastingGeometryEntities) const noexcept
@@ -62,13 +74,15 @@ void PointLight::shine(const Entity& lightEntity,
         // just a tiny bit "away" from the original geometry. It's possible to
         // do this in the geometry shader, but I find this a more elegant
         // solution.
-        glEnable(GL_POLYGON_OFFSET_FILL);
+        OpenGL::StateCache::enable(GL_POLYGON_OFFSET_FILL);
         glPolygonOffset(1.0f, 1.0f);
 
         Renderer::beginStencilPass();
-        glStencilFunc(GL_ALWAYS, 0, 0xff);
-        glStencilOpSeparate(GL_BACK, GL_KEEP, GL_INCR_WRAP, GL_KEEP);
-        glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_DECR_WRAP, GL_KEEP);
+        OpenGL::StateCache::stencilFunc(GL_ALWAYS, 0, 0xff);
+        OpenGL::StateCache::stencilOpSeparate(GL_BACK, GL_KEEP, GL_INCR_WRAP,
+                                              GL_KEEP);
+        OpenGL::StateCache::stencilOpSeparate(GL_FRONT, GL_KEEP, GL_DECR_WRAP,
+                                              GL_KEEP);
         glClear(GL_STENCIL_BUFFER_BIT); // Clear the stencil buffer.
 
         lShadowVolumeProgram.activate();
@@ -77,7 +91,16 @@ void PointLight::shine(const Entity& lightEntity,
         const auto lMatrixPV =
             Renderer::getCameraEntity()->camera->projectionMatrix() *
             Renderer::matrix_V();
-        for (const auto lGeometryEntity : shadowCastingGeometryEntities)
+        // A caster outside the cutoff radius casts its shadow volume further
+        // away from the light, where nothing is lit anyway.
+        sphere3f lSphere;
+        const auto& lCasters =
+            getBoundingSphere(lightEntity, lSphere)
+                ? Renderer::cullShadowCasters(lightEntity, lSphere,
+                                              shadowCastingGeometryEntities)
+                : Renderer::cullShadowCasters(lightEntity,
+                                              shadowCastingGeometryEntities);
+        for (const auto lGeometryEntity : lCasters)
         {
             // Go from world space to the local space of the mesh.
             lLightPosInLocalCoordinates =
@@ -86,19 +109,24 @@ void PointLight::shine(const Entity& lightEntity,
             lShadowVolumeProgram.setLightPosition(lLightPosInLocalCoordinates);
             lShadowVolumeProgram.setMatrixPVM(
                 lMatrixPV * lGeometryEntity->globalTransform());
-            lGeometryEntity->mesh->drawAdjacent();
+            const auto lSkinned = Renderer::skinnedPositions(*lGeometryEntity);
+            if (lSkinned)
+                lSkinned->drawAdjacent();
+            else
+                lGeometryEntity->mesh->drawAdjacent();
         }
 
-        glStencilFunc(
+        OpenGL::StateCache::stencilFunc(
             GL_EQUAL, 0x0,
             0xff); // Draw only if the corresponding stencil value is zero.
-        glStencilOp(GL_KEEP, GL_KEEP,
-                    GL_KEEP); // Prevent update to the stencil buffer.
+        OpenGL::StateCache::stencilOp(
+            GL_KEEP, GL_KEEP,
+            GL_KEEP); // Prevent update to the stencil buffer.
         Renderer::endStencilPass();
 
         // Restore original state. Here we implicitly assume that the default
         // state is to apply no polygon offset.
-        glDisable(GL_POLYGON_OFFSET_FILL);
+        OpenGL::StateCache::disable(GL_POLYGON_OFFSET_FILL);
 
         // Move the light from world space to view space. Here, lLightPos
         // is already in world space. So just apply the view matrix.
@@ -0,0 +1,51 @@
+#include "Graphics/PosePool.hpp"
+
+namespace gintonic
+{
+
+PosePool::Handle::Handle(PosePool& pool,
+                         std::unique_ptr<SQTArray> pose) noexcept
+    : mPool(&pool), mPose(std::move(pose))
+{
+    /* Empty on purpose. */
+}
+
+PosePool::Handle& PosePool::Handle::operator=(Handle&& other) noexcept
+{
+    if (this == &other) return *this;
+    if (mPose) mPool->release(std::move(mPose));
+    mPool = other.mPool;
+    mPose = std::move(other.mPose);
+    return *this;
+}
+
+PosePool::Handle::~Handle()
+{
+    if (mPose) mPool->release(std::move(mPose));
+}
+
+PosePool::Handle PosePool::acquire(const std::size_t jointCount)
+{
+    std::unique_ptr<SQTArray> lPose;
+    if (mFree.empty())
+    {
+        lPose.reset(new SQTArray(jointCount));
+        ++mSize;
+        // So that giving the buffer back never allocates.
+        mFree.reserve(mSize);
+    }
+    else
+    {
+        lPose = std::move(mFree.back());
+        mFree.pop_back();
+        if (lPose->size() != jointCount) lPose->resize(jointCount);
+    }
+    return Handle(*this, std::move(lPose));
+}
+
+void PosePool::release(std::unique_ptr<SQTArray> pose)
+{
+    mFree.push_back(std::move(pose));
+}
+
+} // namespace gintonic
@@ -0,0 +1,192 @@
+#include "Graphics/RenderLists.hpp"
+#include "Entity.hpp"
+#include "Graphics/Light.hpp"
+#include "Graphics/PointLight.hpp"
+#include "Graphics/ShadowBuffer.hpp"
+#include "Graphics/SpotLight.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace gintonic
+{
+
+RenderLists::~RenderLists() noexcept
+{
+    for (auto& lPair : mRegistrations) lPair.second.connection.disconnect();
+}
+
+RenderLists::LightKind RenderLists::lightKind(const Light* light) noexcept
+{
+    // Catch SpotLight before PointLight, because SpotLight inherits from
+    // PointLight.
+    if (!light) return kNoLight;
+    if (dynamic_cast<const SpotLight*>(light)) return kSpotLight;
+    if (dynamic_cast<const PointLight*>(light)) return kPointLight;
+    return kOtherLight;
+}
+
+void RenderLists::add(std::shared_ptr<Entity> entity)
+{
+    const auto lEntity = entity.get();
+    if (!lEntity || mRegistrations.count(lEntity)) return;
+    auto& lRegistration = mRegistrations[lEntity];
+    lRegistration.entity = std::move(entity);
+    lRegistration.connection = lEntity->onRenderStateChange.connect(
+        [this](Entity* e) { markChanged(e); });
+    markChanged(lEntity);
+}
+
+void RenderLists::addRecursive(const std::shared_ptr<Entity>& entity)
+{
+    if (!entity) return;
+    add(entity);
+    for (const auto& lChild : *entity) addRecursive(lChild);
+}
+
+void RenderLists::remove(const Entity* entity)
+{
+    const auto lIter = mRegistrations.find(entity);
+    if (lIter == mRegistrations.end()) return;
+    unlink(lIter->second);
+    lIter->second.connection.disconnect();
+    if (lIter->second.changed)
+    {
+        mChanged.erase(std::find(mChanged.begin(), mChanged.end(), entity));
+    }
+    mRegistrations.erase(lIter);
+}
+
+void RenderLists::removeRecursive(const std::shared_ptr<Entity>& entity)
+{
+    if (!entity) return;
+    for (const auto& lChild : *entity) removeRecursive(lChild);
+    remove(entity.get());
+}
+
+void RenderLists::markChanged(const Entity* entity)
+{
+    const auto lIter = mRegistrations.find(entity);
+    if (lIter == mRegistrations.end() || lIter->second.changed) return;
+    lIter->second.changed = true;
+    mChanged.push_back(entity);
+}
+
+std::size_t RenderLists::update()
+{
+    const auto lResult = mChanged.size();
+    for (const auto lEntity : mChanged)
+    {
+        auto& lRegistration = mRegistrations.find(lEntity)->second;
+        unlink(lRegistration);
+        link(lRegistration);
+        lRegistration.changed = false;
+    }
+    mChanged.clear();
+    return lResult;
+}
+
+void RenderLists::clear() noexcept
+{
+    for (auto& lPair : mRegistrations) lPair.second.connection.disconnect();
+    mRegistrations.clear();
+    mChanged.clear();
+    for (auto& lBucket : mBuckets) lBucket.clear();
+}
+
+void RenderLists::link(Registration& registration)
+{
+    auto& lEntity = *registration.entity;
+
+    // Only look at the type of the light when the light itself has changed.
+    if (registration.light != lEntity.light)
+    {
+        registration.light = lEntity.light;
+        registration.lightKind = lightKind(registration.light.get());
+    }
+
+    if (lEntity.castShadow)
+    {
+        switch (registration.lightKind)
+        {
+        case kNoLight:
+            break;
+        case kPointLight:
+            // Point lights need to be treated separately.
+            registration.lightBucket =
+                FrameSample::kBucketShadowCastingPointLights;
+            break;
+        default:
+            // Treat all other light types as if they apply the shadow map
+            // algorithm.
+            registration.lightBucket = FrameSample::kBucketShadowCastingLights;
+            if (!lEntity.shadowBuffer)
+            {
+                lEntity.light->initializeShadowBuffer(lEntity);
+            }
+            assert(lEntity.shadowBuffer);
+            break;
+        }
+        if (lEntity.material && lEntity.mesh)
+        {
+            registration.geometryBucket =
+                FrameSample::kBucketShadowCastingGeometry;
+        }
+    }
+    else // non-shadow casting entity
+    {
+        if (registration.lightKind != kNoLight)
+        {
+            registration.lightBucket =
+                FrameSample::kBucketNonShadowCastingLights;
+            // A non-shadow casting light does not need its shadow buffer.
+            lEntity.shadowBuffer.reset();
+        }
+        if (lEntity.material && lEntity.mesh)
+        {
+            registration.geometryBucket =
+                FrameSample::kBucketNonShadowCastingGeometry;
+        }
+    }
+
+    if (registration.lightBucket != -1)
+    {
+        registration.lightIndex = mBuckets[registration.lightBucket].size();
+        mBuckets[registration.lightBucket].push_back(registration.entity);
+    }
+    if (registration.geometryBucket != -1)
+    {
+        registration.geometryIndex =
+            mBuckets[registration.geometryBucket].size();
+        mBuckets[registration.geometryBucket].push_back(registration.entity);
+    }
+}
+
+void RenderLists::unlink(Registration& registration)
+{
+    if (registration.lightBucket != -1)
+    {
+        erase(registration.lightBucket, registration.lightIndex);
+        registration.lightBucket = -1;
+    }
+    if (registration.geometryBucket != -1)
+    {
+        erase(registration.geometryBucket, registration.geometryIndex);
+        registration.geometryBucket = -1;
+    }
+}
+
+void RenderLists::erase(const int bucket, const std::size_t index)
+{
+    // Move the last entity of the bucket into the hole, and fix its index.
+    auto& lBucket = mBuckets[bucket];
+    if (index + 1 != lBucket.size())
+    {
+        lBucket[index] = std::move(lBucket.back());
+        auto& lMoved = mRegistrations.find(lBucket[index].get())->second;
+        if (lMoved.lightBucket == bucket) lMoved.lightIndex = index;
+        else lMoved.geometryIndex = index;
+    }
+    lBucket.pop_back();
+}
+
+} // namespace gintonic
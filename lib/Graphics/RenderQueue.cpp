@@ -0,0 +1,150 @@
+#include "Graphics/RenderQueue.hpp"
+#include <algorithm>
+
+namespace gintonic
+{
+
+constexpr int RenderQueue::kDepthBits;
+constexpr int RenderQueue::kMeshBits;
+constexpr int RenderQueue::kMaterialBits;
+constexpr int RenderQueue::kPermutationBits;
+constexpr int RenderQueue::kPassBits;
+
+namespace
+{
+
+constexpr int kDepthShift = 0;
+constexpr int kMeshShift = kDepthShift + RenderQueue::kDepthBits;
+constexpr int kMaterialShift = kMeshShift + RenderQueue::kMeshBits;
+constexpr int kPermutationShift = kMaterialShift + RenderQueue::kMaterialBits;
+constexpr int kPassShift = kPermutationShift + RenderQueue::kPermutationBits;
+
+static_assert(kPassShift + RenderQueue::kPassBits == 64,
+              "The fields of a key must add up to 64 bits.");
+
+constexpr std::uint64_t mask(const int bits) noexcept
+{
+    return (std::uint64_t(1) << bits) - 1;
+}
+
+// The radix sort sorts on one byte at a time.
+constexpr int kRadixBits = 8;
+constexpr int kRadixSize = 1 << kRadixBits;
+constexpr int kRadixPasses = 64 / kRadixBits;
+
+} // anonymous namespace
+
+std::uint64_t RenderQueue::makeKey(const Pass pass,
+                                   const std::uint32_t permutation,
+                                   const std::uint32_t material,
+                                   const std::uint32_t mesh,
+                                   const std::uint32_t depth) noexcept
+{
+    return ((std::uint64_t(pass) & mask(kPassBits)) << kPassShift) |
+           ((std::uint64_t(permutation) & mask(kPermutationBits))
+            << kPermutationShift) |
+           ((std::uint64_t(material) & mask(kMaterialBits)) << kMaterialShift) |
+           ((std::uint64_t(mesh) & mask(kMeshBits)) << kMeshShift) |
+           ((std::uint64_t(depth) & mask(kDepthBits)) << kDepthShift);
+}
+
+std::uint32_t RenderQueue::quantizeDepth(const float depth,
+                                         const float nearPlane,
+                                         const float farPlane) noexcept
+{
+    const auto lRange = farPlane - nearPlane;
+    if (!(lRange > 0.0f)) return 0;
+    auto lNormalized = (depth - nearPlane) / lRange;
+    lNormalized = std::min(std::max(lNormalized, 0.0f), 1.0f);
+    return static_cast<std::uint32_t>(lNormalized *
+                                      static_cast<float>(mask(kDepthBits)));
+}
+
+RenderQueue::Pass RenderQueue::pass(const std::uint64_t key) noexcept
+{
+    return static_cast<Pass>((key >> kPassShift) & mask(kPassBits));
+}
+
+std::uint32_t RenderQueue::permutation(const std::uint64_t key) noexcept
+{
+    return static_cast<std::uint32_t>((key >> kPermutationShift) &
+                                      mask(kPermutationBits));
+}
+
+std::uint32_t RenderQueue::material(const std::uint64_t key) noexcept
+{
+    return static_cast<std::uint32_t>((key >> kMaterialShift) &
+                                      mask(kMaterialBits));
+}
+
+std::uint32_t RenderQueue::mesh(const std::uint64_t key) noexcept
+{
+    return static_cast<std::uint32_t>((key >> kMeshShift) & mask(kMeshBits));
+}
+
+std::uint32_t RenderQueue::depth(const std::uint64_t key) noexcept
+{
+    return static_cast<std::uint32_t>((key >> kDepthShift) & mask(kDepthBits));
+}
+
+std::uint32_t RenderQueue::materialId(const void* material)
+{
+    const auto lId = static_cast<std::uint32_t>(mMaterialIds.size());
+    return mMaterialIds.emplace(material, lId).first->second;
+}
+
+std::uint32_t RenderQueue::meshId(const void* mesh)
+{
+    const auto lId = static_cast<std::uint32_t>(mMeshIds.size());
+    return mMeshIds.emplace(mesh, lId).first->second;
+}
+
+void RenderQueue::sort()
+{
+    if (mItems.size() < 2) return;
+
+    // Build the histograms of all the bytes in a single sweep.
+    std::size_t lCounts[kRadixPasses][kRadixSize] = {};
+    for (const auto& lItem : mItems)
+    {
+        for (int p = 0; p < kRadixPasses; ++p)
+        {
+            ++lCounts[p][(lItem.key >> (p * kRadixBits)) & (kRadixSize - 1)];
+        }
+    }
+
+    mScratch.resize(mItems.size());
+    for (int p = 0; p < kRadixPasses; ++p)
+    {
+        auto& lCount = lCounts[p];
+
+        // If every key has the same byte here, this pass would not move
+        // anything. That is the common case for the high bytes.
+        const auto lByte =
+            (mItems.front().key >> (p * kRadixBits)) & (kRadixSize - 1);
+        if (lCount[lByte] == mItems.size()) continue;
+
+        std::size_t lOffset = 0;
+        for (auto& c : lCount)
+        {
+            const auto lTemp = c;
+            c = lOffset;
+            lOffset += lTemp;
+        }
+        for (const auto& lItem : mItems)
+        {
+            const auto b = (lItem.key >> (p * kRadixBits)) & (kRadixSize - 1);
+            mScratch[lCount[b]++] = lItem;
+        }
+        mItems.swap(mScratch);
+    }
+}
+
+void RenderQueue::clear() noexcept
+{
+    mItems.clear();
+    mMaterialIds.clear();
+    mMeshIds.clear();
+}
+
+} // namespace gintonic
@@ -3,19 +3,30 @@
 #include "Graphics/GUI/Base.hpp"
 
 #include "Foundation/Octree.hpp"
+#include "Foundation/WorkerPool.hpp"
 #include "Foundation/exception.hpp"
+#include "Math/Intersections.hpp"
 #include "Math/MatrixPipeline.hpp"
+#include "Math/frustum3f.hpp"
 #include "Math/vec4f.hpp"
 
 #include "Graphics/AnimationClip.hpp"
+#include "Graphics/DrawCommands.hpp"
+#include "Graphics/GPUFrameTimer.hpp"
 #include "Graphics/GeometryBuffer.hpp"
 #include "Graphics/Light.hpp"
 #include "Graphics/Material.hpp"
 #include "Graphics/Mesh.hpp"
 #include "Graphics/PointLight.hpp"
+#include "Graphics/RenderLists.hpp"
+#include "Graphics/RenderQueue.hpp"
+#include "Graphics/OpenGL/StateCache.hpp"
+#include "Graphics/OpenGL/UniformRingBuffer.hpp"
 #include "Graphics/ShaderPrograms.hpp"
 #include "Graphics/ShadowBuffer.hpp"
 #include "Graphics/Skeleton.hpp"
+#include "Graphics/SkinnedPositions.hpp"
+#include "Graphics/SkinningCache.hpp"
 #include "Graphics/SpotLight.hpp"
 
 #include "Camera.hpp"
@@ -33,7 +44,11 @@
 #pragma clang diagnostic pop
 #endif // __clang__
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 
 #ifdef BOOST_MSVC
 #include <Objbase.h> // for CoInitializeEx
@@ -76,6 +91,107 @@ std::vector<std::shared_ptr<Entity>> sShadowCastingGeometryEntities;
 std::vector<std::shared_ptr<Entity>> sNonShadowCastingLightEntities;
 std::vector<std::shared_ptr<Entity>> sNonShadowCastingGeometryEntities;
 
+// The registered entities. These are rendered every frame without being
+// submitted.
+RenderLists sRenderLists;
+
+// The entities of this frame, per FrameSample::Bucket. These point to the
+// retained render lists when nothing was submitted this frame, and to the
+// submitted entities otherwise.
+const std::vector<std::shared_ptr<Entity>>*
+    sFrameEntities[FrameSample::kBucketCount];
+
+inline const std::vector<std::shared_ptr<Entity>>&
+frameEntities(const FrameSample::Bucket bucket) noexcept
+{
+    return *sFrameEntities[bucket];
+}
+
+// The geometry that survives the culling stage.
+std::vector<std::shared_ptr<Entity>> sVisibleShadowCastingGeometryEntities;
+std::vector<std::shared_ptr<Entity>> sVisibleNonShadowCastingGeometryEntities;
+
+// The lights that survive the culling stage.
+std::vector<std::shared_ptr<Entity>> sVisibleShadowCastingLightEntities;
+std::vector<std::shared_ptr<Entity>> sVisibleShadowCastingPointLightEntities;
+std::vector<std::shared_ptr<Entity>> sVisibleNonShadowCastingLightEntities;
+
+// The shadow casters that Renderer::cullShadowCasters returns.
+std::vector<std::shared_ptr<Entity>> sShadowCasters;
+
+// Scratch space of the culling stage.
+std::vector<box3f, allocator<box3f>> sCullingBoxes;
+std::vector<std::uint8_t> sCullingVisibility;
+std::vector<std::shared_ptr<const Entity>> sCullingQueryResult;
+std::unordered_set<const Entity*> sCullingVisibleSet;
+
+// The visible geometry of this frame, sorted by draw key. The indices of the
+// queue refer into sGeometryQueueEntities.
+RenderQueue sGeometryQueue;
+std::vector<Entity*> sGeometryQueueEntities;
+
+// The threads that build the draw packets and evaluate the joint palettes.
+std::unique_ptr<WorkerPool> sWorkers;
+
+// The joint palettes of the animated entities of this frame. They are
+// evaluated once and uploaded to sJointBlocks, and every pass that draws a
+// skinned mesh binds the range of its entity.
+std::unique_ptr<SkinningCache> sSkinning;
+std::unique_ptr<OpenGL::UniformRingBuffer> sJointBlocks;
+std::vector<GLintptr> sPaletteBlockOffsets;
+GLintptr sDefaultJointBlockOffset = 0;
+
+// The adjacent positions of the skinned shadow casters, skinned on the CPU
+// for the shadow volumes of the point lights. A stream that is not used in
+// a frame is dropped.
+struct SkinnedStream
+{
+    std::unique_ptr<SkinnedPositions> positions;
+    bool used = false;
+};
+std::unordered_map<const Entity*, SkinnedStream> sSkinnedPositions;
+
+// The per-draw packets of the geometry queue, built in parallel.
+std::unique_ptr<DrawCommandBuffer> sDrawCommands;
+
+// The uniform blocks of the geometry queue. They are staged and uploaded in
+// one go, and every draw binds its own range of the buffer.
+std::unique_ptr<OpenGL::UniformRingBuffer> sUniformBlocks;
+
+// A run of draws that share permutation, material and mesh. Runs are drawn
+// with a single instanced draw call when possible.
+struct DrawRun
+{
+    std::size_t begin;
+    std::size_t end;
+    bool instanced;
+    GLintptr material; // Offset of the MaterialBlock.
+};
+
+std::vector<DrawRun> sDrawRuns;
+std::vector<GLintptr> sObjectBlockOffsets; // Per draw that is not instanced.
+GLintptr sCameraBlockOffset = 0;
+GLintptr sDefaultObjectBlockOffset = 0;
+
+// The JointBlock always has room for the largest skeleton.
+constexpr GLsizeiptr kJointBlockSize =
+    sizeof(MaterialShaderProgram::JointData) * GT_SKELETON_MAX_JOINTS;
+
+// Stores a mat3f as the three vec4 columns of a std140 mat3.
+void packMatrix33(const mat3f& matrix, vec4f* columns) noexcept
+{
+    for (int c = 0; c < 3; ++c)
+    {
+        columns[c] = vec4f(matrix.data[3 * c], matrix.data[3 * c + 1],
+                           matrix.data[3 * c + 2], 0.0f);
+    }
+}
+
+// The per-instance matrices of an instanced draw.
+std::vector<mat4f, allocator<mat4f>> sInstanceMatricesPVM;
+std::vector<mat4f, allocator<mat4f>> sInstanceMatricesVM;
+std::vector<mat3f, allocator<mat3f>> sInstanceMatricesN;
+
 WriteLock sEntitiesLock;
 
 MaterialShaderProgram* sMaterialShaderProgram = nullptr;
@@ -153,6 +269,121 @@ class EntitySorter : public EntityVisitor
     }
 };
 
+// Only present when the Renderer owns a real context.
+std::unique_ptr<GPUFrameTimer> sGPUFrameTimer;
+
+// Copies the entities whose bounding box intersects the frustum to the output,
+// and returns the number of culled entities.
+std::size_t cullAgainstFrustum(const frustum3f& frustum,
+                               const std::vector<std::shared_ptr<Entity>>& in,
+                               std::vector<std::shared_ptr<Entity>>& out)
+{
+    sCullingBoxes.resize(in.size());
+    Entity::globalBoundingBoxes(in.data(), in.size(), sCullingBoxes.data());
+    sCullingVisibility.resize(in.size());
+    frustum.intersects(sCullingBoxes.data(), sCullingBoxes.size(),
+                       sCullingVisibility.data());
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        if (sCullingVisibility[i]) out.push_back(in[i]);
+    }
+    return in.size() - out.size();
+}
+
+// Copies the lights whose bounding sphere intersects the frustum to the output,
+// and returns the number of culled lights. Unbounded lights are always copied.
+std::size_t cullLightsAgainstFrustum(
+    const frustum3f& frustum, const std::vector<std::shared_ptr<Entity>>& in,
+    std::vector<std::shared_ptr<Entity>>& out)
+{
+    sphere3f lSphere;
+    for (const auto& lEntity : in)
+    {
+        if (!lEntity->light->getBoundingSphere(*lEntity, lSphere) ||
+            intersects(frustum, lSphere))
+        {
+            out.push_back(lEntity);
+        }
+    }
+    return in.size() - out.size();
+}
+
+// Copies the entities that are in the visible set to the output, and returns
+// the number of culled entities.
+std::size_t cullAgainstVisibleSet(const std::vector<std::shared_ptr<Entity>>& in,
+                                  std::vector<std::shared_ptr<Entity>>& out)
+{
+    for (const auto& lEntity : in)
+    {
+        if (sCullingVisibleSet.count(lEntity.get())) out.push_back(lEntity);
+    }
+    return in.size() - out.size();
+}
+
+// The material flag of an entity. This selects the branches of the material
+// shader, so it is the shader permutation of a draw.
+GLint materialFlag(const Entity& entity) noexcept
+{
+    GLint lMaterialFlag = 0;
+    const auto lMaterial = entity.material.get();
+    const auto lMesh = entity.mesh.get();
+    if (lMaterial->diffuseTexture) lMaterialFlag |= HAS_DIFFUSE_TEXTURE;
+    if (lMaterial->specularTexture) lMaterialFlag |= HAS_SPECULAR_TEXTURE;
+    if (lMaterial->normalTexture) lMaterialFlag |= HAS_NORMAL_TEXTURE;
+    if (lMesh->hasTangentsAndBitangents())
+    {
+        lMaterialFlag |= HAS_TANGENTS_AND_BITANGENTS;
+    }
+    if (SkinningCache::isSkinned(entity))
+    {
+        lMaterialFlag |= MESH_HAS_JOINTS;
+    }
+    return lMaterialFlag;
+}
+
+// Pushes the geometry entities onto the geometry queue.
+void enqueueGeometry(const std::vector<std::shared_ptr<Entity>>& geometries,
+                     const mat4f& matrixV, const float nearPlane,
+                     const float farPlane)
+{
+    for (const auto& lEntity : geometries)
+    {
+        const vec4f lPosition =
+            matrixV * vec4f(lEntity->globalTransform().data[3]);
+        const auto lKey = RenderQueue::makeKey(
+            RenderQueue::kPassOpaque, materialFlag(*lEntity),
+            sGeometryQueue.materialId(lEntity->material.get()),
+            sGeometryQueue.meshId(lEntity->mesh.get()),
+            RenderQueue::quantizeDepth(-lPosition.z, nearPlane, farPlane));
+        sGeometryQueue.push(
+            lKey, static_cast<std::uint32_t>(sGeometryQueueEntities.size()));
+        sGeometryQueueEntities.push_back(lEntity.get());
+    }
+}
+
+// Adds the CPU time spent in its scope to a phase of the current frame, and
+// surrounds the OpenGL commands of its scope with GPU timestamps.
+class PhaseTimer
+{
+  public:
+    PhaseTimer(const FrameSample::Phase phase) noexcept
+        : mPhase(phase), mStart(Renderer::clock_type::now())
+    {
+        if (sGPUFrameTimer) sGPUFrameTimer->begin(mPhase);
+    }
+
+    ~PhaseTimer() noexcept
+    {
+        if (sGPUFrameTimer) sGPUFrameTimer->end();
+        FrameSample::current().phaseTime[mPhase] +=
+            Renderer::clock_type::now() - mStart;
+    }
+
+  private:
+    const FrameSample::Phase mPhase;
+    const Renderer::time_point_type mStart;
+};
+
 // ALL the global variables.
 
 std::shared_ptr<Font> sDebugFont = nullptr;
@@ -168,6 +399,12 @@ bool Renderer::sFullscreen = false;
 bool Renderer::sRenderInWireframeMode = false;
 bool Renderer::sViewGeometryBuffers = false;
 bool Renderer::sViewCameraDepthBuffer = false;
+bool Renderer::sFrameStatsOverlay = false;
+bool Renderer::sFrustumCulling = true;
+bool Renderer::sAutomaticInstancing = true;
+bool Renderer::sDebugSkinning = false;
+float Renderer::sPoseQuantum = 1.0f / 120.0f;
+std::size_t Renderer::sPoseCacheCapacity = 256;
 int Renderer::sWidth = 800;
 int Renderer::sHeight = 640;
 float Renderer::sAspectRatio =
@@ -177,8 +414,8 @@ Renderer::time_point_type Renderer::sStartTime;
 Renderer::duration_type Renderer::sDeltaTime = Renderer::duration_type();
 Renderer::duration_type Renderer::sPrevElapsedTime = Renderer::duration_type();
 Renderer::duration_type Renderer::sElapsedTime = Renderer::duration_type();
-boost::circular_buffer<Renderer::duration_type> Renderer::s_circle_buffer =
-    boost::circular_buffer<Renderer::duration_type>();
+FrameStatistics Renderer::sFrameStatistics = FrameStatistics();
+std::vector<Renderer::ShadowCasterCount> Renderer::sShadowCasterCounts;
 vec2f Renderer::sMouseDelta = vec2f(0.0f, 0.0f);
 vec2f Renderer::sMouseWheel = vec2f(0.0f, 0.0f);
 vec4f Renderer::sFingerMotion = vec4f(0.0f, 0.0f, 0.0f, 0.0f);
@@ -201,19 +438,12 @@ mat4f Renderer::sMatrixVM = mat4f(1.0f);
 mat4f Renderer::sMatrixPVM = mat4f(1.0f);
 mat3f Renderer::sMatrixN = mat3f(1.0f);
 
-std::vector<mat4f, allocator<mat4f>> Renderer::sMatrix44Array =
-    std::vector<mat4f, allocator<mat4f>>(1 * GT_SKELETON_MAX_JOINTS);
-std::vector<vec4f, allocator<vec4f>> Renderer::sMatrix33Array =
-    std::vector<vec4f, allocator<vec4f>>(3 * GT_SKELETON_MAX_JOINTS);
-
-OpenGL::BufferObject* Renderer::sMatrix44UniformBuffer = nullptr;
-OpenGL::BufferObject* Renderer::sMatrix33UniformBuffer = nullptr;
-
 std::shared_ptr<Entity> Renderer::sCameraEntity =
     std::shared_ptr<Entity>(nullptr);
 std::shared_ptr<Entity> Renderer::sDebugShadowBufferEntity =
     std::shared_ptr<Entity>(nullptr);
 const Octree* Renderer::sOctreeRoot = nullptr;
+const Octree* Renderer::sCullingOctree = nullptr;
 vec3f Renderer::sCameraPosition = vec3f(0.0f, 0.0f, 0.0f);
 
 std::shared_ptr<Mesh> Renderer::sUnitQuadPUN = nullptr;
@@ -338,6 +568,7 @@ void Renderer::initialize(const char* windowTitle,
         release();
         throw FunctionLoadException();
     }
+    OpenGL::StateCache::invalidate();
 
     SDL_GetKeyboardState(&sKeyStateCount);
     sKeyPrevState = new Uint8[sKeyStateCount];
@@ -391,16 +622,6 @@ void Renderer::initialize(const char* windowTitle,
     if (initializeShaderPrograms)
     {
         init_shaders();
-
-        sMatrix44UniformBuffer = new OpenGL::BufferObject(
-            GL_UNIFORM_BUFFER, sizeof(mat4f) * 1 * GT_SKELETON_MAX_JOINTS,
-            nullptr, GL_STREAM_DRAW);
-        sMatrix33UniformBuffer = new OpenGL::BufferObject(
-            GL_UNIFORM_BUFFER, sizeof(vec4f) * 3 * GT_SKELETON_MAX_JOINTS,
-            nullptr, GL_STREAM_DRAW);
-
-        // MaterialShaderProgram::get().::gintonic::Uniform::Block::Joint44::bindBuffer(*sMatrix44UniformBuffer);
-        // MaterialShaderProgram::get().::gintonic::Uniform::Block::Joint33::bindBuffer(*sMatrix33UniformBuffer);
     }
 
     //
@@ -442,6 +663,8 @@ void Renderer::initialize(const char* windowTitle,
     lLineWidthDimensions[1] =
         std::min(PREFERRED_LINE_WIDTH, lLineWidthDimensions[1]);
     glLineWidth(static_cast<GLfloat>(lLineWidthDimensions[1]));
+
+    sGPUFrameTimer.reset(new GPUFrameTimer());
 }
 
 void Renderer::initDummy(const bool construct_shaders)
@@ -477,6 +700,7 @@ void Renderer::initDummy(const bool construct_shaders)
         release();
         throw FunctionLoadException();
     }
+    OpenGL::StateCache::invalidate();
 
     if (construct_shaders) init_shaders();
 }
@@ -578,6 +802,41 @@ void Renderer::setViewGeometryBuffers(const bool yesOrNo) noexcept
     if (sViewGeometryBuffers) sViewCameraDepthBuffer = false;
 }
 
+void Renderer::setFrameStatsWindowSize(const std::size_t frameCount)
+{
+    sFrameStatistics.setWindowSize(frameCount);
+}
+
+void Renderer::setFrameStatsOverlay(const bool yesOrNo) noexcept
+{
+    sFrameStatsOverlay = yesOrNo;
+}
+
+void Renderer::setFrustumCulling(const bool yesOrNo) noexcept
+{
+    sFrustumCulling = yesOrNo;
+}
+
+void Renderer::setAutomaticInstancing(const bool yesOrNo) noexcept
+{
+    sAutomaticInstancing = yesOrNo;
+}
+
+void Renderer::setDebugSkinning(const bool yesOrNo) noexcept
+{
+    sDebugSkinning = yesOrNo;
+}
+
+void Renderer::setPoseQuantum(const float seconds) noexcept
+{
+    sPoseQuantum = seconds;
+}
+
+void Renderer::setPoseCacheCapacity(const std::size_t capacity) noexcept
+{
+    sPoseCacheCapacity = capacity;
+}
+
 void Renderer::setViewCameraDepthBuffer(const bool yesOrNo) noexcept
 {
     sViewCameraDepthBuffer = yesOrNo;
@@ -628,23 +887,21 @@ bool Renderer::mouseButton(const int buttoncode) noexcept
 
 void Renderer::release()
 {
-    if (sMatrix33UniformBuffer)
-    {
-        delete sMatrix33UniformBuffer;
-        sMatrix33UniformBuffer = nullptr;
-    }
-    if (sMatrix44UniformBuffer)
-    {
-        delete sMatrix44UniformBuffer;
-        sMatrix44UniformBuffer = nullptr;
-    }
+    sGPUFrameTimer.reset();
+    sDrawCommands.reset();
+    sSkinnedPositions.clear();
+    sSkinning.reset();
+    sWorkers.reset();
+    sUniformBlocks.reset();
+    sJointBlocks.reset();
+    sRenderLists.clear();
     if (sPackedQuadVBO)
     {
-        glDeleteBuffers(1, &sPackedQuadVBO);
+        OpenGL::StateCache::deleteBuffers(1, &sPackedQuadVBO);
     }
     if (sPackedQuadVAO)
     {
-        glDeleteVertexArrays(1, &sPackedQuadVAO);
+        OpenGL::StateCache::deleteVertexArrays(1, &sPackedQuadVAO);
     }
     if (sGeometryBuffer)
     {
@@ -693,31 +950,68 @@ void Renderer::release()
 
 void Renderer::update() noexcept
 {
-    processEvents();
-    prepareRendering();
-    sGeometryBuffer->prepareGeometryPhase();
+    GT_PROFILE_MEMORY(Renderer);
 
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_CULL_FACE);
-    glDisable(GL_BLEND);
-    glDepthMask(GL_TRUE);
-    glDepthFunc(GL_LESS);
-    glCullFace(GL_BACK);
+    auto& lSample = FrameSample::current();
+
+    {
+        PhaseTimer lTimer(FrameSample::kPhaseEvents);
+        processEvents();
+        prepareRendering();
+        collectFrameEntities();
+    }
+
+    lSample.frameTime = sDeltaTime;
+    for (int b = 0; b < FrameSample::kBucketCount; ++b)
+    {
+        lSample.entities[b] =
+            frameEntities(static_cast<FrameSample::Bucket>(b)).size();
+    }
+
+    {
+        PhaseTimer lTimer(FrameSample::kPhaseCulling);
+        cullGeometry();
+        cullLights();
+    }
+
+    {
+        PhaseTimer lTimer(FrameSample::kPhaseSkinning);
+        updateSkinning();
+    }
+
+    {
+        PhaseTimer lTimer(FrameSample::kPhaseGeometry);
+
+        sGeometryBuffer->prepareGeometryPhase();
+
+        OpenGL::StateCache::enable(GL_DEPTH_TEST);
+        OpenGL::StateCache::enable(GL_CULL_FACE);
+        OpenGL::StateCache::disable(GL_BLEND);
+        OpenGL::StateCache::depthMask(GL_TRUE);
+        OpenGL::StateCache::depthFunc(GL_LESS);
+        OpenGL::StateCache::cullFace(GL_BACK);
+
+        // The debug path of the shadow buffers does not render geometry.
+        if (sViewGeometryBuffers || sViewCameraDepthBuffer ||
+            !sDebugShadowBufferEntity)
+        {
+            renderGeometry();
+        }
+    }
 
     if (sViewGeometryBuffers) // <--- debug path
     {
-        renderGeometry();
+        PhaseTimer lTimer(FrameSample::kPhaseDebug);
         sGeometryBuffer->blitDrawbuffersToScreen(sWidth, sHeight);
         cerr() << "GEOMETRY BUFFERS\n";
     }
     else if (sViewCameraDepthBuffer) // <--- debug path
     {
-        renderGeometry();
-
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        glDisable(GL_DEPTH_TEST);
+        PhaseTimer lTimer(FrameSample::kPhaseDebug);
+        OpenGL::StateCache::polygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        OpenGL::StateCache::disable(GL_DEPTH_TEST);
         sGeometryBuffer->bindDepthTexture(DEPTH_TEXTURE_UNIT);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        OpenGL::StateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
         glViewport(0, 0, sWidth, sHeight);
         const auto& lProgram = DepthBufferShaderProgram::get();
         lProgram.activate();
@@ -731,12 +1025,16 @@ void Renderer::update() noexcept
     {
         assert(sDebugShadowBufferEntity->shadowBuffer);
 
-        renderShadows();
+        {
+            PhaseTimer lTimer(FrameSample::kPhaseShadows);
+            renderShadows();
+        }
 
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        glDisable(GL_DEPTH_TEST);
+        PhaseTimer lTimer(FrameSample::kPhaseDebug);
+        OpenGL::StateCache::polygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        OpenGL::StateCache::disable(GL_DEPTH_TEST);
         sDebugShadowBufferEntity->shadowBuffer->bindDepthTextures();
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        OpenGL::StateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
         glViewport(0, 0, sWidth, sHeight);
         const auto& lProgram = DepthBufferShaderProgram::get();
         lProgram.activate();
@@ -748,39 +1046,44 @@ void Renderer::update() noexcept
     }
     else // <--- This is the "default" path.
     {
-        renderGeometry();
-
-        renderShadows();
-
-        sGeometryBuffer->prepareLightingPhase();
-        glViewport(0, 0, sWidth, sHeight);
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        glEnable(GL_BLEND);
-        glBlendEquation(GL_FUNC_ADD);
-        glBlendFunc(GL_ONE, GL_ONE);
-        glDisable(GL_CULL_FACE);
-        glEnable(GL_DEPTH_CLAMP);
-        glEnable(GL_STENCIL_TEST);
-        glEnable(GL_DEPTH_CLAMP);
-        glDepthMask(GL_FALSE);
-        renderPointLights();
-        glDepthMask(GL_TRUE);
-        glDisable(GL_DEPTH_CLAMP);
-        glDisable(GL_STENCIL_TEST);
-        glDisable(GL_DEPTH_CLAMP);
-        glDisable(GL_DEPTH_TEST);
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
-        renderLights();
-
-        sGeometryBuffer->finalize(sWidth, sHeight);
+        {
+            PhaseTimer lTimer(FrameSample::kPhaseShadows);
+            renderShadows();
+        }
+        {
+            PhaseTimer lTimer(FrameSample::kPhasePointLights);
+            sGeometryBuffer->prepareLightingPhase();
+            glViewport(0, 0, sWidth, sHeight);
+            OpenGL::StateCache::polygonMode(GL_FRONT_AND_BACK, GL_FILL);
+            OpenGL::StateCache::enable(GL_BLEND);
+            OpenGL::StateCache::blendEquation(GL_FUNC_ADD);
+            OpenGL::StateCache::blendFunc(GL_ONE, GL_ONE);
+            OpenGL::StateCache::disable(GL_CULL_FACE);
+            OpenGL::StateCache::enable(GL_DEPTH_CLAMP);
+            OpenGL::StateCache::enable(GL_STENCIL_TEST);
+            OpenGL::StateCache::depthMask(GL_FALSE);
+            renderPointLights();
+        }
+        {
+            PhaseTimer lTimer(FrameSample::kPhaseLights);
+            OpenGL::StateCache::depthMask(GL_TRUE);
+            OpenGL::StateCache::disable(GL_DEPTH_CLAMP);
+            OpenGL::StateCache::disable(GL_STENCIL_TEST);
+            OpenGL::StateCache::disable(GL_DEPTH_TEST);
+            OpenGL::StateCache::enable(GL_CULL_FACE);
+            OpenGL::StateCache::cullFace(GL_BACK);
+            renderLights();
+
+            sGeometryBuffer->finalize(sWidth, sHeight);
+        }
     }
 
     if (sOctreeRoot)
     {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        glDisable(GL_CULL_FACE);
-        glDisable(GL_BLEND);
+        PhaseTimer lTimer(FrameSample::kPhaseDebug);
+        OpenGL::StateCache::polygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        OpenGL::StateCache::disable(GL_CULL_FACE);
+        OpenGL::StateCache::disable(GL_BLEND);
         glLineWidth(1.0f);
         const auto& lProgram = OctreeDebugShaderProgram::get();
         lProgram.activate();
@@ -798,15 +1101,28 @@ void Renderer::update() noexcept
         });
     }
 
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendEquation(GL_FUNC_ADD);
-    glBlendFunc(GL_SRC_COLOR, GL_ONE_MINUS_SRC_COLOR);
-    glDisable(GL_CULL_FACE); // for the text
-    renderGUI();
+    {
+        PhaseTimer lTimer(FrameSample::kPhaseGUI);
+        OpenGL::StateCache::polygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        OpenGL::StateCache::disable(GL_DEPTH_TEST);
+        OpenGL::StateCache::enable(GL_BLEND);
+        OpenGL::StateCache::blendEquation(GL_FUNC_ADD);
+        OpenGL::StateCache::blendFunc(GL_SRC_COLOR, GL_ONE_MINUS_SRC_COLOR);
+        OpenGL::StateCache::disable(GL_CULL_FACE); // for the text
+        renderGUI();
+        if (sFrameStatsOverlay) renderFrameStatsOverlay();
+    }
 
-    finalizeRendering();
+    {
+        PhaseTimer lTimer(FrameSample::kPhaseFinalize);
+        finalizeRendering();
+    }
+
+    // Collects the GPU timings of a frame that is a few frames old.
+    if (sGPUFrameTimer) sGPUFrameTimer->nextFrame(lSample);
+
+    sFrameStatistics.push(lSample);
+    lSample = FrameSample();
 }
 
 void Renderer::prepareRendering() noexcept
@@ -815,136 +1131,551 @@ void Renderer::prepareRendering() noexcept
 
     if (sRenderInWireframeMode)
     {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        OpenGL::StateCache::polygonMode(GL_FRONT_AND_BACK, GL_LINE);
     }
     else
     {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        OpenGL::StateCache::polygonMode(GL_FRONT_AND_BACK, GL_FILL);
     }
 }
 
-void Renderer::renderGeometry() noexcept
+void Renderer::collectFrameEntities()
 {
-    const auto& lMaterialShaderProgram = MaterialShaderProgram::get();
-    lMaterialShaderProgram.activate();
-    lMaterialShaderProgram.setMaterialDiffuseTexture(GBUFFER_TEX_DIFFUSE);
-    lMaterialShaderProgram.setMaterialSpecularTexture(GBUFFER_TEX_SPECULAR);
-    lMaterialShaderProgram.setMaterialNormalTexture(GBUFFER_TEX_NORMAL);
+    sRenderLists.update();
+
+    std::vector<std::shared_ptr<Entity>>* lSubmitted[] = {
+        &sShadowCastingLightEntities, &sShadowCastingPointLightEntities,
+        &sShadowCastingGeometryEntities, &sNonShadowCastingLightEntities,
+        &sNonShadowCastingGeometryEntities};
+
+    bool lAnySubmitted = false;
+    for (const auto lList : lSubmitted) lAnySubmitted |= !lList->empty();
+
+    for (int b = 0; b < FrameSample::kBucketCount; ++b)
+    {
+        const auto lBucket = static_cast<FrameSample::Bucket>(b);
+        if (!lAnySubmitted)
+        {
+            // The common case: use the retained lists as they are.
+            sFrameEntities[b] = &sRenderLists[lBucket];
+            continue;
+        }
+        // Fall back to the submitted entities, and add the registered
+        // entities to them.
+        lSubmitted[b]->insert(lSubmitted[b]->end(),
+                              sRenderLists[lBucket].begin(),
+                              sRenderLists[lBucket].end());
+        sFrameEntities[b] = lSubmitted[b];
+    }
+}
 
-    std::vector<mat4f, allocator<mat4f>> matrixBs(GT_SKELETON_MAX_JOINTS);
-    std::vector<mat3f> matrixBNs(GT_SKELETON_MAX_JOINTS);
+void Renderer::registerEntityRecursive(std::shared_ptr<Entity> toRegister)
+{
+    sRenderLists.addRecursive(toRegister);
+}
 
-    renderGeometry(sShadowCastingGeometryEntities, matrixBs, matrixBNs);
-    renderGeometry(sNonShadowCastingGeometryEntities, matrixBs, matrixBNs);
+void Renderer::unregisterEntityRecursive(std::shared_ptr<Entity> toUnregister)
+{
+    sRenderLists.removeRecursive(toUnregister);
 }
 
-void Renderer::renderGeometry(
-    const std::vector<std::shared_ptr<Entity>>& geometries,
-    std::vector<mat4f, allocator<mat4f>>& matrixBs,
-    std::vector<mat3f>& matrixBNs) noexcept
+void Renderer::cullGeometry() noexcept
 {
-    const auto& lMaterialShaderProgram = MaterialShaderProgram::get();
+    auto& lSample = FrameSample::current();
+
+    if (!sFrustumCulling)
+    {
+        sVisibleShadowCastingGeometryEntities =
+            frameEntities(FrameSample::kBucketShadowCastingGeometry);
+        sVisibleNonShadowCastingGeometryEntities =
+            frameEntities(FrameSample::kBucketNonShadowCastingGeometry);
+        return;
+    }
+
+    const frustum3f lFrustum(matrix_P() * matrix_V());
+
+    if (sCullingOctree)
+    {
+        sCullingQueryResult.clear();
+        sCullingOctree->query(lFrustum,
+                              std::back_inserter(sCullingQueryResult));
+        sCullingVisibleSet.clear();
+        for (const auto& lEntity : sCullingQueryResult)
+        {
+            sCullingVisibleSet.insert(lEntity.get());
+        }
+        sCullingQueryResult.clear();
+        lSample.culled[FrameSample::kBucketShadowCastingGeometry] =
+            cullAgainstVisibleSet(
+                frameEntities(FrameSample::kBucketShadowCastingGeometry),
+                sVisibleShadowCastingGeometryEntities);
+        lSample.culled[FrameSample::kBucketNonShadowCastingGeometry] =
+            cullAgainstVisibleSet(
+                frameEntities(FrameSample::kBucketNonShadowCastingGeometry),
+                sVisibleNonShadowCastingGeometryEntities);
+    }
+    else
+    {
+        lSample.culled[FrameSample::kBucketShadowCastingGeometry] =
+            cullAgainstFrustum(
+                lFrustum,
+                frameEntities(FrameSample::kBucketShadowCastingGeometry),
+                sVisibleShadowCastingGeometryEntities);
+        lSample.culled[FrameSample::kBucketNonShadowCastingGeometry] =
+            cullAgainstFrustum(
+                lFrustum,
+                frameEntities(FrameSample::kBucketNonShadowCastingGeometry),
+                sVisibleNonShadowCastingGeometryEntities);
+    }
+}
+
+void Renderer::cullLights() noexcept
+{
+    auto& lSample = FrameSample::current();
+
+    // The lights of this frame count their shadow casters from here on.
+    sShadowCasterCounts.clear();
+
+    if (!sFrustumCulling)
+    {
+        sVisibleShadowCastingLightEntities =
+            frameEntities(FrameSample::kBucketShadowCastingLights);
+        sVisibleShadowCastingPointLightEntities =
+            frameEntities(FrameSample::kBucketShadowCastingPointLights);
+        sVisibleNonShadowCastingLightEntities =
+            frameEntities(FrameSample::kBucketNonShadowCastingLights);
+        return;
+    }
+
+    const frustum3f lFrustum(matrix_P() * matrix_V());
+
+    lSample.culled[FrameSample::kBucketShadowCastingLights] =
+        cullLightsAgainstFrustum(
+            lFrustum, frameEntities(FrameSample::kBucketShadowCastingLights),
+            sVisibleShadowCastingLightEntities);
+    lSample.culled[FrameSample::kBucketShadowCastingPointLights] =
+        cullLightsAgainstFrustum(
+            lFrustum,
+            frameEntities(FrameSample::kBucketShadowCastingPointLights),
+            sVisibleShadowCastingPointLightEntities);
+    lSample.culled[FrameSample::kBucketNonShadowCastingLights] =
+        cullLightsAgainstFrustum(
+            lFrustum,
+            frameEntities(FrameSample::kBucketNonShadowCastingLights),
+            sVisibleNonShadowCastingLightEntities);
+}
+
+void Renderer::countShadowCasters(const Entity& light,
+                                  const std::size_t casters,
+                                  const std::size_t culled)
+{
+    auto& lSample = FrameSample::current();
+    lSample.shadowCasters += casters;
+    lSample.culledShadowCasters += culled;
+    sShadowCasterCounts.push_back({&light, casters, culled});
+}
+
+const std::vector<std::shared_ptr<Entity>>& Renderer::cullShadowCasters(
+    const Entity& light, const frustum3f& frustum,
+    const std::vector<std::shared_ptr<Entity>>& casters)
+{
+    if (!sFrustumCulling) return cullShadowCasters(light, casters);
+
+    sShadowCasters.clear();
+    const auto lCulled = cullAgainstFrustum(frustum, casters, sShadowCasters);
+    countShadowCasters(light, sShadowCasters.size(), lCulled);
+    return sShadowCasters;
+}
+
+const std::vector<std::shared_ptr<Entity>>& Renderer::cullShadowCasters(
+    const Entity& light, const sphere3f& sphere,
+    const std::vector<std::shared_ptr<Entity>>& casters)
+{
+    if (!sFrustumCulling) return cullShadowCasters(light, casters);
+
+    // Pad the boxes to a multiple of four; the padding is never looked at.
+    const auto lCount = casters.size();
+    sCullingBoxes.resize((lCount + 3) & ~std::size_t(3));
+    Entity::globalBoundingBoxes(casters.data(), lCount, sCullingBoxes.data());
+    sShadowCasters.clear();
+    for (std::size_t i = 0; i < lCount; i += 4)
+    {
+        const auto lMask = intersects4(sphere, sCullingBoxes.data() + i);
+        for (std::size_t j = i; j < std::min(i + 4, lCount); ++j)
+        {
+            if (lMask & (1 << (j - i))) sShadowCasters.push_back(casters[j]);
+        }
+    }
+    countShadowCasters(light, sShadowCasters.size(),
+                       lCount - sShadowCasters.size());
+    return sShadowCasters;
+}
+
+const std::vector<std::shared_ptr<Entity>>& Renderer::cullShadowCasters(
+    const Entity& light, const std::vector<std::shared_ptr<Entity>>& casters)
+{
+    countShadowCasters(light, casters.size(), 0);
+    return casters;
+}
+
+void Renderer::updateSkinning() noexcept
+{
+    GT_PROFILE_MEMORY(Animation);
+
+    if (!sWorkers) sWorkers.reset(new WorkerPool());
+    if (!sSkinning) sSkinning.reset(new SkinningCache(*sWorkers));
+    if (!sJointBlocks) sJointBlocks.reset(new OpenGL::UniformRingBuffer());
+
     const auto lElapsedTime =
         static_cast<float>(
             std::chrono::duration_cast<std::chrono::milliseconds>(elapsedTime())
                 .count()) /
         float(1e3);
 
-    for (const auto& lEntity : geometries)
+    // Every entity that some pass may draw this frame. The shadow passes
+    // see all shadow casters, the geometry pass only the visible ones.
+    auto& lSkinning = *sSkinning;
+    lSkinning.setQuantum(sPoseQuantum);
+    lSkinning.setCapacity(sPoseCacheCapacity);
+    lSkinning.clear(lElapsedTime);
+    for (const auto& lEntity :
+         frameEntities(FrameSample::kBucketShadowCastingGeometry))
     {
-        GLint lMaterialFlag = 0;
-        // GLint lHasTangentsAndBitangents = 0;
-        const auto lMaterial = lEntity->material.get();
-        const auto lMesh = lEntity->mesh.get();
-        const auto lAnimationClip = lEntity->activeAnimationClip;
+        lSkinning.add(*lEntity);
+    }
+    for (const auto& lEntity : sVisibleNonShadowCastingGeometryEntities)
+    {
+        lSkinning.add(*lEntity);
+    }
 
-        if (lMaterial->diffuseTexture)
-        {
-            lMaterialFlag |= HAS_DIFFUSE_TEXTURE;
-            lMaterial->diffuseTexture->bind(GBUFFER_TEX_DIFFUSE);
-        }
-        if (lMaterial->specularTexture)
+    lSkinning.evaluate();
+    FrameSample::current().poseCacheHits += lSkinning.hits();
+    FrameSample::current().poseCacheMisses += lSkinning.misses();
+
+    updateSkinnedPositions();
+
+    // Every JointBlock range is bound with room for the largest skeleton,
+    // so only the joints of a palette are staged and the rest is reserved.
+    using Program = MaterialShaderProgram;
+    auto& lBlocks = *sJointBlocks;
+    sDefaultJointBlockOffset = lBlocks.allocate(0, kJointBlockSize);
+    sPaletteBlockOffsets.resize(lSkinning.size());
+    Program::JointData lJoint;
+    for (std::size_t i = 0; i < lSkinning.size(); ++i)
+    {
+        const auto& lPalette = lSkinning[i];
+        const auto lOffset = lBlocks.allocate(
+            sizeof(Program::JointData) * lPalette.count, kJointBlockSize);
+        for (std::uint32_t j = 0; j < lPalette.count; ++j)
         {
-            lMaterialFlag |= HAS_SPECULAR_TEXTURE;
-            lMaterial->specularTexture->bind(GBUFFER_TEX_SPECULAR);
+            const auto lIndex = lPalette.offset + j;
+            lJoint.matrixB = lSkinning.jointMatrices()[lIndex];
+            packMatrix33(lSkinning.jointNormalMatrices()[lIndex],
+                         lJoint.matrixBN);
+            std::memcpy(lBlocks.at(lOffset) + j * sizeof(Program::JointData),
+                        &lJoint, sizeof(Program::JointData));
         }
-        if (lMaterial->normalTexture)
+        sPaletteBlockOffsets[i] = lOffset;
+
+        if (sDebugSkinning)
         {
-            lMaterialFlag |= HAS_NORMAL_TEXTURE;
-            lMaterial->normalTexture->bind(GBUFFER_TEX_NORMAL);
+            const auto lClip = lPalette.entity->activeAnimationClip;
+            cerr() << lPalette.entity->name << " --> "
+                   << (lPalette.entity->activeAnimationBlend
+                           ? "(blend)"
+                           : lClip->name.c_str())
+                   << '\n';
         }
-        if (lMesh->hasTangentsAndBitangents())
+    }
+    lBlocks.upload();
+}
+
+void Renderer::updateSkinnedPositions()
+{
+    for (auto& lStream : sSkinnedPositions) lStream.second.used = false;
+
+    // Only the shadow volumes of the point lights use the positions.
+    if (!sVisibleShadowCastingPointLightEntities.empty())
+    {
+        const auto& lSkinning = *sSkinning;
+        for (const auto& lEntity :
+             frameEntities(FrameSample::kBucketShadowCastingGeometry))
         {
-            lMaterialFlag |= HAS_TANGENTS_AND_BITANGENTS;
-            // lHasTangentsAndBitangents = 1;
+            const auto lPalette = lSkinning.find(lEntity.get());
+            if (lPalette == SkinningCache::kNone) continue;
+            if (!lEntity->mesh->hasAdjacency()) continue;
+            auto& lStream = sSkinnedPositions[lEntity.get()];
+            if (!lStream.positions)
+            {
+                lStream.positions.reset(new SkinnedPositions());
+            }
+            const auto& lJoints = lSkinning[lPalette];
+            lStream.positions->update(
+                *lEntity->mesh,
+                lSkinning.jointMatrices().data() + lJoints.offset,
+                lJoints.count, *sWorkers);
+            lStream.positions->upload();
+            lStream.used = true;
         }
-        if (lAnimationClip && lMesh->hasSkinning())
-        {
-            lMaterialFlag |= MESH_HAS_JOINTS;
+    }
+
+    for (auto lIter = sSkinnedPositions.begin();
+         lIter != sSkinnedPositions.end();)
+    {
+        if (lIter->second.used)
+            ++lIter;
+        else
+            lIter = sSkinnedPositions.erase(lIter);
+    }
+}
+
+const SkinnedPositions*
+Renderer::skinnedPositions(const Entity& entity) noexcept
+{
+    const auto lIter = sSkinnedPositions.find(&entity);
+    return lIter == sSkinnedPositions.end() ? nullptr
+                                            : lIter->second.positions.get();
+}
 
-            lAnimationClip->isLooping = false;
+bool Renderer::bindJointBlock(const Entity& entity) noexcept
+{
+    if (!sJointBlocks) return false;
+    const auto lPalette = sSkinning->find(&entity);
+    const auto lOffset = lPalette == SkinningCache::kNone
+                             ? sDefaultJointBlockOffset
+                             : sPaletteBlockOffsets[lPalette];
+    sJointBlocks->bindRange(MaterialShaderProgram::kJointBlockBinding, lOffset,
+                            kJointBlockSize);
+    return lPalette != SkinningCache::kNone;
+}
 
-            cerr() << lEntity->name << " --> " << lAnimationClip->name << '\n';
-            const auto lStart = lEntity->activeAnimationStartTime;
-            for (uint8_t j = 0; j < lAnimationClip->jointCount(); ++j)
+void Renderer::renderGeometry() noexcept
+{
+    sGeometryQueue.clear();
+    sGeometryQueueEntities.clear();
+    const auto& lCamera = *sCameraEntity->camera;
+    enqueueGeometry(sVisibleShadowCastingGeometryEntities, matrix_V(),
+                    lCamera.nearPlane(), lCamera.farPlane());
+    enqueueGeometry(sVisibleNonShadowCastingGeometryEntities, matrix_V(),
+                    lCamera.nearPlane(), lCamera.farPlane());
+    drawGeometryQueue();
+}
+
+void Renderer::renderGeometry(
+    const std::vector<std::shared_ptr<Entity>>& entities) noexcept
+{
+    // Without a previous update() there is no joint palette at all. Every
+    // draw then binds the default range, which must exist.
+    if (!sWorkers) sWorkers.reset(new WorkerPool());
+    if (!sJointBlocks)
+    {
+        sJointBlocks.reset(new OpenGL::UniformRingBuffer());
+        sDefaultJointBlockOffset = sJointBlocks->allocate(0, kJointBlockSize);
+        sJointBlocks->upload();
+    }
+
+    sCameraEntity->updateViewMatrix(sMatrixV);
+    sGeometryQueue.clear();
+    sGeometryQueueEntities.clear();
+    const auto& lCamera = *sCameraEntity->camera;
+    enqueueGeometry(entities, matrix_V(), lCamera.nearPlane(),
+                    lCamera.farPlane());
+    drawGeometryQueue();
+}
+
+void Renderer::drawGeometryQueue() noexcept
+{
+    const auto& lMaterialShaderProgram = MaterialShaderProgram::get();
+    lMaterialShaderProgram.activate();
+    lMaterialShaderProgram.setMaterialDiffuseTexture(GBUFFER_TEX_DIFFUSE);
+    lMaterialShaderProgram.setMaterialSpecularTexture(GBUFFER_TEX_SPECULAR);
+    lMaterialShaderProgram.setMaterialNormalTexture(GBUFFER_TEX_NORMAL);
+
+    sGeometryQueue.sort();
+
+    // Build the per-draw matrices on the workers. Only the replay below
+    // talks to OpenGL.
+    if (!sDrawCommands) sDrawCommands.reset(new DrawCommandBuffer(*sWorkers));
+    sDrawCommands->build(sGeometryQueue, sGeometryQueueEntities, matrix_P(),
+                         matrix_V(), sSkinning.get(),
+                         sCameraEntity->hasNonUniformScale());
+
+    if (!sUniformBlocks) sUniformBlocks.reset(new OpenGL::UniformRingBuffer());
+    stageGeometryQueue();
+    renderGeometryQueue();
+}
+
+void Renderer::stageGeometryQueue() noexcept
+{
+    using Program = MaterialShaderProgram;
+    const auto& lCommands = *sDrawCommands;
+    auto& lBlocks = *sUniformBlocks;
+
+    // The camera matrices are the same for every draw.
+    Program::CameraData lCamera;
+    lCamera.matrixP = matrix_P();
+    lCamera.matrixV = matrix_V();
+    sCameraBlockOffset = lBlocks.stage(lCamera);
+
+    // Every block that the shader declares must be backed by the buffer,
+    // even when a draw does not read it. This range only backs the block
+    // for instanced draws, which take their matrices from the instance
+    // attributes instead. Nothing is staged here, so the next block
+    // overwrites these bytes: they are present, but not meaningful.
+    sDefaultObjectBlockOffset =
+        lBlocks.allocate(0, sizeof(Program::ObjectData));
+
+    sDrawRuns.clear();
+    sObjectBlockOffsets.resize(lCommands.size());
+
+    const Material* lLastMaterial = nullptr;
+    GLintptr lMaterialOffset = 0;
+
+    const auto lCount = lCommands.size();
+    std::size_t i = 0;
+    while (i < lCount)
+    {
+        // Draws that share permutation, material and mesh are adjacent in
+        // the queue. Find the end of this run.
+        const auto& lFirst = lCommands[i];
+        DrawRun lRun;
+        lRun.begin = i;
+        lRun.end = i + 1;
+        for (; lRun.end < lCount; ++lRun.end)
+        {
+            const auto& lCommand = lCommands[lRun.end];
+            if (lCommand.materialFlag != lFirst.materialFlag ||
+                lCommand.material != lFirst.material ||
+                lCommand.mesh != lFirst.mesh)
             {
-                matrixBs[j] = lAnimationClip->evaluate(j, lStart, lElapsedTime);
-                matrixBNs[j] = matrixBs[j].upperLeft33().invert().transpose();
-
-                // sMatrix44Array[j] = matrixBs[j];
-                // sMatrix33Array[j] = matrixBNs[j];
-                // sMatrix44Array[j] = lAnimationClip->evaluate(j, lStart,
-                // lElapsedTime); const auto lTempNormalMatrix =
-                // sMatrix44Array[j].upperLeft33().invert().transpose();
-                // sMatrix33Array[3 * j + 0] = vec4f(lTempNormalMatrix.data[0],
-                // lTempNormalMatrix.data[1], lTempNormalMatrix.data[2], 0.0f);
-                // sMatrix33Array[3 * j + 1] = vec4f(lTempNormalMatrix.data[3],
-                // lTempNormalMatrix.data[4], lTempNormalMatrix.data[5], 0.0f);
-                // sMatrix33Array[3 * j + 2] = vec4f(lTempNormalMatrix.data[6],
-                // lTempNormalMatrix.data[7], lTempNormalMatrix.data[8], 0.0f);
-                // sMatrix33Array[j] =
-                // sMatrix44Array[j].upperLeft33().invert().transpose();
+                break;
             }
+        }
+
+        // Skinned meshes need their own joint matrices, so only the others
+        // can be instanced.
+        lRun.instanced = sAutomaticInstancing &&
+                         !(lFirst.materialFlag & MESH_HAS_JOINTS) &&
+                         lRun.end - lRun.begin > 1;
 
-            lMaterialShaderProgram.setMatrixB(matrixBs);
-            lMaterialShaderProgram.setMatrixBN(matrixBNs);
-
-            // glBindBuffer(GL_UNIFORM_BUFFER, *sMatrix44UniformBuffer);
-            // gtBufferSubData(GL_UNIFORM_BUFFER, 0, sMatrix44Array.size(),
-            // sMatrix44Array); glBindBufferBase(GL_UNIFORM_BUFFER,
-            // lMaterialShaderProgram.getJoint44(), *sMatrix44UniformBuffer);
-            // glBindBuffer(GL_UNIFORM_BUFFER, *sMatrix33UniformBuffer);
-            // gtBufferSubData(GL_UNIFORM_BUFFER, 0, sMatrix33Array.size(),
-            // sMatrix33Array); glBindBufferBase(GL_UNIFORM_BUFFER,
-            // lMaterialShaderProgram.getJoint33(), *sMatrix33UniformBuffer);
+        if (lFirst.material != lLastMaterial)
+        {
+            Program::MaterialData lMaterial;
+            lMaterial.diffuseColor = lFirst.material->diffuseColor;
+            lMaterial.specularColor = lFirst.material->specularColor;
+            lMaterialOffset = lBlocks.stage(lMaterial);
+            lLastMaterial = lFirst.material;
         }
+        lRun.material = lMaterialOffset;
+        sDrawRuns.push_back(lRun);
 
-        setModelMatrix(lEntity->globalTransform());
+        if (lRun.instanced)
+        {
+            i = lRun.end;
+            continue;
+        }
 
-        // const auto lJointBlockIndex       =
-        // glGetUniformBlockIndex(lMaterialShaderProgram, "JointBlock44"); const
-        // auto lNormalJointBlockIndex =
-        // glGetUniformBlockIndex(lMaterialShaderProgram, "JointBlock33");
+        for (; i < lRun.end; ++i)
+        {
+            const auto& lCommand = lCommands[i];
+            Program::ObjectData lObject;
+            lObject.matrixVM = lCommand.matrixVM;
+            packMatrix33(lCommand.matrixN, lObject.matrixN);
+            sObjectBlockOffsets[i] = lBlocks.stage(lObject);
+        }
+    }
+
+    lBlocks.upload();
+}
 
-        // if (lJointBlockIndex == GL_INVALID_INDEX)
-        // {
-        // 	cerr() << "GL_INVALID_INDEX for joint block.\n";
-        // }
-        // if (lNormalJointBlockIndex == GL_INVALID_INDEX)
-        // {
-        // 	cerr() << "GL_INVALID_INDEX for normal joint block.\n";
-        // }
+void Renderer::renderGeometryQueue() noexcept
+{
+    using Program = MaterialShaderProgram;
+    const auto& lMaterialShaderProgram = Program::get();
+    const auto& lCommands = *sDrawCommands;
+    const auto& lBlocks = *sUniformBlocks;
+
+    lBlocks.bindRange<Program::CameraData>(Program::kCameraBlockBinding,
+                                           sCameraBlockOffset);
+    lBlocks.bindRange<Program::ObjectData>(Program::kObjectBlockBinding,
+                                           sDefaultObjectBlockOffset);
+    sJointBlocks->bindRange(Program::kJointBlockBinding,
+                            sDefaultJointBlockOffset, kJointBlockSize);
+
+    // The state that the previous draw left behind. Consecutive draws in the
+    // queue usually share it, so most binds can be skipped. Repeated binds
+    // of the same uniform block range are dropped by the StateCache.
+    const Texture2D* lLastDiffuseTexture = nullptr;
+    const Texture2D* lLastSpecularTexture = nullptr;
+    const Texture2D* lLastNormalTexture = nullptr;
+    GLint lLastMaterialFlag = -1;
+
+    for (const auto& lRun : sDrawRuns)
+    {
+        const auto& lFirst = lCommands[lRun.begin];
+        const auto lMesh = lFirst.mesh;
+
+        const auto lDiffuseTexture = lFirst.diffuseTexture;
+        if (lDiffuseTexture && lDiffuseTexture != lLastDiffuseTexture)
+        {
+            lDiffuseTexture->bind(GBUFFER_TEX_DIFFUSE);
+            lLastDiffuseTexture = lDiffuseTexture;
+        }
+        const auto lSpecularTexture = lFirst.specularTexture;
+        if (lSpecularTexture && lSpecularTexture != lLastSpecularTexture)
+        {
+            lSpecularTexture->bind(GBUFFER_TEX_SPECULAR);
+            lLastSpecularTexture = lSpecularTexture;
+        }
+        const auto lNormalTexture = lFirst.normalTexture;
+        if (lNormalTexture && lNormalTexture != lLastNormalTexture)
+        {
+            lNormalTexture->bind(GBUFFER_TEX_NORMAL);
+            lLastNormalTexture = lNormalTexture;
+        }
+        lBlocks.bindRange<Program::MaterialData>(Program::kMaterialBlockBinding,
+                                                 lRun.material);
+
+        const auto lMaterialFlag = static_cast<GLint>(lFirst.materialFlag);
+        const auto lFlag = lRun.instanced
+                               ? (lMaterialFlag | INSTANCED_RENDERING)
+                               : lMaterialFlag;
+        if (lFlag != lLastMaterialFlag)
+        {
+            lMaterialShaderProgram.setMaterialFlag(lFlag);
+            lLastMaterialFlag = lFlag;
+        }
 
-        lMaterialShaderProgram.setMaterialDiffuseColor(lMaterial->diffuseColor);
-        lMaterialShaderProgram.setMaterialSpecularColor(
-            lMaterial->specularColor);
-        lMaterialShaderProgram.setMaterialFlag(lMaterialFlag);
-        // lMaterialShaderProgram.setHasTangentsAndBitangents(lHasTangentsAndBitangents);
-        lMaterialShaderProgram.setMatrixPVM(matrix_PVM());
-        lMaterialShaderProgram.setMatrixVM(matrix_VM());
-        lMaterialShaderProgram.setMatrixN(matrix_N());
+        if (lRun.instanced)
+        {
+            sInstanceMatricesPVM.clear();
+            sInstanceMatricesVM.clear();
+            sInstanceMatricesN.clear();
+            for (auto j = lRun.begin; j < lRun.end; ++j)
+            {
+                sInstanceMatricesPVM.push_back(lCommands[j].matrixPVM);
+                sInstanceMatricesVM.push_back(lCommands[j].matrixVM);
+                sInstanceMatricesN.push_back(lCommands[j].matrixN);
+            }
+            lMesh->draw(sInstanceMatricesPVM, sInstanceMatricesVM,
+                        sInstanceMatricesN);
+            continue;
+        }
 
-        lMesh->draw();
+        for (auto i = lRun.begin; i < lRun.end; ++i)
+        {
+            const auto& lCommand = lCommands[i];
+            lBlocks.bindRange<Program::ObjectData>(Program::kObjectBlockBinding,
+                                                   sObjectBlockOffsets[i]);
+            const auto lJointOffset =
+                lCommand.palette == SkinningCache::kNone
+                    ? sDefaultJointBlockOffset
+                    : sPaletteBlockOffsets[lCommand.palette];
+            sJointBlocks->bindRange(Program::kJointBlockBinding, lJointOffset,
+                                    kJointBlockSize);
+
+            lMesh->draw();
+        }
     }
 }
 
@@ -952,18 +1683,21 @@ void Renderer::renderShadows() noexcept
 {
     // ShadowShaderProgram::get().activate();
     // ShadowShaderProgram::get().setInstancedRendering(0);
-    for (auto lEntity : sShadowCastingLightEntities)
+    const auto& lGeometry =
+        frameEntities(FrameSample::kBucketShadowCastingGeometry);
+    for (auto lEntity : sVisibleShadowCastingLightEntities)
     {
-        lEntity->shadowBuffer->collect(*lEntity,
-                                       sShadowCastingGeometryEntities);
+        lEntity->shadowBuffer->collect(*lEntity, lGeometry);
     }
 }
 
 void Renderer::renderPointLights() noexcept
 {
-    for (const auto lEntity : sShadowCastingPointLightEntities)
+    const auto& lGeometry =
+        frameEntities(FrameSample::kBucketShadowCastingGeometry);
+    for (const auto lEntity : sVisibleShadowCastingPointLightEntities)
     {
-        lEntity->light->shine(*lEntity, sShadowCastingGeometryEntities);
+        lEntity->light->shine(*lEntity, lGeometry);
     }
 }
 
@@ -977,13 +1711,15 @@ void Renderer::renderLights() noexcept
     lAmbientLightShaderProgram.setLightIntensity(vec4f(1.0f, 1.0f, 1.0f, 1.0f));
     sUnitQuadPUN->draw();
 
-    for (auto lEntity : sShadowCastingLightEntities)
+    const auto& lGeometry =
+        frameEntities(FrameSample::kBucketShadowCastingGeometry);
+    for (auto lEntity : sVisibleShadowCastingLightEntities)
     {
-        lEntity->light->shine(*lEntity, sShadowCastingGeometryEntities);
+        lEntity->light->shine(*lEntity, lGeometry);
     }
-    for (auto lEntity : sNonShadowCastingLightEntities)
+    for (auto lEntity : sVisibleNonShadowCastingLightEntities)
     {
-        lEntity->light->shine(*lEntity, sShadowCastingGeometryEntities);
+        lEntity->light->shine(*lEntity, lGeometry);
     }
 }
 
@@ -997,6 +1733,13 @@ void Renderer::renderGUI() noexcept
     }
 }
 
+void Renderer::renderFrameStatsOverlay() noexcept
+{
+    cout() << "Average over " << sFrameStatistics.sampleCount()
+           << " frames\n"
+           << sFrameStatistics.average();
+}
+
 void Renderer::finalizeRendering() noexcept
 {
     sShadowCastingLightEntities.clear();
@@ -1004,6 +1747,14 @@ void Renderer::finalizeRendering() noexcept
     sShadowCastingGeometryEntities.clear();
     sNonShadowCastingLightEntities.clear();
     sNonShadowCastingGeometryEntities.clear();
+    sVisibleShadowCastingGeometryEntities.clear();
+    sVisibleNonShadowCastingGeometryEntities.clear();
+    sVisibleShadowCastingLightEntities.clear();
+    sVisibleShadowCastingPointLightEntities.clear();
+    sVisibleNonShadowCastingLightEntities.clear();
+    sShadowCasters.clear();
+    sGeometryQueue.clear();
+    sGeometryQueueEntities.clear();
     sEntitiesLock.release();
 
     const auto& lTextProgram = FlatTextShaderProgram::get();
@@ -1017,6 +1768,8 @@ void Renderer::finalizeRendering() noexcept
 
     sDebugErrorStream->open(sDebugFont);
     sDebugLogStream->open(sDebugFont);
+
+    GT_PROFILE_MEMORY_NEXT_FRAME;
 }
 
 void Renderer::processEvents() noexcept
@@ -1134,7 +1887,6 @@ void Renderer::updateMatrixVM()
     if (sMatrixVMDirty)
     {
         sMatrixVM = sMatrixV * sMatrixM;
-        // sMatrix44Array[0] = sMatrixVM;
         sMatrixVMDirty = false;
     }
 }
@@ -1146,7 +1898,6 @@ void Renderer::updateMatrixPVM()
     if (sMatrixPVMDirty)
     {
         sMatrixPVM = sCameraEntity->camera->projectionMatrix() * sMatrixVM;
-        // sMatrix44Array[1] = sMatrixPVM;
         sMatrixPVMDirty = false;
     }
 }
@@ -1156,8 +1907,7 @@ void Renderer::updateMatrixN()
     updateMatrixVM();
     if (sMatrixNDirty)
     {
-        sMatrixN = sMatrixVM.upperLeft33().invert().transpose();
-        // sMatrix33Array[0] = sMatrixN;
+        sMatrixN = sMatrixVM.normalMatrix();
         sMatrixNDirty = false;
     }
 }
@@ -1406,7 +2156,7 @@ struct SphereRightFace : public SphereFace
 
 void Renderer::drawPackedUnitQuad() noexcept
 {
-    glBindVertexArray(sPackedQuadVAO);
+    OpenGL::StateCache::bindVertexArray(sPackedQuadVAO);
     glBindBuffer(GL_ARRAY_BUFFER, sPackedQuadVBO);
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 }
@@ -1417,7 +2167,7 @@ void Renderer::initializeBasicShapes()
 
     glGenVertexArrays(1, &sPackedQuadVAO);
     glGenBuffers(1, &sPackedQuadVBO);
-    glBindVertexArray(sPackedQuadVAO);
+    OpenGL::StateCache::bindVertexArray(sPackedQuadVAO);
     glBindBuffer(GL_ARRAY_BUFFER, sPackedQuadVBO);
     std::array<float, 16> lPackedQuadArray{{-1.0f, -1.0f, 0.0f, 1.0f, 1.0f,
                                             -1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
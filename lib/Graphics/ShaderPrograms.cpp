@@ -11,13 +11,16 @@ DepthBufferShaderProgram::DepthBufferShaderProgram()
 ShadowShaderProgram::ShadowShaderProgram()
 : OpenGL::ShaderProgram("Shaders/Shadow.vert", "Shaders/Shadow.frag")
 {
-	/* Empty on purpose. */
+	setJointBlockBinding(MaterialShaderProgram::kJointBlockBinding);
 }
 
 MaterialShaderProgram::MaterialShaderProgram()
 : OpenGL::ShaderProgram("Shaders/Material.vert", "Shaders/Material.frag")
 {
-	/* Empty on purpose. */
+	setCameraBlockBinding(kCameraBlockBinding);
+	setObjectBlockBinding(kObjectBlockBinding);
+	setMaterialBlockBinding(kMaterialBlockBinding);
+	setJointBlockBinding(kJointBlockBinding);
 }
 
 AmbientLightShaderProgram::AmbientLightShaderProgram()
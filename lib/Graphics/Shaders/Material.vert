@@ -37,42 +37,33 @@ layout(location = GT_VERTEX_LAYOUT_SLOT_11_12_13) in mat3  iMatrixN;
 layout(location = GT_VERTEX_LAYOUT_SLOT_14)       in ivec4 iBoneID;
 layout(location = GT_VERTEX_LAYOUT_SLOT_15)       in vec4  iBoneWeight;
 
-uniform mat4 matrixPVM;
-uniform mat4 matrixVM;
-uniform mat3 matrixN;
-uniform mat4 matrixB[GT_SKELETON_MAX_JOINTS];
-uniform mat3 matrixBN[GT_SKELETON_MAX_JOINTS];
-uniform int  materialFlag;
-
-// uniform Matrix44Block
-// {
-// 	mat4 projection;
-// 	mat4 view;
-// 	mat4 projectionView;
-// } matrix44;
-
-// uniform Joint44
-// {
-// 	mat4 matrix[GT_SKELETON_MAX_JOINTS];
-// } joint;
-
-// uniform Joint33
-// {
-// 	vec4 matrix[3 * GT_SKELETON_MAX_JOINTS];
-// } normalJoint;
-
-// uniform Matrix44
-// {
-// 	uniform mat4 matrixPVM;
-// 	uniform mat4 matrixVM;
-// 	uniform mat4 matrixB[GT_SKELETON_MAX_JOINTS];
-// } matrix44;
-
-// uniform Matrix33
-// {
-// 	uniform mat3 matrixN;
-// 	uniform mat3 matrixBN[GT_SKELETON_MAX_JOINTS];
-// } matrix33;
+// Uploaded once per frame.
+layout(std140) uniform CameraBlock
+{
+	mat4 matrixP;
+	mat4 matrixV;
+} camera;
+
+// Uploaded per draw call, unless the draw call is instanced.
+layout(std140) uniform ObjectBlock
+{
+	mat4 matrixVM;
+	mat3 matrixN;
+} object;
+
+struct Joint
+{
+	mat4 matrixB;
+	mat3 matrixBN;
+};
+
+// Uploaded per draw call of a mesh with joints.
+layout(std140) uniform JointBlock
+{
+	Joint joints[GT_SKELETON_MAX_JOINTS];
+} skeleton;
+
+uniform int materialFlag;
 
 out vec3 viewSpaceVertexPosition;
 out vec3 viewSpaceVertexNormal;
@@ -85,15 +76,10 @@ vec4 fromBoneSpaceToLocalSpace(in vec4 v)
 {
 	vec4 lTemp = vec4(0.0f, 0.0f, 0.0f, 0.0f);
 
-	lTemp += (matrixB[iBoneID.x] * v) * iBoneWeight.x;
-	lTemp += (matrixB[iBoneID.y] * v) * iBoneWeight.y;
-	lTemp += (matrixB[iBoneID.z] * v) * iBoneWeight.z;
-	lTemp += (matrixB[iBoneID.w] * v) * iBoneWeight.w;
-
-	// lTemp += (joint.matrix[iBoneID.x] * v) * iBoneWeight.x;
-	// lTemp += (joint.matrix[iBoneID.y] * v) * iBoneWeight.y;
-	// lTemp += (joint.matrix[iBoneID.z] * v) * iBoneWeight.z;
-	// lTemp += (joint.matrix[iBoneID.w] * v) * iBoneWeight.w;
+	lTemp += (skeleton.joints[iBoneID.x].matrixB * v) * iBoneWeight.x;
+	lTemp += (skeleton.joints[iBoneID.y].matrixB * v) * iBoneWeight.y;
+	lTemp += (skeleton.joints[iBoneID.z].matrixB * v) * iBoneWeight.z;
+	lTemp += (skeleton.joints[iBoneID.w].matrixB * v) * iBoneWeight.w;
 
 	return lTemp;
 }
@@ -102,25 +88,10 @@ vec3 fromBoneSpaceToNormalSpace(in vec3 v)
 {
 	vec3 lTemp = vec3(0.0f, 0.0f, 0.0f);
 
-	lTemp += (matrixBN[iBoneID.x] * v) * iBoneWeight.x;
-	lTemp += (matrixBN[iBoneID.y] * v) * iBoneWeight.y;
-	lTemp += (matrixBN[iBoneID.z] * v) * iBoneWeight.z;
-	lTemp += (matrixBN[iBoneID.w] * v) * iBoneWeight.w;
-	
-	// mat3 lMatrixX = transpose(inverse(mat3(joint.matrix[iBoneID.x])));
-	// mat3 lMatrixY = transpose(inverse(mat3(joint.matrix[iBoneID.y])));
-	// mat3 lMatrixZ = transpose(inverse(mat3(joint.matrix[iBoneID.z])));
-	// mat3 lMatrixW = transpose(inverse(mat3(joint.matrix[iBoneID.w])));
-
-	// lTemp += (lMatrixX * v) * iBoneWeight.x;
-	// lTemp += (lMatrixY * v) * iBoneWeight.y;
-	// lTemp += (lMatrixZ * v) * iBoneWeight.z;
-	// lTemp += (lMatrixW * v) * iBoneWeight.w;
-
-	// lTemp += (normalJoint.matrix[iBoneID.x] * v) * iBoneWeight.x;
-	// lTemp += (normalJoint.matrix[iBoneID.y] * v) * iBoneWeight.y;
-	// lTemp += (normalJoint.matrix[iBoneID.z] * v) * iBoneWeight.z;
-	// lTemp += (normalJoint.matrix[iBoneID.w] * v) * iBoneWeight.w;
+	lTemp += (skeleton.joints[iBoneID.x].matrixBN * v) * iBoneWeight.x;
+	lTemp += (skeleton.joints[iBoneID.y].matrixBN * v) * iBoneWeight.y;
+	lTemp += (skeleton.joints[iBoneID.z].matrixBN * v) * iBoneWeight.z;
+	lTemp += (skeleton.joints[iBoneID.w].matrixBN * v) * iBoneWeight.w;
 
 	return lTemp;
 }
@@ -152,9 +123,10 @@ void main()
 	}
 	else
 	{
-		gl_Position             =  matrixPVM * localPosition;
-		viewSpaceVertexPosition = (matrixVM  * localPosition).xyz;
-		viewSpaceVertexNormal   =  matrixN   * localNormal;
+		vec4 viewSpacePosition  =  object.matrixVM * localPosition;
+		gl_Position             =  camera.matrixP  * viewSpacePosition;
+		viewSpaceVertexPosition =  viewSpacePosition.xyz;
+		viewSpaceVertexNormal   =  object.matrixN  * localNormal;
 		
 		if (checkFlag(HAS_TANGENTS_AND_BITANGENTS))
 		{
@@ -162,9 +134,9 @@ void main()
 			vec3 localBitangent = cross(localNormal, localTangent) * iSlot2.w;
 
 			tangentMatrix = mat3(
-				matrixN * localTangent, 
-				matrixN * localBitangent, 
-				matrixN * localNormal);
+				object.matrixN * localTangent, 
+				object.matrixN * localBitangent, 
+				object.matrixN * localNormal);
 		}
 	}
 }
\ No newline at end of file
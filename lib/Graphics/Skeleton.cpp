@@ -1,4 +1,5 @@
 #include "Graphics/Skeleton.hpp"
+#include "Math/SQTArray.hpp"
 #include <iostream>
 
 namespace gintonic
@@ -24,6 +25,39 @@ std::ostream& operator<<(std::ostream& os, const Skeleton::Joint& joint)
     return os << ']';
 }
 
+void Skeleton::compose(const SQTArray& localPose, mat4f* outPalette) const
+    noexcept
+{
+    const auto lJointCount = static_cast<uint8_t>(localPose.size());
+
+    // The global transform of every joint. A joint is composed with its
+    // parent once the parent is done. Usually the parents come first, but
+    // the skeleton does not promise that, so a joint whose parent is not
+    // done yet takes the path up to the first ancestor that is.
+    mat4f lGlobal[GT_SKELETON_MAX_JOINTS];
+    bool lDone[GT_SKELETON_MAX_JOINTS] = {false};
+    uint8_t lPath[GT_SKELETON_MAX_JOINTS];
+
+    for (uint8_t i = 0; i < lJointCount; ++i)
+    {
+        uint8_t lPathLength = 0;
+        for (auto j = i; j != GT_JOINT_NONE && !lDone[j]; j = joints[j].parent)
+        {
+            lPath[lPathLength++] = j;
+        }
+        while (lPathLength)
+        {
+            const auto j = lPath[--lPathLength];
+            const auto lParent = joints[j].parent;
+            const mat4f lLocal(localPose.get(j));
+            lGlobal[j] = lParent == GT_JOINT_NONE ? lLocal
+                                                  : lGlobal[lParent] * lLocal;
+            lDone[j] = true;
+        }
+        outPalette[i] = lGlobal[i] * joints[i].inverseBindPose;
+    }
+}
+
 std::ostream& operator<<(std::ostream& os, const Skeleton& skeleton)
 {
     os << "\nSkeleton name: " << skeleton.name << "\nJoints:\n";
@@ -0,0 +1,60 @@
+#include "Graphics/SkinnedPositions.hpp"
+#include "Graphics/FrameStatistics.hpp"
+#include "Foundation/WorkerPool.hpp"
+#include "Math/Skinning.hpp"
+
+namespace gintonic
+{
+
+void SkinnedPositions::update(const Mesh& mesh, const mat4f* palette,
+                              const std::size_t jointCount,
+                              WorkerPool& workers)
+{
+    GT_PROFILE_MEMORY(Mesh);
+
+    static_assert(sizeof(Mesh::vec3f) == 3 * sizeof(float),
+                  "Mesh::vec3f must be three packed floats.");
+    static_assert(sizeof(Mesh::vec4i) == 4 * sizeof(std::int32_t),
+                  "Mesh::vec4i must be four packed ints.");
+
+    mMesh = &mesh;
+    const auto& lSource = mesh.adjacentPositions();
+    mPositions.resize(lSource.size());
+
+    const auto lPositions = &lSource.data()->x;
+    const auto lVertices = mesh.adjacentPositionVertices().data();
+    const auto lJointIndices = &mesh.jointIndices().data()->x;
+    const auto lJointWeights = &mesh.jointWeights().data()->x;
+    const auto lResult = &mPositions.data()->x;
+
+    workers.run(mPositions.size(), mChunkSize,
+                [=](const std::size_t first, const std::size_t last) {
+                    skinPositions(palette, jointCount, lPositions, lVertices,
+                                  lJointIndices, lJointWeights, first, last,
+                                  lResult);
+                });
+}
+
+void SkinnedPositions::upload()
+{
+    OpenGL::StateCache::bindVertexArray(mVertexArrayObject);
+    glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+    gtBufferData(GL_ARRAY_BUFFER, mPositions, GL_STREAM_DRAW);
+    if (mBoundMesh != mMesh)
+    {
+        // The vertex array object remembers the index buffer.
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mMesh->adjacencyIndexBuffer());
+        Mesh::vec3f::enableAttribute(GT_VERTEX_LAYOUT_SLOT_0);
+        mBoundMesh = mMesh;
+    }
+}
+
+void SkinnedPositions::drawAdjacent() const noexcept
+{
+    FrameSample::current().addDrawCall(mMesh->numIndicesAdjacent() / 6);
+    OpenGL::StateCache::bindVertexArray(mVertexArrayObject);
+    glDrawElements(GL_TRIANGLES_ADJACENCY, mMesh->numIndicesAdjacent(),
+                   GL_UNSIGNED_INT, nullptr);
+}
+
+} // namespace gintonic
@@ -0,0 +1,262 @@
+#include "Graphics/SkinningCache.hpp"
+#include "Entity.hpp"
+#include "Foundation/WorkerPool.hpp"
+#include "Graphics/AnimationBlend.hpp"
+#include "Graphics/AnimationClip.hpp"
+#include "Graphics/Mesh.hpp"
+#include "Graphics/PosePool.hpp"
+#include "Math/Transforms.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+namespace gintonic
+{
+
+constexpr std::uint32_t SkinningCache::kNone;
+
+SkinningCache::SkinningCache(WorkerPool& workers) : mWorkers(workers)
+{
+    /* Empty on purpose. */
+}
+
+bool SkinningCache::isSkinned(const Entity& entity) noexcept
+{
+    return (entity.activeAnimationClip || entity.activeAnimationBlend) &&
+           entity.mesh && entity.mesh->hasSkinning();
+}
+
+std::size_t SkinningCache::KeyHash::operator()(const Key& key) const noexcept
+{
+    const auto lClip = std::hash<const AnimationClip*>()(key.clip);
+    const auto lTime = std::hash<std::int64_t>()(key.time);
+    return lClip ^ (lTime + 0x9e3779b9 + (lClip << 6) + (lClip >> 2));
+}
+
+void SkinningCache::clear(const float elapsedTime) noexcept
+{
+    mPalettes.clear();
+    mSources.clear();
+    mIndices.clear();
+    mShared.clear();
+    mJointCount = 0;
+    mElapsedTime = elapsedTime;
+    mHits = 0;
+    mMisses = 0;
+}
+
+std::uint32_t SkinningCache::add(const Entity& entity)
+{
+    if (!isSkinned(entity)) return kNone;
+    const auto lExisting = mIndices.find(&entity);
+    if (lExisting != mIndices.end()) return lExisting->second;
+    const auto lIndex = static_cast<std::uint32_t>(mPalettes.size());
+
+    Source lSource;
+    lSource.blend = entity.activeAnimationBlend;
+    lSource.matrices = nullptr;
+    lSource.normalMatrices = nullptr;
+
+    Palette lPalette;
+    lPalette.entity = &entity;
+    lPalette.offset = mJointCount;
+
+    if (lSource.blend)
+    {
+        // Written here rather than in the workers, since several blends
+        // may share a clip.
+        for (const auto& lLayer : lSource.blend->layers)
+        {
+            if (lLayer.clip->isPacked() || lLayer.clip->isCompressed())
+            {
+                continue;
+            }
+            const_cast<AnimationClip*>(lLayer.clip)->pack();
+        }
+        lSource.key.clip = nullptr;
+        lSource.key.time = lIndex;
+        lSource.startTime = 0.0f;
+        lPalette.count = lSource.blend->jointCount();
+        mIndices.emplace(&entity, lIndex);
+        mJointCount += lPalette.count;
+        mPalettes.push_back(lPalette);
+        mSources.push_back(lSource);
+        return lIndex;
+    }
+
+    // Written here rather than in the workers, since several entities may
+    // share the clip.
+    const auto lClip = entity.activeAnimationClip;
+    lClip->isLooping = false;
+    if (!lClip->isPacked() && !lClip->isCompressed()) lClip->pack();
+
+    lSource.key.clip = lClip;
+    if (mQuantum > 0.0f)
+    {
+        // The clip does not loop, so every time past its end is the same
+        // pose.
+        const auto lEnd = std::ceil(lClip->duration() / mQuantum);
+        const auto lTime =
+            std::round((mElapsedTime - entity.activeAnimationStartTime) /
+                       mQuantum);
+        lSource.key.time =
+            static_cast<std::int64_t>(std::min(std::max(lTime, 0.0f), lEnd));
+        lSource.startTime =
+            mElapsedTime - static_cast<float>(lSource.key.time) * mQuantum;
+    }
+    else
+    {
+        std::uint32_t lBits;
+        std::memcpy(&lBits, &entity.activeAnimationStartTime, sizeof(lBits));
+        lSource.key.time = lBits;
+        lSource.startTime = entity.activeAnimationStartTime;
+    }
+
+    const auto lShared = mShared.emplace(lSource.key, lIndex);
+    mIndices.emplace(&entity, lShared.first->second);
+    if (!lShared.second)
+    {
+        ++mHits;
+        return lShared.first->second;
+    }
+
+    lPalette.count = lClip->jointCount();
+    mJointCount += lPalette.count;
+    mPalettes.push_back(lPalette);
+    mSources.push_back(lSource);
+    return lIndex;
+}
+
+void SkinningCache::evaluate()
+{
+    mJointMatrices.resize(mJointCount);
+    mJointNormalMatrices.resize(mJointCount);
+
+    // Look up the poses of earlier frames before the workers start, since
+    // the list of poses is not safe to touch from several threads.
+    const auto lKeep = mQuantum > 0.0f && mCapacity > 0;
+    for (std::size_t i = 0; i < mSources.size(); ++i)
+    {
+        auto& lSource = mSources[i];
+        const auto lIter = lKeep && !lSource.blend
+                               ? mPoseIndices.find(lSource.key)
+                               : mPoseIndices.end();
+        if (lIter == mPoseIndices.end() ||
+            lIter->second->matrices.size() != mPalettes[i].count)
+        {
+            ++mMisses;
+            continue;
+        }
+        mPoses.splice(mPoses.begin(), mPoses, lIter->second);
+        lSource.matrices = &lIter->second->matrices;
+        lSource.normalMatrices = &lIter->second->normalMatrices;
+        ++mHits;
+    }
+
+    mWorkers.run(mPalettes.size(), mChunkSize,
+                 [this](const std::size_t first, const std::size_t last) {
+                     evaluateRange(first, last);
+                 });
+
+    if (!lKeep) return;
+    for (std::size_t i = 0; i < mSources.size(); ++i)
+    {
+        const auto& lSource = mSources[i];
+        if (!lSource.matrices && !lSource.blend)
+        {
+            keepPose(lSource, mPalettes[i]);
+        }
+    }
+}
+
+void SkinningCache::evaluateRange(const std::size_t first,
+                                  const std::size_t last)
+{
+    for (auto i = first; i < last; ++i)
+    {
+        const auto& lPalette = mPalettes[i];
+        const auto& lSource = mSources[i];
+        const auto lMatricesB = mJointMatrices.data() + lPalette.offset;
+        const auto lMatricesBN = mJointNormalMatrices.data() + lPalette.offset;
+        if (lSource.matrices)
+        {
+            std::copy(lSource.matrices->begin(), lSource.matrices->end(),
+                      lMatricesB);
+            std::copy(lSource.normalMatrices->begin(),
+                      lSource.normalMatrices->end(), lMatricesBN);
+            continue;
+        }
+        if (lSource.blend)
+        {
+            // Every worker blends with its own buffers.
+            thread_local PosePool lPool;
+            lSource.blend->evaluatePose(mElapsedTime, lPool, lMatricesB);
+        }
+        else
+        {
+            lSource.key.clip->evaluatePose(lSource.startTime, mElapsedTime,
+                                           lMatricesB);
+        }
+        normalMatrices(lMatricesB, lPalette.count, lMatricesBN);
+    }
+}
+
+void SkinningCache::keepPose(const Source& source, const Palette& palette)
+{
+    const auto lExisting = mPoseIndices.find(source.key);
+    if (lExisting != mPoseIndices.end())
+    {
+        mPoses.erase(lExisting->second);
+        mPoseIndices.erase(lExisting);
+    }
+    if (mPoses.size() < mCapacity)
+    {
+        mPoses.emplace_front();
+    }
+    else
+    {
+        // Reuse the least recently used pose, and its memory.
+        const auto lLast = std::prev(mPoses.end());
+        mPoseIndices.erase(lLast->key);
+        mPoses.splice(mPoses.begin(), mPoses, lLast);
+    }
+    auto& lPose = mPoses.front();
+    lPose.key = source.key;
+    const auto lMatricesB = mJointMatrices.begin() + palette.offset;
+    const auto lMatricesBN = mJointNormalMatrices.begin() + palette.offset;
+    lPose.matrices.assign(lMatricesB, lMatricesB + palette.count);
+    lPose.normalMatrices.assign(lMatricesBN, lMatricesBN + palette.count);
+    mPoseIndices[source.key] = mPoses.begin();
+}
+
+void SkinningCache::setQuantum(const float quantum)
+{
+    if (quantum == mQuantum) return;
+    mQuantum = std::max(quantum, 0.0f);
+    clearPoses();
+}
+
+void SkinningCache::setCapacity(const std::size_t capacity)
+{
+    mCapacity = capacity;
+    while (mPoses.size() > mCapacity)
+    {
+        mPoseIndices.erase(mPoses.back().key);
+        mPoses.pop_back();
+    }
+}
+
+void SkinningCache::clearPoses() noexcept
+{
+    mPoses.clear();
+    mPoseIndices.clear();
+}
+
+std::uint32_t SkinningCache::find(const Entity* entity) const noexcept
+{
+    const auto lIter = mIndices.find(entity);
+    return lIter == mIndices.end() ? kNone : lIter->second;
+}
+
+} // namespace gintonic
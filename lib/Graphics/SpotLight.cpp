@@ -1,6 +1,7 @@
 #include "Graphics/SpotLight.hpp"
 
 #include "Math/SQT.hpp"
+#include "Math/sphere3f.hpp"
 
 #include "Graphics/Mesh.hpp"
 #include "Graphics/Renderer.hpp"
@@ -9,6 +10,8 @@
 
 #include "Entity.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 
@@ -122,14 +125,14 @@ void SpotLight::shine(
 
         lProgram.setDebugFlag(1);
 #endif
-        glCullFace(GL_FRONT);
+        OpenGL::StateCache::cullFace(GL_FRONT);
     }
     else // Outside
     {
 #ifdef DEBUG_SPOT_LIGHTS
         lProgram.setDebugFlag(2);
 #endif
-        glCullFace(GL_BACK);
+        OpenGL::StateCache::cullFace(GL_BACK);
     }
 
 #ifdef DEBUG_SPOT_LIGHTS
@@ -150,6 +153,43 @@ float SpotLight::getCosineHalfAngle() const noexcept
     return mCosineHalfAngle;
 }
 
+bool SpotLight::getBoundingSphere(const Entity& lightEntity,
+                                  sphere3f& sphere) const noexcept
+{
+    if (!Super::getBoundingSphere(lightEntity, sphere)) return false;
+
+    // The shader lights a pixel when cos(angle) + mCosineHalfAngle >= 1, so
+    // this is the actual cosine of the half angle of the cone.
+    const auto lCosine =
+        std::max(-1.0f, std::min(1.0f, 1.0f - mCosineHalfAngle));
+
+    // A cone of more than a hemisphere has the sphere around the apex.
+    if (lCosine <= 0.0f) return true;
+
+    const auto lRadius = getCutoffRadius();
+    const vec3f lDirection =
+        vec3f((lightEntity.globalTransform() * vec4f(0.0f, 0.0f, -1.0f, 0.0f))
+                  .data)
+            .normalize();
+
+    // For a narrow cone the rim is the widest part and the apex lies on the
+    // sphere through the rim. Beyond 45 degrees the sphere around the rim
+    // contains the apex.
+    float lDistance;
+    if (lCosine * lCosine >= 0.5f)
+    {
+        sphere.radius = lRadius / (2.0f * lCosine);
+        lDistance = sphere.radius;
+    }
+    else
+    {
+        sphere.radius = lRadius * std::sqrt(1.0f - lCosine * lCosine);
+        lDistance = lRadius * lCosine;
+    }
+    sphere.center += lDistance * lDirection;
+    return true;
+}
+
 void SpotLight::initializeShadowBuffer(Entity& lightEntity) const
 {
     lightEntity.shadowBuffer.reset(new SpotShadowBuffer());
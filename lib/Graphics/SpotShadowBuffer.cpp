@@ -2,6 +2,7 @@
 
 #include "Foundation/exception.hpp"
 
+#include "Math/frustum3f.hpp"
 #include "Math/mat4f.hpp"
 
 #include "Graphics/Light.hpp"
@@ -17,7 +18,7 @@ namespace gintonic {
 SpotShadowBuffer::SpotShadowBuffer()
 {
 	mFramebuffer.bind(GL_DRAW_FRAMEBUFFER);
-	glBindTexture(GL_TEXTURE_2D, mTexture);
+	OpenGL::StateCache::bindTexture(GL_TEXTURE_2D, mTexture);
 	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
@@ -47,13 +48,24 @@ void SpotShadowBuffer::collect(
 	mFramebuffer.bind(GL_DRAW_FRAMEBUFFER);
 	glViewport(0, 0, SHADOW_QUALITY, SHADOW_QUALITY);
 	glClear(GL_DEPTH_BUFFER_BIT);
-	glCullFace(GL_FRONT);
+	OpenGL::StateCache::cullFace(GL_FRONT);
 
 	const auto& lProgram = ShadowShaderProgram::get();
 	lProgram.activate();
 
-	for (const auto lGeometryEntity : shadowCastingGeometryEntities)
+	// Only the casters in the frustum of the light end up in the shadow map.
+	const auto& lCasters = Renderer::cullShadowCasters(lightEntity,
+		frustum3f(lProjectionViewMatrix), shadowCastingGeometryEntities);
+
+	GLint lLastMeshHasJoints = -1;
+	for (const auto lGeometryEntity : lCasters)
 	{
+		const GLint lMeshHasJoints = Renderer::bindJointBlock(*lGeometryEntity);
+		if (lMeshHasJoints != lLastMeshHasJoints)
+		{
+			lProgram.setMeshHasJoints(lMeshHasJoints);
+			lLastMeshHasJoints = lMeshHasJoints;
+		}
 		lProjectionViewModelMatrix = lProjectionViewMatrix * lGeometryEntity->globalTransform();
 		lProgram.setMatrixPVM(lProjectionViewModelMatrix);
 		lGeometryEntity->mesh->draw();
@@ -53,7 +53,7 @@ void Texture2D::loadFromFile(boost::filesystem::path filename)
 		default: throw UnknownImageFormatException();
 	}
 	
-	glBindTexture(GL_TEXTURE_2D, mTextureObject);
+	OpenGL::StateCache::bindTexture(GL_TEXTURE_2D, mTextureObject);
 
 	glTexImage2D(GL_TEXTURE_2D, 0, lFormat, 
 		static_cast<GLsizei>(lWidth), static_cast<GLsizei>(lHeight), 0, 
@@ -32,7 +32,7 @@ void skybox::draw() const noexcept
 	// diffuse_texture.bind(0);
 
 	// We must enable depth testing.
-	glEnable(GL_DEPTH_TEST);
+	OpenGL::StateCache::enable(GL_DEPTH_TEST);
 
 	// // We render from the inside of a cube, so we must flip
 	// // our definition of what we call a front face triangle.
@@ -40,12 +40,12 @@ void skybox::draw() const noexcept
 
 	// Change depth function so depth test passes when values
 	// are equal to depth buffer's content
-	glDepthFunc(GL_LEQUAL);
+	OpenGL::StateCache::depthFunc(GL_LEQUAL);
 	
 	Renderer::getInsideOutUnitCube()->draw();
 
 	// Restore default values.
-	glDepthFunc(GL_LESS);
+	OpenGL::StateCache::depthFunc(GL_LESS);
 	// glFrontFace(GL_CCW);
 }
 
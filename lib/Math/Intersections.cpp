@@ -0,0 +1,654 @@
+#include "Math/Intersections.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace gintonic {
+namespace { // anonymous namespace
+
+// The dot product of the x, y and z coordinates; w is ignored.
+inline float dot3(const vec3f& a, const vec3f& b) noexcept
+{
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// The normal of a plane of a frustum.
+inline vec3f normalOf(const vec4f& plane) noexcept
+{
+	return vec3f(plane.x, plane.y, plane.z);
+}
+
+// The signed distance of a point to a plane of a frustum.
+inline float signedDistance(const vec4f& plane, const vec3f& point) noexcept
+{
+	return plane.x * point.x + plane.y * point.y + plane.z * point.z
+		+ plane.w;
+}
+
+// The radius of an oriented box, projected on some axis.
+inline float projectedRadius(const obb3f& box, const vec3f& axis) noexcept
+{
+	return box.extent.x * std::abs(dot3(axis, box.axes[0]))
+		+ box.extent.y * std::abs(dot3(axis, box.axes[1]))
+		+ box.extent.z * std::abs(dot3(axis, box.axes[2]));
+}
+
+// One over the direction of a ray. Zero coordinates are replaced by tiny
+// ones of the same sign, so that the slab tests never compute 0 * infinity.
+inline __m128 inverseDirection(const __m128 direction) noexcept
+{
+	const auto lSignMask = _mm_set1_ps(-0.0f);
+	const auto lMagnitude = _mm_max_ps(_mm_andnot_ps(lSignMask, direction),
+		_mm_set1_ps(1e-20f));
+	return _mm_div_ps(_mm_set1_ps(1.0f),
+		_mm_or_ps(lMagnitude, _mm_and_ps(lSignMask, direction)));
+}
+
+// The slab test of a ray against the box [minCorner, maxCorner].
+bool slabs(const vec3f& origin, const vec3f& direction,
+	const vec3f& minCorner, const vec3f& maxCorner, float& distance) noexcept
+{
+	const auto lInverse = inverseDirection(direction.data);
+	const auto lT1 = _mm_mul_ps(_mm_sub_ps(minCorner.data, origin.data),
+		lInverse);
+	const auto lT2 = _mm_mul_ps(_mm_sub_ps(maxCorner.data, origin.data),
+		lInverse);
+	const vec3f lNear(_mm_min_ps(lT1, lT2));
+	const vec3f lFar(_mm_max_ps(lT1, lT2));
+	const auto lEnter = std::max(std::max(lNear.x, lNear.y),
+		std::max(lNear.z, 0.0f));
+	const auto lExit = std::min(std::min(lFar.x, lFar.y), lFar.z);
+	distance = lEnter;
+	return lEnter <= lExit;
+}
+
+// The point where three planes meet. Returns false if they don't meet in
+// exactly one point.
+bool meet(const vec4f& p, const vec4f& q, const vec4f& r, vec3f& point)
+	noexcept
+{
+	const auto lP = normalOf(p);
+	const auto lQ = normalOf(q);
+	const auto lR = normalOf(r);
+	const auto lQR = cross(lQ, lR);
+	const auto lDeterminant = dot3(lP, lQR);
+	if (std::abs(lDeterminant) < 1e-6f) return false;
+	point = (p.w * lQR + q.w * cross(lR, lP) + r.w * cross(lP, lQ))
+		/ -lDeterminant;
+	return true;
+}
+
+// The eight corners of a frustum. Returns false if the frustum is
+// unbounded, for instance when it has no far plane.
+bool getCorners(const frustum3f& frustum, vec3f* corners) noexcept
+{
+	int lIndex = 0;
+	for (const int lDepth : {frustum3f::kNear, frustum3f::kFar})
+	{
+		for (const int lHeight : {frustum3f::kBottom, frustum3f::kTop})
+		{
+			for (const int lWidth : {frustum3f::kLeft, frustum3f::kRight})
+			{
+				if (!meet(frustum.planes[lDepth], frustum.planes[lHeight],
+					frustum.planes[lWidth], corners[lIndex++]))
+				{
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+// Wether one of the planes of a frustum has all the points behind it.
+bool separates(const frustum3f& frustum, const vec3f* points,
+	const int count) noexcept
+{
+	for (const auto& lPlane : frustum.planes)
+	{
+		int i = 0;
+		while (i < count && signedDistance(lPlane, points[i]) < 0.0f) ++i;
+		if (i == count) return true;
+	}
+	return false;
+}
+
+// Four boxes, transposed such that lane i holds the coordinates of box i.
+struct FourBoxes
+{
+	__m128 minX, minY, minZ;
+	__m128 maxX, maxY, maxZ;
+
+	explicit FourBoxes(const box3f* boxes) noexcept
+	{
+		auto lW = boxes[3].minCorner.data;
+		minX = boxes[0].minCorner.data;
+		minY = boxes[1].minCorner.data;
+		minZ = boxes[2].minCorner.data;
+		_MM_TRANSPOSE4_PS(minX, minY, minZ, lW);
+		lW = boxes[3].maxCorner.data;
+		maxX = boxes[0].maxCorner.data;
+		maxY = boxes[1].maxCorner.data;
+		maxZ = boxes[2].maxCorner.data;
+		_MM_TRANSPOSE4_PS(maxX, maxY, maxZ, lW);
+	}
+
+	// Compute the centers and the half extents.
+	void centers(__m128* center, __m128* extent) const noexcept
+	{
+		const auto lHalf = _mm_set1_ps(0.5f);
+		center[0] = _mm_mul_ps(lHalf, _mm_add_ps(minX, maxX));
+		center[1] = _mm_mul_ps(lHalf, _mm_add_ps(minY, maxY));
+		center[2] = _mm_mul_ps(lHalf, _mm_add_ps(minZ, maxZ));
+		extent[0] = _mm_mul_ps(lHalf, _mm_sub_ps(maxX, minX));
+		extent[1] = _mm_mul_ps(lHalf, _mm_sub_ps(maxY, minY));
+		extent[2] = _mm_mul_ps(lHalf, _mm_sub_ps(maxZ, minZ));
+	}
+};
+
+inline __m128 abs4(const __m128 v) noexcept
+{
+	return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+
+// The signed distances of four points to the plane (a, b, c, d).
+inline __m128 distances4(const vec4f& plane, const __m128* points) noexcept
+{
+	auto lResult = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), points[0]),
+		_mm_set1_ps(plane.w));
+	lResult = _mm_add_ps(lResult,
+		_mm_mul_ps(_mm_set1_ps(plane.y), points[1]));
+	return _mm_add_ps(lResult, _mm_mul_ps(_mm_set1_ps(plane.z), points[2]));
+}
+
+// The radii of four boxes, projected on the axis (a, b, c).
+inline __m128 radii4(const vec4f& axis, const __m128* extent) noexcept
+{
+	auto lResult = _mm_mul_ps(_mm_set1_ps(std::abs(axis.x)), extent[0]);
+	lResult = _mm_add_ps(lResult,
+		_mm_mul_ps(_mm_set1_ps(std::abs(axis.y)), extent[1]));
+	return _mm_add_ps(lResult,
+		_mm_mul_ps(_mm_set1_ps(std::abs(axis.z)), extent[2]));
+}
+
+} // anonymous namespace
+
+bool intersects(const ray3f& ray, const frustum3f& frustum, float& distance)
+	noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	// Clip the ray against every plane.
+	auto lEnter = 0.0f;
+	auto lExit = std::numeric_limits<float>::infinity();
+	for (const auto& lPlane : frustum.planes)
+	{
+		const auto lDistance = signedDistance(lPlane, ray.origin);
+		const auto lSpeed = dot3(normalOf(lPlane), ray.direction);
+		if (lSpeed == 0.0f)
+		{
+			if (lDistance < 0.0f) return false;
+		}
+		else if (lSpeed > 0.0f)
+		{
+			lEnter = std::max(lEnter, -lDistance / lSpeed);
+		}
+		else
+		{
+			lExit = std::min(lExit, -lDistance / lSpeed);
+		}
+	}
+	distance = lEnter;
+	return lEnter <= lExit;
+}
+
+bool intersects(const ray3f& ray, const plane3f& plane, float& distance)
+	noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const auto lDistance = plane.distance(ray.origin);
+	const auto lSpeed = dot3(plane.normal(), ray.direction);
+	if (std::abs(lSpeed) < 1e-6f)
+	{
+		distance = 0.0f;
+		return std::abs(lDistance) < 1e-6f;
+	}
+	distance = -lDistance / lSpeed;
+	return distance >= 0.0f;
+}
+
+bool intersects(const ray3f& ray, const sphere3f& sphere, float& distance)
+	noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const vec3f lDelta(ray.origin.x - sphere.center.x,
+		ray.origin.y - sphere.center.y, ray.origin.z - sphere.center.z);
+	const auto lB = dot3(lDelta, ray.direction);
+	const auto lC = dot3(lDelta, lDelta) - sphere.radius * sphere.radius;
+
+	// Outside of the sphere and pointing away from it.
+	if (lC > 0.0f && lB > 0.0f) return false;
+
+	const auto lDiscriminant = lB * lB - lC;
+	if (lDiscriminant < 0.0f) return false;
+	distance = std::max(0.0f, -lB - std::sqrt(lDiscriminant));
+	return true;
+}
+
+bool intersects(const ray3f& ray, const obb3f& box, float& distance)
+	noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	// Do the slab test in the space of the box.
+	const vec3f lDelta(ray.origin.x - box.center.x,
+		ray.origin.y - box.center.y, ray.origin.z - box.center.z);
+	const vec3f lOrigin(dot3(lDelta, box.axes[0]), dot3(lDelta, box.axes[1]),
+		dot3(lDelta, box.axes[2]));
+	const vec3f lDirection(dot3(ray.direction, box.axes[0]),
+		dot3(ray.direction, box.axes[1]), dot3(ray.direction, box.axes[2]));
+	return slabs(lOrigin, lDirection, -box.extent, box.extent, distance);
+}
+
+bool intersects(const ray3f& ray, const box3f& box, float& distance)
+	noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	return slabs(ray.origin, ray.direction, box.minCorner, box.maxCorner,
+		distance);
+}
+
+bool intersects(const frustum3f& a, const frustum3f& b) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	vec3f lCorners[8];
+	if (getCorners(b, lCorners) && separates(a, lCorners, 8)) return false;
+	if (getCorners(a, lCorners) && separates(b, lCorners, 8)) return false;
+	return true;
+}
+
+bool intersects(const frustum3f& frustum, const plane3f& plane) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	vec3f lCorners[8];
+	if (!getCorners(frustum, lCorners)) return true;
+	bool lInFront = false;
+	bool lBehind = false;
+	for (const auto& lCorner : lCorners)
+	{
+		const auto lDistance = plane.distance(lCorner);
+		lInFront |= lDistance >= 0.0f;
+		lBehind |= lDistance <= 0.0f;
+	}
+	return lInFront && lBehind;
+}
+
+bool intersects(const frustum3f& frustum, const sphere3f& sphere) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	for (const auto& lPlane : frustum.planes)
+	{
+		if (signedDistance(lPlane, sphere.center) < -sphere.radius)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool intersects(const frustum3f& frustum, const obb3f& box) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	for (const auto& lPlane : frustum.planes)
+	{
+		const auto lDistance = signedDistance(lPlane, box.center);
+		if (lDistance + projectedRadius(box, normalOf(lPlane)) < 0.0f)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool intersects(const frustum3f& frustum, const box3f& box) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	return frustum.intersects(box);
+}
+
+bool intersects(const plane3f& a, const plane3f& b) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const auto lNormalA = a.normal();
+	const auto lNormalB = b.normal();
+	if (cross(lNormalA, lNormalB).length2() > 1e-12f) return true;
+
+	// The planes are parallel, so they must be the same plane.
+	const auto lOffset = dot3(lNormalA, lNormalB) > 0.0f
+		? a.equation.w - b.equation.w : a.equation.w + b.equation.w;
+	return std::abs(lOffset) < 1e-6f;
+}
+
+bool intersects(const plane3f& plane, const sphere3f& sphere) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	return std::abs(plane.distance(sphere.center)) <= sphere.radius;
+}
+
+bool intersects(const plane3f& plane, const obb3f& box) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	return std::abs(plane.distance(box.center))
+		<= projectedRadius(box, plane.normal());
+}
+
+bool intersects(const plane3f& plane, const box3f& box) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const auto lCenter = 0.5f * (box.minCorner + box.maxCorner);
+	const auto lExtent = 0.5f * (box.maxCorner - box.minCorner);
+	const auto lRadius = std::abs(plane.equation.x) * lExtent.x
+		+ std::abs(plane.equation.y) * lExtent.y
+		+ std::abs(plane.equation.z) * lExtent.z;
+	return std::abs(plane.distance(lCenter)) <= lRadius;
+}
+
+bool intersects(const sphere3f& a, const sphere3f& b) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const vec3f lDelta(a.center.x - b.center.x, a.center.y - b.center.y,
+		a.center.z - b.center.z);
+	const auto lRadius = a.radius + b.radius;
+	return dot3(lDelta, lDelta) <= lRadius * lRadius;
+}
+
+bool intersects(const sphere3f& sphere, const obb3f& box) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	// The distance to the closest point, in the space of the box.
+	const vec3f lDelta(sphere.center.x - box.center.x,
+		sphere.center.y - box.center.y, sphere.center.z - box.center.z);
+	const vec3f lLocal(std::abs(dot3(lDelta, box.axes[0])),
+		std::abs(dot3(lDelta, box.axes[1])),
+		std::abs(dot3(lDelta, box.axes[2])));
+	const vec3f lOutside(_mm_max_ps(_mm_sub_ps(lLocal.data, box.extent.data),
+		_mm_setzero_ps()));
+	return dot3(lOutside, lOutside) <= sphere.radius * sphere.radius;
+}
+
+bool intersects(const sphere3f& sphere, const box3f& box) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	// The distance to the closest point of the box.
+	const vec3f lOutside(_mm_max_ps(
+		_mm_max_ps(_mm_sub_ps(box.minCorner.data, sphere.center.data),
+			_mm_sub_ps(sphere.center.data, box.maxCorner.data)),
+		_mm_setzero_ps()));
+	return dot3(lOutside, lOutside) <= sphere.radius * sphere.radius;
+}
+
+bool intersects(const obb3f& a, const obb3f& b) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	// The rotation from the space of b to the space of a. The epsilon keeps
+	// the cross products of (nearly) parallel axes from separating anything.
+	float lRotation[3][3];
+	float lAbsolute[3][3];
+	for (int i = 0; i < 3; ++i)
+	{
+		for (int j = 0; j < 3; ++j)
+		{
+			lRotation[i][j] = dot3(a.axes[i], b.axes[j]);
+			lAbsolute[i][j] = std::abs(lRotation[i][j]) + 1e-6f;
+		}
+	}
+
+	const vec3f lDelta(b.center.x - a.center.x, b.center.y - a.center.y,
+		b.center.z - a.center.z);
+	const float lT[3] = {dot3(lDelta, a.axes[0]), dot3(lDelta, a.axes[1]),
+		dot3(lDelta, a.axes[2])};
+	const float lA[3] = {a.extent.x, a.extent.y, a.extent.z};
+	const float lB[3] = {b.extent.x, b.extent.y, b.extent.z};
+
+	// The axes of a.
+	for (int i = 0; i < 3; ++i)
+	{
+		const auto lRadiusB = lB[0] * lAbsolute[i][0]
+			+ lB[1] * lAbsolute[i][1] + lB[2] * lAbsolute[i][2];
+		if (std::abs(lT[i]) > lA[i] + lRadiusB) return false;
+	}
+
+	// The axes of b.
+	for (int j = 0; j < 3; ++j)
+	{
+		const auto lRadiusA = lA[0] * lAbsolute[0][j]
+			+ lA[1] * lAbsolute[1][j] + lA[2] * lAbsolute[2][j];
+		const auto lDistance = lT[0] * lRotation[0][j]
+			+ lT[1] * lRotation[1][j] + lT[2] * lRotation[2][j];
+		if (std::abs(lDistance) > lRadiusA + lB[j]) return false;
+	}
+
+	// The cross products of an axis of a with an axis of b.
+	for (int i = 0; i < 3; ++i)
+	{
+		const int i1 = (i + 1) % 3;
+		const int i2 = (i + 2) % 3;
+		for (int j = 0; j < 3; ++j)
+		{
+			const int j1 = (j + 1) % 3;
+			const int j2 = (j + 2) % 3;
+			const auto lRadiusA = lA[i1] * lAbsolute[i2][j]
+				+ lA[i2] * lAbsolute[i1][j];
+			const auto lRadiusB = lB[j1] * lAbsolute[i][j2]
+				+ lB[j2] * lAbsolute[i][j1];
+			const auto lDistance = lT[i2] * lRotation[i1][j]
+				- lT[i1] * lRotation[i2][j];
+			if (std::abs(lDistance) > lRadiusA + lRadiusB) return false;
+		}
+	}
+	return true;
+}
+
+bool intersects(const obb3f& a, const box3f& b) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	return intersects(a, obb3f(b));
+}
+
+int intersects4(const ray3f& ray, const box3f* boxes, float* distances)
+	noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const FourBoxes lBoxes(boxes);
+	const vec3f lInverse(inverseDirection(ray.direction.data));
+	const __m128 lMin[3] = {lBoxes.minX, lBoxes.minY, lBoxes.minZ};
+	const __m128 lMax[3] = {lBoxes.maxX, lBoxes.maxY, lBoxes.maxZ};
+	const float lOrigin[3] = {ray.origin.x, ray.origin.y, ray.origin.z};
+	const float lScale[3] = {lInverse.x, lInverse.y, lInverse.z};
+
+	auto lEnter = _mm_setzero_ps();
+	auto lExit = _mm_set1_ps(std::numeric_limits<float>::infinity());
+	for (int i = 0; i < 3; ++i)
+	{
+		const auto lO = _mm_set1_ps(lOrigin[i]);
+		const auto lS = _mm_set1_ps(lScale[i]);
+		const auto lT1 = _mm_mul_ps(_mm_sub_ps(lMin[i], lO), lS);
+		const auto lT2 = _mm_mul_ps(_mm_sub_ps(lMax[i], lO), lS);
+		lEnter = _mm_max_ps(lEnter, _mm_min_ps(lT1, lT2));
+		lExit = _mm_min_ps(lExit, _mm_max_ps(lT1, lT2));
+	}
+	_mm_storeu_ps(distances, lEnter);
+	return _mm_movemask_ps(_mm_cmple_ps(lEnter, lExit));
+}
+
+int intersects4(const frustum3f& frustum, const box3f* boxes) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	__m128 lCenter[3];
+	__m128 lExtent[3];
+	FourBoxes(boxes).centers(lCenter, lExtent);
+	auto lOutside = _mm_setzero_ps();
+	for (const auto& lPlane : frustum.planes)
+	{
+		const auto lReach = _mm_add_ps(distances4(lPlane, lCenter),
+			radii4(lPlane, lExtent));
+		lOutside = _mm_or_ps(lOutside,
+			_mm_cmplt_ps(lReach, _mm_setzero_ps()));
+	}
+	return ~_mm_movemask_ps(lOutside) & 0xf;
+}
+
+int intersects4(const plane3f& plane, const box3f* boxes) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	__m128 lCenter[3];
+	__m128 lExtent[3];
+	FourBoxes(boxes).centers(lCenter, lExtent);
+	const auto lDistance = abs4(distances4(plane.equation, lCenter));
+	return _mm_movemask_ps(_mm_cmple_ps(lDistance,
+		radii4(plane.equation, lExtent)));
+}
+
+int intersects4(const sphere3f& sphere, const box3f* boxes) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const FourBoxes lBoxes(boxes);
+	const auto lZero = _mm_setzero_ps();
+	const auto lX = _mm_set1_ps(sphere.center.x);
+	const auto lY = _mm_set1_ps(sphere.center.y);
+	const auto lZ = _mm_set1_ps(sphere.center.z);
+
+	// The distances to the closest points of the boxes.
+	const auto lDX = _mm_max_ps(_mm_max_ps(_mm_sub_ps(lBoxes.minX, lX),
+		_mm_sub_ps(lX, lBoxes.maxX)), lZero);
+	const auto lDY = _mm_max_ps(_mm_max_ps(_mm_sub_ps(lBoxes.minY, lY),
+		_mm_sub_ps(lY, lBoxes.maxY)), lZero);
+	const auto lDZ = _mm_max_ps(_mm_max_ps(_mm_sub_ps(lBoxes.minZ, lZ),
+		_mm_sub_ps(lZ, lBoxes.maxZ)), lZero);
+	auto lDistance2 = _mm_mul_ps(lDX, lDX);
+	lDistance2 = _mm_add_ps(lDistance2, _mm_mul_ps(lDY, lDY));
+	lDistance2 = _mm_add_ps(lDistance2, _mm_mul_ps(lDZ, lDZ));
+	return _mm_movemask_ps(_mm_cmple_ps(lDistance2,
+		_mm_set1_ps(sphere.radius * sphere.radius)));
+}
+
+int intersects4(const obb3f& box, const box3f* boxes) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	__m128 lCenter[3];
+	__m128 lExtent[3];
+	FourBoxes(boxes).centers(lCenter, lExtent);
+
+	// Move the boxes such that the oriented box is at the origin.
+	lCenter[0] = _mm_sub_ps(lCenter[0], _mm_set1_ps(box.center.x));
+	lCenter[1] = _mm_sub_ps(lCenter[1], _mm_set1_ps(box.center.y));
+	lCenter[2] = _mm_sub_ps(lCenter[2], _mm_set1_ps(box.center.z));
+
+	// The separating axes are the same for all four boxes: the three world
+	// axes, the three axes of the oriented box, and their cross products.
+	// Because the axes are orthonormal, the projections on the cross
+	// products are just the coordinates of the axes.
+	const float lAxes[3][3] = {
+		{box.axes[0].x, box.axes[0].y, box.axes[0].z},
+		{box.axes[1].x, box.axes[1].y, box.axes[1].z},
+		{box.axes[2].x, box.axes[2].y, box.axes[2].z}};
+	const float lAbsolute[3][3] = {
+		{std::abs(lAxes[0][0]), std::abs(lAxes[0][1]), std::abs(lAxes[0][2])},
+		{std::abs(lAxes[1][0]), std::abs(lAxes[1][1]), std::abs(lAxes[1][2])},
+		{std::abs(lAxes[2][0]), std::abs(lAxes[2][1]), std::abs(lAxes[2][2])}};
+	const float lHalf[3] = {box.extent.x, box.extent.y, box.extent.z};
+
+	// The world axes separate most boxes, so try those first.
+	auto lSeparated = _mm_setzero_ps();
+	for (int i = 0; i < 3; ++i)
+	{
+		const auto lRadius = lHalf[0] * lAbsolute[0][i]
+			+ lHalf[1] * lAbsolute[1][i] + lHalf[2] * lAbsolute[2][i];
+		lSeparated = _mm_or_ps(lSeparated, _mm_cmpgt_ps(abs4(lCenter[i]),
+			_mm_add_ps(lExtent[i], _mm_set1_ps(lRadius))));
+	}
+	if (_mm_movemask_ps(lSeparated) == 0xf) return 0;
+
+	// The axes of the oriented box.
+	for (int j = 0; j < 3; ++j)
+	{
+		const vec4f lAxis(lAxes[j][0], lAxes[j][1], lAxes[j][2], 0.0f);
+		const auto lRadius = _mm_add_ps(radii4(lAxis, lExtent),
+			_mm_set1_ps(lHalf[j]));
+		lSeparated = _mm_or_ps(lSeparated,
+			_mm_cmpgt_ps(abs4(distances4(lAxis, lCenter)), lRadius));
+	}
+
+	// The cross product of world axis i and axis j of the oriented box has
+	// coordinate i1 equal to -axes[j][i2] and coordinate i2 equal to
+	// axes[j][i1].
+	for (int i = 0; i < 3; ++i)
+	{
+		const int i1 = (i + 1) % 3;
+		const int i2 = (i + 2) % 3;
+		for (int j = 0; j < 3; ++j)
+		{
+			// Parallel axes give nothing new.
+			if (lAbsolute[j][i1] + lAbsolute[j][i2] < 1e-3f) continue;
+
+			const int j1 = (j + 1) % 3;
+			const int j2 = (j + 2) % 3;
+			const auto lRadius = lHalf[j1] * lAbsolute[j2][i]
+				+ lHalf[j2] * lAbsolute[j1][i];
+			auto lRadii = _mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(lAbsolute[j][i2]), lExtent[i1]),
+				_mm_mul_ps(_mm_set1_ps(lAbsolute[j][i1]), lExtent[i2]));
+			lRadii = _mm_add_ps(lRadii, _mm_set1_ps(lRadius));
+			const auto lDistance = _mm_sub_ps(
+				_mm_mul_ps(_mm_set1_ps(lAxes[j][i1]), lCenter[i2]),
+				_mm_mul_ps(_mm_set1_ps(lAxes[j][i2]), lCenter[i1]));
+			lSeparated = _mm_or_ps(lSeparated,
+				_mm_cmpgt_ps(abs4(lDistance), lRadii));
+		}
+	}
+	return ~_mm_movemask_ps(lSeparated) & 0xf;
+}
+
+int intersects4(const box3f& box, const box3f* boxes) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const FourBoxes lBoxes(boxes);
+	auto lSeparated = _mm_cmpgt_ps(lBoxes.minX,
+		_mm_set1_ps(box.maxCorner.x));
+	lSeparated = _mm_or_ps(lSeparated, _mm_cmpgt_ps(lBoxes.minY,
+		_mm_set1_ps(box.maxCorner.y)));
+	lSeparated = _mm_or_ps(lSeparated, _mm_cmpgt_ps(lBoxes.minZ,
+		_mm_set1_ps(box.maxCorner.z)));
+	lSeparated = _mm_or_ps(lSeparated, _mm_cmplt_ps(lBoxes.maxX,
+		_mm_set1_ps(box.minCorner.x)));
+	lSeparated = _mm_or_ps(lSeparated, _mm_cmplt_ps(lBoxes.maxY,
+		_mm_set1_ps(box.minCorner.y)));
+	lSeparated = _mm_or_ps(lSeparated, _mm_cmplt_ps(lBoxes.maxZ,
+		_mm_set1_ps(box.minCorner.z)));
+	return ~_mm_movemask_ps(lSeparated) & 0xf;
+}
+
+} // namespace gintonic
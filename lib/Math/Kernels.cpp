@@ -0,0 +1,19 @@
+#include "Kernels.hpp"
+
+#include "Foundation/CPU.hpp"
+
+namespace gintonic {
+namespace detail {
+
+const MathKernels& kernels() noexcept
+{
+	switch (activeSIMDLevel())
+	{
+		case SIMDLevel::kAVX2: return kAVX2Kernels;
+		case SIMDLevel::kAVX:  return kAVXKernels;
+		default:               return kSSE3Kernels;
+	}
+}
+
+} // namespace detail
+} // namespace gintonic
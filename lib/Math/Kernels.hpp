@@ -0,0 +1,82 @@
+/**
+ * @file Kernels.hpp
+ * @brief Defines the table of batched math kernels that is picked at
+ * runtime.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gintonic {
+
+union mat3f;   // Forward declaration.
+union mat4f;   // Forward declaration.
+union vec3f;   // Forward declaration.
+union vec4f;   // Forward declaration.
+struct SQT;    // Forward declaration.
+struct box3f;  // Forward declaration.
+struct frustum3f; // Forward declaration.
+
+namespace detail {
+
+/**
+ * @brief The batched math kernels, compiled for one instruction set.
+ * @details Kernels.inl holds the kernels. It is compiled once for every
+ * SIMDLevel by KernelsSSE3.cpp, KernelsAVX.cpp and KernelsAVX2.cpp, each
+ * with its own compiler flags. The public functions in Math call the
+ * kernels of the active level through kernels().
+ *
+ * The kernels of an SQTArray get the first channel and the stride; channel
+ * c starts at c * stride.
+ */
+struct MathKernels
+{
+	void (*multiplyOne)(const mat4f& lhs, const mat4f* rhs,
+		const std::size_t count, mat4f* result);
+	void (*multiplyMany)(const mat4f* lhs, const mat4f* rhs,
+		const std::size_t count, mat4f* result);
+	void (*transform)(const mat4f& matrix, const vec4f* vectors,
+		const std::size_t count, vec4f* result);
+	void (*transformPoints)(const mat4f& matrix, const vec3f* points,
+		const std::size_t count, vec3f* result);
+	void (*transformDirections)(const mat4f& matrix, const vec3f* directions,
+		const std::size_t count, vec3f* result);
+	void (*transformPackedPoints)(const mat4f& matrix, const float* points,
+		const std::size_t count, float* result);
+	void (*transformPackedDirections)(const mat4f& matrix,
+		const float* directions, const std::size_t count, float* result);
+	void (*toMatrices)(const SQT* transforms, const std::size_t count,
+		mat4f* result);
+	void (*transformBoxes)(const mat4f& matrix, const box3f* boxes,
+		const std::size_t count, box3f* result);
+	void (*transformEachBox)(const mat4f* matrices, const box3f* boxes,
+		const std::size_t count, box3f* result);
+	void (*normalMatrices)(const mat4f* matrices, const std::size_t count,
+		mat3f* result);
+	void (*skinPositions)(const mat4f* palette, const std::size_t jointCount,
+		const float* positions, const std::uint32_t* vertices,
+		const std::int32_t* jointIndices, const float* jointWeights,
+		const std::size_t first, const std::size_t last, float* result);
+	void (*mix)(const float* u, const float* v, const float a,
+		const float* mask, float* result, const std::size_t stride);
+	void (*difference)(const float* reference, const float* pose,
+		float* result, const std::size_t stride);
+	void (*applyAdditive)(const float* base, const float* difference,
+		const float a, const float* mask, float* result,
+		const std::size_t stride);
+	std::size_t (*intersects)(const frustum3f& frustum, const box3f* boxes,
+		const std::size_t count, std::uint8_t* visible);
+};
+
+extern const MathKernels kSSE3Kernels;
+extern const MathKernels kAVXKernels;
+extern const MathKernels kAVX2Kernels;
+
+/// Get the kernels of the active SIMDLevel.
+const MathKernels& kernels() noexcept;
+
+} // namespace detail
+} // namespace gintonic
@@ -0,0 +1,1155 @@
+// The batched math kernels, see Kernels.hpp. This file is compiled once
+// for every SIMDLevel, so __AVX__ and __FMA__ tell which level this is.
+//
+// Use only intrinsics and the data members of the math types in here. An
+// inline function of a header that is emitted in this file may be picked
+// by the linker for the whole library, and then the baseline code would
+// call instructions that the CPU may not have.
+
+#ifndef GT_KERNELS
+#error Define GT_KERNELS to the name of the kernel table.
+#endif
+
+#include "Kernels.hpp"
+
+#include "Math/SQT.hpp"
+#include "Math/SQTArray.hpp"
+#include "Math/box3f.hpp"
+#include "Math/frustum3f.hpp"
+#include "Math/mat3f.hpp"
+#include "Math/mat4f.hpp"
+#include "Math/vec4f.hpp"
+
+namespace gintonic {
+namespace detail {
+namespace {
+
+/*****************************************************************************
+* Math/Transforms                                                            *
+*****************************************************************************/
+
+// The element in row r and column c.
+inline float element(const mat4f& m, const int r, const int c) noexcept
+{
+	return reinterpret_cast<const float*>(m.data)[4 * c + r];
+}
+
+// Clears the w-coordinate.
+inline __m128 xyz0(const __m128 v) noexcept
+{
+	return _mm_and_ps(v, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+}
+
+inline __m128 absolute(const __m128 v) noexcept
+{
+	return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+
+// The product of a matrix, given by its columns, with a vector.
+inline __m128 product(const __m128* m, const __m128 v) noexcept
+{
+	auto r = _mm_mul_ps(m[0], _mm_replicate_x_ps(v));
+	r = _mm_madd_ps(m[1], _mm_replicate_y_ps(v), r);
+	r = _mm_madd_ps(m[2], _mm_replicate_z_ps(v), r);
+	return _mm_madd_ps(m[3], _mm_replicate_w_ps(v), r);
+}
+
+// The same, with a w-coordinate of 1.
+inline __m128 productPoint(const __m128* m, const __m128 v) noexcept
+{
+	auto r = _mm_madd_ps(m[0], _mm_replicate_x_ps(v), m[3]);
+	r = _mm_madd_ps(m[1], _mm_replicate_y_ps(v), r);
+	return _mm_madd_ps(m[2], _mm_replicate_z_ps(v), r);
+}
+
+// The same, with a w-coordinate of 0.
+inline __m128 productDirection(const __m128* m, const __m128 v) noexcept
+{
+	auto r = _mm_mul_ps(m[0], _mm_replicate_x_ps(v));
+	r = _mm_madd_ps(m[1], _mm_replicate_y_ps(v), r);
+	return _mm_madd_ps(m[2], _mm_replicate_z_ps(v), r);
+}
+
+// Transform a box by a matrix and the absolute values of its columns.
+inline void transformBox(const __m128* m, const __m128* a, const box3f& box,
+	box3f& result) noexcept
+{
+	const auto lHalf = _mm_set1_ps(0.5f);
+	const auto lCenter = _mm_mul_ps(
+		_mm_add_ps(box.minCorner.data, box.maxCorner.data), lHalf);
+	const auto lExtent = _mm_mul_ps(
+		_mm_sub_ps(box.maxCorner.data, box.minCorner.data), lHalf);
+	const auto lNewCenter = productPoint(m, lCenter);
+	const auto lNewExtent = productDirection(a, lExtent);
+	result.minCorner.data = xyz0(_mm_sub_ps(lNewCenter, lNewExtent));
+	result.maxCorner.data = xyz0(_mm_add_ps(lNewCenter, lNewExtent));
+}
+
+// Deinterleave four tightly packed xyz triples.
+inline void load3(const float* p, __m128& x, __m128& y, __m128& z) noexcept
+{
+	const auto a = _mm_loadu_ps(p);     // x0 y0 z0 x1
+	const auto b = _mm_loadu_ps(p + 4); // y1 z1 x2 y2
+	const auto c = _mm_loadu_ps(p + 8); // z2 x3 y3 z3
+	x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 3, 2)),
+		_MM_SHUFFLE(3, 0, 3, 0));
+	y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+		_mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+	z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+		_mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+// Interleave four xyz triples, the inverse of load3.
+inline void store3(float* p, const __m128 x, const __m128 y, const __m128 z)
+	noexcept
+{
+	const auto lLow = _mm_unpacklo_ps(x, y);  // x0 y0 x1 y1
+	const auto lHigh = _mm_unpackhi_ps(x, y); // x2 y2 x3 y3
+	_mm_storeu_ps(p, _mm_shuffle_ps(lLow,
+		_mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+	_mm_storeu_ps(p + 4, _mm_shuffle_ps(
+		_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), lHigh,
+		_MM_SHUFFLE(1, 0, 2, 0)));
+	_mm_storeu_ps(p + 8, _mm_shuffle_ps(
+		_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+		_mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+#ifdef __AVX__
+
+// The product of a matrix with two vectors. Both halves of every register of
+// m hold the same column.
+inline __m256 product(const __m256* m, const __m256 v) noexcept
+{
+	auto r = _mm256_mul_ps(m[0], _mm256_permute_ps(v, 0x00));
+	r = _mm256_madd_ps(m[1], _mm256_permute_ps(v, 0x55), r);
+	r = _mm256_madd_ps(m[2], _mm256_permute_ps(v, 0xaa), r);
+	return _mm256_madd_ps(m[3], _mm256_permute_ps(v, 0xff), r);
+}
+
+inline __m256 productPoint(const __m256* m, const __m256 v) noexcept
+{
+	auto r = _mm256_madd_ps(m[0], _mm256_permute_ps(v, 0x00), m[3]);
+	r = _mm256_madd_ps(m[1], _mm256_permute_ps(v, 0x55), r);
+	return _mm256_madd_ps(m[2], _mm256_permute_ps(v, 0xaa), r);
+}
+
+inline __m256 productDirection(const __m256* m, const __m256 v) noexcept
+{
+	auto r = _mm256_mul_ps(m[0], _mm256_permute_ps(v, 0x00));
+	r = _mm256_madd_ps(m[1], _mm256_permute_ps(v, 0x55), r);
+	return _mm256_madd_ps(m[2], _mm256_permute_ps(v, 0xaa), r);
+}
+
+inline __m256 xyz0(const __m256 v) noexcept
+{
+	return _mm256_and_ps(v, _mm256_castsi256_ps(
+		_mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0)));
+}
+
+inline __m256 combine(const __m128 low, const __m128 high) noexcept
+{
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+}
+
+// Both halves hold the columns of the matrix.
+inline void broadcast(const mat4f& matrix, __m256* columns) noexcept
+{
+	for (int c = 0; c < 4; ++c)
+	{
+		columns[c] = _mm256_broadcast_ps(&matrix.data[c]);
+	}
+}
+
+#endif // __AVX__
+
+// Transform tightly packed triples. Every row of the matrix is broadcast to
+// four registers, so that four triples are transformed at a time.
+template <bool IsPoint>
+void transformPacked(const mat4f& matrix, const float* in,
+	const std::size_t count, float* out) noexcept
+{
+	__m128 lRows[3][4];
+	for (int r = 0; r < 3; ++r)
+	{
+		for (int c = 0; c < 4; ++c)
+		{
+			lRows[r][c] = _mm_set1_ps(element(matrix, r, c));
+		}
+	}
+
+	std::size_t i = 0;
+
+	#ifdef __AVX__
+
+	__m256 lWideRows[3][4];
+	for (int r = 0; r < 3; ++r)
+	{
+		for (int c = 0; c < 4; ++c)
+		{
+			lWideRows[r][c] = combine(lRows[r][c], lRows[r][c]);
+		}
+	}
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128 x0, y0, z0, x1, y1, z1;
+		load3(in + 3 * i, x0, y0, z0);
+		load3(in + 3 * i + 12, x1, y1, z1);
+		const auto x = combine(x0, x1);
+		const auto y = combine(y0, y1);
+		const auto z = combine(z0, z1);
+		__m256 lResult[3];
+		for (int r = 0; r < 3; ++r)
+		{
+			auto lSum = _mm256_mul_ps(lWideRows[r][0], x);
+			lSum = _mm256_madd_ps(lWideRows[r][1], y, lSum);
+			lSum = _mm256_madd_ps(lWideRows[r][2], z, lSum);
+			lResult[r] = IsPoint ? _mm256_add_ps(lSum, lWideRows[r][3]) : lSum;
+		}
+		store3(out + 3 * i, _mm256_castps256_ps128(lResult[0]),
+			_mm256_castps256_ps128(lResult[1]),
+			_mm256_castps256_ps128(lResult[2]));
+		store3(out + 3 * i + 12, _mm256_extractf128_ps(lResult[0], 1),
+			_mm256_extractf128_ps(lResult[1], 1),
+			_mm256_extractf128_ps(lResult[2], 1));
+	}
+
+	#endif // __AVX__
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x, y, z;
+		load3(in + 3 * i, x, y, z);
+		__m128 lResult[3];
+		for (int r = 0; r < 3; ++r)
+		{
+			auto lSum = _mm_mul_ps(lRows[r][0], x);
+			lSum = _mm_madd_ps(lRows[r][1], y, lSum);
+			lSum = _mm_madd_ps(lRows[r][2], z, lSum);
+			lResult[r] = IsPoint ? _mm_add_ps(lSum, lRows[r][3]) : lSum;
+		}
+		store3(out + 3 * i, lResult[0], lResult[1], lResult[2]);
+	}
+
+	// The remaining triples.
+	for (; i < count; ++i)
+	{
+		const auto x = in[3 * i + 0];
+		const auto y = in[3 * i + 1];
+		const auto z = in[3 * i + 2];
+		for (int r = 0; r < 3; ++r)
+		{
+			out[3 * i + r] = element(matrix, r, 0) * x
+				+ element(matrix, r, 1) * y + element(matrix, r, 2) * z
+				+ (IsPoint ? element(matrix, r, 3) : 0.0f);
+		}
+	}
+}
+
+
+void multiplyOne(const mat4f& lhs, const mat4f* rhs,
+	const std::size_t count, mat4f* result) noexcept
+{
+	#ifdef __AVX__
+
+	__m256 lLhs[4];
+	broadcast(lhs, lLhs);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const auto lRhs = reinterpret_cast<const float*>(rhs[i].data);
+		const auto lColumns01 = product(lLhs, _mm256_loadu_ps(lRhs));
+		const auto lColumns23 = product(lLhs, _mm256_loadu_ps(lRhs + 8));
+		const auto lResult = reinterpret_cast<float*>(result[i].data);
+		_mm256_storeu_ps(lResult, lColumns01);
+		_mm256_storeu_ps(lResult + 8, lColumns23);
+	}
+
+	#else
+
+	const __m128 lLhs[4] = {lhs.data[0], lhs.data[1], lhs.data[2], lhs.data[3]};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const auto lColumn0 = product(lLhs, rhs[i].data[0]);
+		const auto lColumn1 = product(lLhs, rhs[i].data[1]);
+		const auto lColumn2 = product(lLhs, rhs[i].data[2]);
+		const auto lColumn3 = product(lLhs, rhs[i].data[3]);
+		result[i].data[0] = lColumn0;
+		result[i].data[1] = lColumn1;
+		result[i].data[2] = lColumn2;
+		result[i].data[3] = lColumn3;
+	}
+
+	#endif
+}
+
+void multiplyMany(const mat4f* lhs, const mat4f* rhs,
+	const std::size_t count, mat4f* result) noexcept
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		#ifdef __AVX__
+
+		__m256 lLhs[4];
+		broadcast(lhs[i], lLhs);
+		const auto lRhs = reinterpret_cast<const float*>(rhs[i].data);
+		const auto lColumns01 = product(lLhs, _mm256_loadu_ps(lRhs));
+		const auto lColumns23 = product(lLhs, _mm256_loadu_ps(lRhs + 8));
+		const auto lResult = reinterpret_cast<float*>(result[i].data);
+		_mm256_storeu_ps(lResult, lColumns01);
+		_mm256_storeu_ps(lResult + 8, lColumns23);
+
+		#else
+
+		const __m128 lLhs[4] = {lhs[i].data[0], lhs[i].data[1],
+			lhs[i].data[2], lhs[i].data[3]};
+		const auto lColumn0 = product(lLhs, rhs[i].data[0]);
+		const auto lColumn1 = product(lLhs, rhs[i].data[1]);
+		const auto lColumn2 = product(lLhs, rhs[i].data[2]);
+		const auto lColumn3 = product(lLhs, rhs[i].data[3]);
+		result[i].data[0] = lColumn0;
+		result[i].data[1] = lColumn1;
+		result[i].data[2] = lColumn2;
+		result[i].data[3] = lColumn3;
+
+		#endif
+	}
+}
+
+void transform(const mat4f& matrix, const vec4f* vectors,
+	const std::size_t count, vec4f* result) noexcept
+{
+	std::size_t i = 0;
+
+	#ifdef __AVX__
+
+	__m256 lWide[4];
+	broadcast(matrix, lWide);
+	for (; i + 2 <= count; i += 2)
+	{
+		const auto lVectors = _mm256_loadu_ps(&vectors[i].x);
+		_mm256_storeu_ps(&result[i].x, product(lWide, lVectors));
+	}
+
+	#endif
+
+	const __m128 lMatrix[4] = {matrix.data[0], matrix.data[1], matrix.data[2],
+		matrix.data[3]};
+	for (; i < count; ++i)
+	{
+		result[i].data = product(lMatrix, vectors[i].data);
+	}
+}
+
+void transformPoints(const mat4f& matrix, const vec3f* points,
+	const std::size_t count, vec3f* result) noexcept
+{
+	std::size_t i = 0;
+
+	#ifdef __AVX__
+
+	__m256 lWide[4];
+	broadcast(matrix, lWide);
+	for (; i + 2 <= count; i += 2)
+	{
+		const auto lPoints = _mm256_loadu_ps(&points[i].x);
+		_mm256_storeu_ps(&result[i].x, xyz0(productPoint(lWide, lPoints)));
+	}
+
+	#endif
+
+	const __m128 lMatrix[4] = {matrix.data[0], matrix.data[1], matrix.data[2],
+		matrix.data[3]};
+	for (; i < count; ++i)
+	{
+		result[i].data = xyz0(productPoint(lMatrix, points[i].data));
+	}
+}
+
+void transformDirections(const mat4f& matrix, const vec3f* directions,
+	const std::size_t count, vec3f* result) noexcept
+{
+	std::size_t i = 0;
+
+	#ifdef __AVX__
+
+	__m256 lWide[4];
+	broadcast(matrix, lWide);
+	for (; i + 2 <= count; i += 2)
+	{
+		const auto lDirections = _mm256_loadu_ps(&directions[i].x);
+		_mm256_storeu_ps(&result[i].x,
+			xyz0(productDirection(lWide, lDirections)));
+	}
+
+	#endif
+
+	const __m128 lMatrix[4] = {matrix.data[0], matrix.data[1], matrix.data[2],
+		matrix.data[3]};
+	for (; i < count; ++i)
+	{
+		result[i].data = xyz0(productDirection(lMatrix, directions[i].data));
+	}
+}
+
+void transformPackedPoints(const mat4f& matrix, const float* points,
+	const std::size_t count, float* result) noexcept
+{
+	transformPacked<true>(matrix, points, count, result);
+}
+
+void transformPackedDirections(const mat4f& matrix,
+	const float* directions, const std::size_t count, float* result) noexcept
+{
+	transformPacked<false>(matrix, directions, count, result);
+}
+
+void toMatrices(const SQT* transforms, const std::size_t count,
+	mat4f* result) noexcept
+{
+	const auto lZero = _mm_setzero_ps();
+	const auto lOne = _mm_set1_ps(1.0f);
+	const auto lTwo = _mm_set1_ps(2.0f);
+	std::size_t i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		// Transpose four rotations and scales into x, y, z and w registers.
+		auto qx = transforms[i + 0].rotation.data;
+		auto qy = transforms[i + 1].rotation.data;
+		auto qz = transforms[i + 2].rotation.data;
+		auto qw = transforms[i + 3].rotation.data;
+		_MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+		auto lScaleX = transforms[i + 0].scale.data;
+		auto lScaleY = transforms[i + 1].scale.data;
+		auto lScaleZ = transforms[i + 2].scale.data;
+		auto lScaleW = transforms[i + 3].scale.data;
+		_MM_TRANSPOSE4_PS(lScaleX, lScaleY, lScaleZ, lScaleW);
+
+		// The same arithmetic as the mat4f constructor.
+		auto n = _mm_mul_ps(qx, qx);
+		n = _mm_madd_ps(qy, qy, n);
+		n = _mm_madd_ps(qz, qz, n);
+		n = _mm_madd_ps(qw, qw, n);
+		const auto s = _mm_and_ps(_mm_div_ps(lTwo, n), _mm_cmpneq_ps(n, lZero));
+		const auto sw = _mm_mul_ps(s, qw);
+		const auto sx = _mm_mul_ps(s, qx);
+		const auto sy = _mm_mul_ps(s, qy);
+		const auto wx = _mm_mul_ps(sw, qx);
+		const auto wy = _mm_mul_ps(sw, qy);
+		const auto wz = _mm_mul_ps(sw, qz);
+		const auto xx = _mm_mul_ps(sx, qx);
+		const auto xy = _mm_mul_ps(sx, qy);
+		const auto xz = _mm_mul_ps(sx, qz);
+		const auto yy = _mm_mul_ps(sy, qy);
+		const auto yz = _mm_mul_ps(sy, qz);
+		const auto zz = _mm_mul_ps(_mm_mul_ps(s, qz), qz);
+
+		// Every row is scaled by its component of the scale.
+		auto m00 = _mm_mul_ps(_mm_sub_ps(lOne, _mm_add_ps(yy, zz)), lScaleX);
+		auto m10 = _mm_mul_ps(_mm_add_ps(xy, wz), lScaleY);
+		auto m20 = _mm_mul_ps(_mm_sub_ps(xz, wy), lScaleZ);
+		auto m30 = lZero;
+		auto m01 = _mm_mul_ps(_mm_sub_ps(xy, wz), lScaleX);
+		auto m11 = _mm_mul_ps(_mm_sub_ps(lOne, _mm_add_ps(xx, zz)), lScaleY);
+		auto m21 = _mm_mul_ps(_mm_add_ps(yz, wx), lScaleZ);
+		auto m31 = lZero;
+		auto m02 = _mm_mul_ps(_mm_add_ps(xz, wy), lScaleX);
+		auto m12 = _mm_mul_ps(_mm_sub_ps(yz, wx), lScaleY);
+		auto m22 = _mm_mul_ps(_mm_sub_ps(lOne, _mm_add_ps(xx, yy)), lScaleZ);
+		auto m32 = lZero;
+
+		// Transpose back into the columns of four matrices.
+		_MM_TRANSPOSE4_PS(m00, m10, m20, m30);
+		_MM_TRANSPOSE4_PS(m01, m11, m21, m31);
+		_MM_TRANSPOSE4_PS(m02, m12, m22, m32);
+		const __m128 lColumns[3][4] = {{m00, m10, m20, m30},
+			{m01, m11, m21, m31}, {m02, m12, m22, m32}};
+		for (int k = 0; k < 4; ++k)
+		{
+			auto& lResult = result[i + k];
+			lResult.data[0] = lColumns[0][k];
+			lResult.data[1] = lColumns[1][k];
+			lResult.data[2] = lColumns[2][k];
+			lResult.data[3] = transforms[i + k].translation.data;
+			lResult.m33 = 1.0f;
+		}
+	}
+
+	// The remaining SQTs.
+	for (; i < count; ++i)
+	{
+		const mat4f lMatrix(transforms[i]);
+		for (int c = 0; c < 4; ++c) result[i].data[c] = lMatrix.data[c];
+	}
+}
+
+void transformBoxes(const mat4f& matrix, const box3f* boxes,
+	const std::size_t count, box3f* result) noexcept
+{
+	const __m128 lMatrix[4] = {matrix.data[0], matrix.data[1], matrix.data[2],
+		matrix.data[3]};
+	const __m128 lAbsolute[3] = {absolute(matrix.data[0]),
+		absolute(matrix.data[1]), absolute(matrix.data[2])};
+	std::size_t i = 0;
+
+	#ifdef __AVX__
+
+	__m256 lWide[4];
+	broadcast(matrix, lWide);
+	__m256 lWideAbsolute[3];
+	for (int c = 0; c < 3; ++c)
+	{
+		lWideAbsolute[c] = combine(lAbsolute[c], lAbsolute[c]);
+	}
+	const auto lHalf = _mm256_set1_ps(0.5f);
+	for (; i + 2 <= count; i += 2)
+	{
+		// The minimum corners in one register, the maximum corners in
+		// another.
+		const auto lBox0 = _mm256_loadu_ps(&boxes[i].minCorner.x);
+		const auto lBox1 = _mm256_loadu_ps(&boxes[i + 1].minCorner.x);
+		const auto lMin = _mm256_permute2f128_ps(lBox0, lBox1, 0x20);
+		const auto lMax = _mm256_permute2f128_ps(lBox0, lBox1, 0x31);
+
+		const auto lCenter = _mm256_mul_ps(_mm256_add_ps(lMin, lMax), lHalf);
+		const auto lExtent = _mm256_mul_ps(_mm256_sub_ps(lMax, lMin), lHalf);
+		const auto lNewCenter = productPoint(lWide, lCenter);
+		const auto lNewExtent = productDirection(lWideAbsolute, lExtent);
+		const auto lNewMin = xyz0(_mm256_sub_ps(lNewCenter, lNewExtent));
+		const auto lNewMax = xyz0(_mm256_add_ps(lNewCenter, lNewExtent));
+
+		_mm256_storeu_ps(&result[i].minCorner.x,
+			_mm256_permute2f128_ps(lNewMin, lNewMax, 0x20));
+		_mm256_storeu_ps(&result[i + 1].minCorner.x,
+			_mm256_permute2f128_ps(lNewMin, lNewMax, 0x31));
+	}
+
+	#endif
+
+	for (; i < count; ++i)
+	{
+		transformBox(lMatrix, lAbsolute, boxes[i], result[i]);
+	}
+}
+
+void transformEachBox(const mat4f* matrices, const box3f* boxes,
+	const std::size_t count, box3f* result) noexcept
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const auto& lMatrix = matrices[i].data;
+		const __m128 lAbsolute[3] = {absolute(lMatrix[0]),
+			absolute(lMatrix[1]), absolute(lMatrix[2])};
+		transformBox(lMatrix, lAbsolute, boxes[i], result[i]);
+	}
+}
+
+// The cross product of the first three components. The fourth is zero.
+inline __m128 cross3(const __m128 a, const __m128 b) noexcept
+{
+	return _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle(a, 3, 0, 2, 1), _mm_shuffle(b, 3, 1, 0, 2)),
+		_mm_mul_ps(_mm_shuffle(a, 3, 1, 0, 2), _mm_shuffle(b, 3, 0, 2, 1)));
+}
+
+// Stores three columns as the nine floats of a mat3f. The last store also
+// writes the padding after them.
+inline void storeColumns(mat3f& m, const __m128 c0, const __m128 c1,
+	const __m128 c2) noexcept
+{
+	static_assert(sizeof(mat3f) >= 10 * sizeof(float),
+		"The padding of mat3f is overwritten.");
+	_mm_storeu_ps(m.data, c0);
+	_mm_storeu_ps(m.data + 3, c1);
+	_mm_storeu_ps(m.data + 6, c2);
+}
+
+#ifdef __AVX__
+
+inline __m256 cross3(const __m256 a, const __m256 b) noexcept
+{
+	const int kYZX = _MM_SHUFFLE(3, 0, 2, 1);
+	const int kZXY = _MM_SHUFFLE(3, 1, 0, 2);
+	return _mm256_sub_ps(
+		_mm256_mul_ps(_mm256_shuffle_ps(a, a, kYZX),
+			_mm256_shuffle_ps(b, b, kZXY)),
+		_mm256_mul_ps(_mm256_shuffle_ps(a, a, kZXY),
+			_mm256_shuffle_ps(b, b, kYZX)));
+}
+
+#endif // __AVX__
+
+// The columns of the normal matrix are the cross products of the columns,
+// divided by the determinant.
+void normalMatrices(const mat4f* matrices, const std::size_t count,
+	mat3f* result) noexcept
+{
+	std::size_t i = 0;
+
+	#ifdef __AVX__
+
+	const auto lWideOne = _mm256_set1_ps(1.0f);
+	for (; i + 2 <= count; i += 2)
+	{
+		__m256 c[3];
+		for (int k = 0; k < 3; ++k)
+		{
+			c[k] = combine(matrices[i].data[k], matrices[i + 1].data[k]);
+		}
+		const auto n0 = cross3(c[1], c[2]);
+		const auto n1 = cross3(c[2], c[0]);
+		const auto n2 = cross3(c[0], c[1]);
+
+		// The fourth component of n0 is zero.
+		auto lDeterminant = _mm256_mul_ps(c[0], n0);
+		lDeterminant = _mm256_hadd_ps(lDeterminant, lDeterminant);
+		lDeterminant = _mm256_hadd_ps(lDeterminant, lDeterminant);
+		const auto lScale = _mm256_div_ps(lWideOne, lDeterminant);
+
+		const auto r0 = _mm256_mul_ps(n0, lScale);
+		const auto r1 = _mm256_mul_ps(n1, lScale);
+		const auto r2 = _mm256_mul_ps(n2, lScale);
+		storeColumns(result[i], _mm256_castps256_ps128(r0),
+			_mm256_castps256_ps128(r1), _mm256_castps256_ps128(r2));
+		storeColumns(result[i + 1], _mm256_extractf128_ps(r0, 1),
+			_mm256_extractf128_ps(r1, 1), _mm256_extractf128_ps(r2, 1));
+	}
+
+	#endif // __AVX__
+
+	const auto lOne = _mm_set1_ps(1.0f);
+	for (; i < count; ++i)
+	{
+		const auto& c = matrices[i].data;
+		const auto n0 = cross3(c[1], c[2]);
+		const auto n1 = cross3(c[2], c[0]);
+		const auto n2 = cross3(c[0], c[1]);
+
+		auto lDeterminant = _mm_mul_ps(c[0], n0);
+		lDeterminant = _mm_hadd_ps(lDeterminant, lDeterminant);
+		lDeterminant = _mm_hadd_ps(lDeterminant, lDeterminant);
+		const auto lScale = _mm_div_ps(lOne, lDeterminant);
+
+		storeColumns(result[i], _mm_mul_ps(n0, lScale),
+			_mm_mul_ps(n1, lScale), _mm_mul_ps(n2, lScale));
+	}
+}
+
+/*****************************************************************************
+* Math/Skinning                                                              *
+*****************************************************************************/
+
+void skinPositions(const mat4f* palette, const std::size_t jointCount,
+	const float* positions, const std::uint32_t* vertices,
+	const std::int32_t* jointIndices, const float* jointWeights,
+	const std::size_t first, const std::size_t last, float* result) noexcept
+{
+	alignas(16) float lResult[4];
+
+	for (std::size_t i = first; i < last; ++i)
+	{
+		const auto v = vertices ? vertices[i] : i;
+		const auto lJoints = jointIndices + 4 * v;
+		const auto lWeights = jointWeights + 4 * v;
+		const auto lPosition = positions + 3 * i;
+
+		#ifdef __AVX__
+
+		// The columns 0 and 1 of a matrix in one register, and the columns
+		// 2 and 3 in another.
+		auto lColumns01 = _mm256_setzero_ps();
+		auto lColumns23 = _mm256_setzero_ps();
+		for (int k = 0; k < 4; ++k)
+		{
+			// Unused influences are padded with GT_JOINT_NONE.
+			if (lWeights[k] == 0.0f
+				|| static_cast<std::size_t>(lJoints[k]) >= jointCount)
+			{
+				continue;
+			}
+			const auto lWeight = _mm256_set1_ps(lWeights[k]);
+			const auto lMatrix =
+				reinterpret_cast<const float*>(&palette[lJoints[k]]);
+			lColumns01 = _mm256_add_ps(lColumns01,
+				_mm256_mul_ps(lWeight, _mm256_loadu_ps(lMatrix)));
+			lColumns23 = _mm256_add_ps(lColumns23,
+				_mm256_mul_ps(lWeight, _mm256_loadu_ps(lMatrix + 8)));
+		}
+
+		// x * column 0 + y * column 1 + z * column 2 + column 3.
+		const auto lXY = _mm256_insertf128_ps(
+			_mm256_castps128_ps256(_mm_set1_ps(lPosition[0])),
+			_mm_set1_ps(lPosition[1]), 1);
+		const auto lZ1 = _mm256_insertf128_ps(
+			_mm256_castps128_ps256(_mm_set1_ps(lPosition[2])),
+			_mm_set1_ps(1.0f), 1);
+		const auto lSum = _mm256_add_ps(_mm256_mul_ps(lColumns01, lXY),
+			_mm256_mul_ps(lColumns23, lZ1));
+		_mm_store_ps(lResult, _mm_add_ps(_mm256_castps256_ps128(lSum),
+			_mm256_extractf128_ps(lSum, 1)));
+
+		#else
+
+		__m128 lColumns[4];
+		for (int c = 0; c < 4; ++c) lColumns[c] = _mm_setzero_ps();
+		for (int k = 0; k < 4; ++k)
+		{
+			// Unused influences are padded with GT_JOINT_NONE.
+			if (lWeights[k] == 0.0f
+				|| static_cast<std::size_t>(lJoints[k]) >= jointCount)
+			{
+				continue;
+			}
+			const auto lWeight = _mm_set1_ps(lWeights[k]);
+			const auto& lMatrix = palette[lJoints[k]];
+			for (int c = 0; c < 4; ++c)
+			{
+				lColumns[c] = _mm_add_ps(lColumns[c],
+					_mm_mul_ps(lWeight, lMatrix.data[c]));
+			}
+		}
+
+		// x * column 0 + y * column 1 + z * column 2 + column 3.
+		const auto lSum = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(lColumns[0], _mm_set1_ps(lPosition[0])),
+				_mm_mul_ps(lColumns[1], _mm_set1_ps(lPosition[1]))),
+			_mm_add_ps(_mm_mul_ps(lColumns[2], _mm_set1_ps(lPosition[2])),
+				lColumns[3]));
+		_mm_store_ps(lResult, lSum);
+
+		#endif
+
+		result[3 * i + 0] = lResult[0];
+		result[3 * i + 1] = lResult[1];
+		result[3 * i + 2] = lResult[2];
+	}
+}
+
+/*****************************************************************************
+* Math/SQTArray                                                              *
+*****************************************************************************/
+
+#ifdef __AVX__
+
+typedef __m256 Lane;
+
+constexpr std::size_t kLaneWidth = 8;
+
+inline Lane load(const float* p) noexcept { return _mm256_load_ps(p); }
+inline void store(float* p, const Lane v) noexcept { _mm256_store_ps(p, v); }
+inline Lane set1(const float s) noexcept { return _mm256_set1_ps(s); }
+inline Lane add(const Lane a, const Lane b) noexcept { return _mm256_add_ps(a, b); }
+inline Lane sub(const Lane a, const Lane b) noexcept { return _mm256_sub_ps(a, b); }
+inline Lane mul(const Lane a, const Lane b) noexcept { return _mm256_mul_ps(a, b); }
+inline Lane div(const Lane a, const Lane b) noexcept { return _mm256_div_ps(a, b); }
+inline Lane sqrt(const Lane a) noexcept { return _mm256_sqrt_ps(a); }
+inline Lane bitAnd(const Lane a, const Lane b) noexcept { return _mm256_and_ps(a, b); }
+inline Lane bitXor(const Lane a, const Lane b) noexcept { return _mm256_xor_ps(a, b); }
+
+#else
+
+typedef __m128 Lane;
+
+constexpr std::size_t kLaneWidth = 4;
+
+inline Lane load(const float* p) noexcept { return _mm_load_ps(p); }
+inline void store(float* p, const Lane v) noexcept { _mm_store_ps(p, v); }
+inline Lane set1(const float s) noexcept { return _mm_set1_ps(s); }
+inline Lane add(const Lane a, const Lane b) noexcept { return _mm_add_ps(a, b); }
+inline Lane sub(const Lane a, const Lane b) noexcept { return _mm_sub_ps(a, b); }
+inline Lane mul(const Lane a, const Lane b) noexcept { return _mm_mul_ps(a, b); }
+inline Lane div(const Lane a, const Lane b) noexcept { return _mm_div_ps(a, b); }
+inline Lane sqrt(const Lane a) noexcept { return _mm_sqrt_ps(a); }
+inline Lane bitAnd(const Lane a, const Lane b) noexcept { return _mm_and_ps(a, b); }
+inline Lane bitXor(const Lane a, const Lane b) noexcept { return _mm_xor_ps(a, b); }
+
+#endif
+
+// The interpolation parameter of the SQTs [i, i + kLaneWidth).
+inline Lane weight(const Lane a, const float* mask, const std::size_t i)
+	noexcept
+{
+	return mask ? mul(a, load(mask + i)) : a;
+}
+
+// r = u + (v - u) * a for one channel.
+inline void lerpChannel(const float* u, const float* v, const Lane a,
+	const float* mask, float* r, const std::size_t stride) noexcept
+{
+	for (std::size_t i = 0; i < stride; i += kLaneWidth)
+	{
+		const auto lU = load(u + i);
+		store(r + i, add(lU, mul(sub(load(v + i), lU), weight(a, mask, i))));
+	}
+}
+
+// The rotation channels of an SQTArray.
+struct Rotations
+{
+	float* x;
+	float* y;
+	float* z;
+	float* w;
+
+	Rotations(const float* sqts, const std::size_t stride) noexcept
+	: x(const_cast<float*>(sqts) + SQTArray::kRotationX * stride)
+	, y(const_cast<float*>(sqts) + SQTArray::kRotationY * stride)
+	, z(const_cast<float*>(sqts) + SQTArray::kRotationZ * stride)
+	, w(const_cast<float*>(sqts) + SQTArray::kRotationW * stride)
+	{
+		/* Empty on purpose. */
+	}
+};
+
+const SQTArray::Channel kLinearChannels[] = {SQTArray::kScaleX,
+	SQTArray::kScaleY, SQTArray::kScaleZ, SQTArray::kTranslationX,
+	SQTArray::kTranslationY, SQTArray::kTranslationZ};
+const SQTArray::Channel kScaleChannels[] = {SQTArray::kScaleX,
+	SQTArray::kScaleY, SQTArray::kScaleZ};
+const SQTArray::Channel kTranslationChannels[] = {SQTArray::kTranslationX,
+	SQTArray::kTranslationY, SQTArray::kTranslationZ};
+
+// r = a * b for four or eight quaternions at once.
+inline void multiply(const Lane ax, const Lane ay, const Lane az,
+	const Lane aw, const Lane bx, const Lane by, const Lane bz, const Lane bw,
+	Lane& rx, Lane& ry, Lane& rz, Lane& rw) noexcept
+{
+	rx = sub(add(add(mul(aw, bx), mul(ax, bw)), mul(ay, bz)), mul(az, by));
+	ry = add(sub(add(mul(aw, by), mul(ay, bw)), mul(ax, bz)), mul(az, bx));
+	rz = sub(add(add(mul(aw, bz), mul(az, bw)), mul(ax, by)), mul(ay, bx));
+	rw = sub(sub(sub(mul(aw, bw), mul(ax, bx)), mul(ay, by)), mul(az, bz));
+}
+
+void mix(const float* u, const float* v, const float a, const float* mask,
+	float* result, const std::size_t stride) noexcept
+{
+	const auto lA = set1(a);
+
+	for (const auto c : kLinearChannels)
+	{
+		lerpChannel(u + c * stride, v + c * stride, lA, mask,
+			result + c * stride, stride);
+	}
+
+	const auto lOne = set1(1.0f);
+	const auto lSignMask = set1(-0.0f);
+
+	const float* lUX = u + SQTArray::kRotationX * stride;
+	const float* lUY = u + SQTArray::kRotationY * stride;
+	const float* lUZ = u + SQTArray::kRotationZ * stride;
+	const float* lUW = u + SQTArray::kRotationW * stride;
+	const float* lVX = v + SQTArray::kRotationX * stride;
+	const float* lVY = v + SQTArray::kRotationY * stride;
+	const float* lVZ = v + SQTArray::kRotationZ * stride;
+	const float* lVW = v + SQTArray::kRotationW * stride;
+	float* lRX = result + SQTArray::kRotationX * stride;
+	float* lRY = result + SQTArray::kRotationY * stride;
+	float* lRZ = result + SQTArray::kRotationZ * stride;
+	float* lRW = result + SQTArray::kRotationW * stride;
+
+	for (std::size_t i = 0; i < stride; i += kLaneWidth)
+	{
+		const auto lX0 = load(lUX + i);
+		const auto lY0 = load(lUY + i);
+		const auto lZ0 = load(lUZ + i);
+		const auto lW0 = load(lUW + i);
+		auto lX1 = load(lVX + i);
+		auto lY1 = load(lVY + i);
+		auto lZ1 = load(lVZ + i);
+		auto lW1 = load(lVW + i);
+
+		// q and -q are the same rotation. Take the one that is closest to
+		// the first quaternion, so that the shortest arc is followed.
+		const auto lDot = add(add(mul(lX0, lX1), mul(lY0, lY1)),
+			add(mul(lZ0, lZ1), mul(lW0, lW1)));
+		const auto lSign = bitAnd(lDot, lSignMask);
+		lX1 = bitXor(lX1, lSign);
+		lY1 = bitXor(lY1, lSign);
+		lZ1 = bitXor(lZ1, lSign);
+		lW1 = bitXor(lW1, lSign);
+
+		const auto lA1 = weight(lA, mask, i);
+		const auto lA0 = sub(lOne, lA1);
+		const auto lX = add(mul(lX0, lA0), mul(lX1, lA1));
+		const auto lY = add(mul(lY0, lA0), mul(lY1, lA1));
+		const auto lZ = add(mul(lZ0, lA0), mul(lZ1, lA1));
+		const auto lW = add(mul(lW0, lA0), mul(lW1, lA1));
+
+		const auto lLength = sqrt(add(add(mul(lX, lX), mul(lY, lY)),
+			add(mul(lZ, lZ), mul(lW, lW))));
+
+		store(lRX + i, div(lX, lLength));
+		store(lRY + i, div(lY, lLength));
+		store(lRZ + i, div(lZ, lLength));
+		store(lRW + i, div(lW, lLength));
+	}
+}
+
+void difference(const float* reference, const float* pose, float* result,
+	const std::size_t stride) noexcept
+{
+
+	for (const auto c : kScaleChannels)
+	{
+		const auto lR = reference + c * stride;
+		const auto lP = pose + c * stride;
+		const auto lResult = result + c * stride;
+		for (std::size_t i = 0; i < stride; i += kLaneWidth)
+		{
+			store(lResult + i, div(load(lP + i), load(lR + i)));
+		}
+	}
+	for (const auto c : kTranslationChannels)
+	{
+		const auto lR = reference + c * stride;
+		const auto lP = pose + c * stride;
+		const auto lResult = result + c * stride;
+		for (std::size_t i = 0; i < stride; i += kLaneWidth)
+		{
+			store(lResult + i, sub(load(lP + i), load(lR + i)));
+		}
+	}
+
+	// The conjugate of the reference rotation, times the pose rotation.
+	const auto lSignMask = set1(-0.0f);
+	const Rotations lR(reference, stride);
+	const Rotations lP(pose, stride);
+	const Rotations lResult(result, stride);
+	for (std::size_t i = 0; i < stride; i += kLaneWidth)
+	{
+		Lane lX, lY, lZ, lW;
+		multiply(bitXor(load(lR.x + i), lSignMask),
+			bitXor(load(lR.y + i), lSignMask),
+			bitXor(load(lR.z + i), lSignMask), load(lR.w + i),
+			load(lP.x + i), load(lP.y + i), load(lP.z + i), load(lP.w + i),
+			lX, lY, lZ, lW);
+		store(lResult.x + i, lX);
+		store(lResult.y + i, lY);
+		store(lResult.z + i, lZ);
+		store(lResult.w + i, lW);
+	}
+}
+
+void applyAdditive(const float* base, const float* difference,
+	const float a, const float* mask, float* result, const std::size_t stride)
+	noexcept
+{
+	const auto lA = set1(a);
+	const auto lOne = set1(1.0f);
+
+	// The scales are multiplied with the difference scaled towards one.
+	for (const auto c : kScaleChannels)
+	{
+		const auto lB = base + c * stride;
+		const auto lD = difference + c * stride;
+		const auto lResult = result + c * stride;
+		for (std::size_t i = 0; i < stride; i += kLaneWidth)
+		{
+			const auto lScale = add(lOne,
+				mul(sub(load(lD + i), lOne), weight(lA, mask, i)));
+			store(lResult + i, mul(load(lB + i), lScale));
+		}
+	}
+	for (const auto c : kTranslationChannels)
+	{
+		const auto lB = base + c * stride;
+		const auto lD = difference + c * stride;
+		const auto lResult = result + c * stride;
+		for (std::size_t i = 0; i < stride; i += kLaneWidth)
+		{
+			store(lResult + i,
+				add(load(lB + i), mul(load(lD + i), weight(lA, mask, i))));
+		}
+	}
+
+	// The base rotation times the difference nlerped from the identity.
+	// The identity is (0, 0, 0, 1), so the nlerp keeps the sign of w
+	// positive to take the shortest arc.
+	const auto lSignMask = set1(-0.0f);
+	const Rotations lB(base, stride);
+	const Rotations lD(difference, stride);
+	const Rotations lResult(result, stride);
+	for (std::size_t i = 0; i < stride; i += kLaneWidth)
+	{
+		const auto lA1 = weight(lA, mask, i);
+		const auto lA0 = sub(lOne, lA1);
+		const auto lDW = load(lD.w + i);
+		const auto lSign = bitAnd(lDW, lSignMask);
+		const auto lX1 = mul(bitXor(load(lD.x + i), lSign), lA1);
+		const auto lY1 = mul(bitXor(load(lD.y + i), lSign), lA1);
+		const auto lZ1 = mul(bitXor(load(lD.z + i), lSign), lA1);
+		const auto lW1 = add(lA0, mul(bitXor(lDW, lSign), lA1));
+		const auto lLength = sqrt(add(add(mul(lX1, lX1), mul(lY1, lY1)),
+			add(mul(lZ1, lZ1), mul(lW1, lW1))));
+
+		Lane lX, lY, lZ, lW;
+		multiply(load(lB.x + i), load(lB.y + i), load(lB.z + i),
+			load(lB.w + i), div(lX1, lLength), div(lY1, lLength),
+			div(lZ1, lLength), div(lW1, lLength), lX, lY, lZ, lW);
+		store(lResult.x + i, lX);
+		store(lResult.y + i, lY);
+		store(lResult.z + i, lZ);
+		store(lResult.w + i, lW);
+	}
+}
+
+/*****************************************************************************
+* Math/frustum3f                                                             *
+*****************************************************************************/
+
+// Returns a * x + b * y + c * z + w, where (a, b, c, w) is the plane.
+inline __m128 planeDistance(const __m128 plane, const __m128 x,
+	const __m128 y, const __m128 z) noexcept
+{
+	auto lResult = _mm_madd_ps(_mm_replicate_x_ps(plane), x,
+		_mm_replicate_w_ps(plane));
+	lResult = _mm_madd_ps(_mm_replicate_y_ps(plane), y, lResult);
+	return _mm_madd_ps(_mm_replicate_z_ps(plane), z, lResult);
+}
+
+// Transpose the corners of four boxes into x, y and z registers.
+inline void transposeBoxes(const box3f* boxes, __m128& minX, __m128& minY,
+	__m128& minZ, __m128& maxX, __m128& maxY, __m128& maxZ) noexcept
+{
+	minX = boxes[0].minCorner.data;
+	minY = boxes[1].minCorner.data;
+	minZ = boxes[2].minCorner.data;
+	auto lMinW = boxes[3].minCorner.data;
+	_MM_TRANSPOSE4_PS(minX, minY, minZ, lMinW);
+	maxX = boxes[0].maxCorner.data;
+	maxY = boxes[1].maxCorner.data;
+	maxZ = boxes[2].maxCorner.data;
+	auto lMaxW = boxes[3].maxCorner.data;
+	_MM_TRANSPOSE4_PS(maxX, maxY, maxZ, lMaxW);
+}
+
+std::size_t intersects(const frustum3f& frustum, const box3f* boxes,
+	const std::size_t count, std::uint8_t* visible) noexcept
+{
+	std::size_t lResult = 0;
+	std::size_t i = 0;
+
+	#ifdef __AVX__
+
+	// Eight boxes at a time, every plane broadcast to all lanes.
+	const auto lWideHalf = _mm256_set1_ps(0.5f);
+	const auto lWideZero = _mm256_setzero_ps();
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128 lMin[2][3];
+		__m128 lMax[2][3];
+		for (int k = 0; k < 2; ++k)
+		{
+			transposeBoxes(boxes + i + 4 * k, lMin[k][0], lMin[k][1],
+				lMin[k][2], lMax[k][0], lMax[k][1], lMax[k][2]);
+		}
+		__m256 lCenter[3];
+		__m256 lExtent[3];
+		for (int c = 0; c < 3; ++c)
+		{
+			const auto lMinC = combine(lMin[0][c], lMin[1][c]);
+			const auto lMaxC = combine(lMax[0][c], lMax[1][c]);
+			lCenter[c] = _mm256_mul_ps(_mm256_add_ps(lMinC, lMaxC), lWideHalf);
+			lExtent[c] = _mm256_mul_ps(_mm256_sub_ps(lMaxC, lMinC), lWideHalf);
+		}
+
+		auto lOutside = _mm256_setzero_ps();
+		for (const auto& lPlane : frustum.planes)
+		{
+			const auto lAbsolute = absolute(lPlane.data);
+			auto lDistance = _mm256_madd_ps(_mm256_set1_ps(lPlane.x),
+				lCenter[0], _mm256_set1_ps(lPlane.w));
+			lDistance = _mm256_madd_ps(_mm256_set1_ps(lPlane.y), lCenter[1],
+				lDistance);
+			lDistance = _mm256_madd_ps(_mm256_set1_ps(lPlane.z), lCenter[2],
+				lDistance);
+			auto lRadius = _mm256_mul_ps(combine(_mm_replicate_x_ps(lAbsolute),
+				_mm_replicate_x_ps(lAbsolute)), lExtent[0]);
+			lRadius = _mm256_madd_ps(combine(_mm_replicate_y_ps(lAbsolute),
+				_mm_replicate_y_ps(lAbsolute)), lExtent[1], lRadius);
+			lRadius = _mm256_madd_ps(combine(_mm_replicate_z_ps(lAbsolute),
+				_mm_replicate_z_ps(lAbsolute)), lExtent[2], lRadius);
+			lOutside = _mm256_or_ps(lOutside, _mm256_cmp_ps(
+				_mm256_add_ps(lDistance, lRadius), lWideZero, _CMP_LT_OQ));
+		}
+
+		const auto lMask = _mm256_movemask_ps(lOutside);
+		for (int j = 0; j < 8; ++j)
+		{
+			visible[i + j] = (lMask & (1 << j)) ? 0 : 1;
+			lResult += visible[i + j];
+		}
+	}
+
+	#endif // __AVX__
+
+	const auto lHalf = _mm_set1_ps(0.5f);
+	const auto lZero = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 lMinX, lMinY, lMinZ, lMaxX, lMaxY, lMaxZ;
+		transposeBoxes(boxes + i, lMinX, lMinY, lMinZ, lMaxX, lMaxY, lMaxZ);
+
+		const auto lCenterX = _mm_mul_ps(_mm_add_ps(lMinX, lMaxX), lHalf);
+		const auto lCenterY = _mm_mul_ps(_mm_add_ps(lMinY, lMaxY), lHalf);
+		const auto lCenterZ = _mm_mul_ps(_mm_add_ps(lMinZ, lMaxZ), lHalf);
+		const auto lExtentX = _mm_mul_ps(_mm_sub_ps(lMaxX, lMinX), lHalf);
+		const auto lExtentY = _mm_mul_ps(_mm_sub_ps(lMaxY, lMinY), lHalf);
+		const auto lExtentZ = _mm_mul_ps(_mm_sub_ps(lMaxZ, lMinZ), lHalf);
+
+		auto lOutside = _mm_setzero_ps();
+		for (const auto& lPlane : frustum.planes)
+		{
+			const auto lDistance = planeDistance(lPlane.data, lCenterX,
+				lCenterY, lCenterZ);
+			const auto lAbsolute = absolute(lPlane.data);
+			auto lRadius = _mm_mul_ps(_mm_replicate_x_ps(lAbsolute), lExtentX);
+			lRadius = _mm_madd_ps(_mm_replicate_y_ps(lAbsolute), lExtentY,
+				lRadius);
+			lRadius = _mm_madd_ps(_mm_replicate_z_ps(lAbsolute), lExtentZ,
+				lRadius);
+			lOutside = _mm_or_ps(lOutside,
+				_mm_cmplt_ps(_mm_add_ps(lDistance, lRadius), lZero));
+		}
+
+		const auto lMask = _mm_movemask_ps(lOutside);
+		for (int j = 0; j < 4; ++j)
+		{
+			visible[i + j] = (lMask & (1 << j)) ? 0 : 1;
+			lResult += visible[i + j];
+		}
+	}
+
+	// The remaining boxes.
+	for (; i < count; ++i)
+	{
+		visible[i] = frustum.intersects(boxes[i]) ? 1 : 0;
+		lResult += visible[i];
+	}
+
+	return lResult;
+}
+
+} // anonymous namespace
+
+const MathKernels GT_KERNELS = {
+	&multiplyOne,
+	&multiplyMany,
+	&transform,
+	&transformPoints,
+	&transformDirections,
+	&transformPackedPoints,
+	&transformPackedDirections,
+	&toMatrices,
+	&transformBoxes,
+	&transformEachBox,
+	&normalMatrices,
+	&skinPositions,
+	&mix,
+	&difference,
+	&applyAdditive,
+	&intersects
+};
+
+} // namespace detail
+} // namespace gintonic
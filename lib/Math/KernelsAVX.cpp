@@ -0,0 +1,3 @@
+// The kernels for SIMDLevel::kAVX, compiled with AVX. See lib/CMakeLists.txt.
+#define GT_KERNELS kAVXKernels
+#include "Kernels.inl"
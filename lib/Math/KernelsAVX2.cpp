@@ -0,0 +1,4 @@
+// The kernels for SIMDLevel::kAVX2, compiled with AVX2 and FMA. See
+// lib/CMakeLists.txt.
+#define GT_KERNELS kAVX2Kernels
+#include "Kernels.inl"
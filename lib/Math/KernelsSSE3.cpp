@@ -0,0 +1,4 @@
+// The kernels for SIMDLevel::kSSE3, compiled with the baseline flags of the
+// library. See lib/CMakeLists.txt.
+#define GT_KERNELS kSSE3Kernels
+#include "Kernels.inl"
@@ -0,0 +1,99 @@
+#include "Math/SQTArray.hpp"
+
+#include "Kernels.hpp"
+
+#include <algorithm>
+
+namespace gintonic {
+
+constexpr std::size_t SQTArray::kWidth;
+
+static_assert(SQTArray::kWidth % 8 == 0,
+	"The padding of an SQTArray must be a multiple of the AVX lane width.");
+
+SQTArray::SQTArray(const std::size_t count)
+{
+	resize(count);
+}
+
+void SQTArray::resize(const std::size_t count)
+{
+	mCount = count;
+	mStride = (count + kWidth - 1) / kWidth * kWidth;
+	mData.assign(kChannelCount * mStride, 0.0f);
+	std::fill_n(channel(kScaleX), mStride, 1.0f);
+	std::fill_n(channel(kScaleY), mStride, 1.0f);
+	std::fill_n(channel(kScaleZ), mStride, 1.0f);
+	std::fill_n(channel(kRotationW), mStride, 1.0f);
+}
+
+SQT SQTArray::get(const std::size_t i) const noexcept
+{
+	SQT lResult;
+	lResult.scale.x = channel(kScaleX)[i];
+	lResult.scale.y = channel(kScaleY)[i];
+	lResult.scale.z = channel(kScaleZ)[i];
+	lResult.rotation.x = channel(kRotationX)[i];
+	lResult.rotation.y = channel(kRotationY)[i];
+	lResult.rotation.z = channel(kRotationZ)[i];
+	lResult.rotation.w = channel(kRotationW)[i];
+	lResult.translation.x = channel(kTranslationX)[i];
+	lResult.translation.y = channel(kTranslationY)[i];
+	lResult.translation.z = channel(kTranslationZ)[i];
+	return lResult;
+}
+
+void SQTArray::set(const std::size_t i, const SQT& sqt) noexcept
+{
+	channel(kScaleX)[i] = sqt.scale.x;
+	channel(kScaleY)[i] = sqt.scale.y;
+	channel(kScaleZ)[i] = sqt.scale.z;
+	channel(kRotationX)[i] = sqt.rotation.x;
+	channel(kRotationY)[i] = sqt.rotation.y;
+	channel(kRotationZ)[i] = sqt.rotation.z;
+	channel(kRotationW)[i] = sqt.rotation.w;
+	channel(kTranslationX)[i] = sqt.translation.x;
+	channel(kTranslationY)[i] = sqt.translation.y;
+	channel(kTranslationZ)[i] = sqt.translation.z;
+}
+
+void mix(const SQTArray& u, const SQTArray& v, const float a,
+	SQTArray& result)
+{
+	mix(u, v, a, nullptr, result);
+}
+
+void mix(const SQTArray& u, const SQTArray& v, const float a,
+	const float* mask, SQTArray& result)
+{
+	GT_PROFILE_FUNCTION;
+
+	if (result.size() != u.size()) result.resize(u.size());
+	detail::kernels().mix(u.channel(SQTArray::kScaleX),
+		v.channel(SQTArray::kScaleX), a, mask,
+		result.channel(SQTArray::kScaleX), u.stride());
+}
+
+void difference(const SQTArray& reference, const SQTArray& pose,
+	SQTArray& result)
+{
+	GT_PROFILE_FUNCTION;
+
+	if (result.size() != pose.size()) result.resize(pose.size());
+	detail::kernels().difference(reference.channel(SQTArray::kScaleX),
+		pose.channel(SQTArray::kScaleX), result.channel(SQTArray::kScaleX),
+		pose.stride());
+}
+
+void applyAdditive(const SQTArray& base, const SQTArray& difference,
+	const float a, const float* mask, SQTArray& result)
+{
+	GT_PROFILE_FUNCTION;
+
+	if (result.size() != base.size()) result.resize(base.size());
+	detail::kernels().applyAdditive(base.channel(SQTArray::kScaleX),
+		difference.channel(SQTArray::kScaleX), a, mask,
+		result.channel(SQTArray::kScaleX), base.stride());
+}
+
+} // namespace gintonic
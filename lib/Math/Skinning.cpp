@@ -0,0 +1,17 @@
+#include "Math/Skinning.hpp"
+
+#include "Kernels.hpp"
+
+namespace gintonic {
+
+void skinPositions(const mat4f* palette, const std::size_t jointCount,
+	const float* positions, const std::uint32_t* vertices,
+	const std::int32_t* jointIndices, const float* jointWeights,
+	const std::size_t first, const std::size_t last, float* result) noexcept
+{
+	GT_PROFILE_FUNCTION;
+	detail::kernels().skinPositions(palette, jointCount, positions, vertices,
+		jointIndices, jointWeights, first, last, result);
+}
+
+} // namespace gintonic
@@ -0,0 +1,85 @@
+#include "Math/Transforms.hpp"
+
+#include "Kernels.hpp"
+
+namespace gintonic {
+
+void multiply(const mat4f& lhs, const mat4f* rhs, const std::size_t count,
+	mat4f* result) noexcept
+{
+	GT_PROFILE_FUNCTION;
+	detail::kernels().multiplyOne(lhs, rhs, count, result);
+}
+
+void multiply(const mat4f* lhs, const mat4f* rhs, const std::size_t count,
+	mat4f* result) noexcept
+{
+	GT_PROFILE_FUNCTION;
+	detail::kernels().multiplyMany(lhs, rhs, count, result);
+}
+
+void transform(const mat4f& matrix, const vec4f* vectors,
+	const std::size_t count, vec4f* result) noexcept
+{
+	GT_PROFILE_FUNCTION;
+	detail::kernels().transform(matrix, vectors, count, result);
+}
+
+void transformPoints(const mat4f& matrix, const vec3f* points,
+	const std::size_t count, vec3f* result) noexcept
+{
+	GT_PROFILE_FUNCTION;
+	detail::kernels().transformPoints(matrix, points, count, result);
+}
+
+void transformDirections(const mat4f& matrix, const vec3f* directions,
+	const std::size_t count, vec3f* result) noexcept
+{
+	GT_PROFILE_FUNCTION;
+	detail::kernels().transformDirections(matrix, directions, count, result);
+}
+
+void transformPoints(const mat4f& matrix, const float* points,
+	const std::size_t count, float* result) noexcept
+{
+	GT_PROFILE_FUNCTION;
+	detail::kernels().transformPackedPoints(matrix, points, count, result);
+}
+
+void transformDirections(const mat4f& matrix, const float* directions,
+	const std::size_t count, float* result) noexcept
+{
+	GT_PROFILE_FUNCTION;
+	detail::kernels().transformPackedDirections(matrix, directions, count,
+		result);
+}
+
+void toMatrices(const SQT* transforms, const std::size_t count,
+	mat4f* result) noexcept
+{
+	GT_PROFILE_FUNCTION;
+	detail::kernels().toMatrices(transforms, count, result);
+}
+
+void transformBoxes(const mat4f& matrix, const box3f* boxes,
+	const std::size_t count, box3f* result) noexcept
+{
+	GT_PROFILE_FUNCTION;
+	detail::kernels().transformBoxes(matrix, boxes, count, result);
+}
+
+void transformBoxes(const mat4f* matrices, const box3f* boxes,
+	const std::size_t count, box3f* result) noexcept
+{
+	GT_PROFILE_FUNCTION;
+	detail::kernels().transformEachBox(matrices, boxes, count, result);
+}
+
+void normalMatrices(const mat4f* matrices, const std::size_t count,
+	mat3f* result) noexcept
+{
+	GT_PROFILE_FUNCTION;
+	detail::kernels().normalMatrices(matrices, count, result);
+}
+
+} // namespace gintonic
@@ -71,37 +71,17 @@ void box3f::addPoint(const vec4f& point) noexcept
 	maxCorner.data = _mm_max_ps(maxCorner.data, point.data);
 }
 
-#define GT_INTERSECTS_VERSION 0
-
 bool intersects(const box3f& a, const box3f& b) noexcept
 {
 	GT_PROFILE_FUNCTION;
 
-	#if GT_INTERSECTS_VERSION == 1
-
-	auto x = a.contains(b.minCorner);
-	auto y = a.contains(b.maxCorner);
-	auto z = b.contains(a.minCorner);
-	auto w = b.contains(a.maxCorner);
-	return x || y || z || w;
-
-	#else // GT_INTERSECTS_VERSION
-
-	std::array<vec3f, 8> lCorners;
-	a.getCorners(lCorners.begin());
-	for (int i = 0; i < 8; ++i)
-	{
-		if (b.contains(lCorners[i])) return true;
-	}
-	b.getCorners(lCorners.begin());
-	for (int i = 0; i < 8; ++i)
-	{
-		if (a.contains(lCorners[i])) return true;
-	}
-
-	return false;
-
-	#endif // GT_INTERSECTS_VERSION
+	// The boxes are apart if they are apart along one of the axes. Checking
+	// wether a corner of one box is inside the other misses boxes that
+	// overlap like a plus sign.
+	const auto lApart = _mm_or_ps(
+		_mm_cmpgt_ps(a.minCorner.data, b.maxCorner.data),
+		_mm_cmpgt_ps(b.minCorner.data, a.maxCorner.data));
+	return (_mm_movemask_ps(lApart) & 0x7) == 0;
 }
 
 std::ostream& operator << (std::ostream& os, const box3f& b)
@@ -0,0 +1,138 @@
+#include "Math/frustum3f.hpp"
+#include "Math/box3f.hpp"
+#include "Math/mat4f.hpp"
+#include "Math/plane3f.hpp"
+#include "Kernels.hpp"
+#include <cmath>
+
+namespace { // anonymous namespace
+
+// The signed distance of a point to a plane.
+inline float signedDistance(const gintonic::vec4f& plane,
+	const gintonic::vec3f& point) noexcept
+{
+	return plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w;
+}
+
+// The radius of a box with the given half extents, projected on the
+// normal of a plane.
+inline float projectedRadius(const gintonic::vec4f& plane,
+	const gintonic::vec3f& extent) noexcept
+{
+	return std::abs(plane.x) * extent.x + std::abs(plane.y) * extent.y
+		+ std::abs(plane.z) * extent.z;
+}
+
+} // anonymous namespace
+
+namespace gintonic {
+
+frustum3f::frustum3f() noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	for (auto& lPlane : planes) lPlane = vec4f(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+frustum3f::frustum3f(const mat4f& matrixPV) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	set(matrixPV);
+}
+
+void frustum3f::set(const mat4f& matrixPV) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	// The matrix is stored column major, so transposing gives us the rows.
+	auto lRow0 = matrixPV.data[0];
+	auto lRow1 = matrixPV.data[1];
+	auto lRow2 = matrixPV.data[2];
+	auto lRow3 = matrixPV.data[3];
+	_MM_TRANSPOSE4_PS(lRow0, lRow1, lRow2, lRow3);
+
+	planes[kLeft]   = plane3f(_mm_add_ps(lRow3, lRow0)).equation;
+	planes[kRight]  = plane3f(_mm_sub_ps(lRow3, lRow0)).equation;
+	planes[kBottom] = plane3f(_mm_add_ps(lRow3, lRow1)).equation;
+	planes[kTop]    = plane3f(_mm_sub_ps(lRow3, lRow1)).equation;
+	planes[kNear]   = plane3f(_mm_add_ps(lRow3, lRow2)).equation;
+	planes[kFar]    = plane3f(_mm_sub_ps(lRow3, lRow2)).equation;
+}
+
+plane3f frustum3f::extractPlane(const mat4f& matrixPV, const Plane which)
+	noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	// Only the last row and the row of the plane are needed.
+	const auto lValues = matrixPV.value_ptr();
+	const int lRow = which / 2;
+	const auto lLast = _mm_setr_ps(lValues[3], lValues[7], lValues[11],
+		lValues[15]);
+	const auto lOther = _mm_setr_ps(lValues[lRow], lValues[4 + lRow],
+		lValues[8 + lRow], lValues[12 + lRow]);
+	return plane3f(which % 2 == 0 ? _mm_add_ps(lLast, lOther)
+		: _mm_sub_ps(lLast, lOther));
+}
+
+plane3f frustum3f::getPlane(const Plane which) const noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	plane3f lResult;
+	lResult.equation = planes[which];
+	return lResult;
+}
+
+bool frustum3f::intersects(const box3f& box) const noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const auto lCenter = 0.5f * (box.minCorner + box.maxCorner);
+	const auto lExtent = 0.5f * (box.maxCorner - box.minCorner);
+	for (const auto& lPlane : planes)
+	{
+		const auto lDistance = signedDistance(lPlane, lCenter);
+		const auto lRadius = projectedRadius(lPlane, lExtent);
+		if (lDistance + lRadius < 0.0f) return false;
+	}
+	return true;
+}
+
+bool frustum3f::contains(const box3f& box) const noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const auto lCenter = 0.5f * (box.minCorner + box.maxCorner);
+	const auto lExtent = 0.5f * (box.maxCorner - box.minCorner);
+	for (const auto& lPlane : planes)
+	{
+		const auto lDistance = signedDistance(lPlane, lCenter);
+		const auto lRadius = projectedRadius(lPlane, lExtent);
+		if (lDistance - lRadius < 0.0f) return false;
+	}
+	return true;
+}
+
+std::size_t frustum3f::intersects(const box3f* boxes, const std::size_t count,
+	std::uint8_t* visible) const noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	return detail::kernels().intersects(*this, boxes, count, visible);
+}
+
+std::ostream& operator << (std::ostream& os, const frustum3f& f)
+{
+	GT_PROFILE_FUNCTION;
+
+	for (int i = 0; i < frustum3f::kPlaneCount; ++i)
+	{
+		if (i) os << ' ';
+		os << f.planes[i];
+	}
+	return os;
+}
+
+} // namespace gintonic
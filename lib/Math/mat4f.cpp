@@ -573,6 +573,101 @@ void mat4f::decompose(SQT& sqt) const
 	decompose(sqt.scale, sqt.rotation, sqt.translation);
 }
 
+namespace {
+
+// The translation of the inverse, given the first three columns of the
+// inverse and the translation of the matrix.
+inline __m128 inverseTranslation(const __m128 column0, const __m128 column1,
+	const __m128 column2, const __m128 translation) noexcept
+{
+	auto lResult = _mm_mul_ps(column0, _mm_replicate_x_ps(translation));
+	lResult = _mm_madd_ps(column1, _mm_replicate_y_ps(translation), lResult);
+	lResult = _mm_madd_ps(column2, _mm_replicate_z_ps(translation), lResult);
+	return _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), lResult);
+}
+
+// The cross product of the first three components. The fourth is zero.
+inline __m128 cross3(const __m128 lhs, const __m128 rhs) noexcept
+{
+	return _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle(lhs, 3, 0, 2, 1), _mm_shuffle(rhs, 3, 1, 0, 2)),
+		_mm_mul_ps(_mm_shuffle(lhs, 3, 1, 0, 2), _mm_shuffle(rhs, 3, 0, 2, 1)));
+}
+
+// The dot product of the first three components, in every component.
+inline __m128 dot3(const __m128 lhs, const __m128 rhs) noexcept
+{
+	auto lResult = _mm_mul_ps(lhs, rhs);
+	lResult = _mm_and_ps(lResult,
+		_mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+	lResult = _mm_hadd_ps(lResult, lResult);
+	return _mm_hadd_ps(lResult, lResult);
+}
+
+} // anonymous namespace
+
+mat4f mat4f::inverseRigid() const noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	// Transposing the first three columns, with a zero column for the fourth,
+	// gives the first three columns of the inverse.
+	auto c0 = data[0];
+	auto c1 = data[1];
+	auto c2 = data[2];
+	auto c3 = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+	return mat4f(c0, c1, c2, inverseTranslation(c0, c1, c2, data[3]));
+}
+
+mat4f mat4f::inverseAffine() const noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	// The rows of the inverse of the upper-left three by three part.
+	auto r0 = cross3(data[1], data[2]);
+	auto r1 = cross3(data[2], data[0]);
+	auto r2 = cross3(data[0], data[1]);
+
+	// The fourth component of r0 is zero, so this is the determinant.
+	auto lDeterminant = _mm_mul_ps(data[0], r0);
+	lDeterminant = _mm_hadd_ps(lDeterminant, lDeterminant);
+	lDeterminant = _mm_hadd_ps(lDeterminant, lDeterminant);
+	const auto lInverseDeterminant = _mm_div_ps(_mm_set1_ps(1.0f),
+		lDeterminant);
+	r0 = _mm_mul_ps(r0, lInverseDeterminant);
+	r1 = _mm_mul_ps(r1, lInverseDeterminant);
+	r2 = _mm_mul_ps(r2, lInverseDeterminant);
+
+	auto r3 = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	return mat4f(r0, r1, r2, inverseTranslation(r0, r1, r2, data[3]));
+}
+
+mat3f mat4f::normalMatrix(const bool nonUniformScale) const noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	__m128 c0, c1, c2, lScale;
+	if (nonUniformScale)
+	{
+		// The columns of the cofactor matrix.
+		c0 = cross3(data[1], data[2]);
+		c1 = cross3(data[2], data[0]);
+		c2 = cross3(data[0], data[1]);
+		lScale = _mm_div_ps(_mm_set1_ps(1.0f), dot3(data[0], c0));
+	}
+	else
+	{
+		c0 = data[0];
+		c1 = data[1];
+		c2 = data[2];
+		lScale = _mm_div_ps(_mm_set1_ps(1.0f), dot3(c0, c0));
+	}
+	return mat3f(vec3f(_mm_mul_ps(c0, lScale)), vec3f(_mm_mul_ps(c1, lScale)),
+		vec3f(_mm_mul_ps(c2, lScale)));
+}
+
 vec3f mat4f::apply_to_point(const vec3f& point) const noexcept
 {
 	GT_PROFILE_FUNCTION;
@@ -0,0 +1,82 @@
+#include "Math/obb3f.hpp"
+#include "Math/box3f.hpp"
+#include "Math/mat4f.hpp"
+#include <cmath>
+
+namespace gintonic {
+
+obb3f::obb3f() noexcept
+: center(0.0f, 0.0f, 0.0f)
+, extent(0.0f, 0.0f, 0.0f)
+{
+	GT_PROFILE_FUNCTION;
+
+	axes[0] = vec3f(1.0f, 0.0f, 0.0f);
+	axes[1] = vec3f(0.0f, 1.0f, 0.0f);
+	axes[2] = vec3f(0.0f, 0.0f, 1.0f);
+}
+
+obb3f::obb3f(const box3f& box) noexcept
+: center(0.5f * (box.minCorner + box.maxCorner))
+, extent(0.5f * (box.maxCorner - box.minCorner))
+{
+	GT_PROFILE_FUNCTION;
+
+	axes[0] = vec3f(1.0f, 0.0f, 0.0f);
+	axes[1] = vec3f(0.0f, 1.0f, 0.0f);
+	axes[2] = vec3f(0.0f, 0.0f, 1.0f);
+}
+
+obb3f::obb3f(const box3f& box, const mat4f& matrix) noexcept
+: center(matrix.apply_to_point(0.5f * (box.minCorner + box.maxCorner)))
+{
+	GT_PROFILE_FUNCTION;
+
+	const auto lExtent = 0.5f * (box.maxCorner - box.minCorner);
+	float lScale[3];
+	for (int i = 0; i < 3; ++i)
+	{
+		// The w-coordinates of the first three columns are zero.
+		axes[i] = vec3f(matrix.data[i]);
+		lScale[i] = axes[i].length();
+		if (lScale[i] > 0.0f) axes[i] /= lScale[i];
+	}
+	extent = vec3f(lExtent.x * lScale[0], lExtent.y * lScale[1],
+		lExtent.z * lScale[2]);
+}
+
+bool obb3f::contains(const vec3f& point) const noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const vec3f lDelta(point.x - center.x, point.y - center.y,
+		point.z - center.z);
+	return std::abs(dot(lDelta, axes[0])) <= extent.x
+		&& std::abs(dot(lDelta, axes[1])) <= extent.y
+		&& std::abs(dot(lDelta, axes[2])) <= extent.z;
+}
+
+box3f obb3f::bounds() const noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const auto lSignMask = _mm_set1_ps(-0.0f);
+	auto lHalf = _mm_mul_ps(_mm_andnot_ps(lSignMask, axes[0].data),
+		_mm_set1_ps(extent.x));
+	lHalf = _mm_add_ps(lHalf, _mm_mul_ps(
+		_mm_andnot_ps(lSignMask, axes[1].data), _mm_set1_ps(extent.y)));
+	lHalf = _mm_add_ps(lHalf, _mm_mul_ps(
+		_mm_andnot_ps(lSignMask, axes[2].data), _mm_set1_ps(extent.z)));
+	return box3f(_mm_sub_ps(center.data, lHalf),
+		_mm_add_ps(center.data, lHalf));
+}
+
+std::ostream& operator << (std::ostream& os, const obb3f& b)
+{
+	GT_PROFILE_FUNCTION;
+
+	return os << b.center << ' ' << b.axes[0] << ' ' << b.axes[1] << ' '
+		<< b.axes[2] << ' ' << b.extent;
+}
+
+} // namespace gintonic
@@ -0,0 +1,53 @@
+#include "Math/plane3f.hpp"
+#include <cmath>
+
+namespace gintonic {
+
+plane3f::plane3f() noexcept
+: equation(0.0f, 0.0f, 1.0f, 0.0f)
+{
+	GT_PROFILE_FUNCTION;
+}
+
+plane3f::plane3f(const vec3f& normal, const vec3f& point) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const auto lNormal = vec3f(normal.x, normal.y, normal.z).normalize();
+	equation = vec4f(lNormal, -dot(lNormal, vec3f(point.x, point.y, point.z)));
+}
+
+plane3f::plane3f(const vec4f& equation) noexcept
+: equation(equation)
+{
+	GT_PROFILE_FUNCTION;
+
+	const auto lLength = std::sqrt(equation.x * equation.x
+		+ equation.y * equation.y + equation.z * equation.z);
+	if (lLength < 1e-6f) this->equation = vec4f(0.0f, 0.0f, 0.0f, 1.0f);
+	else this->equation /= lLength;
+}
+
+float plane3f::distance(const vec3f& point) const noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	return equation.x * point.x + equation.y * point.y
+		+ equation.z * point.z + equation.w;
+}
+
+vec3f plane3f::project(const vec3f& point) const noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	return point - distance(point) * normal();
+}
+
+std::ostream& operator << (std::ostream& os, const plane3f& p)
+{
+	GT_PROFILE_FUNCTION;
+
+	return os << p.equation;
+}
+
+} // namespace gintonic
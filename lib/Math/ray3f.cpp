@@ -0,0 +1,44 @@
+#include "Math/ray3f.hpp"
+#include "Math/mat4f.hpp"
+#include "Math/vec4f.hpp"
+
+namespace gintonic {
+
+ray3f::ray3f() noexcept
+: origin(0.0f, 0.0f, 0.0f)
+, direction(0.0f, 0.0f, -1.0f)
+{
+	GT_PROFILE_FUNCTION;
+}
+
+ray3f::ray3f(const vec3f& origin, const vec3f& direction) noexcept
+: origin(origin.x, origin.y, origin.z)
+, direction(direction.x, direction.y, direction.z)
+{
+	GT_PROFILE_FUNCTION;
+
+	this->direction.normalize();
+}
+
+ray3f::ray3f(const mat4f& inverseMatrixPV, const float ndcX,
+	const float ndcY) noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	// Unproject a point on the near plane and one halfway the depth range.
+	// The far plane is at infinity for an infinite perspective projection.
+	const auto lNear = inverseMatrixPV * vec4f(ndcX, ndcY, -1.0f, 1.0f);
+	const auto lMiddle = inverseMatrixPV * vec4f(ndcX, ndcY, 0.0f, 1.0f);
+	origin = vec3f(lNear.x, lNear.y, lNear.z) / lNear.w;
+	direction = vec3f(lMiddle.x, lMiddle.y, lMiddle.z) / lMiddle.w - origin;
+	direction.normalize();
+}
+
+std::ostream& operator << (std::ostream& os, const ray3f& r)
+{
+	GT_PROFILE_FUNCTION;
+
+	return os << r.origin << ' ' << r.direction;
+}
+
+} // namespace gintonic
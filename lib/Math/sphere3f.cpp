@@ -0,0 +1,35 @@
+#include "Math/sphere3f.hpp"
+
+namespace gintonic {
+
+sphere3f::sphere3f() noexcept
+: center(0.0f, 0.0f, 0.0f)
+, radius(0.0f)
+{
+	GT_PROFILE_FUNCTION;
+}
+
+sphere3f::sphere3f(const vec3f& center, const float radius) noexcept
+: center(center.x, center.y, center.z)
+, radius(radius)
+{
+	GT_PROFILE_FUNCTION;
+}
+
+bool sphere3f::contains(const vec3f& point) const noexcept
+{
+	GT_PROFILE_FUNCTION;
+
+	const vec3f lDelta(point.x - center.x, point.y - center.y,
+		point.z - center.z);
+	return lDelta.length2() <= radius * radius;
+}
+
+std::ostream& operator << (std::ostream& os, const sphere3f& s)
+{
+	GT_PROFILE_FUNCTION;
+
+	return os << s.center << ' ' << s.radius;
+}
+
+} // namespace gintonic
@@ -164,7 +164,7 @@ OctreeComp::Node* OctreeComp::Node::removeRecursive() noexcept
             // (Node::operator delete)(child, mAllocPlace);
             child = nullptr;
         }
-        _mm_free(mAllocPlace);
+        GINTONIC_ALIGNED_FREE(mAllocPlace);
         mAllocPlace = nullptr;
     }
     return mParent ? mParent->removeRecursive() : this;
@@ -199,7 +199,7 @@ void OctreeComp::Node::subdivide()
 
     assert(!isLeaf());
 
-    mAllocPlace = _mm_malloc(sizeof(Node) * 8, 16);
+    mAllocPlace = GINTONIC_ALIGNED_MALLOC(sizeof(Node) * 8, 16);
 
     mChildren[0] = new ((Node*)mAllocPlace + 0) Node(this, lMin, lMin + lHalf);
 
@@ -237,7 +237,7 @@ OctreeComp::Node::~Node() noexcept
             child->~Node();
             child = nullptr;
         }
-        _mm_free(mAllocPlace);
+        GINTONIC_ALIGNED_FREE(mAllocPlace);
         mAllocPlace = nullptr;
     }
     for (auto* comp : mComps) comp->mNode = nullptr;
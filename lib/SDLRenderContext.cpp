@@ -1,4 +1,5 @@
 #include "SDLRenderContext.hpp"
+#include "Graphics/OpenGL/StateCache.hpp"
 #include "Math/vec4f.hpp"
 #include "SDLWindow.hpp"
 #include "glad/glad.h"
@@ -28,6 +29,7 @@ SDLRenderContext::SDLRenderContext(SDLWindow& owner, const int major,
         SDL_GL_DeleteContext(mHandle);
         throw std::bad_alloc();
     }
+    OpenGL::StateCache::invalidate();
 
     // glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     resize();
@@ -0,0 +1,207 @@
+#define BOOST_TEST_MODULE AnimationBlend test
+#include <boost/test/unit_test.hpp>
+
+#include "Graphics/AnimationBlend.hpp"
+#include "Graphics/PosePool.hpp"
+#include "Math/SQTArray.hpp"
+#include "Fixtures.hpp"
+#include <algorithm>
+
+using namespace gintonic;
+
+namespace {
+
+// The time at which every blend is sampled.
+constexpr float kTime = 0.3f;
+
+// Two clips for the same skeleton that are in different poses at every
+// time, since the second one plays the frames of the first backwards.
+struct Clips
+{
+	std::shared_ptr<AnimationClip> first;
+	std::shared_ptr<AnimationClip> second;
+
+	Clips()
+	{
+		const auto lSkeleton = fixtures::makeSkeleton(
+			{GT_JOINT_NONE, 0, 1, 1, 3});
+		first = fixtures::makeClip(lSkeleton, 12);
+		second = fixtures::makeClip(lSkeleton, 12);
+		for (auto& lFrames : second->frames)
+		{
+			std::reverse(lFrames.begin(), lFrames.end());
+		}
+		first->pack();
+		second->pack();
+	}
+
+	SQT sample(const AnimationClip& clip, const std::size_t joint,
+		const float startTime = 0.0f) const
+	{
+		SQTArray lPose;
+		clip.samplePose(startTime, kTime, lPose);
+		return lPose.get(joint);
+	}
+};
+
+AnimationBlend::Layer makeLayer(const AnimationClip& clip,
+	const float weight = 1.0f)
+{
+	AnimationBlend::Layer lLayer;
+	lLayer.clip = &clip;
+	lLayer.weight = weight;
+	return lLayer;
+}
+
+// Compare the matrices, so that q and -q are the same rotation.
+void checkClose(const SQT& a, const SQT& b)
+{
+	const mat4f lA(a);
+	const mat4f lB(b);
+	for (int k = 0; k < 16; ++k)
+	{
+		BOOST_CHECK_SMALL(lA.value_ptr()[k] - lB.value_ptr()[k], 1e-4f);
+	}
+}
+
+// The reference: lerp for scale and translation, nlerp for the rotation.
+SQT reference(const SQT& u, SQT v, const float a)
+{
+	const auto lDot = u.rotation.x * v.rotation.x + u.rotation.y * v.rotation.y
+		+ u.rotation.z * v.rotation.z + u.rotation.w * v.rotation.w;
+	if (lDot < 0.0f) v.rotation = v.rotation * -1.0f;
+	auto lRotation = mix(u.rotation, v.rotation, a);
+	lRotation = lRotation * (1.0f / std::sqrt(lRotation.length2()));
+	return SQT(mix(u.scale, v.scale, a), lRotation,
+		mix(u.translation, v.translation, a));
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE ( crossfades_follow_the_weight )
+{
+	const Clips lClips;
+	const auto lJointCount = lClips.first->jointCount();
+	PosePool lPool;
+	AnimationBlend lBlend;
+	lBlend.layers.push_back(makeLayer(*lClips.first));
+	lBlend.layers.push_back(makeLayer(*lClips.second));
+	BOOST_CHECK_EQUAL(lBlend.jointCount(), lJointCount);
+
+	SQTArray lPose;
+	for (const float lWeight : {0.0f, 0.5f, 1.0f})
+	{
+		BOOST_TEST_CHECKPOINT("weight " << lWeight);
+		lBlend.layers.back().weight = lWeight;
+		lBlend.samplePose(kTime, lPool, lPose);
+		BOOST_REQUIRE_EQUAL(lPose.size(), lJointCount);
+		for (std::size_t j = 0; j < lJointCount; ++j)
+		{
+			checkClose(lPose.get(j), reference(lClips.sample(*lClips.first, j),
+				lClips.sample(*lClips.second, j), lWeight));
+		}
+	}
+
+	// The ends of the crossfade are the poses of the clips.
+	std::vector<mat4f, allocator<mat4f>> lExpected(lJointCount);
+	std::vector<mat4f, allocator<mat4f>> lActual(lJointCount);
+	lBlend.layers.back().weight = 0.0f;
+	lBlend.evaluatePose(kTime, lPool, lActual.data());
+	lClips.first->evaluatePose(0.0f, kTime, lExpected.data());
+	for (std::size_t j = 0; j < lJointCount; ++j)
+	{
+		for (int k = 0; k < 16; ++k)
+		{
+			BOOST_CHECK_SMALL(lActual[j].value_ptr()[k]
+				- lExpected[j].value_ptr()[k], 1e-4f);
+		}
+	}
+	lBlend.layers.back().weight = 1.0f;
+	lBlend.evaluatePose(kTime, lPool, lActual.data());
+	lClips.second->evaluatePose(0.0f, kTime, lExpected.data());
+	for (std::size_t j = 0; j < lJointCount; ++j)
+	{
+		for (int k = 0; k < 16; ++k)
+		{
+			BOOST_CHECK_SMALL(lActual[j].value_ptr()[k]
+				- lExpected[j].value_ptr()[k], 1e-4f);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE ( masked_joints_are_left_alone )
+{
+	const Clips lClips;
+	const auto lJointCount = lClips.first->jointCount();
+	auto lMask = AnimationBlend::makeMask(lJointCount);
+	BOOST_CHECK_EQUAL(lMask.size() % SQTArray::kWidth, 0);
+	lMask[1] = 1.0f;
+	lMask[3] = 0.5f;
+
+	PosePool lPool;
+	AnimationBlend lBlend;
+	lBlend.layers.push_back(makeLayer(*lClips.first));
+	lBlend.layers.push_back(makeLayer(*lClips.second, 0.8f));
+	lBlend.layers.back().mask = &lMask;
+
+	SQTArray lPose;
+	lBlend.samplePose(kTime, lPool, lPose);
+	for (std::size_t j = 0; j < lJointCount; ++j)
+	{
+		checkClose(lPose.get(j), reference(lClips.sample(*lClips.first, j),
+			lClips.sample(*lClips.second, j), 0.8f * lMask[j]));
+	}
+	for (const std::size_t j : {0, 2, 4})
+	{
+		checkClose(lPose.get(j), lClips.sample(*lClips.first, j));
+	}
+}
+
+BOOST_AUTO_TEST_CASE ( additive_layers_are_relative_to_their_first_frame )
+{
+	const Clips lClips;
+	const auto lJointCount = lClips.first->jointCount();
+	PosePool lPool;
+	AnimationBlend lBlend;
+	lBlend.layers.push_back(makeLayer(*lClips.first));
+	lBlend.layers.push_back(makeLayer(*lClips.second));
+	lBlend.layers.back().additive = true;
+
+	// On top of the first frame of its own clip, a full additive layer is
+	// just its clip.
+	lBlend.layers.front().clip = lClips.second.get();
+	lBlend.layers.front().startTime = kTime;
+	SQTArray lPose;
+	lBlend.samplePose(kTime, lPool, lPose);
+	for (std::size_t j = 0; j < lJointCount; ++j)
+	{
+		checkClose(lPose.get(j), lClips.sample(*lClips.second, j));
+	}
+
+	// At its first frame, an additive layer adds nothing.
+	lBlend.layers.front().clip = lClips.first.get();
+	lBlend.layers.front().startTime = 0.0f;
+	lBlend.layers.back().startTime = kTime;
+	lBlend.samplePose(kTime, lPool, lPose);
+	for (std::size_t j = 0; j < lJointCount; ++j)
+	{
+		checkClose(lPose.get(j), lClips.sample(*lClips.first, j));
+	}
+
+	// Otherwise it adds the weighted change since its first frame.
+	lBlend.layers.back().startTime = 0.0f;
+	lBlend.layers.back().weight = 0.5f;
+	lBlend.samplePose(kTime, lPool, lPose);
+	for (std::size_t j = 0; j < lJointCount; ++j)
+	{
+		const auto lBase = lClips.sample(*lClips.first, j);
+		const auto lFirstFrame = lClips.sample(*lClips.second, j, kTime);
+		const auto lLayer = lClips.sample(*lClips.second, j);
+		const auto lExpected = lBase.translation
+			+ 0.5f * (lLayer.translation - lFirstFrame.translation);
+		const auto lActual = lPose.get(j).translation;
+		BOOST_CHECK_SMALL(lActual.x - lExpected.x, 1e-4f);
+		BOOST_CHECK_SMALL(lActual.y - lExpected.y, 1e-4f);
+		BOOST_CHECK_SMALL(lActual.z - lExpected.z, 1e-4f);
+	}
+}
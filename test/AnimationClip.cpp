@@ -0,0 +1,58 @@
+#define BOOST_TEST_MODULE AnimationClip test
+#include <boost/test/unit_test.hpp>
+
+#include "Graphics/AnimationClip.hpp"
+#include "Graphics/Skeleton.hpp"
+#include "Fixtures.hpp"
+
+using namespace gintonic;
+
+namespace {
+
+// A packed clip nlerps its rotations, where AnimationClip::evaluate slerps
+// them, so it only matches up to a looser tolerance.
+void checkPoseMatchesJoints(const AnimationClip& clip,
+	const float tolerance = 1e-4f)
+{
+	const auto lJointCount = clip.jointCount();
+	std::vector<mat4f, allocator<mat4f>> lPalette(lJointCount);
+	for (const float lTime : {0.0f, 0.01f, 0.1f, 0.37f, 0.5f, 2.0f})
+	{
+		clip.evaluatePose(0.0f, lTime, lPalette.data());
+		for (uint8_t j = 0; j < lJointCount; ++j)
+		{
+			const auto lExpected = clip.evaluate(j, 0.0f, lTime);
+			for (int k = 0; k < 16; ++k)
+			{
+				BOOST_CHECK_SMALL(lPalette[j].value_ptr()[k]
+					- lExpected.value_ptr()[k], tolerance);
+			}
+		}
+	}
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE ( pose_matches_every_joint )
+{
+	const auto lClip = fixtures::makeClip(
+		fixtures::makeSkeleton({GT_JOINT_NONE, 0, 1, 1, 3}), 12);
+	checkPoseMatchesJoints(*lClip);
+
+	lClip->isLooping = false;
+	checkPoseMatchesJoints(*lClip);
+
+	lClip->pack();
+	checkPoseMatchesJoints(*lClip, 1e-3f);
+}
+
+BOOST_AUTO_TEST_CASE ( children_may_come_before_their_parents )
+{
+	// Joint 1 is the root, then 2, 0 and 3 hang below each other.
+	const auto lClip = fixtures::makeClip(
+		fixtures::makeSkeleton({2, GT_JOINT_NONE, 1, 0}), 12);
+	checkPoseMatchesJoints(*lClip);
+
+	lClip->pack();
+	checkPoseMatchesJoints(*lClip, 1e-3f);
+}
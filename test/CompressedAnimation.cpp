@@ -0,0 +1,93 @@
+#define BOOST_TEST_MODULE CompressedAnimation test
+#include <boost/test/unit_test.hpp>
+
+#include "Graphics/CompressedAnimation.hpp"
+#include "Math/SQTArray.hpp"
+
+using namespace gintonic;
+
+namespace {
+
+constexpr std::size_t kJointCount = 40;
+constexpr std::size_t kFrameCount = 240;
+constexpr float kTolerance = 1e-3f;
+
+// Joints divisible by four do not move. The others move smoothly, as they
+// would in a sampled animation.
+CompressedAnimation::Frames makeFrames()
+{
+	CompressedAnimation::Frames lFrames(kJointCount);
+	for (std::size_t j = 0; j < kJointCount; ++j)
+	{
+		const auto lAxis = vec3f(1.0f, float(j % 3), float(j % 5)).normalize();
+		for (std::size_t f = 0; f < kFrameCount; ++f)
+		{
+			const auto t = j % 4 == 0 ? 0.0f : float(f) / 24.0f;
+			lFrames[j].emplace_back(
+				vec3f(1.0f, 1.0f + 0.1f * std::sin(t), 1.0f),
+				quatf::axis_angle(lAxis, 0.1f * float(j) + std::sin(t)),
+				vec3f(float(j), 2.0f * t, std::cos(t)));
+		}
+	}
+	return lFrames;
+}
+
+float rotationError(const quatf& u, const quatf& v)
+{
+	const auto lDot = u.x * v.x + u.y * v.y + u.z * v.z + u.w * v.w;
+	const auto lV = lDot < 0.0f ? v * -1.0f : v;
+	return std::max(std::max(std::abs(u.x - lV.x), std::abs(u.y - lV.y)),
+		std::max(std::abs(u.z - lV.z), std::abs(u.w - lV.w)));
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE ( every_frame_decodes_within_the_tolerance )
+{
+	const auto lFrames = makeFrames();
+	const CompressedAnimation lCompressed(lFrames);
+	BOOST_CHECK_EQUAL(lCompressed.jointCount(), kJointCount);
+	BOOST_CHECK_EQUAL(lCompressed.frameCount(), kFrameCount);
+
+	SQTArray lPose;
+	for (std::size_t f = 0; f < kFrameCount; ++f)
+	{
+		const auto lUpper = std::min(f + 1, kFrameCount - 1);
+		lCompressed.sample(f, lUpper, 0.0f, lPose);
+		for (std::size_t j = 0; j < kJointCount; ++j)
+		{
+			const auto lExpected = lFrames[j][f];
+			const auto lActual = lPose.get(j);
+			BOOST_CHECK_SMALL(rotationError(lActual.rotation,
+				lExpected.rotation), 2.0f * kTolerance);
+			BOOST_CHECK_SMALL(lActual.scale.y - lExpected.scale.y,
+				2.0f * kTolerance);
+			BOOST_CHECK_SMALL(lActual.translation.y - lExpected.translation.y,
+				2.0f * kTolerance);
+			BOOST_CHECK_SMALL(lActual.translation.z - lExpected.translation.z,
+				2.0f * kTolerance);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE ( looping_wraps_to_the_first_frame )
+{
+	const auto lFrames = makeFrames();
+	const CompressedAnimation lCompressed(lFrames);
+	const auto lLast = kFrameCount - 1;
+	const auto lSQT = lCompressed.sample(5, lLast, 0, 1.0f);
+	BOOST_CHECK_SMALL(lSQT.translation.y - lFrames[5][0].translation.y,
+		2.0f * kTolerance);
+}
+
+BOOST_AUTO_TEST_CASE ( constant_joints_and_clips_are_small )
+{
+	const auto lFrames = makeFrames();
+	const CompressedAnimation lCompressed(lFrames);
+	const auto lConstant = lCompressed.sample(0, 100, 101, 0.5f);
+	BOOST_CHECK_EQUAL(lConstant.translation.x, 0.0f);
+	BOOST_CHECK_EQUAL(lConstant.translation.y, 0.0f);
+
+	const auto lRawSize = kJointCount * kFrameCount * sizeof(SQT);
+	BOOST_CHECK_LT(lCompressed.byteSize() * 8, lRawSize);
+}
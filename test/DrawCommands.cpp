@@ -0,0 +1,128 @@
+#define BOOST_TEST_MODULE DrawCommands test
+#include <boost/test/unit_test.hpp>
+
+#include "Graphics/OpenGL/RecordingContext.hpp"
+#include "Graphics/DrawCommands.hpp"
+#include "Graphics/SkinningCache.hpp"
+#include "Graphics/Material.hpp"
+#include "Graphics/Mesh.hpp"
+#include "Graphics/RenderQueue.hpp"
+#include "Foundation/WorkerPool.hpp"
+#include "Entity.hpp"
+#include <cstring>
+
+using namespace gintonic;
+
+namespace {
+
+bool bitwiseEqual(const mat4f& a, const mat4f& b)
+{
+	return std::memcmp(&a, &b, sizeof(mat4f)) == 0;
+}
+
+// Only the nine floats, the padding after them is undefined.
+bool bitwiseEqual(const mat3f& a, const mat3f& b)
+{
+	return std::memcmp(a.data, b.data, sizeof(a.data)) == 0;
+}
+
+struct Scene
+{
+	OpenGL::RecordingContext context;
+	std::vector<std::shared_ptr<Entity>> owners;
+	std::vector<Entity*> entities;
+	RenderQueue queue;
+	mat4f matrixP;
+	mat4f matrixV;
+
+	Scene(const std::size_t count)
+	{
+		const std::shared_ptr<Mesh> lMeshes[] = {Mesh::create(), Mesh::create()};
+		const std::shared_ptr<Material> lMaterials[] = {Material::create(),
+			Material::create(), Material::create()};
+		matrixP.set_perspective(1.0f, 1.5f, 0.1f, 100.0f);
+		matrixV = mat4f(vec3f(0.0f, -1.0f, -10.0f));
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto lEntity = Entity::create("Entity");
+			lEntity->mesh = lMeshes[i % 2];
+			lEntity->material = lMaterials[i % 3];
+			lEntity->setTranslation(vec3f(float(i), float(i % 7), -float(i % 5)));
+			lEntity->setScale(vec3f(1.0f, 2.0f, float(1 + i % 3)));
+			queue.push(RenderQueue::makeKey(RenderQueue::kPassOpaque, 0,
+				queue.materialId(lEntity->material.get()),
+				queue.meshId(lEntity->mesh.get()), 0),
+				static_cast<std::uint32_t>(entities.size()));
+			entities.push_back(lEntity.get());
+			owners.push_back(lEntity);
+		}
+		queue.sort();
+	}
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE ( packets_follow_the_queue )
+{
+	Scene lScene(100);
+	WorkerPool lWorkers(0);
+	SkinningCache lSkinning(lWorkers);
+	for (const auto lEntity : lScene.entities) lSkinning.add(*lEntity);
+	BOOST_CHECK(lSkinning.empty());
+
+	DrawCommandBuffer lBuffer(lWorkers);
+	lBuffer.build(lScene.queue, lScene.entities, lScene.matrixP,
+		lScene.matrixV, &lSkinning);
+
+	BOOST_REQUIRE_EQUAL(lBuffer.size(), lScene.queue.size());
+	for (std::size_t i = 0; i < lBuffer.size(); ++i)
+	{
+		const auto lEntity = lScene.entities[lScene.queue[i].index];
+		const auto& lCommand = lBuffer[i];
+		BOOST_CHECK_EQUAL(lCommand.entity, lEntity);
+		BOOST_CHECK_EQUAL(lCommand.mesh, lEntity->mesh.get());
+		BOOST_CHECK_EQUAL(lCommand.material, lEntity->material.get());
+		BOOST_CHECK_EQUAL(lCommand.palette, SkinningCache::kNone);
+		const mat4f lVM = lScene.matrixV * lEntity->globalTransform();
+		BOOST_CHECK(bitwiseEqual(lCommand.matrixVM, lVM));
+		BOOST_CHECK(bitwiseEqual(lCommand.matrixPVM, lScene.matrixP * lVM));
+		BOOST_CHECK(bitwiseEqual(lCommand.matrixN, lVM.normalMatrix()));
+		const auto lInverseTranspose = lVM.upperLeft33().invert().transpose();
+		for (int k = 0; k < 9; ++k)
+		{
+			BOOST_CHECK_SMALL(lCommand.matrixN.data[k]
+				- lInverseTranspose.data[k], 1e-5f);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE ( workers_do_not_change_the_result )
+{
+	Scene lScene(1000);
+	WorkerPool lNoWorkers(0);
+	DrawCommandBuffer lSerial(lNoWorkers);
+	lSerial.build(lScene.queue, lScene.entities, lScene.matrixP,
+		lScene.matrixV);
+
+	WorkerPool lWorkers(3);
+	BOOST_CHECK_EQUAL(lWorkers.workerCount(), 3);
+	DrawCommandBuffer lParallel(lWorkers);
+	for (const std::size_t lChunkSize : {1, 7, 64, 5000})
+	{
+		lParallel.setChunkSize(lChunkSize);
+		lParallel.build(lScene.queue, lScene.entities, lScene.matrixP,
+			lScene.matrixV);
+		BOOST_REQUIRE_EQUAL(lParallel.size(), lSerial.size());
+		for (std::size_t i = 0; i < lSerial.size(); ++i)
+		{
+			BOOST_CHECK_EQUAL(lParallel[i].entity, lSerial[i].entity);
+			BOOST_CHECK(bitwiseEqual(lParallel[i].matrixPVM,
+				lSerial[i].matrixPVM));
+			BOOST_CHECK(bitwiseEqual(lParallel[i].matrixN, lSerial[i].matrixN));
+		}
+	}
+
+	// Building again with fewer draws shrinks the buffer.
+	lParallel.build(RenderQueue(), {}, lScene.matrixP, lScene.matrixV);
+	BOOST_CHECK(lParallel.empty());
+}
@@ -2,6 +2,8 @@
 #include <boost/test/unit_test.hpp>
 
 #include "Entity.hpp"
+#include "Graphics/Mesh.hpp"
+#include "Graphics/OpenGL/RecordingContext.hpp"
 #include "Transform.hpp"
 
 using namespace gintonic;
@@ -32,3 +34,113 @@ BOOST_AUTO_TEST_CASE(exp_entity)
     auto comp = ent.add<Transform>();
     BOOST_CHECK(comp == ent.get<Transform>());
 }
+
+BOOST_AUTO_TEST_CASE(view_matrix_follows_the_global_transform)
+{
+    auto lParent = Entity::create("parent");
+    auto lChild = Entity::create("child");
+    lParent->addChild(lChild);
+
+    const auto lCheckInverse = [](const Entity& entity) {
+        const auto lProduct =
+            entity.getViewMatrix() * entity.globalTransform();
+        const mat4f lIdentity(1.0f);
+        for (int c = 0; c < 4; ++c)
+        {
+            for (int r = 0; r < 4; ++r)
+            {
+                BOOST_CHECK_SMALL(lProduct.data[c][r] - lIdentity.data[c][r],
+                                  0.0001f);
+            }
+        }
+    };
+
+    lChild->setLocalTransform(
+        SQT(vec3f(1.0f, 1.0f, 1.0f),
+            quatf::axis_angle(vec3f(0.0f, 1.0f, 0.0f), 0.7f),
+            vec3f(1.0f, 2.0f, 3.0f)));
+    lCheckInverse(*lChild);
+
+    // Changing the parent changes the global transform of the child.
+    lParent->setScale(vec3f(2.0f, 0.5f, 3.0f));
+    lParent->setRotation(quatf::axis_angle(vec3f(1.0f, 0.0f, 0.0f), 0.3f));
+    lParent->setTranslation(vec3f(-4.0f, 0.0f, 1.0f));
+    lCheckInverse(*lParent);
+    lCheckInverse(*lChild);
+}
+
+BOOST_AUTO_TEST_CASE(non_uniform_scale_is_inherited)
+{
+    auto lParent = Entity::create("parent");
+    auto lChild = Entity::create("child");
+    lParent->addChild(lChild);
+    BOOST_CHECK(!lParent->hasNonUniformScale());
+    BOOST_CHECK(!lChild->hasNonUniformScale());
+
+    lParent->setScale(vec3f(2.0f, 2.0f, 2.0f));
+    BOOST_CHECK(!lChild->hasNonUniformScale());
+
+    lParent->setScale(vec3f(2.0f, 1.0f, 2.0f));
+    BOOST_CHECK(lParent->hasNonUniformScale());
+    BOOST_CHECK(lChild->hasNonUniformScale());
+
+    lParent->setScale(vec3f(1.0f, 1.0f, 1.0f));
+    lChild->setScale(vec3f(1.0f, 3.0f, 1.0f));
+    BOOST_CHECK(!lParent->hasNonUniformScale());
+    BOOST_CHECK(lChild->hasNonUniformScale());
+}
+
+BOOST_AUTO_TEST_CASE(global_bounding_box_is_tight)
+{
+    OpenGL::RecordingContext lContext;
+    const std::vector<GLuint> lIndices{0, 1, 2};
+    const std::vector<Mesh::vec4f> lPositions{
+        {-1.0f, -1.0f, -1.0f, 0.0f},
+        {1.0f, 2.0f, 3.0f, 0.0f},
+        {0.0f, 0.0f, 0.0f, 0.0f}};
+    const std::vector<Mesh::vec4f> lNormals(3, {0.0f, 0.0f, 1.0f, 0.0f});
+    const auto lMesh = Mesh::create(lIndices, lPositions, lNormals);
+
+    const auto lCheckBox = [&lMesh](const Entity& entity, const box3f& box) {
+        vec3f lCorners[8];
+        lMesh->getLocalBoundingBox().getCorners(lCorners);
+        const auto lFirst =
+            entity.globalTransform().apply_to_point(lCorners[0]);
+        box3f lExpected(lFirst, lFirst);
+        for (const auto& lCorner : lCorners)
+        {
+            lExpected.addPoint(
+                entity.globalTransform().apply_to_point(lCorner));
+        }
+        BOOST_CHECK_SMALL((box.minCorner - lExpected.minCorner).length(),
+                          0.0001f);
+        BOOST_CHECK_SMALL((box.maxCorner - lExpected.maxCorner).length(),
+                          0.0001f);
+    };
+
+    auto lEntity = Entity::create("entity");
+    lEntity->setMesh(lMesh);
+    lEntity->setLocalTransform(
+        SQT(vec3f(2.0f, 1.0f, 0.5f),
+            quatf::axis_angle(vec3f(0.0f, 0.0f, 1.0f), 0.6f),
+            vec3f(5.0f, 0.0f, -1.0f)));
+    lCheckBox(*lEntity, lEntity->globalBoundingBox());
+
+    // A mesh that is assigned directly is not cached, but still correct.
+    auto lOther = Entity::create("other");
+    lOther->setRotation(quatf::axis_angle(vec3f(1.0f, 0.0f, 0.0f), 1.0f));
+    lOther->mesh = lMesh;
+    lCheckBox(*lOther, lOther->globalBoundingBox());
+
+    // Without a mesh, the box is the point at the translation.
+    auto lEmpty = Entity::create("empty");
+    lEmpty->setTranslation(vec3f(1.0f, 2.0f, 3.0f));
+
+    const Entity::SharedPtr lEntities[] = {lEntity, lOther, lEmpty};
+    box3f lBoxes[3];
+    Entity::globalBoundingBoxes(lEntities, 3, lBoxes);
+    lCheckBox(*lEntity, lBoxes[0]);
+    lCheckBox(*lOther, lBoxes[1]);
+    BOOST_CHECK(lBoxes[2].minCorner == vec3f(1.0f, 2.0f, 3.0f));
+    BOOST_CHECK(lBoxes[2].maxCorner == vec3f(1.0f, 2.0f, 3.0f));
+}
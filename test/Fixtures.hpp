@@ -0,0 +1,314 @@
+/**
+ * @file Fixtures.hpp
+ * @brief Defines the objects that several unit tests build their cases
+ * from.
+ * @author Raoul Wols
+ */
+
+#pragma once
+
+#include "Foundation/allocator.hpp"
+#include "Graphics/AnimationClip.hpp"
+#include "Graphics/Mesh.hpp"
+#include "Graphics/Skeleton.hpp"
+#include "Math/SQT.hpp"
+#include "Math/Skinning.hpp"
+#include "Math/box3f.hpp"
+#include "Math/mat4f.hpp"
+#include "Math/obb3f.hpp"
+#include "Math/vec4f.hpp"
+#include "Entity.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gintonic {
+namespace fixtures {
+
+/**
+ * @brief Make a rotation axis that differs for consecutive indices.
+ * @param i The index.
+ * @return A unit vector.
+ */
+inline vec3f makeAxis(const std::size_t i)
+{
+	return vec3f(1.0f, float(i % 3), float(i % 5)).normalize();
+}
+
+/**
+ * @brief Make a transform with a non-uniform scale, a rotation and a
+ * translation that differ for every index.
+ * @param i The index.
+ * @param t A parameter that moves the transform a little, so that the SQTs
+ * at t = 0 and t = 1 are two keyframes of the same joint.
+ * @return The SQT.
+ */
+inline SQT makeSQT(const std::size_t i, const float t = 0.0f)
+{
+	return SQT(vec3f(1.0f + 0.1f * float(i % 4) + 0.1f * t, 1.0f, 0.5f + t),
+		quatf::axis_angle(makeAxis(i), 0.3f * float(i) + 0.2f * t),
+		vec3f(float(i), t - 2.0f, 0.5f * float(i) - float(i) * t));
+}
+
+/**
+ * @brief Make a point that differs for every index.
+ * @param i The index.
+ * @return The point.
+ */
+inline vec3f makePoint(const std::size_t i)
+{
+	return vec3f(float(i % 17) * 0.1f, float(i % 5) * -0.3f,
+		float(i % 11) * 0.2f);
+}
+
+/**
+ * @brief The bounds of the eight transformed corners of a box; the
+ * reference for the batched box transforms.
+ * @param m The transform.
+ * @param box The box.
+ * @return The transformed box.
+ */
+inline box3f referenceBox(const mat4f& m, const box3f& box)
+{
+	vec3f lCorners[8];
+	box.getCorners(lCorners);
+	const auto lFirst = m.apply_to_point(lCorners[0]);
+	box3f lResult(lFirst, lFirst);
+	for (const auto& lCorner : lCorners)
+	{
+		lResult.addPoint(m.apply_to_point(lCorner));
+	}
+	return lResult;
+}
+
+/**
+ * @brief Make a perspective projection for a camera at the origin looking
+ * down the negative z-axis.
+ * @return The projection matrix.
+ */
+inline mat4f makeProjection()
+{
+	mat4f lProjection;
+	lProjection.set_perspective(static_cast<float>(M_PI) / 2.0f, 1.0f, 1.0f,
+		100.0f);
+	return lProjection;
+}
+
+/**
+ * @brief Make an axis-aligned cube.
+ * @param x The x-coordinate of the center.
+ * @param y The y-coordinate of the center.
+ * @param z The z-coordinate of the center.
+ * @param r Half the length of an edge.
+ * @return The cube.
+ */
+inline box3f boxAround(const float x, const float y, const float z,
+	const float r = 1.0f)
+{
+	return box3f(vec3f(x - r, y - r, z - r), vec3f(x + r, y + r, z + r));
+}
+
+/**
+ * @brief Make a cube with edges of length two, rotated by 45 degrees around
+ * the z-axis.
+ * @param x The x-coordinate of the center.
+ * @param y The y-coordinate of the center.
+ * @param z The z-coordinate of the center.
+ * @return The oriented cube.
+ */
+inline obb3f diamondAround(const float x, const float y, const float z)
+{
+	const SQT lTransform(vec3f(1.0f, 1.0f, 1.0f),
+		quatf::axis_angle(vec3f(0.0f, 0.0f, 1.0f),
+			static_cast<float>(M_PI) / 4.0f),
+		vec3f(x, y, z));
+	return obb3f(boxAround(0.0f, 0.0f, 0.0f), mat4f(lTransform));
+}
+
+/**
+ * @brief Make boxes of different sizes all over the place, some of them
+ * flat.
+ * @param count The number of boxes.
+ * @return The boxes.
+ */
+inline std::vector<box3f, allocator<box3f>> makeBoxes(const std::size_t count)
+{
+	std::vector<box3f, allocator<box3f>> lBoxes;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const vec3f lMin(float(i % 17) * 1.3f - 11.0f,
+			float(i % 13) * -1.1f + 6.0f, float(i % 11) * -2.7f + 3.0f);
+		const vec3f lSize(float(i % 3), 0.5f * float(i % 7),
+			1.0f + float(i % 5));
+		lBoxes.emplace_back(lMin, lMin + lSize);
+	}
+	return lBoxes;
+}
+
+/**
+ * @brief The skinning data of a character with 64 joints, without a mesh.
+ * @details Every vertex has four influences, and there are two positions per
+ * vertex, like the welded positions of a mesh map to its vertices the other
+ * way around.
+ */
+struct Character
+{
+	std::vector<mat4f, allocator<mat4f>> palette;
+	std::vector<float> positions;
+	std::vector<std::uint32_t> vertices;
+	std::vector<std::int32_t> jointIndices;
+	std::vector<float> jointWeights;
+
+	/// The number of joints. The palette may be padded beyond them.
+	std::size_t jointCount = 64;
+
+	Character(const std::size_t positionCount)
+	{
+		for (std::size_t j = 0; j < jointCount; ++j)
+		{
+			palette.emplace_back(SQT(vec3f(1.0f, 1.0f + 0.01f * j, 1.0f),
+				quatf::axis_angle(makeAxis(j), 0.1f * float(j)),
+				vec3f(float(j), 0.5f, -1.0f)));
+		}
+		const auto lVertexCount = positionCount / 2 + 1;
+		for (std::size_t v = 0; v < lVertexCount; ++v)
+		{
+			float lTotal = 0.0f;
+			for (std::size_t k = 0; k < 4; ++k)
+			{
+				jointIndices.push_back(
+					static_cast<std::int32_t>((v * 7 + k * 13) % 64));
+				jointWeights.push_back(float(1 + (v + k) % 4));
+				lTotal += jointWeights.back();
+			}
+			for (std::size_t k = 0; k < 4; ++k)
+			{
+				jointWeights[4 * v + k] /= lTotal;
+			}
+		}
+		for (std::size_t i = 0; i < positionCount; ++i)
+		{
+			positions.push_back(float(i % 17) * 0.1f);
+			positions.push_back(float(i % 5) * -0.3f);
+			positions.push_back(float(i % 11) * 0.2f);
+			vertices.push_back(static_cast<std::uint32_t>(i / 2));
+		}
+	}
+
+	/// The skinned position i, one joint at a time.
+	vec3f reference(const std::size_t i) const
+	{
+		const auto v = vertices[i];
+		const vec4f lPosition(positions[3 * i], positions[3 * i + 1],
+			positions[3 * i + 2], 1.0f);
+		vec4f lResult(0.0f, 0.0f, 0.0f, 0.0f);
+		for (std::size_t k = 0; k < 4; ++k)
+		{
+			const auto lJoint =
+				static_cast<std::size_t>(jointIndices[4 * v + k]);
+			const auto lWeight = jointWeights[4 * v + k];
+			if (lWeight == 0.0f || lJoint >= jointCount) continue;
+			lResult += lWeight * (palette[lJoint] * lPosition);
+		}
+		return vec3f(lResult.x, lResult.y, lResult.z);
+	}
+
+	/// Skin the positions [first, last) with skinPositions.
+	void skin(std::vector<float>& result, const std::size_t first,
+		const std::size_t last) const
+	{
+		skinPositions(palette.data(), jointCount, positions.data(),
+			vertices.data(), jointIndices.data(), jointWeights.data(), first,
+			last, result.data());
+	}
+};
+
+/**
+ * @brief Make a skeleton.
+ * @param parents The parent of every joint, or GT_JOINT_NONE for a root.
+ * The parents do not have to come before their children.
+ * @return A skeleton whose joint j has the inverse bind pose of a joint at
+ * (j, 0, 0).
+ */
+inline std::shared_ptr<Skeleton> makeSkeleton(
+	const std::vector<uint8_t>& parents)
+{
+	auto lSkeleton = std::make_shared<Skeleton>();
+	lSkeleton->joints.resize(parents.size());
+	for (std::size_t j = 0; j < parents.size(); ++j)
+	{
+		auto& lJoint = lSkeleton->joints[j];
+		lJoint.inverseBindPose = mat4f(vec3f(-float(j), 0.0f, 0.0f));
+		lJoint.parent = parents[j];
+		for (auto& lChild : lJoint.child) lChild = GT_JOINT_NONE;
+	}
+	return lSkeleton;
+}
+
+/**
+ * @brief Make an animation clip in which every joint rotates and moves a
+ * little further every frame.
+ * @param skeleton The skeleton of the clip.
+ * @param frameCount The number of frames. The clip plays at 24 frames per
+ * second.
+ * @return The clip.
+ */
+inline std::shared_ptr<AnimationClip> makeClip(
+	const std::shared_ptr<Skeleton>& skeleton, const std::size_t frameCount)
+{
+	auto lClip = std::make_shared<AnimationClip>();
+	lClip->skeleton = skeleton;
+	lClip->frames.resize(skeleton->joints.size());
+	for (std::size_t j = 0; j < lClip->frames.size(); ++j)
+	{
+		const auto lAxis = vec3f(float(j % 2), 1.0f, float(j % 3)).normalize();
+		for (std::size_t f = 0; f < frameCount; ++f)
+		{
+			lClip->frames[j].emplace_back(
+				vec3f(1.0f, 1.0f + 0.01f * float(f), 1.0f),
+				quatf::axis_angle(lAxis, 0.1f * float(j) + 0.2f * float(f)),
+				vec3f(1.0f, 0.1f * float(f), -0.05f * float(j)));
+		}
+	}
+	return lClip;
+}
+
+/**
+ * @brief Make a triangle that is moved by the first two joints of a
+ * skeleton. Needs an OpenGL context, for instance an
+ * OpenGL::RecordingContext.
+ * @return The mesh.
+ */
+inline std::shared_ptr<Mesh> makeSkinnedMesh()
+{
+	auto lMesh = Mesh::create(std::vector<GLuint>{0, 1, 2},
+		std::vector<Mesh::vec4f>{Mesh::vec4f(0.0f, 0.0f, 0.0f, 0.0f),
+			Mesh::vec4f(1.0f, 0.0f, 0.0f, 1.0f),
+			Mesh::vec4f(0.0f, 1.0f, 0.0f, 0.0f)},
+		std::vector<Mesh::vec4f>(3, Mesh::vec4f(0.0f, 0.0f, 1.0f, 0.0f)));
+	lMesh->setJoints(std::vector<Mesh::vec4i>(3,
+			Mesh::vec4i(0, 1, GT_JOINT_NONE, GT_JOINT_NONE)),
+		std::vector<Mesh::vec4f>(3, Mesh::vec4f(0.75f, 0.25f, 0.0f, 0.0f)));
+	return lMesh;
+}
+
+/**
+ * @brief Make an entity that plays a clip.
+ * @param mesh The skinned mesh of the entity.
+ * @param clip The clip. Not owned by the entity.
+ * @param startTime The time at which the entity started the clip.
+ * @return The entity.
+ */
+inline std::shared_ptr<Entity> makeAnimatedEntity(
+	const std::shared_ptr<Mesh>& mesh, AnimationClip& clip,
+	const float startTime)
+{
+	auto lEntity = Entity::create("Animated");
+	lEntity->mesh = mesh;
+	lEntity->activeAnimationClip = &clip;
+	lEntity->activeAnimationStartTime = startTime;
+	return lEntity;
+}
+
+} // namespace fixtures
+} // namespace gintonic
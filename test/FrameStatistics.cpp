@@ -0,0 +1,109 @@
+#define BOOST_TEST_MODULE FrameStatistics test
+#include <boost/test/unit_test.hpp>
+
+#include "Graphics/FrameStatistics.hpp"
+#include <sstream>
+
+using namespace gintonic;
+
+namespace {
+
+FrameSample makeSample(const std::size_t drawCalls,
+                       const std::chrono::milliseconds geometryTime)
+{
+	FrameSample lSample;
+	for (std::size_t i = 0; i < drawCalls; ++i) lSample.addDrawCall(12);
+	lSample.programBinds = 1;
+	lSample.poseCacheHits = 3 * drawCalls;
+	lSample.poseCacheMisses = 1;
+	lSample.phaseTime[FrameSample::kPhaseGeometry] = geometryTime;
+	lSample.frameTime = geometryTime;
+	lSample.entities[FrameSample::kBucketShadowCastingGeometry] = drawCalls;
+	lSample.shadowCasters = 2 * drawCalls;
+	lSample.culledShadowCasters = drawCalls;
+	return lSample;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE ( draw_calls_accumulate_triangles )
+{
+	FrameSample lSample;
+	lSample.addDrawCall(10);
+	lSample.addDrawCall(32);
+	BOOST_CHECK_EQUAL(lSample.drawCalls, 2);
+	BOOST_CHECK_EQUAL(lSample.triangles, 42);
+}
+
+BOOST_AUTO_TEST_CASE ( rolling_average )
+{
+	using std::chrono::milliseconds;
+
+	FrameStatistics lStats(4);
+	BOOST_CHECK_EQUAL(lStats.sampleCount(), 0);
+	BOOST_CHECK_EQUAL(lStats.average().drawCalls, 0);
+
+	lStats.push(makeSample(10, milliseconds(2)));
+	lStats.push(makeSample(20, milliseconds(4)));
+	BOOST_CHECK_EQUAL(lStats.sampleCount(), 2);
+	BOOST_CHECK_EQUAL(lStats.lastFrame().drawCalls, 20);
+	BOOST_CHECK_EQUAL(lStats.average().drawCalls, 15);
+	BOOST_CHECK_EQUAL(lStats.average().triangles, 15 * 12);
+	BOOST_CHECK(lStats.average().phaseTime[FrameSample::kPhaseGeometry] == milliseconds(3));
+
+	// Fill the window and push two more; the first two samples fall out.
+	lStats.push(makeSample(30, milliseconds(6)));
+	lStats.push(makeSample(40, milliseconds(8)));
+	lStats.push(makeSample(50, milliseconds(10)));
+	lStats.push(makeSample(60, milliseconds(12)));
+	BOOST_CHECK_EQUAL(lStats.sampleCount(), 4);
+	BOOST_CHECK_EQUAL(lStats.average().drawCalls, 45);
+	BOOST_CHECK_EQUAL(lStats.average().programBinds, 1);
+	BOOST_CHECK_EQUAL(lStats.average().poseCacheHits, 3 * 45);
+	BOOST_CHECK_EQUAL(lStats.average().poseCacheMisses, 1);
+	BOOST_CHECK_EQUAL(lStats.average().entities[FrameSample::kBucketShadowCastingGeometry], 45);
+	BOOST_CHECK_EQUAL(lStats.average().shadowCasters, 2 * 45);
+	BOOST_CHECK_EQUAL(lStats.average().culledShadowCasters, 45);
+	BOOST_CHECK(lStats.average().frameTime == milliseconds(9));
+	BOOST_CHECK(lStats.average().totalPhaseTime() == milliseconds(9));
+
+	lStats.setWindowSize(2);
+	BOOST_CHECK_EQUAL(lStats.windowSize(), 2);
+	BOOST_CHECK_EQUAL(lStats.sampleCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE ( names_and_output )
+{
+	BOOST_CHECK_EQUAL(FrameSample::name(FrameSample::kPhaseGeometry), "Geometry");
+	BOOST_CHECK_EQUAL(FrameSample::name(FrameSample::kBucketNonShadowCastingLights), "NonShadowCastingLights");
+
+	std::ostringstream lStream;
+	lStream << makeSample(3, std::chrono::milliseconds(1));
+	BOOST_CHECK(lStream.str().find("Draw calls: 3") != std::string::npos);
+	BOOST_CHECK(lStream.str().find("Pose cache: 9 hits") != std::string::npos);
+	BOOST_CHECK(lStream.str().find("Shadow casters: 6 (3 culled)") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE ( gpu_average_skips_frames_without_results )
+{
+	using std::chrono::milliseconds;
+
+	FrameStatistics lStats(4);
+	auto lSample = makeSample(1, milliseconds(1));
+	lStats.push(lSample);
+	BOOST_CHECK_EQUAL(lStats.average().gpuSamples, 0);
+
+	lSample.gpuPhaseTime[FrameSample::kPhaseLights] = milliseconds(4);
+	lSample.gpuSamples = 1;
+	lStats.push(lSample);
+	lSample.gpuPhaseTime[FrameSample::kPhaseLights] = milliseconds(2);
+	lStats.push(lSample);
+
+	BOOST_CHECK_EQUAL(lStats.average().gpuSamples, 1);
+	BOOST_CHECK(lStats.average().gpuPhaseTime[FrameSample::kPhaseLights] == milliseconds(3));
+	BOOST_CHECK(lStats.average().totalGPUPhaseTime() == milliseconds(3));
+
+	std::ostringstream lStream;
+	lStream << lStats.average();
+	BOOST_CHECK(lStream.str().find("GPU") != std::string::npos);
+}
@@ -0,0 +1,59 @@
+#define BOOST_TEST_MODULE GPUFrameTimer test
+#include <boost/test/unit_test.hpp>
+
+#include "Graphics/GPUFrameTimer.hpp"
+#include "Graphics/OpenGL/RecordingContext.hpp"
+
+using namespace gintonic;
+
+BOOST_AUTO_TEST_CASE ( one_pair_per_phase )
+{
+	OpenGL::RecordingContext lContext;
+	GPUFrameTimer lTimer;
+	BOOST_CHECK(lTimer.enabled());
+	lContext.clear();
+
+	lTimer.begin(FrameSample::kPhaseGeometry);
+	lTimer.end();
+	lTimer.begin(FrameSample::kPhaseLights);
+	lTimer.end();
+	BOOST_CHECK_EQUAL(lContext.count("glQueryCounter"), 4);
+}
+
+BOOST_AUTO_TEST_CASE ( nested_phases_close_on_the_outermost_end )
+{
+	OpenGL::RecordingContext lContext;
+	GPUFrameTimer lTimer;
+	lContext.clear();
+
+	lTimer.begin(FrameSample::kPhaseGeometry);
+	lTimer.begin(FrameSample::kPhaseLights);
+	BOOST_CHECK_EQUAL(lContext.count("glQueryCounter"), 1);
+	lTimer.end();
+	// The inner end must not close the outer phase.
+	BOOST_CHECK_EQUAL(lContext.count("glQueryCounter"), 1);
+	lTimer.end();
+	BOOST_CHECK_EQUAL(lContext.count("glQueryCounter"), 2);
+
+	// An unmatched end does nothing.
+	lTimer.end();
+	BOOST_CHECK_EQUAL(lContext.count("glQueryCounter"), 2);
+}
+
+BOOST_AUTO_TEST_CASE ( next_frame_closes_an_open_phase )
+{
+	OpenGL::RecordingContext lContext;
+	GPUFrameTimer lTimer;
+	lContext.clear();
+
+	lTimer.begin(FrameSample::kPhaseGeometry);
+	lTimer.begin(FrameSample::kPhaseLights);
+	FrameSample lSample;
+	lTimer.nextFrame(lSample);
+	BOOST_CHECK_EQUAL(lContext.count("glQueryCounter"), 2);
+
+	// The depth starts over in the next frame.
+	lTimer.begin(FrameSample::kPhaseGeometry);
+	lTimer.end();
+	BOOST_CHECK_EQUAL(lContext.count("glQueryCounter"), 4);
+}
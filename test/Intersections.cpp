@@ -0,0 +1,258 @@
+#define BOOST_TEST_MODULE Intersections test
+#include <boost/test/unit_test.hpp>
+
+#include "Foundation/allocator.hpp"
+#include "Math/Intersections.hpp"
+#include "Math/SQT.hpp"
+#include "Math/mat4f.hpp"
+#include "Fixtures.hpp"
+#include <vector>
+
+using namespace gintonic;
+using fixtures::boxAround;
+using fixtures::diamondAround;
+using fixtures::makeBoxes;
+using fixtures::makeProjection;
+
+BOOST_AUTO_TEST_CASE ( planes )
+{
+	const plane3f lPlane(vec3f(0.0f, 2.0f, 0.0f), vec3f(5.0f, 3.0f, -1.0f));
+	BOOST_CHECK_CLOSE(lPlane.equation.y, 1.0f, 1e-4f);
+	BOOST_CHECK_CLOSE(lPlane.equation.w, -3.0f, 1e-4f);
+	BOOST_CHECK_CLOSE(lPlane.distance(vec3f(7.0f, 5.0f, 2.0f)), 2.0f, 1e-4f);
+	BOOST_CHECK_SMALL(lPlane.project(vec3f(7.0f, 5.0f, 2.0f)).y - 3.0f, 1e-5f);
+
+	// A degenerate equation becomes a plane with everything in front of it.
+	const plane3f lEverything(vec4f(0.0f, 0.0f, 0.0f, 3.0f));
+	BOOST_CHECK_EQUAL(lEverything.distance(vec3f(1e6f, -1e6f, 0.0f)), 1.0f);
+
+	BOOST_CHECK(intersects(lPlane, plane3f(vec3f(1.0f, 1.0f, 0.0f), vec3f(0.0f))));
+	BOOST_CHECK(intersects(lPlane, plane3f(vec3f(0.0f, -1.0f, 0.0f), vec3f(1.0f, 3.0f, 0.0f))));
+	BOOST_CHECK(!intersects(lPlane, plane3f(vec3f(0.0f, 1.0f, 0.0f), vec3f(0.0f))));
+}
+
+BOOST_AUTO_TEST_CASE ( extracting_one_plane )
+{
+	const auto lMatrixPV = makeProjection() * mat4f(SQT(vec3f(1.0f, 1.0f, 1.0f),
+		quatf::axis_angle(vec3f(0.0f, 1.0f, 0.0f), 0.3f), vec3f(1.0f, 2.0f, 3.0f)));
+	const frustum3f lFrustum(lMatrixPV);
+	for (int i = 0; i < frustum3f::kPlaneCount; ++i)
+	{
+		const auto lWhich = static_cast<frustum3f::Plane>(i);
+		const auto lPlane = frustum3f::extractPlane(lMatrixPV, lWhich);
+		const auto lExpected = lFrustum.getPlane(lWhich);
+		BOOST_CHECK_SMALL((lPlane.equation - lExpected.equation).length(), 1e-5f);
+	}
+}
+
+BOOST_AUTO_TEST_CASE ( rays )
+{
+	float lDistance;
+	const ray3f lRay(vec3f(0.0f, 0.0f, 10.0f), vec3f(0.0f, 0.0f, -2.0f));
+	BOOST_CHECK_CLOSE(lRay.direction.z, -1.0f, 1e-4f);
+
+	BOOST_CHECK(intersects(lRay, boxAround(0.0f, 0.0f, 0.0f), lDistance));
+	BOOST_CHECK_CLOSE(lDistance, 9.0f, 1e-4f);
+	BOOST_CHECK(!intersects(lRay, boxAround(3.0f, 0.0f, 0.0f), lDistance));
+	BOOST_CHECK(!intersects(lRay, boxAround(0.0f, 0.0f, 20.0f), lDistance));
+
+	// Starting inside, and grazing a face.
+	BOOST_CHECK(intersects(lRay, boxAround(0.0f, 0.0f, 10.0f), lDistance));
+	BOOST_CHECK_EQUAL(lDistance, 0.0f);
+	BOOST_CHECK(intersects(lRay, boxAround(1.0f, 0.0f, 0.0f), lDistance));
+
+	BOOST_CHECK(intersects(lRay, sphere3f(vec3f(0.0f, 0.5f, 0.0f), 1.0f), lDistance));
+	BOOST_CHECK_CLOSE(lDistance, 10.0f - std::sqrt(0.75f), 1e-3f);
+	BOOST_CHECK(!intersects(lRay, sphere3f(vec3f(0.0f, 1.5f, 0.0f), 1.0f), lDistance));
+	BOOST_CHECK(!intersects(lRay, sphere3f(vec3f(0.0f, 0.0f, 12.0f), 1.0f), lDistance));
+
+	BOOST_CHECK(intersects(lRay, plane3f(vec3f(0.0f, 0.0f, 1.0f), vec3f(0.0f, 0.0f, 4.0f)), lDistance));
+	BOOST_CHECK_CLOSE(lDistance, 6.0f, 1e-4f);
+	BOOST_CHECK(!intersects(lRay, plane3f(vec3f(0.0f, 0.0f, 1.0f), vec3f(0.0f, 0.0f, 11.0f)), lDistance));
+	BOOST_CHECK(!intersects(lRay, plane3f(vec3f(1.0f, 0.0f, 0.0f), vec3f(1.0f, 0.0f, 0.0f)), lDistance));
+
+	// The corner of the diamond sticks out to x = sqrt(2).
+	BOOST_CHECK(intersects(lRay, diamondAround(1.3f, 0.0f, 0.0f), lDistance));
+	BOOST_CHECK_CLOSE(lDistance, 9.0f, 1e-3f);
+	BOOST_CHECK(!intersects(lRay, diamondAround(1.5f, 0.0f, 0.0f), lDistance));
+	BOOST_CHECK(!intersects(lRay, diamondAround(1.3f, 1.0f, 0.0f), lDistance));
+}
+
+BOOST_AUTO_TEST_CASE ( rays_and_frustums )
+{
+	const auto lProjection = makeProjection();
+	const frustum3f lFrustum(lProjection);
+	float lDistance;
+
+	// The ray through the center of the screen starts on the near plane.
+	mat4f lInverse(1.0f);
+	lInverse.m00 = 1.0f / lProjection.m00;
+	lInverse.m11 = 1.0f / lProjection.m11;
+	lInverse.m22 = 0.0f;
+	lInverse.m23 = -1.0f;
+	lInverse.m32 = 1.0f / lProjection.m23;
+	lInverse.m33 = lProjection.m22 / lProjection.m23;
+	const ray3f lCenter(lInverse, 0.0f, 0.0f);
+	BOOST_CHECK_SMALL(lCenter.origin.x, 1e-4f);
+	BOOST_CHECK_CLOSE(lCenter.origin.z, -1.0f, 1e-3f);
+	BOOST_CHECK_CLOSE(lCenter.direction.z, -1.0f, 1e-3f);
+	BOOST_CHECK(intersects(lCenter, lFrustum, lDistance));
+	BOOST_CHECK_SMALL(lDistance, 1e-3f);
+
+	// A ray from behind the camera enters through the near plane.
+	BOOST_CHECK(intersects(ray3f(vec3f(0.0f, 0.0f, 5.0f), vec3f(0.0f, 0.0f, -1.0f)), lFrustum, lDistance));
+	BOOST_CHECK_CLOSE(lDistance, 6.0f, 1e-3f);
+	BOOST_CHECK(!intersects(ray3f(vec3f(0.0f, 0.0f, 5.0f), vec3f(0.0f, 0.0f, 1.0f)), lFrustum, lDistance));
+
+	// A ray parallel to the side, outside of the frustum.
+	BOOST_CHECK(!intersects(ray3f(vec3f(20.0f, 0.0f, -10.0f), vec3f(0.0f, 1.0f, 0.0f)), lFrustum, lDistance));
+}
+
+BOOST_AUTO_TEST_CASE ( frustums )
+{
+	const frustum3f lFrustum(makeProjection());
+
+	BOOST_CHECK(intersects(lFrustum, sphere3f(vec3f(0.0f, 0.0f, -50.0f), 1.0f)));
+	BOOST_CHECK(intersects(lFrustum, sphere3f(vec3f(0.0f, 0.0f, -0.5f), 1.0f)));
+	BOOST_CHECK(!intersects(lFrustum, sphere3f(vec3f(0.0f, 0.0f, 2.0f), 1.0f)));
+	BOOST_CHECK(!intersects(lFrustum, sphere3f(vec3f(30.0f, 0.0f, -10.0f), 1.0f)));
+
+	BOOST_CHECK(intersects(lFrustum, diamondAround(0.0f, 0.0f, -10.0f)));
+	BOOST_CHECK(!intersects(lFrustum, diamondAround(0.0f, 0.0f, 10.0f)));
+	BOOST_CHECK_EQUAL(intersects(lFrustum, boxAround(0.0f, 0.0f, 10.0f)),
+		lFrustum.intersects(boxAround(0.0f, 0.0f, 10.0f)));
+
+	BOOST_CHECK(intersects(lFrustum, plane3f(vec3f(0.0f, 0.0f, 1.0f), vec3f(0.0f, 0.0f, -50.0f))));
+	BOOST_CHECK(!intersects(lFrustum, plane3f(vec3f(0.0f, 0.0f, 1.0f), vec3f(0.0f, 0.0f, -150.0f))));
+	BOOST_CHECK(!intersects(lFrustum, plane3f(vec3f(1.0f, 0.0f, 0.0f), vec3f(101.0f, 0.0f, 0.0f))));
+
+	// The same camera, moved along and turned around.
+	const auto lTurned = [&](const float x, const float angle)
+	{
+		const SQT lCamera(vec3f(1.0f, 1.0f, 1.0f),
+			quatf::axis_angle(vec3f(0.0f, 1.0f, 0.0f), angle), vec3f(x, 0.0f, 0.0f));
+		return frustum3f(makeProjection() * mat4f(lCamera).inverseRigid());
+	};
+	BOOST_CHECK(intersects(lFrustum, lTurned(10.0f, 0.0f)));
+	BOOST_CHECK(intersects(lFrustum, lTurned(150.0f, 0.0f)));
+	BOOST_CHECK(!intersects(lFrustum, lTurned(0.0f, static_cast<float>(M_PI))));
+	BOOST_CHECK(!intersects(lFrustum, lTurned(300.0f, 0.0f)));
+
+	// Without a far plane, the test gives up.
+	mat4f lInfinite;
+	lInfinite.set_perspective_infinite(static_cast<float>(M_PI) / 2.0f, 1.0f, 1.0f);
+	BOOST_CHECK(intersects(lFrustum, frustum3f(lInfinite)));
+}
+
+BOOST_AUTO_TEST_CASE ( spheres_planes_and_boxes )
+{
+	const sphere3f lSphere(vec3f(0.0f, 0.0f, 0.0f), 2.0f);
+	BOOST_CHECK(lSphere.contains(vec3f(0.0f, 2.0f, 0.0f)));
+	BOOST_CHECK(!lSphere.contains(vec3f(1.5f, 1.5f, 0.0f)));
+
+	BOOST_CHECK(intersects(lSphere, sphere3f(vec3f(3.0f, 0.0f, 0.0f), 1.0f)));
+	BOOST_CHECK(!intersects(lSphere, sphere3f(vec3f(3.0f, 0.5f, 0.0f), 1.0f)));
+
+	// The closest corner of the box at (c, c, c) is at a distance
+	// sqrt(3) * (c - 1).
+	BOOST_CHECK(intersects(lSphere, boxAround(2.0f, 0.0f, 0.0f)));
+	BOOST_CHECK(intersects(lSphere, boxAround(2.1f, 2.1f, 2.1f)));
+	BOOST_CHECK(!intersects(lSphere, boxAround(2.2f, 2.2f, 2.2f)));
+
+	// The diamond is closer along the x-axis, and further along the diagonal.
+	BOOST_CHECK(intersects(lSphere, diamondAround(3.3f, 0.0f, 0.0f)));
+	BOOST_CHECK(!intersects(lSphere, diamondAround(3.5f, 0.0f, 0.0f)));
+	BOOST_CHECK(intersects(lSphere, diamondAround(2.1f, 2.1f, 0.0f)));
+	BOOST_CHECK(!intersects(lSphere, diamondAround(2.2f, 2.2f, 0.0f)));
+
+	const plane3f lPlane(vec3f(1.0f, 0.0f, 0.0f), vec3f(1.0f, 0.0f, 0.0f));
+	BOOST_CHECK(intersects(lPlane, lSphere));
+	BOOST_CHECK(!intersects(lPlane, sphere3f(vec3f(4.0f, 0.0f, 0.0f), 2.0f)));
+	BOOST_CHECK(intersects(lPlane, boxAround(1.5f, 0.0f, 0.0f)));
+	BOOST_CHECK(!intersects(lPlane, boxAround(2.5f, 0.0f, 0.0f)));
+	BOOST_CHECK(intersects(lPlane, diamondAround(2.3f, 0.0f, 0.0f)));
+	BOOST_CHECK(!intersects(lPlane, diamondAround(2.5f, 0.0f, 0.0f)));
+}
+
+BOOST_AUTO_TEST_CASE ( oriented_boxes )
+{
+	const auto lDiamond = diamondAround(0.0f, 0.0f, 0.0f);
+	BOOST_CHECK(lDiamond.contains(vec3f(1.4f, 0.0f, 0.0f)));
+	BOOST_CHECK(!lDiamond.contains(vec3f(0.9f, 0.9f, 0.0f)));
+
+	const auto lBounds = lDiamond.bounds();
+	BOOST_CHECK_CLOSE(lBounds.maxCorner.x, std::sqrt(2.0f), 1e-3f);
+	BOOST_CHECK_CLOSE(lBounds.minCorner.y, -std::sqrt(2.0f), 1e-3f);
+	BOOST_CHECK_CLOSE(lBounds.maxCorner.z, 1.0f, 1e-3f);
+
+	// The bounds overlap the box at (1.9, 1.9), the diamond itself does not.
+	BOOST_CHECK(intersects(lBounds, boxAround(1.9f, 1.9f, 0.0f)));
+	BOOST_CHECK(!intersects(lDiamond, boxAround(1.9f, 1.9f, 0.0f)));
+	BOOST_CHECK(intersects(lDiamond, boxAround(2.3f, 0.0f, 0.0f)));
+	BOOST_CHECK(!intersects(lDiamond, boxAround(2.5f, 0.0f, 0.0f)));
+
+	BOOST_CHECK(intersects(lDiamond, diamondAround(1.3f, 1.3f, 0.0f)));
+	BOOST_CHECK(!intersects(lDiamond, diamondAround(1.5f, 1.5f, 0.0f)));
+	BOOST_CHECK(!intersects(lDiamond, diamondAround(0.0f, 0.0f, 2.5f)));
+
+	// Non-uniform scale stretches the extent.
+	const obb3f lStretched(boxAround(0.0f, 0.0f, 0.0f), mat4f(SQT(vec3f(3.0f, 1.0f, 1.0f),
+		quatf(1.0f, 0.0f, 0.0f, 0.0f), vec3f(0.0f, 0.0f, 0.0f))));
+	BOOST_CHECK_CLOSE(lStretched.extent.x, 3.0f, 1e-4f);
+	BOOST_CHECK_CLOSE(lStretched.axes[0].x, 1.0f, 1e-4f);
+}
+
+BOOST_AUTO_TEST_CASE ( four_boxes_agree_with_single_boxes )
+{
+	const auto lBoxes = makeBoxes(4 * 61);
+	const frustum3f lFrustum(makeProjection() * mat4f(SQT(vec3f(1.0f, 1.0f, 1.0f),
+		quatf::axis_angle(vec3f(0.0f, 1.0f, 0.0f), 0.5f), vec3f(2.0f, 0.0f, 5.0f))).inverseRigid());
+	const ray3f lRay(vec3f(-12.0f, 1.0f, 2.0f), vec3f(1.0f, -0.2f, -0.6f));
+	const ray3f lAxisRay(vec3f(-12.0f, 5.0f, 1.0f), vec3f(1.0f, 0.0f, 0.0f));
+	const plane3f lPlane(vec3f(1.0f, 2.0f, -1.0f), vec3f(0.5f, 0.5f, -4.0f));
+	const sphere3f lSphere(vec3f(-2.0f, 1.0f, -5.0f), 6.0f);
+	const auto lDiamond = diamondAround(1.0f, 2.0f, -6.0f);
+	const auto lBox = boxAround(-1.0f, 1.0f, -10.0f, 4.0f);
+
+	std::size_t lHits[7] = {0, 0, 0, 0, 0, 0, 0};
+	for (std::size_t i = 0; i < lBoxes.size(); i += 4)
+	{
+		const auto lFour = lBoxes.data() + i;
+		const int lMasks[7] = {intersects4(lFrustum, lFour), intersects4(lPlane, lFour),
+			intersects4(lSphere, lFour), intersects4(lDiamond, lFour), intersects4(lBox, lFour),
+			0, 0};
+		float lDistances[4];
+		float lAxisDistances[4];
+		const int lRayMask = intersects4(lRay, lFour, lDistances);
+		const int lAxisMask = intersects4(lAxisRay, lFour, lAxisDistances);
+		for (int j = 0; j < 4; ++j)
+		{
+			const auto& lOne = lFour[j];
+			const bool lSingle[5] = {intersects(lFrustum, lOne), intersects(lPlane, lOne),
+				intersects(lSphere, lOne), intersects(lDiamond, lOne), intersects(lBox, lOne)};
+			for (int k = 0; k < 5; ++k)
+			{
+				BOOST_CHECK_EQUAL(((lMasks[k] >> j) & 1) != 0, lSingle[k]);
+				if (lSingle[k]) ++lHits[k];
+			}
+			float lDistance;
+			const bool lRayHit = intersects(lRay, lOne, lDistance);
+			BOOST_CHECK_EQUAL(((lRayMask >> j) & 1) != 0, lRayHit);
+			if (lRayHit)
+			{
+				BOOST_CHECK_CLOSE(lDistances[j], lDistance, 1e-3f);
+				++lHits[5];
+			}
+			const bool lAxisHit = intersects(lAxisRay, lOne, lDistance);
+			BOOST_CHECK_EQUAL(((lAxisMask >> j) & 1) != 0, lAxisHit);
+			if (lAxisHit) ++lHits[6];
+		}
+	}
+
+	// Make sure that both outcomes happen for every primitive.
+	for (const auto lCount : lHits)
+	{
+		BOOST_CHECK(lCount > 0);
+		BOOST_CHECK(lCount < lBoxes.size());
+	}
+}
@@ -0,0 +1,296 @@
+/**
+ * @file MathBenchmark.cpp
+ * @brief Times the batched math kernels against the one-by-one operators
+ * that they replace.
+ * @details This is not a unit test; the unit tests check that both give the
+ * same results. It is built next to them, but ctest does not run it. Every
+ * timing is followed by a checksum of the results, which is printed so that
+ * the optimizer cannot throw the timed work away.
+ * @author Raoul Wols
+ */
+
+#include "Foundation/CPU.hpp"
+#include "Math/Intersections.hpp"
+#include "Math/SQTArray.hpp"
+#include "Math/Transforms.hpp"
+#include "Math/mat3f.hpp"
+#include "Fixtures.hpp"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace gintonic;
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+double microseconds(const Clock::duration d)
+{
+	return std::chrono::duration<double, std::micro>(d).count();
+}
+
+// Run scalar and batched the given number of times and print both timings,
+// per run.
+template <class Scalar, class Batched, class Checksum>
+void compare(const char* name, const std::size_t iterations, Scalar&& scalar,
+	Batched&& batched, Checksum&& checksum)
+{
+	auto lStart = Clock::now();
+	for (std::size_t k = 0; k < iterations; ++k) scalar();
+	const auto lScalar = Clock::now() - lStart;
+	const auto lScalarSum = checksum();
+	lStart = Clock::now();
+	for (std::size_t k = 0; k < iterations; ++k) batched();
+	const auto lBatched = Clock::now() - lStart;
+	std::cout << "  " << name << ": "
+		<< microseconds(lScalar) / iterations << " us one by one, "
+		<< microseconds(lBatched) / iterations << " us batched"
+		<< " (checksums " << lScalarSum << ", " << checksum() << ")\n";
+}
+
+void poses()
+{
+	const std::size_t lJointCount = 100;
+	std::vector<SQT, allocator<SQT>> lU;
+	std::vector<SQT, allocator<SQT>> lV;
+	std::vector<SQT, allocator<SQT>> lPerJoint(lJointCount);
+	SQTArray lPackedU(lJointCount);
+	SQTArray lPackedV(lJointCount);
+	SQTArray lPacked(lJointCount);
+	for (std::size_t j = 0; j < lJointCount; ++j)
+	{
+		lU.push_back(fixtures::makeSQT(j, 0.0f));
+		lV.push_back(fixtures::makeSQT(j, 0.1f));
+		lPackedU.set(j, lU.back());
+		lPackedV.set(j, lV.back());
+	}
+
+	std::cout << "Poses of " << lJointCount << " joints\n";
+	std::size_t i = 0;
+	bool lPackedLast = false;
+	compare("mix", 10000,
+		[&] {
+			const auto a = float(i++ % 100) / 100.0f;
+			for (std::size_t j = 0; j < lJointCount; ++j)
+			{
+				lPerJoint[j] = mix(lU[j], lV[j], a);
+			}
+		},
+		[&] {
+			mix(lPackedU, lPackedV, float(i++ % 100) / 100.0f, lPacked);
+			lPackedLast = true;
+		},
+		[&] {
+			float lSum = 0.0f;
+			for (std::size_t j = 0; j < lJointCount; ++j)
+			{
+				lSum += lPackedLast ? lPacked.get(j).translation.z
+					: lPerJoint[j].translation.z;
+			}
+			return lSum;
+		});
+}
+
+void transforms()
+{
+	const std::size_t lCount = 10000;
+	const mat4f lMatrix(fixtures::makeSQT(3));
+	std::vector<mat4f, allocator<mat4f>> lMatrices;
+	std::vector<SQT, allocator<SQT>> lSQTs;
+	std::vector<vec3f, allocator<vec3f>> lPoints;
+	std::vector<box3f, allocator<box3f>> lBoxes;
+	for (std::size_t i = 0; i < lCount; ++i)
+	{
+		lSQTs.push_back(fixtures::makeSQT(i));
+		lMatrices.emplace_back(lSQTs.back());
+		lPoints.push_back(fixtures::makePoint(i));
+		lBoxes.emplace_back(lPoints.back(), lPoints.back() + vec3f(1.0f));
+	}
+	std::vector<mat4f, allocator<mat4f>> lMatrixResult(lCount);
+	std::vector<vec3f, allocator<vec3f>> lPointResult(lCount);
+	std::vector<box3f, allocator<box3f>> lBoxResult(lCount);
+	std::vector<mat3f> lNormalResult(lCount);
+
+	const auto lMatrixSum = [&] {
+		float lSum = 0.0f;
+		for (const auto& lResult : lMatrixResult) lSum += lResult.m03;
+		return lSum;
+	};
+	const auto lPointSum = [&] {
+		float lSum = 0.0f;
+		for (const auto& lResult : lPointResult) lSum += lResult.x;
+		return lSum;
+	};
+	const auto lBoxSum = [&] {
+		float lSum = 0.0f;
+		for (const auto& lResult : lBoxResult) lSum += lResult.maxCorner.x;
+		return lSum;
+	};
+	const auto lNormalSum = [&] {
+		float lSum = 0.0f;
+		for (const auto& lResult : lNormalResult) lSum += lResult.m00;
+		return lSum;
+	};
+
+	const auto lSupported = static_cast<int>(supportedSIMDLevel());
+	const auto lActive = activeSIMDLevel();
+	for (int lLevel = 0; lLevel <= lSupported; ++lLevel)
+	{
+		std::cout << lCount << " values, "
+			<< forceSIMDLevel(static_cast<SIMDLevel>(lLevel)) << '\n';
+		compare("mat4f * mat4f[]", 100,
+			[&] {
+				for (std::size_t i = 0; i < lCount; ++i)
+					lMatrixResult[i] = lMatrix * lMatrices[i];
+			},
+			[&] {
+				multiply(lMatrix, lMatrices.data(), lCount,
+					lMatrixResult.data());
+			},
+			lMatrixSum);
+		compare("mat4f[] * mat4f[]", 100,
+			[&] {
+				for (std::size_t i = 0; i < lCount; ++i)
+					lMatrixResult[i] = lMatrices[i] * lMatrices[i];
+			},
+			[&] {
+				multiply(lMatrices.data(), lMatrices.data(), lCount,
+					lMatrixResult.data());
+			},
+			lMatrixSum);
+		compare("points", 100,
+			[&] {
+				for (std::size_t i = 0; i < lCount; ++i)
+					lPointResult[i] = lMatrix.apply_to_point(lPoints[i]);
+			},
+			[&] {
+				transformPoints(lMatrix, lPoints.data(), lCount,
+					lPointResult.data());
+			},
+			lPointSum);
+		compare("SQT[] -> mat4f[]", 100,
+			[&] {
+				for (std::size_t i = 0; i < lCount; ++i)
+					lMatrixResult[i] = mat4f(lSQTs[i]);
+			},
+			[&] {
+				toMatrices(lSQTs.data(), lCount, lMatrixResult.data());
+			},
+			lMatrixSum);
+		compare("boxes", 100,
+			[&] {
+				for (std::size_t i = 0; i < lCount; ++i)
+				{
+					lBoxResult[i] =
+						fixtures::referenceBox(lMatrix, lBoxes[i]);
+				}
+			},
+			[&] {
+				transformBoxes(lMatrix, lBoxes.data(), lCount,
+					lBoxResult.data());
+			},
+			lBoxSum);
+		compare("normal matrices", 100,
+			[&] {
+				for (std::size_t i = 0; i < lCount; ++i)
+				{
+					lNormalResult[i] =
+						lMatrices[i].upperLeft33().invert().transpose();
+				}
+			},
+			[&] {
+				normalMatrices(lMatrices.data(), lCount, lNormalResult.data());
+			},
+			lNormalSum);
+	}
+	forceSIMDLevel(lActive);
+}
+
+void skinning()
+{
+	for (const std::size_t lCount : {10000, 100000})
+	{
+		const fixtures::Character lCharacter(lCount);
+		std::vector<float> lResult(3 * lCount);
+
+		std::cout << lCount << " skinned positions\n";
+		compare("positions", 10,
+			[&] {
+				for (std::size_t i = 0; i < lCount; ++i)
+				{
+					const auto lPosition = lCharacter.reference(i);
+					lResult[3 * i + 0] = lPosition.x;
+					lResult[3 * i + 1] = lPosition.y;
+					lResult[3 * i + 2] = lPosition.z;
+				}
+			},
+			[&] { lCharacter.skin(lResult, 0, lCount); },
+			[&] {
+				float lSum = 0.0f;
+				for (const auto lValue : lResult) lSum += lValue;
+				return lSum;
+			});
+	}
+}
+
+void intersections()
+{
+	const std::size_t lCount = 10000;
+	const auto lBoxes = fixtures::makeBoxes(lCount);
+	const frustum3f lFrustum(fixtures::makeProjection());
+	const ray3f lRay(vec3f(-12.0f, 1.0f, 2.0f), vec3f(1.0f, -0.2f, -0.6f));
+	const sphere3f lSphere(vec3f(-2.0f, 1.0f, -5.0f), 6.0f);
+	const auto lDiamond = fixtures::diamondAround(1.0f, 2.0f, -6.0f);
+	std::size_t lHits = 0;
+
+	// Count the hits of every box, one at a time or four at a time.
+	const auto lCompare = [&](const char* name, auto&& single, auto&& four)
+	{
+		compare(name, 100,
+			[&] {
+				for (std::size_t i = 0; i < lCount; ++i)
+				{
+					lHits += single(lBoxes[i]);
+				}
+			},
+			[&] {
+				for (std::size_t i = 0; i < lCount; i += 4)
+				{
+					const int lMask = four(lBoxes.data() + i);
+					lHits += (lMask & 1) + ((lMask >> 1) & 1)
+						+ ((lMask >> 2) & 1) + ((lMask >> 3) & 1);
+				}
+			},
+			[&] {
+				const auto lResult = lHits;
+				lHits = 0;
+				return lResult;
+			});
+	};
+
+	std::cout << lCount << " boxes\n";
+	lCompare("frustum",
+		[&](const box3f& b) { return lFrustum.intersects(b) ? 1 : 0; },
+		[&](const box3f* b) { return intersects4(lFrustum, b); });
+	lCompare("sphere",
+		[&](const box3f& b) { return intersects(lSphere, b) ? 1 : 0; },
+		[&](const box3f* b) { return intersects4(lSphere, b); });
+	lCompare("ray",
+		[&](const box3f& b) { float d; return intersects(lRay, b, d) ? 1 : 0; },
+		[&](const box3f* b) { float d[4]; return intersects4(lRay, b, d); });
+	lCompare("oriented box",
+		[&](const box3f& b) { return intersects(lDiamond, b) ? 1 : 0; },
+		[&](const box3f* b) { return intersects4(lDiamond, b); });
+}
+
+} // anonymous namespace
+
+int main()
+{
+	poses();
+	transforms();
+	skinning();
+	intersections();
+	return 0;
+}
@@ -0,0 +1,89 @@
+#define BOOST_TEST_MODULE MemoryProfiler test
+#include <boost/test/unit_test.hpp>
+
+#include "Foundation/MemoryProfiler.hpp"
+#include "Foundation/utilities.hpp"
+
+using namespace gintonic;
+
+using Subsystem = MemoryProfiler::Subsystem;
+
+BOOST_AUTO_TEST_CASE ( scopes_nest )
+{
+	BOOST_CHECK(MemoryProfiler::current() == Subsystem::General);
+	{
+		MemoryProfiler::Scope lOuter(Subsystem::Renderer);
+		BOOST_CHECK(MemoryProfiler::current() == Subsystem::Renderer);
+		{
+			MemoryProfiler::Scope lInner(Subsystem::Animation);
+			BOOST_CHECK(MemoryProfiler::current() == Subsystem::Animation);
+		}
+		BOOST_CHECK(MemoryProfiler::current() == Subsystem::Renderer);
+	}
+	BOOST_CHECK(MemoryProfiler::current() == Subsystem::General);
+}
+
+BOOST_AUTO_TEST_CASE ( counts_bytes_and_peak )
+{
+	MemoryProfiler::reset();
+	const auto lBefore = MemoryProfiler::get(Subsystem::Mesh);
+
+	void* lFirst;
+	void* lSecond;
+	{
+		MemoryProfiler::Scope lScope(Subsystem::Mesh);
+		lFirst = MemoryProfiler::allocate(100, 16);
+		lSecond = MemoryProfiler::allocate(28, 64);
+	}
+
+	BOOST_CHECK(isAligned(lFirst, 16));
+	BOOST_CHECK(isAligned(lSecond, 64));
+
+	auto lStats = MemoryProfiler::get(Subsystem::Mesh);
+	BOOST_CHECK_EQUAL(lStats.allocations, 2);
+	BOOST_CHECK_EQUAL(lStats.totalBytes, 128);
+	BOOST_CHECK_EQUAL(lStats.liveBytes, lBefore.liveBytes + 128);
+	BOOST_CHECK_EQUAL(lStats.peakBytes, lBefore.liveBytes + 128);
+
+	// Deallocation is attributed to the subsystem that allocated,
+	// not to the subsystem that is active at the time.
+	{
+		MemoryProfiler::Scope lScope(Subsystem::Octree);
+		MemoryProfiler::deallocate(lFirst);
+	}
+	MemoryProfiler::deallocate(lSecond);
+
+	lStats = MemoryProfiler::get(Subsystem::Mesh);
+	BOOST_CHECK_EQUAL(lStats.deallocations, 2);
+	BOOST_CHECK_EQUAL(lStats.liveBytes, lBefore.liveBytes);
+	BOOST_CHECK_EQUAL(lStats.peakBytes, lBefore.liveBytes + 128);
+	BOOST_CHECK_EQUAL(MemoryProfiler::get(Subsystem::Octree).deallocations, 0);
+}
+
+BOOST_AUTO_TEST_CASE ( per_frame_rate )
+{
+	MemoryProfiler::reset();
+	MemoryProfiler::Scope lScope(Subsystem::Asset);
+
+	for (int lFrame = 1; lFrame <= 4; ++lFrame)
+	{
+		for (int i = 0; i < lFrame; ++i)
+		{
+			MemoryProfiler::deallocate(MemoryProfiler::allocate(8, 16));
+		}
+		MemoryProfiler::nextFrame();
+	}
+
+	const auto lStats = MemoryProfiler::get(Subsystem::Asset);
+	BOOST_CHECK_EQUAL(lStats.frames, 4);
+	BOOST_CHECK_EQUAL(lStats.allocationsLastFrame, 4);
+	BOOST_CHECK_EQUAL(lStats.bytesLastFrame, 32);
+	BOOST_CHECK_EQUAL(lStats.maxAllocationsPerFrame, 4);
+	BOOST_CHECK_CLOSE(lStats.averageAllocationsPerFrame(), 2.5, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE ( subsystem_names )
+{
+	BOOST_CHECK_EQUAL(MemoryProfiler::name(Subsystem::Renderer), "Renderer");
+	BOOST_CHECK_EQUAL(MemoryProfiler::name(Subsystem::Animation), "Animation");
+}
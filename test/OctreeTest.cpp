@@ -38,3 +38,39 @@ BOOST_AUTO_TEST_CASE( main_test )
 	}
 	DEBUG_PRINT;
 }
+
+BOOST_AUTO_TEST_CASE( frustum_query )
+{
+	const box3f lBoundingBox(vec3f(-128.0f, -128.0f, -128.0f), vec3f(128.0f, 128.0f, 128.0f));
+	Octree lRoot(lBoundingBox);
+
+	std::vector<std::shared_ptr<Entity>> lEntities;
+	for (int i = -10; i <= 10; ++i)
+	{
+		auto lEntity = Entity::create();
+		lEntity->setTranslation(vec3f(static_cast<float>(i) * 10.0f, 0.0f, -50.0f));
+		lRoot.insert(lEntity);
+		lEntities.push_back(lEntity);
+	}
+
+	// Camera at the origin looking down the negative z-axis.
+	mat4f lProjection;
+	lProjection.set_perspective(static_cast<float>(M_PI) / 2.0f, 1.0f, 1.0f, 100.0f);
+	const frustum3f lFrustum(lProjection);
+
+	std::vector<std::shared_ptr<const Entity>> lResult;
+	const auto& lConstRoot = lRoot;
+	lConstRoot.query(lFrustum, std::back_inserter(lResult));
+
+	std::size_t lExpected = 0;
+	for (const auto& lEntity : lEntities)
+	{
+		const bool lVisible = lFrustum.intersects(lEntity->globalBoundingBox());
+		const bool lFound = std::find(lResult.begin(), lResult.end(), lEntity) != lResult.end();
+		BOOST_CHECK_EQUAL(lVisible, lFound);
+		if (lVisible) ++lExpected;
+	}
+	BOOST_CHECK_EQUAL(lResult.size(), lExpected);
+	BOOST_CHECK(lExpected > 0);
+	BOOST_CHECK(lExpected < lEntities.size());
+}
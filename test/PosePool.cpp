@@ -0,0 +1,36 @@
+#define BOOST_TEST_MODULE PosePool test
+#include <boost/test/unit_test.hpp>
+
+#include "Graphics/PosePool.hpp"
+
+using namespace gintonic;
+
+BOOST_AUTO_TEST_CASE ( buffers_are_reused )
+{
+	PosePool lPool;
+	{
+		auto lA = lPool.acquire(10);
+		auto lB = lPool.acquire(10);
+		BOOST_CHECK_EQUAL(lA->size(), 10);
+		BOOST_CHECK(&*lA != &*lB);
+	}
+	BOOST_CHECK_EQUAL(lPool.size(), 2);
+	BOOST_CHECK_EQUAL(lPool.available(), 2);
+
+	// A buffer is resized when it has a different size.
+	for (int i = 0; i < 100; ++i)
+	{
+		auto lA = lPool.acquire(10);
+		auto lB = lPool.acquire(20);
+		BOOST_CHECK_EQUAL(lB->size(), 20);
+	}
+	BOOST_CHECK_EQUAL(lPool.size(), 2);
+
+	auto lA = lPool.acquire(10);
+	BOOST_CHECK_EQUAL(lPool.available(), 1);
+	auto lB = std::move(lA);
+	lA = lPool.acquire(10);
+	BOOST_CHECK_EQUAL(lPool.available(), 0);
+	lA = PosePool::Handle();
+	BOOST_CHECK_EQUAL(lPool.available(), 1);
+}
@@ -0,0 +1,168 @@
+#define BOOST_TEST_MODULE RecordingContext test
+#include <boost/test/unit_test.hpp>
+
+#include "Graphics/OpenGL/RecordingContext.hpp"
+#include "Graphics/OpenGL/BufferObject.hpp"
+#include "Graphics/OpenGL/Shader.hpp"
+#include "Graphics/OpenGL/SourceCode.hpp"
+#include "Graphics/OpenGL/StateCache.hpp"
+#include "Graphics/FrameStatistics.hpp"
+#include "Graphics/Material.hpp"
+#include "Graphics/Mesh.hpp"
+#include "Graphics/Renderer.hpp"
+#include "Graphics/ShaderPrograms.hpp"
+#include "Camera.hpp"
+#include "Entity.hpp"
+#include <memory>
+
+using namespace gintonic;
+
+BOOST_AUTO_TEST_CASE ( records_calls_and_arguments )
+{
+	OpenGL::RecordingContext lContext;
+	BOOST_CHECK(OpenGL::RecordingContext::current() == &lContext);
+	BOOST_CHECK(lContext.calls().empty());
+
+	glUseProgram(3);
+	glUseProgram(3);
+	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+	BOOST_CHECK_EQUAL(glGetError(), GL_NO_ERROR);
+
+	BOOST_CHECK_EQUAL(lContext.calls().size(), 3);
+	BOOST_CHECK_EQUAL(lContext.count("glUseProgram"), 2);
+	BOOST_CHECK_EQUAL(lContext.count("glDrawElements"), 1);
+	BOOST_CHECK_EQUAL(lContext.count("glGetError"), 0);
+	BOOST_CHECK_EQUAL(lContext.calls()[0].arguments, "3");
+	BOOST_CHECK_EQUAL(lContext.calls()[2].name, "glDrawElements");
+
+	lContext.clear();
+	BOOST_CHECK(lContext.calls().empty());
+}
+
+BOOST_AUTO_TEST_CASE ( simulates_object_names )
+{
+	OpenGL::RecordingContext lContext;
+
+	OpenGL::BufferObject lFirst;
+	OpenGL::BufferObject lSecond;
+	BOOST_CHECK(lFirst != 0);
+	BOOST_CHECK(lSecond != 0);
+	BOOST_CHECK(static_cast<GLuint>(lFirst) != static_cast<GLuint>(lSecond));
+	BOOST_CHECK_EQUAL(lContext.count("glGenBuffers"), 2);
+
+	// Shaders always compile.
+	OpenGL::VertexShader lShader(
+		OpenGL::SourceCode::fromMemory("void main() {}"));
+	BOOST_CHECK(lShader != 0);
+	BOOST_CHECK_EQUAL(lContext.count("glCompileShader"), 1);
+}
+
+BOOST_AUTO_TEST_CASE ( wrappers_count_into_frame_sample )
+{
+	OpenGL::RecordingContext lContext;
+	FrameSample::current() = FrameSample();
+
+	OpenGL::setUniform(0, 1.0f);
+	OpenGL::setUniform(1, 2);
+	BOOST_CHECK_EQUAL(lContext.count("glUniform1f") + lContext.count("glUniform1i"), 2);
+	BOOST_CHECK_EQUAL(FrameSample::current().uniformUploads, 2);
+
+	FrameSample::current() = FrameSample();
+}
+
+BOOST_AUTO_TEST_CASE ( queries_fill_every_value )
+{
+	OpenGL::RecordingContext lContext;
+
+	GLfloat lRange[2] = {-1.0f, -1.0f};
+	glGetFloatv(GL_ALIASED_LINE_WIDTH_RANGE, lRange);
+	BOOST_CHECK_EQUAL(lRange[0], 1.0f);
+	BOOST_CHECK_EQUAL(lRange[1], 1.0f);
+	glGetFloatv(GL_DEPTH_RANGE, lRange);
+	BOOST_CHECK_EQUAL(lRange[0], 0.0f);
+	BOOST_CHECK_EQUAL(lRange[1], 1.0f);
+
+	GLfloat lColor[4] = {-1.0f, -1.0f, -1.0f, -1.0f};
+	glGetFloatv(GL_COLOR_CLEAR_VALUE, lColor);
+	for (const auto lValue : lColor) BOOST_CHECK_EQUAL(lValue, 0.0f);
+
+	GLint lDepthRange[2] = {-1, -1};
+	glGetIntegerv(GL_DEPTH_RANGE, lDepthRange);
+	BOOST_CHECK_EQUAL(lDepthRange[0], 0);
+	BOOST_CHECK_EQUAL(lDepthRange[1], 1);
+
+	GLboolean lMask[4] = {GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE};
+	glGetBooleanv(GL_COLOR_WRITEMASK, lMask);
+	for (const auto lValue : lMask) BOOST_CHECK_EQUAL(lValue, GL_TRUE);
+}
+
+BOOST_AUTO_TEST_CASE ( the_geometry_pass_stays_within_its_call_budget )
+{
+	OpenGL::RecordingContext lContext;
+	FrameSample::current() = FrameSample();
+	MaterialShaderProgram::initialize();
+
+	auto lCameraEntity = Entity::create("Camera");
+	lCameraEntity->camera = Camera::create("Camera");
+	lCameraEntity->camera->setWidth(800.0f);
+	lCameraEntity->camera->setHeight(600.0f);
+	lCameraEntity->camera->setNearPlane(0.1f);
+	lCameraEntity->camera->setFarPlane(100.0f);
+	Renderer::setCameraEntity(lCameraEntity);
+
+	// 3 materials and 2 meshes, spread over 60 entities in front of the
+	// camera, in an order in which every entity differs from the previous
+	// one.
+	const std::size_t kMaterials = 3, kMeshes = 2, kEntities = 60;
+	std::vector<std::shared_ptr<Material>> lMaterials;
+	std::vector<std::shared_ptr<Mesh>> lMeshes;
+	for (std::size_t i = 0; i < kMaterials; ++i)
+	{
+		lMaterials.push_back(Material::create());
+	}
+	for (std::size_t i = 0; i < kMeshes; ++i) lMeshes.push_back(Mesh::create());
+	std::vector<std::shared_ptr<Entity>> lEntities;
+	for (std::size_t i = 0; i < kEntities; ++i)
+	{
+		auto lEntity = Entity::create("Entity");
+		lEntity->material = lMaterials[i % kMaterials];
+		lEntity->mesh = lMeshes[i % kMeshes];
+		lEntity->setTranslation(vec3f(float(i % 7), float(i % 5),
+			-1.0f - float(i)));
+		lEntities.push_back(lEntity);
+	}
+	const std::size_t kRuns = kMaterials * kMeshes;
+
+	// Every run of draws that share material and mesh is one instanced
+	// draw. The program is bound once, a vertex array once per run, and
+	// a uniform block range once per material, besides the camera block
+	// and the default object and joint blocks.
+	Renderer::setAutomaticInstancing(true);
+	OpenGL::StateCache::invalidate();
+	lContext.clear();
+	Renderer::renderGeometry(lEntities);
+	BOOST_CHECK_EQUAL(lContext.count("glDrawElements"), 0);
+	BOOST_CHECK_EQUAL(lContext.count("glDrawElementsInstanced"), kRuns);
+	BOOST_CHECK_LE(lContext.count("glUseProgram"), 1);
+	BOOST_CHECK_LE(lContext.count("glBindVertexArray"), kRuns);
+	BOOST_CHECK_LE(lContext.count("glBindBufferRange"), kMaterials + 3);
+	BOOST_CHECK_LE(lContext.count("glUniform1i"), 4);
+
+	// Without instancing, every entity is a draw with its own object block,
+	// but the program, vertex arrays and materials are bound just as often.
+	Renderer::setAutomaticInstancing(false);
+	OpenGL::StateCache::invalidate();
+	lContext.clear();
+	Renderer::renderGeometry(lEntities);
+	BOOST_CHECK_EQUAL(lContext.count("glDrawElements"), kEntities);
+	BOOST_CHECK_EQUAL(lContext.count("glDrawElementsInstanced"), 0);
+	BOOST_CHECK_LE(lContext.count("glUseProgram"), 1);
+	BOOST_CHECK_LE(lContext.count("glBindVertexArray"), kRuns);
+	BOOST_CHECK_LE(lContext.count("glBindBufferRange"),
+		kEntities + kMaterials + 3);
+	BOOST_CHECK_LE(lContext.count("glUniform1i"), 4);
+
+	Renderer::setAutomaticInstancing(true);
+	MaterialShaderProgram::release();
+	FrameSample::current() = FrameSample();
+}
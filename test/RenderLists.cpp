@@ -0,0 +1,155 @@
+#define BOOST_TEST_MODULE RenderLists test
+#include <boost/test/unit_test.hpp>
+
+#include "Graphics/OpenGL/RecordingContext.hpp"
+#include "Graphics/RenderLists.hpp"
+#include "Graphics/Material.hpp"
+#include "Graphics/Mesh.hpp"
+#include "Graphics/PointLight.hpp"
+#include "Graphics/SpotLight.hpp"
+#include "Entity.hpp"
+#include <algorithm>
+
+using namespace gintonic;
+
+namespace {
+
+bool contains(const RenderLists& lists, const FrameSample::Bucket bucket,
+	const std::shared_ptr<Entity>& entity)
+{
+	const auto& lBucket = lists[bucket];
+	return std::find(lBucket.begin(), lBucket.end(), entity) != lBucket.end();
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE ( light_kinds )
+{
+	BOOST_CHECK_EQUAL(RenderLists::lightKind(nullptr), RenderLists::kNoLight);
+	const auto lPoint = PointLight::create(vec4f(1.0f, 1.0f, 1.0f, 1.0f));
+	BOOST_CHECK_EQUAL(RenderLists::lightKind(lPoint.get()),
+		RenderLists::kPointLight);
+	const auto lSpot = SpotLight::create(vec4f(1.0f, 1.0f, 1.0f, 1.0f));
+	BOOST_CHECK_EQUAL(RenderLists::lightKind(lSpot.get()),
+		RenderLists::kSpotLight);
+}
+
+BOOST_AUTO_TEST_CASE ( entities_move_between_buckets_on_change )
+{
+	OpenGL::RecordingContext lContext;
+	const auto lMesh = Mesh::create();
+	const auto lMaterial = Material::create();
+
+	auto lRoot = Entity::create("Root");
+	auto lChild = Entity::create("Child");
+	lRoot->addChild(lChild);
+	lChild->material = lMaterial;
+	lChild->mesh = lMesh;
+
+	RenderLists lLists;
+	lLists.addRecursive(lRoot);
+	BOOST_CHECK_EQUAL(lLists.size(), 2);
+	BOOST_CHECK_EQUAL(lLists.changedCount(), 2);
+	BOOST_CHECK_EQUAL(lLists.update(), 2);
+	BOOST_CHECK(contains(lLists, FrameSample::kBucketNonShadowCastingGeometry,
+		lChild));
+	BOOST_CHECK(lLists[FrameSample::kBucketShadowCastingGeometry].empty());
+
+	// Nothing changed, so there is nothing to do.
+	BOOST_CHECK_EQUAL(lLists.update(), 0);
+
+	lChild->setCastShadow(true);
+	BOOST_CHECK_EQUAL(lLists.changedCount(), 1);
+	BOOST_CHECK_EQUAL(lLists.update(), 1);
+	BOOST_CHECK(contains(lLists, FrameSample::kBucketShadowCastingGeometry,
+		lChild));
+	BOOST_CHECK(lLists[FrameSample::kBucketNonShadowCastingGeometry].empty());
+
+	lRoot->setLight(PointLight::create(vec4f(1.0f, 1.0f, 1.0f, 1.0f)));
+	lRoot->setCastShadow(true);
+	BOOST_CHECK_EQUAL(lLists.changedCount(), 1);
+	lLists.update();
+	BOOST_CHECK(contains(lLists, FrameSample::kBucketShadowCastingPointLights,
+		lRoot));
+
+	lChild->setMesh(nullptr);
+	lLists.update();
+	BOOST_CHECK(lLists[FrameSample::kBucketShadowCastingGeometry].empty());
+
+	lLists.removeRecursive(lRoot);
+	BOOST_CHECK(lLists.empty());
+	for (int b = 0; b < FrameSample::kBucketCount; ++b)
+	{
+		BOOST_CHECK(lLists[static_cast<FrameSample::Bucket>(b)].empty());
+	}
+
+	// Unregistered entities are not tracked anymore.
+	lChild->setMesh(lMesh);
+	BOOST_CHECK_EQUAL(lLists.changedCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE ( removal_keeps_the_other_entities )
+{
+	OpenGL::RecordingContext lContext;
+	const auto lMesh = Mesh::create();
+	const auto lMaterial = Material::create();
+
+	RenderLists lLists;
+	std::vector<std::shared_ptr<Entity>> lEntities;
+	for (int i = 0; i < 8; ++i)
+	{
+		auto lEntity = Entity::create("Entity");
+		lEntity->material = lMaterial;
+		lEntity->mesh = lMesh;
+		lLists.add(lEntity);
+		lEntities.push_back(lEntity);
+	}
+	lLists.update();
+
+	lLists.remove(lEntities[0].get());
+	lLists.remove(lEntities[5].get());
+	lEntities[3]->setCastShadow(true);
+	lLists.update();
+
+	const auto& lGeometry = lLists[FrameSample::kBucketNonShadowCastingGeometry];
+	BOOST_CHECK_EQUAL(lGeometry.size(), 5);
+	for (const auto i : {1, 2, 4, 6, 7})
+	{
+		BOOST_CHECK(contains(lLists,
+			FrameSample::kBucketNonShadowCastingGeometry, lEntities[i]));
+	}
+	BOOST_CHECK(contains(lLists, FrameSample::kBucketShadowCastingGeometry,
+		lEntities[3]));
+
+	// Changing the remaining entities must still find them at their new
+	// positions.
+	for (const auto i : {1, 2, 4, 6, 7}) lEntities[i]->setCastShadow(true);
+	lLists.update();
+	BOOST_CHECK(lGeometry.empty());
+	BOOST_CHECK_EQUAL(
+		lLists[FrameSample::kBucketShadowCastingGeometry].size(), 6);
+}
+
+BOOST_AUTO_TEST_CASE ( a_new_light_gets_a_new_kind )
+{
+	OpenGL::RecordingContext lContext;
+
+	auto lEntity = Entity::create("Light");
+	lEntity->setLight(PointLight::create(vec4f(1.0f, 1.0f, 1.0f, 1.0f)));
+	lEntity->setCastShadow(true);
+
+	RenderLists lLists;
+	lLists.add(lEntity);
+	lLists.update();
+	BOOST_CHECK(contains(lLists, FrameSample::kBucketShadowCastingPointLights,
+		lEntity));
+
+	// Drop the point light first, so that the spot light could be allocated
+	// at its address.
+	lEntity->light.reset();
+	lEntity->setLight(SpotLight::create(vec4f(1.0f, 1.0f, 1.0f, 1.0f)));
+	lLists.update();
+	BOOST_CHECK(contains(lLists, FrameSample::kBucketShadowCastingLights,
+		lEntity));
+	BOOST_CHECK(lLists[FrameSample::kBucketShadowCastingPointLights].empty());
+}
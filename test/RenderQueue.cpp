@@ -0,0 +1,79 @@
+#define BOOST_TEST_MODULE RenderQueue test
+#include <boost/test/unit_test.hpp>
+
+#include "Graphics/RenderQueue.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace gintonic;
+
+BOOST_AUTO_TEST_CASE ( keys_pack_and_unpack )
+{
+	const auto lKey = RenderQueue::makeKey(RenderQueue::kPassOpaque, 21, 1234,
+		4321, 98765);
+	BOOST_CHECK_EQUAL(RenderQueue::pass(lKey), RenderQueue::kPassOpaque);
+	BOOST_CHECK_EQUAL(RenderQueue::permutation(lKey), 21);
+	BOOST_CHECK_EQUAL(RenderQueue::material(lKey), 1234);
+	BOOST_CHECK_EQUAL(RenderQueue::mesh(lKey), 4321);
+	BOOST_CHECK_EQUAL(RenderQueue::depth(lKey), 98765);
+
+	// State is more significant than depth.
+	const auto lNear = RenderQueue::makeKey(RenderQueue::kPassOpaque, 1, 2, 0, 0);
+	const auto lFar = RenderQueue::makeKey(RenderQueue::kPassOpaque, 1, 1, 0, 1000);
+	BOOST_CHECK_LT(lFar, lNear);
+}
+
+BOOST_AUTO_TEST_CASE ( depth_is_quantized_and_clamped )
+{
+	const std::uint32_t lMax = (1u << RenderQueue::kDepthBits) - 1;
+	BOOST_CHECK_EQUAL(RenderQueue::quantizeDepth(0.5f, 1.0f, 100.0f), 0);
+	BOOST_CHECK_EQUAL(RenderQueue::quantizeDepth(1.0f, 1.0f, 100.0f), 0);
+	BOOST_CHECK_EQUAL(RenderQueue::quantizeDepth(100.0f, 1.0f, 100.0f), lMax);
+	BOOST_CHECK_EQUAL(RenderQueue::quantizeDepth(500.0f, 1.0f, 100.0f), lMax);
+	BOOST_CHECK_LT(RenderQueue::quantizeDepth(10.0f, 1.0f, 100.0f),
+		RenderQueue::quantizeDepth(11.0f, 1.0f, 100.0f));
+	BOOST_CHECK_EQUAL(RenderQueue::quantizeDepth(5.0f, 1.0f, 1.0f), 0);
+}
+
+BOOST_AUTO_TEST_CASE ( identifiers_are_dense_and_stable )
+{
+	RenderQueue lQueue;
+	int a, b;
+	BOOST_CHECK_EQUAL(lQueue.materialId(&a), 0);
+	BOOST_CHECK_EQUAL(lQueue.materialId(&b), 1);
+	BOOST_CHECK_EQUAL(lQueue.materialId(&a), 0);
+	BOOST_CHECK_EQUAL(lQueue.meshId(&b), 0);
+	lQueue.clear();
+	BOOST_CHECK_EQUAL(lQueue.materialId(&b), 0);
+}
+
+BOOST_AUTO_TEST_CASE ( sort_matches_stable_sort )
+{
+	std::mt19937_64 lGenerator(42);
+	std::uniform_int_distribution<std::uint32_t> lSmall(0, 3);
+	std::uniform_int_distribution<std::uint32_t> lDepth(0, 1u << 20);
+
+	RenderQueue lQueue;
+	std::vector<RenderQueue::Item> lExpected;
+	for (std::uint32_t i = 0; i < 1000; ++i)
+	{
+		const auto lKey = RenderQueue::makeKey(RenderQueue::kPassOpaque,
+			lSmall(lGenerator), lSmall(lGenerator), lSmall(lGenerator),
+			lDepth(lGenerator) % 8);
+		lQueue.push(lKey, i);
+		lExpected.push_back({lKey, i});
+	}
+	lQueue.sort();
+	std::stable_sort(lExpected.begin(), lExpected.end(),
+		[](const RenderQueue::Item& x, const RenderQueue::Item& y)
+		{
+			return x.key < y.key;
+		});
+
+	BOOST_REQUIRE_EQUAL(lQueue.size(), lExpected.size());
+	for (std::size_t i = 0; i < lExpected.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(lQueue[i].key, lExpected[i].key);
+		BOOST_CHECK_EQUAL(lQueue[i].index, lExpected[i].index);
+	}
+}
@@ -0,0 +1,146 @@
+#define BOOST_TEST_MODULE SQTArray test
+#include <boost/test/unit_test.hpp>
+
+#include "Math/SQTArray.hpp"
+#include "Fixtures.hpp"
+#include <vector>
+
+using namespace gintonic;
+
+namespace {
+
+// The reference: lerp for scale and translation, nlerp for the rotation.
+SQT reference(const SQT& u, SQT v, const float a)
+{
+	const auto lDot = u.rotation.x * v.rotation.x + u.rotation.y * v.rotation.y
+		+ u.rotation.z * v.rotation.z + u.rotation.w * v.rotation.w;
+	if (lDot < 0.0f) v.rotation = v.rotation * -1.0f;
+	auto lRotation = mix(u.rotation, v.rotation, a);
+	lRotation = lRotation * (1.0f / std::sqrt(lRotation.length2()));
+	return SQT(mix(u.scale, v.scale, a), lRotation,
+		mix(u.translation, v.translation, a));
+}
+
+void checkClose(const SQT& a, const SQT& b)
+{
+	BOOST_CHECK_CLOSE(a.scale.x, b.scale.x, 0.001f);
+	BOOST_CHECK_CLOSE(a.scale.y, b.scale.y, 0.001f);
+	BOOST_CHECK_CLOSE(a.scale.z, b.scale.z, 0.001f);
+	BOOST_CHECK_SMALL(a.rotation.x - b.rotation.x, 1e-5f);
+	BOOST_CHECK_SMALL(a.rotation.y - b.rotation.y, 1e-5f);
+	BOOST_CHECK_SMALL(a.rotation.z - b.rotation.z, 1e-5f);
+	BOOST_CHECK_SMALL(a.rotation.w - b.rotation.w, 1e-5f);
+	BOOST_CHECK_SMALL(a.translation.x - b.translation.x, 1e-4f);
+	BOOST_CHECK_SMALL(a.translation.y - b.translation.y, 1e-4f);
+	BOOST_CHECK_SMALL(a.translation.z - b.translation.z, 1e-4f);
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE ( channels_are_padded_with_the_identity )
+{
+	SQTArray lArray(13);
+	BOOST_CHECK_EQUAL(lArray.size(), 13);
+	BOOST_CHECK_EQUAL(lArray.stride(), 16);
+	BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(
+		lArray.channel(SQTArray::kRotationW)) % 32, 0);
+
+	const auto lSQT = fixtures::makeSQT(7, 0.5f);
+	lArray.set(7, lSQT);
+	checkClose(lArray.get(7), lSQT);
+	BOOST_CHECK_EQUAL(lArray.channel(SQTArray::kScaleX)[15], 1.0f);
+	BOOST_CHECK_EQUAL(lArray.channel(SQTArray::kRotationW)[15], 1.0f);
+	BOOST_CHECK_EQUAL(lArray.channel(SQTArray::kTranslationX)[15], 0.0f);
+}
+
+BOOST_AUTO_TEST_CASE ( mix_interpolates_every_sqt )
+{
+	const std::size_t lCount = 37;
+	SQTArray lU(lCount);
+	SQTArray lV(lCount);
+	for (std::size_t i = 0; i < lCount; ++i)
+	{
+		lU.set(i, fixtures::makeSQT(i, 0.0f));
+		auto lSQT = fixtures::makeSQT(i, 1.0f);
+		// Every other rotation is stored with the opposite sign. That is
+		// the same rotation, and the shortest arc must still be taken.
+		if (i % 2) lSQT.rotation = lSQT.rotation * -1.0f;
+		lV.set(i, lSQT);
+	}
+
+	SQTArray lResult;
+	for (const float a : {0.0f, 0.25f, 0.5f, 1.0f})
+	{
+		mix(lU, lV, a, lResult);
+		BOOST_REQUIRE_EQUAL(lResult.size(), lCount);
+		for (std::size_t i = 0; i < lCount; ++i)
+		{
+			checkClose(lResult.get(i), reference(lU.get(i), lV.get(i), a));
+		}
+	}
+
+	// The result may alias an input.
+	mix(lU, lV, 0.5f, lResult);
+	mix(lU, lV, 0.5f, lU);
+	checkClose(lU.get(3), lResult.get(3));
+}
+
+BOOST_AUTO_TEST_CASE ( mix_weighs_every_sqt_with_its_mask )
+{
+	const std::size_t lCount = 21;
+	SQTArray lU(lCount);
+	SQTArray lV(lCount);
+	std::vector<float, allocator<float, 32>> lMask(lU.stride(), 0.0f);
+	for (std::size_t i = 0; i < lCount; ++i)
+	{
+		lU.set(i, fixtures::makeSQT(i, 0.0f));
+		lV.set(i, fixtures::makeSQT(i, 1.0f));
+		lMask[i] = float(i % 3) / 2.0f;
+	}
+
+	SQTArray lResult;
+	mix(lU, lV, 0.5f, lMask.data(), lResult);
+	for (std::size_t i = 0; i < lCount; ++i)
+	{
+		checkClose(lResult.get(i),
+			reference(lU.get(i), lV.get(i), 0.5f * lMask[i]));
+	}
+}
+
+BOOST_AUTO_TEST_CASE ( additive_layers_undo_the_difference )
+{
+	const std::size_t lCount = 19;
+	SQTArray lReference(lCount);
+	SQTArray lPose(lCount);
+	for (std::size_t i = 0; i < lCount; ++i)
+	{
+		lReference.set(i, fixtures::makeSQT(i, 0.0f));
+		lPose.set(i, fixtures::makeSQT(i + 3, 0.7f));
+	}
+
+	SQTArray lDifference;
+	difference(lReference, lPose, lDifference);
+	for (std::size_t i = 0; i < lCount; ++i)
+	{
+		const auto lExpected = lReference.get(i).rotation.conjugate()
+			* lPose.get(i).rotation;
+		const auto lActual = lDifference.get(i).rotation;
+		BOOST_CHECK_SMALL(lActual.x - lExpected.x, 1e-5f);
+		BOOST_CHECK_SMALL(lActual.y - lExpected.y, 1e-5f);
+		BOOST_CHECK_SMALL(lActual.z - lExpected.z, 1e-5f);
+		BOOST_CHECK_SMALL(lActual.w - lExpected.w, 1e-5f);
+	}
+
+	// A full weight turns the reference into the pose, no weight leaves it.
+	SQTArray lResult;
+	applyAdditive(lReference, lDifference, 1.0f, nullptr, lResult);
+	for (std::size_t i = 0; i < lCount; ++i)
+	{
+		checkClose(lResult.get(i), lPose.get(i));
+	}
+	applyAdditive(lReference, lDifference, 0.0f, nullptr, lResult);
+	for (std::size_t i = 0; i < lCount; ++i)
+	{
+		checkClose(lResult.get(i), lReference.get(i));
+	}
+}
@@ -0,0 +1,59 @@
+#define BOOST_TEST_MODULE Skinning test
+#include <boost/test/unit_test.hpp>
+
+#include "Math/Skinning.hpp"
+#include "Fixtures.hpp"
+#include <limits>
+#include <vector>
+
+using namespace gintonic;
+
+BOOST_AUTO_TEST_CASE ( every_position_is_moved_by_its_joints )
+{
+	const fixtures::Character lCharacter(1001);
+	std::vector<float> lResult(3 * 1001, 0.0f);
+	lCharacter.skin(lResult, 0, 500);
+	lCharacter.skin(lResult, 500, 1001);
+	for (std::size_t i = 0; i < 1001; ++i)
+	{
+		const auto lExpected = lCharacter.reference(i);
+		BOOST_CHECK_SMALL(lResult[3 * i + 0] - lExpected.x, 1e-4f);
+		BOOST_CHECK_SMALL(lResult[3 * i + 1] - lExpected.y, 1e-4f);
+		BOOST_CHECK_SMALL(lResult[3 * i + 2] - lExpected.z, 1e-4f);
+	}
+}
+
+BOOST_AUTO_TEST_CASE ( unused_influences_are_skipped )
+{
+	fixtures::Character lCharacter(1001);
+
+	// Pad the palette with NaNs, so that reading past the joints shows.
+	const auto lNaN = std::numeric_limits<float>::quiet_NaN();
+	lCharacter.palette.resize(2 * lCharacter.jointCount,
+		mat4f(vec4f(lNaN, lNaN, lNaN, lNaN), vec4f(lNaN, lNaN, lNaN, lNaN),
+			vec4f(lNaN, lNaN, lNaN, lNaN), vec4f(lNaN, lNaN, lNaN, lNaN)));
+
+	// Some vertices pad their last influence with GT_JOINT_NONE, and give
+	// it no weight. Others have a weight for a joint that does not exist.
+	const auto lVertexCount = lCharacter.jointIndices.size() / 4;
+	for (std::size_t v = 0; v < lVertexCount; v += 3)
+	{
+		lCharacter.jointIndices[4 * v + 3] = GT_JOINT_NONE;
+		lCharacter.jointWeights[4 * v + 3] = 0.0f;
+	}
+	for (std::size_t v = 1; v < lVertexCount; v += 5)
+	{
+		lCharacter.jointIndices[4 * v + 2] = GT_JOINT_NONE;
+		lCharacter.jointIndices[4 * v + 1] = -1;
+	}
+
+	std::vector<float> lResult(3 * 1001, 0.0f);
+	lCharacter.skin(lResult, 0, 1001);
+	for (std::size_t i = 0; i < 1001; ++i)
+	{
+		const auto lExpected = lCharacter.reference(i);
+		BOOST_CHECK_SMALL(lResult[3 * i + 0] - lExpected.x, 1e-4f);
+		BOOST_CHECK_SMALL(lResult[3 * i + 1] - lExpected.y, 1e-4f);
+		BOOST_CHECK_SMALL(lResult[3 * i + 2] - lExpected.z, 1e-4f);
+	}
+}
@@ -0,0 +1,315 @@
+#define BOOST_TEST_MODULE SkinningCache test
+#include <boost/test/unit_test.hpp>
+
+#include "Graphics/OpenGL/RecordingContext.hpp"
+#include "Graphics/SkinningCache.hpp"
+#include "Foundation/WorkerPool.hpp"
+#include "Entity.hpp"
+#include "Fixtures.hpp"
+#include <cstring>
+
+using namespace gintonic;
+
+namespace {
+
+bool bitwiseEqual(const mat4f& a, const mat4f& b)
+{
+	return std::memcmp(&a, &b, sizeof(mat4f)) == 0;
+}
+
+// Only the nine floats, the padding after them is undefined.
+bool bitwiseEqual(const mat3f& a, const mat3f& b)
+{
+	return std::memcmp(a.data, b.data, sizeof(a.data)) == 0;
+}
+
+// Three joints and twelve frames, so the clip lasts half a second.
+struct Crowd
+{
+	OpenGL::RecordingContext context;
+	std::shared_ptr<AnimationClip> clip;
+	std::shared_ptr<Mesh> mesh;
+	std::vector<std::shared_ptr<Entity>> entities;
+	WorkerPool workers;
+	SkinningCache skinning;
+
+	Crowd()
+	: clip(fixtures::makeClip(
+		fixtures::makeSkeleton({GT_JOINT_NONE, 0, 1}), 12))
+	, mesh(fixtures::makeSkinnedMesh())
+	, workers(0)
+	, skinning(workers)
+	{
+		skinning.setQuantum(0.1f);
+	}
+
+	// Add an entity that started the clip at the given time.
+	Entity& start(const float startTime)
+	{
+		entities.push_back(
+			fixtures::makeAnimatedEntity(mesh, *clip, startTime));
+		return *entities.back();
+	}
+
+	// Check that a palette is the pose of the clip at the given time since
+	// its start.
+	void checkPose(const std::uint32_t index, const float phase) const
+	{
+		BOOST_REQUIRE(index < skinning.size());
+		const auto& lPalette = skinning[index];
+		BOOST_REQUIRE_EQUAL(lPalette.count, clip->jointCount());
+		SkinningCache::Matrix4fArray lExpected(lPalette.count);
+		clip->evaluatePose(0.0f, phase, lExpected.data());
+		for (std::uint32_t j = 0; j < lPalette.count; ++j)
+		{
+			const auto& lMatrix =
+				skinning.jointMatrices()[lPalette.offset + j];
+			for (int k = 0; k < 16; ++k)
+			{
+				BOOST_CHECK_SMALL(lMatrix.value_ptr()[k]
+					- lExpected[j].value_ptr()[k], 1e-4f);
+			}
+		}
+	}
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE ( phases_are_rounded_to_the_quantum )
+{
+	Crowd lCrowd;
+	auto& lA = lCrowd.start(0.0f);
+	auto& lB = lCrowd.start(-0.04f);
+	auto& lC = lCrowd.start(-0.06f);
+
+	// At 0.3 seconds, A and B are at 3 quanta, and C is at 4.
+	lCrowd.skinning.clear(0.3f);
+	const auto lIndexA = lCrowd.skinning.add(lA);
+	const auto lIndexB = lCrowd.skinning.add(lB);
+	const auto lIndexC = lCrowd.skinning.add(lC);
+	BOOST_CHECK_EQUAL(lIndexA, lIndexB);
+	BOOST_CHECK_NE(lIndexA, lIndexC);
+	BOOST_CHECK_EQUAL(lCrowd.skinning.size(), 2);
+
+	lCrowd.skinning.evaluate();
+	lCrowd.checkPose(lIndexA, 0.3f);
+	lCrowd.checkPose(lIndexC, 0.4f);
+}
+
+BOOST_AUTO_TEST_CASE ( entities_at_the_same_phase_share_one_pose )
+{
+	Crowd lCrowd;
+	lCrowd.skinning.setQuantum(0.0f);
+	auto& lA = lCrowd.start(-0.25f);
+	auto& lB = lCrowd.start(-0.25f);
+
+	lCrowd.skinning.clear(0.0f);
+	const auto lIndex = lCrowd.skinning.add(lA);
+	BOOST_CHECK_EQUAL(lCrowd.skinning.add(lB), lIndex);
+	BOOST_CHECK_EQUAL(lCrowd.skinning.find(&lA), lIndex);
+	BOOST_CHECK_EQUAL(lCrowd.skinning.find(&lB), lIndex);
+	BOOST_REQUIRE_EQUAL(lCrowd.skinning.size(), 1);
+
+	// The palette remembers the first entity that was added with it.
+	BOOST_CHECK_EQUAL(lCrowd.skinning[lIndex].entity, &lA);
+
+	lCrowd.skinning.evaluate();
+	BOOST_CHECK_EQUAL(lCrowd.skinning.jointMatrices().size(),
+		lCrowd.clip->jointCount());
+	lCrowd.checkPose(lIndex, 0.25f);
+}
+
+BOOST_AUTO_TEST_CASE ( time_past_the_end_of_the_clip_is_clamped )
+{
+	Crowd lCrowd;
+	auto& lA = lCrowd.start(-0.7f);
+	auto& lB = lCrowd.start(-2.0f);
+	auto& lC = lCrowd.start(-0.2f);
+
+	lCrowd.skinning.clear(0.0f);
+	const auto lIndexA = lCrowd.skinning.add(lA);
+	BOOST_CHECK_EQUAL(lCrowd.skinning.add(lB), lIndexA);
+	BOOST_CHECK_NE(lCrowd.skinning.add(lC), lIndexA);
+	BOOST_CHECK(!lCrowd.clip->isLooping);
+
+	lCrowd.skinning.evaluate();
+	lCrowd.checkPose(lIndexA, lCrowd.clip->duration());
+	lCrowd.checkPose(lIndexA, 10.0f);
+}
+
+BOOST_AUTO_TEST_CASE ( the_least_recently_used_pose_is_dropped )
+{
+	Crowd lCrowd;
+	lCrowd.skinning.setCapacity(2);
+	auto& lA = lCrowd.start(0.0f);
+	auto& lB = lCrowd.start(-0.1f);
+	auto& lC = lCrowd.start(-0.2f);
+
+	// Every frame is at the same time, so the entities keep their phase.
+	lCrowd.skinning.clear(0.1f);
+	lCrowd.skinning.add(lA);
+	lCrowd.skinning.add(lB);
+	lCrowd.skinning.evaluate();
+	BOOST_CHECK_EQUAL(lCrowd.skinning.hits(), 0);
+	BOOST_CHECK_EQUAL(lCrowd.skinning.misses(), 2);
+
+	// Using A makes B the least recently used pose, so keeping C drops B.
+	lCrowd.skinning.clear(0.1f);
+	lCrowd.skinning.add(lA);
+	lCrowd.skinning.add(lC);
+	lCrowd.skinning.evaluate();
+	BOOST_CHECK_EQUAL(lCrowd.skinning.hits(), 1);
+	BOOST_CHECK_EQUAL(lCrowd.skinning.misses(), 1);
+
+	lCrowd.skinning.clear(0.1f);
+	const auto lIndexA = lCrowd.skinning.add(lA);
+	const auto lIndexB = lCrowd.skinning.add(lB);
+	const auto lIndexC = lCrowd.skinning.add(lC);
+	lCrowd.skinning.evaluate();
+	BOOST_CHECK_EQUAL(lCrowd.skinning.hits(), 2);
+	BOOST_CHECK_EQUAL(lCrowd.skinning.misses(), 1);
+
+	// The kept poses are the same as evaluated ones.
+	lCrowd.checkPose(lIndexA, 0.1f);
+	lCrowd.checkPose(lIndexB, 0.2f);
+	lCrowd.checkPose(lIndexC, 0.3f);
+
+	// Without a capacity, nothing is kept.
+	lCrowd.skinning.setCapacity(0);
+	lCrowd.skinning.clear(0.1f);
+	lCrowd.skinning.add(lA);
+	lCrowd.skinning.evaluate();
+	BOOST_CHECK_EQUAL(lCrowd.skinning.hits(), 0);
+	BOOST_CHECK_EQUAL(lCrowd.skinning.misses(), 1);
+}
+
+BOOST_AUTO_TEST_CASE ( hits_count_every_entity_that_is_not_evaluated )
+{
+	Crowd lCrowd;
+	auto& lA = lCrowd.start(0.0f);
+	auto& lB = lCrowd.start(0.0f);
+	auto& lC = lCrowd.start(-0.2f);
+
+	// B shares with A; A and C are evaluated.
+	lCrowd.skinning.clear(0.1f);
+	lCrowd.skinning.add(lA);
+	lCrowd.skinning.add(lB);
+	lCrowd.skinning.add(lC);
+	BOOST_CHECK_EQUAL(lCrowd.skinning.hits(), 1);
+	lCrowd.skinning.evaluate();
+	BOOST_CHECK_EQUAL(lCrowd.skinning.hits(), 1);
+	BOOST_CHECK_EQUAL(lCrowd.skinning.misses(), 2);
+
+	// Adding an entity twice is not a hit.
+	lCrowd.skinning.clear(0.1f);
+	lCrowd.skinning.add(lA);
+	lCrowd.skinning.add(lA);
+	lCrowd.skinning.add(lB);
+	lCrowd.skinning.add(lC);
+	lCrowd.skinning.evaluate();
+	BOOST_CHECK_EQUAL(lCrowd.skinning.hits(), 3);
+	BOOST_CHECK_EQUAL(lCrowd.skinning.misses(), 0);
+
+	// A new quantum drops the kept poses.
+	lCrowd.skinning.setQuantum(0.05f);
+	lCrowd.skinning.clear(0.1f);
+	lCrowd.skinning.add(lA);
+	lCrowd.skinning.add(lB);
+	lCrowd.skinning.add(lC);
+	lCrowd.skinning.evaluate();
+	BOOST_CHECK_EQUAL(lCrowd.skinning.hits(), 1);
+	BOOST_CHECK_EQUAL(lCrowd.skinning.misses(), 2);
+}
+
+BOOST_AUTO_TEST_CASE ( every_skinned_entity_gets_one_palette )
+{
+	OpenGL::RecordingContext lContext;
+	const auto lClip = fixtures::makeClip(
+		fixtures::makeSkeleton({GT_JOINT_NONE, 0, 1}), 12);
+	const auto lMesh = fixtures::makeSkinnedMesh();
+	auto lStill = Entity::create("Still");
+	lStill->mesh = lMesh;
+
+	// Every entity starts at another time, so none of them share a pose.
+	std::vector<std::shared_ptr<Entity>> lEntities;
+	for (int i = 0; i < 5; ++i)
+	{
+		lEntities.push_back(fixtures::makeAnimatedEntity(lMesh, *lClip,
+			-0.1f * float(i)));
+	}
+
+	WorkerPool lWorkers(0);
+	SkinningCache lSkinning(lWorkers);
+	lSkinning.setQuantum(0.0f);
+	lSkinning.clear(0.0f);
+	BOOST_CHECK_EQUAL(lSkinning.add(*lStill), SkinningCache::kNone);
+	std::vector<std::uint32_t> lIndices;
+	for (const auto& lEntity : lEntities)
+	{
+		lIndices.push_back(lSkinning.add(*lEntity));
+	}
+	BOOST_REQUIRE_EQUAL(lSkinning.size(), lEntities.size());
+
+	// Adding an entity again gives it the palette it already has.
+	for (std::size_t i = 0; i < lEntities.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(lSkinning.add(*lEntities[i]), lIndices[i]);
+		BOOST_CHECK_EQUAL(lSkinning.find(lEntities[i].get()), lIndices[i]);
+	}
+	BOOST_CHECK_EQUAL(lSkinning.size(), lEntities.size());
+	BOOST_CHECK_EQUAL(lSkinning.find(lStill.get()), SkinningCache::kNone);
+
+	lSkinning.evaluate();
+	std::uint32_t lOffset = 0;
+	for (std::size_t i = 0; i < lSkinning.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(lSkinning[i].entity, lEntities[i].get());
+		BOOST_CHECK_EQUAL(lSkinning[i].offset, lOffset);
+		BOOST_CHECK_EQUAL(lSkinning[i].count, 3);
+		lOffset += lSkinning[i].count;
+	}
+	BOOST_CHECK_EQUAL(lSkinning.jointMatrices().size(), lOffset);
+}
+
+BOOST_AUTO_TEST_CASE ( palettes_do_not_depend_on_the_workers )
+{
+	OpenGL::RecordingContext lContext;
+	const auto lClip = fixtures::makeClip(
+		fixtures::makeSkeleton({GT_JOINT_NONE, 0, 1}), 12);
+	const auto lMesh = fixtures::makeSkinnedMesh();
+	std::vector<std::shared_ptr<Entity>> lEntities;
+	for (int i = 0; i < 50; ++i)
+	{
+		lEntities.push_back(fixtures::makeAnimatedEntity(lMesh, *lClip,
+			-0.01f * float(i)));
+	}
+
+	WorkerPool lNoWorkers(0);
+	WorkerPool lWorkers(3);
+	SkinningCache lSerial(lNoWorkers);
+	SkinningCache lParallel(lWorkers);
+	lParallel.setChunkSize(1);
+	for (auto lCache : {&lSerial, &lParallel})
+	{
+		lCache->setQuantum(0.0f);
+		lCache->clear(0.25f);
+		for (const auto& lEntity : lEntities) lCache->add(*lEntity);
+		lCache->evaluate();
+	}
+
+	BOOST_REQUIRE_EQUAL(lParallel.size(), lSerial.size());
+	for (std::size_t i = 0; i < lSerial.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(lParallel[i].entity, lSerial[i].entity);
+		BOOST_CHECK_EQUAL(lParallel[i].offset, lSerial[i].offset);
+	}
+	BOOST_REQUIRE_EQUAL(lParallel.jointMatrices().size(),
+		lSerial.jointMatrices().size());
+	for (std::size_t j = 0; j < lSerial.jointMatrices().size(); ++j)
+	{
+		BOOST_CHECK(bitwiseEqual(lParallel.jointMatrices()[j],
+			lSerial.jointMatrices()[j]));
+		BOOST_CHECK(bitwiseEqual(lParallel.jointNormalMatrices()[j],
+			lSerial.jointNormalMatrices()[j]));
+	}
+}
@@ -0,0 +1,95 @@
+#define BOOST_TEST_MODULE StateCache test
+#include <boost/test/unit_test.hpp>
+
+#include "Graphics/OpenGL/RecordingContext.hpp"
+#include "Graphics/OpenGL/StateCache.hpp"
+#include "Graphics/OpenGL/TextureObject.hpp"
+#include "Graphics/FrameStatistics.hpp"
+
+using namespace gintonic;
+using OpenGL::StateCache;
+
+BOOST_AUTO_TEST_CASE ( redundant_changes_are_elided )
+{
+	OpenGL::RecordingContext lContext;
+	FrameSample::current() = FrameSample();
+
+	StateCache::useProgram(3);
+	StateCache::useProgram(3);
+	StateCache::enable(GL_DEPTH_TEST);
+	StateCache::enable(GL_DEPTH_TEST);
+	StateCache::disable(GL_DEPTH_TEST);
+	StateCache::blendFunc(GL_ONE, GL_ONE);
+	StateCache::blendFunc(GL_ONE, GL_ONE);
+	StateCache::blendFunc(GL_ONE, GL_ZERO);
+	StateCache::depthMask(GL_FALSE);
+	StateCache::depthMask(GL_FALSE);
+	StateCache::bindFramebuffer(GL_FRAMEBUFFER, 5);
+	StateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 5);
+	StateCache::bindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+	BOOST_CHECK_EQUAL(lContext.count("glUseProgram"), 1);
+	BOOST_CHECK_EQUAL(lContext.count("glEnable"), 1);
+	BOOST_CHECK_EQUAL(lContext.count("glDisable"), 1);
+	BOOST_CHECK_EQUAL(lContext.count("glBlendFunc"), 2);
+	BOOST_CHECK_EQUAL(lContext.count("glDepthMask"), 1);
+	BOOST_CHECK_EQUAL(lContext.count("glBindFramebuffer"), 2);
+	BOOST_CHECK_EQUAL(FrameSample::current().programBinds, 1);
+	BOOST_CHECK_EQUAL(FrameSample::current().elidedStateChanges, 5);
+
+	// Untracked capabilities always go through.
+	StateCache::enable(GL_PROGRAM_POINT_SIZE);
+	StateCache::enable(GL_PROGRAM_POINT_SIZE);
+	BOOST_CHECK_EQUAL(lContext.count("glEnable"), 3);
+
+	// After invalidating, nothing is known anymore.
+	StateCache::invalidate();
+	StateCache::useProgram(3);
+	BOOST_CHECK_EQUAL(lContext.count("glUseProgram"), 2);
+}
+
+BOOST_AUTO_TEST_CASE ( textures_are_tracked_per_unit )
+{
+	OpenGL::RecordingContext lContext;
+
+	StateCache::bindTexture(0, GL_TEXTURE_2D, 7);
+	StateCache::bindTexture(1, GL_TEXTURE_2D, 8);
+	StateCache::bindTexture(0, GL_TEXTURE_2D, 7);
+	StateCache::bindTexture(1, GL_TEXTURE_2D, 8);
+	BOOST_CHECK_EQUAL(lContext.count("glBindTexture"), 2);
+	BOOST_CHECK_EQUAL(lContext.count("glActiveTexture"), 2);
+
+	// A cube map on the same unit is a different binding.
+	StateCache::bindTexture(1, GL_TEXTURE_CUBE_MAP, 8);
+	BOOST_CHECK_EQUAL(lContext.count("glBindTexture"), 3);
+	BOOST_CHECK_EQUAL(lContext.count("glActiveTexture"), 2);
+}
+
+BOOST_AUTO_TEST_CASE ( deleted_objects_are_unbound )
+{
+	OpenGL::RecordingContext lContext;
+	GLuint lName;
+	{
+		OpenGL::TextureObject lTexture;
+		lName = lTexture;
+		lTexture.bind(GL_TEXTURE_2D, 2);
+		lTexture.bind(GL_TEXTURE_2D, 2);
+		BOOST_CHECK_EQUAL(lContext.count("glBindTexture"), 1);
+	}
+	BOOST_CHECK_EQUAL(lContext.count("glDeleteTextures"), 1);
+
+	// Drivers may hand out the name of a deleted texture again.
+	StateCache::bindTexture(2, GL_TEXTURE_2D, lName);
+	BOOST_CHECK_EQUAL(lContext.count("glBindTexture"), 2);
+
+	StateCache::bindVertexArray(4);
+	StateCache::deleteVertexArrays(1, &lName);
+	StateCache::bindVertexArray(4);
+	BOOST_CHECK_EQUAL(lContext.count("glBindVertexArray"), 1);
+	const GLuint lVertexArray = 4;
+	StateCache::deleteVertexArrays(1, &lVertexArray);
+	StateCache::bindVertexArray(0);
+	BOOST_CHECK_EQUAL(lContext.count("glBindVertexArray"), 1);
+	StateCache::bindVertexArray(4);
+	BOOST_CHECK_EQUAL(lContext.count("glBindVertexArray"), 2);
+}
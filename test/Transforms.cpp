@@ -0,0 +1,234 @@
+#define BOOST_TEST_MODULE Transforms test
+#include <boost/test/unit_test.hpp>
+
+#include "Foundation/CPU.hpp"
+#include "Foundation/allocator.hpp"
+#include "Math/SQT.hpp"
+#include "Math/Transforms.hpp"
+#include "Math/box3f.hpp"
+#include "Math/mat3f.hpp"
+#include "Math/vec4f.hpp"
+#include "Fixtures.hpp"
+#include <vector>
+
+using namespace gintonic;
+
+namespace {
+
+// Odd counts, so that the remainders of the wide loops are tested too.
+constexpr std::size_t kCount = 37;
+
+void checkClose(const float a, const float b)
+{
+	BOOST_CHECK_SMALL(a - b, 1e-4f * (1.0f + std::abs(b)));
+}
+
+void checkClose(const vec3f& a, const vec3f& b)
+{
+	checkClose(a.x, b.x);
+	checkClose(a.y, b.y);
+	checkClose(a.z, b.z);
+}
+
+void checkClose(const mat4f& a, const mat4f& b)
+{
+	const auto lA = reinterpret_cast<const float*>(a.data);
+	const auto lB = reinterpret_cast<const float*>(b.data);
+	for (int k = 0; k < 16; ++k) checkClose(lA[k], lB[k]);
+}
+
+// Run the test once for every level that the CPU supports.
+template <class F> void forEachLevel(F&& test)
+{
+	const auto lSupported = static_cast<int>(supportedSIMDLevel());
+	const auto lActive = activeSIMDLevel();
+	for (int i = 0; i <= lSupported; ++i)
+	{
+		const auto lLevel = forceSIMDLevel(static_cast<SIMDLevel>(i));
+		BOOST_TEST_CHECKPOINT("SIMD level " << lLevel);
+		test();
+	}
+	forceSIMDLevel(lActive);
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE ( levels_are_clamped_to_the_supported_level )
+{
+	const auto lActive = activeSIMDLevel();
+	BOOST_CHECK(static_cast<int>(lActive)
+		<= static_cast<int>(supportedSIMDLevel()));
+	BOOST_CHECK(forceSIMDLevel(SIMDLevel::kSSE3) == SIMDLevel::kSSE3);
+	BOOST_CHECK(activeSIMDLevel() == SIMDLevel::kSSE3);
+	BOOST_CHECK(forceSIMDLevel(SIMDLevel::kAVX2) == supportedSIMDLevel());
+	forceSIMDLevel(lActive);
+}
+
+BOOST_AUTO_TEST_CASE ( matrix_products_match_the_operator )
+{
+	forEachLevel([&]
+	{
+		std::vector<mat4f, allocator<mat4f>> lLhs;
+		std::vector<mat4f, allocator<mat4f>> lRhs;
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			lLhs.emplace_back(fixtures::makeSQT(i));
+			lRhs.emplace_back(fixtures::makeSQT(i + 5));
+		}
+		// Not affine, so that the bottom row is tested too.
+		lLhs[3].m30 = 0.5f;
+		lRhs[4].m31 = -0.25f;
+
+		std::vector<mat4f, allocator<mat4f>> lResult(kCount);
+		multiply(lLhs[3], lRhs.data(), kCount, lResult.data());
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			checkClose(lResult[i], lLhs[3] * lRhs[i]);
+		}
+
+		multiply(lLhs.data(), lRhs.data(), kCount, lResult.data());
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			checkClose(lResult[i], lLhs[i] * lRhs[i]);
+		}
+
+		// The result may be an input.
+		auto lCopy = lRhs;
+		multiply(lLhs.data(), lCopy.data(), kCount, lCopy.data());
+		checkClose(lCopy[kCount - 1], lResult[kCount - 1]);
+	});
+}
+
+BOOST_AUTO_TEST_CASE ( points_and_directions_match_the_matrix )
+{
+	forEachLevel([&]
+	{
+		const mat4f lMatrix(fixtures::makeSQT(7));
+		std::vector<vec3f, allocator<vec3f>> lPoints;
+		std::vector<vec4f, allocator<vec4f>> lVectors;
+		std::vector<float> lPacked;
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			lPoints.push_back(fixtures::makePoint(i));
+			lVectors.emplace_back(lPoints.back(), float(i % 2));
+			lPacked.push_back(lPoints.back().x);
+			lPacked.push_back(lPoints.back().y);
+			lPacked.push_back(lPoints.back().z);
+		}
+
+		std::vector<vec3f, allocator<vec3f>> lResult(kCount);
+		transformPoints(lMatrix, lPoints.data(), kCount, lResult.data());
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			checkClose(lResult[i], lMatrix.apply_to_point(lPoints[i]));
+			BOOST_CHECK_EQUAL(lResult[i].dummy, 0.0f);
+		}
+		transformDirections(lMatrix, lPoints.data(), kCount, lResult.data());
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			checkClose(lResult[i], lMatrix.apply_to_direction(lPoints[i]));
+		}
+
+		std::vector<vec4f, allocator<vec4f>> lVectorResult(kCount);
+		transform(lMatrix, lVectors.data(), kCount, lVectorResult.data());
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			const auto lExpected = lMatrix * lVectors[i];
+			checkClose(lVectorResult[i].x, lExpected.x);
+			checkClose(lVectorResult[i].y, lExpected.y);
+			checkClose(lVectorResult[i].z, lExpected.z);
+			checkClose(lVectorResult[i].w, lExpected.w);
+		}
+
+		// Packed in place, which also shows the floats need no alignment.
+		auto lUnaligned = lPacked;
+		lUnaligned.insert(lUnaligned.begin(), 0.0f);
+		transformPoints(lMatrix, lUnaligned.data() + 1, kCount,
+			lUnaligned.data() + 1);
+		std::vector<float> lPackedResult(3 * kCount);
+		transformDirections(lMatrix, lPacked.data(), kCount, lPackedResult.data());
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			checkClose(vec3f(lUnaligned[3 * i + 1], lUnaligned[3 * i + 2],
+				lUnaligned[3 * i + 3]), lMatrix.apply_to_point(lPoints[i]));
+			checkClose(vec3f(lPackedResult[3 * i], lPackedResult[3 * i + 1],
+				lPackedResult[3 * i + 2]), lMatrix.apply_to_direction(lPoints[i]));
+		}
+	});
+}
+
+BOOST_AUTO_TEST_CASE ( sqts_match_the_matrix_constructor )
+{
+	forEachLevel([&]
+	{
+		std::vector<SQT, allocator<SQT>> lSQTs;
+		for (std::size_t i = 0; i < kCount; ++i) lSQTs.push_back(fixtures::makeSQT(i));
+		// A zero quaternion is handled like the constructor handles it.
+		lSQTs[2].rotation = quatf(0.0f, 0.0f, 0.0f, 0.0f);
+
+		std::vector<mat4f, allocator<mat4f>> lResult(kCount);
+		toMatrices(lSQTs.data(), kCount, lResult.data());
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			checkClose(lResult[i], mat4f(lSQTs[i]));
+		}
+	});
+}
+
+BOOST_AUTO_TEST_CASE ( boxes_are_the_bounds_of_their_transformed_corners )
+{
+	forEachLevel([&]
+	{
+		std::vector<box3f, allocator<box3f>> lBoxes;
+		std::vector<mat4f, allocator<mat4f>> lMatrices;
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			const auto lMin = fixtures::makePoint(i);
+			lBoxes.emplace_back(lMin, lMin + vec3f(1.0f, 0.5f + float(i % 3), 2.0f));
+			lMatrices.emplace_back(fixtures::makeSQT(i));
+		}
+
+		std::vector<box3f, allocator<box3f>> lResult(kCount);
+		transformBoxes(lMatrices[5], lBoxes.data(), kCount, lResult.data());
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			const auto lExpected = fixtures::referenceBox(lMatrices[5], lBoxes[i]);
+			checkClose(lResult[i].minCorner, lExpected.minCorner);
+			checkClose(lResult[i].maxCorner, lExpected.maxCorner);
+		}
+
+		transformBoxes(lMatrices.data(), lBoxes.data(), kCount, lResult.data());
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			const auto lExpected = fixtures::referenceBox(lMatrices[i], lBoxes[i]);
+			checkClose(lResult[i].minCorner, lExpected.minCorner);
+			checkClose(lResult[i].maxCorner, lExpected.maxCorner);
+		}
+	});
+}
+
+BOOST_AUTO_TEST_CASE ( normal_matrices_are_the_inverse_transposes )
+{
+	forEachLevel([&]
+	{
+		std::vector<mat4f, allocator<mat4f>> lMatrices;
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			lMatrices.emplace_back(fixtures::makeSQT(i));
+		}
+		// A shear, like a rotated child of a non-uniformly scaled parent.
+		lMatrices[1] = lMatrices[0] * lMatrices[1];
+
+		std::vector<mat3f> lResult(kCount);
+		normalMatrices(lMatrices.data(), kCount, lResult.data());
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			const auto lExpected =
+				lMatrices[i].upperLeft33().invert().transpose();
+			for (int k = 0; k < 9; ++k)
+			{
+				checkClose(lResult[i].data[k], lExpected.data[k]);
+			}
+		}
+	});
+}
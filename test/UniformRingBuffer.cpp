@@ -0,0 +1,74 @@
+#define BOOST_TEST_MODULE UniformRingBuffer test
+#include <boost/test/unit_test.hpp>
+
+#include "Graphics/OpenGL/RecordingContext.hpp"
+#include "Graphics/OpenGL/UniformRingBuffer.hpp"
+#include "Graphics/FrameStatistics.hpp"
+#include "Math/vec4f.hpp"
+
+using namespace gintonic;
+
+BOOST_AUTO_TEST_CASE ( blocks_are_aligned_and_uploaded_at_once )
+{
+	OpenGL::RecordingContext lContext;
+	FrameSample::current() = FrameSample();
+	OpenGL::UniformRingBuffer lBuffer(4096);
+
+	// The recording context reports an alignment of 256 bytes.
+	BOOST_CHECK_EQUAL(lBuffer.alignment(), 256);
+
+	const vec4f lColor(1.0f, 2.0f, 3.0f, 4.0f);
+	BOOST_CHECK_EQUAL(lBuffer.stage(lColor), 0);
+	BOOST_CHECK_EQUAL(lBuffer.stage(lColor), 256);
+	BOOST_CHECK_EQUAL(lBuffer.allocate(16, 1024), 512);
+	BOOST_CHECK_EQUAL(lBuffer.stage(lColor), 768);
+	BOOST_CHECK_EQUAL(lBuffer.size(), 512 + 1024);
+
+	lContext.clear();
+	lBuffer.upload();
+	BOOST_CHECK(lBuffer.empty());
+	BOOST_CHECK_EQUAL(lContext.count("glBufferSubData"), 1);
+	BOOST_CHECK_EQUAL(lContext.count("glBufferData"), 0);
+	BOOST_CHECK_EQUAL(FrameSample::current().uniformUploads, 1);
+	BOOST_CHECK_EQUAL(FrameSample::current().uniformBufferBytes, 1536);
+
+	// Binding the same range twice only reaches OpenGL once.
+	lBuffer.bindRange<vec4f>(1, 256);
+	lBuffer.bindRange<vec4f>(1, 256);
+	lBuffer.bindRange<vec4f>(2, 256);
+	lBuffer.bindRange<vec4f>(1, 0);
+	BOOST_CHECK_EQUAL(lContext.count("glBindBufferRange"), 3);
+}
+
+BOOST_AUTO_TEST_CASE ( the_buffer_wraps_around_and_grows )
+{
+	OpenGL::RecordingContext lContext;
+	OpenGL::UniformRingBuffer lBuffer(1024);
+	const vec4f lColor(1.0f, 2.0f, 3.0f, 4.0f);
+
+	// Three uploads of 256 bytes fit one after the other.
+	lContext.clear();
+	for (int i = 0; i < 3; ++i)
+	{
+		lBuffer.stage(&lColor, sizeof(vec4f), 256);
+		lBuffer.upload();
+	}
+	BOOST_CHECK_EQUAL(lContext.count("glBufferData"), 0);
+
+	// The fourth one still fits, the fifth one does not. Its storage is
+	// orphaned and it starts at the beginning again.
+	lBuffer.stage(&lColor, sizeof(vec4f), 256);
+	lBuffer.upload();
+	BOOST_CHECK_EQUAL(lContext.count("glBufferData"), 0);
+	lBuffer.stage(&lColor, sizeof(vec4f), 256);
+	lBuffer.upload();
+	BOOST_CHECK_EQUAL(lContext.count("glBufferData"), 1);
+	BOOST_CHECK_EQUAL(lBuffer.capacity(), 1024);
+
+	// An upload that is larger than the buffer grows it.
+	lBuffer.stage(&lColor, sizeof(vec4f), 3000);
+	lBuffer.upload();
+	BOOST_CHECK_EQUAL(lContext.count("glBufferData"), 2);
+	BOOST_CHECK_EQUAL(lBuffer.capacity(), 4096);
+	BOOST_CHECK_EQUAL(lContext.count("glBufferSubData"), 6);
+}
@@ -0,0 +1,43 @@
+#define BOOST_TEST_MODULE WorkerPool test
+#include <boost/test/unit_test.hpp>
+
+#include "Foundation/WorkerPool.hpp"
+#include <thread>
+
+using namespace gintonic;
+
+BOOST_AUTO_TEST_CASE ( every_item_is_visited_once )
+{
+	WorkerPool lWorkers(3);
+	BOOST_CHECK_EQUAL(lWorkers.workerCount(), 3);
+	for (const std::size_t lChunkSize : {0, 1, 7, 64, 5000})
+	{
+		std::vector<int> lVisits(1000, 0);
+		lWorkers.run(lVisits.size(), lChunkSize,
+			[&lVisits](const std::size_t first, const std::size_t last)
+		{
+			for (auto i = first; i < last; ++i) ++lVisits[i];
+		});
+		for (const auto lCount : lVisits) BOOST_CHECK_EQUAL(lCount, 1);
+	}
+
+	// An empty run returns right away.
+	lWorkers.run(0, 16, [](const std::size_t, const std::size_t)
+	{
+		BOOST_ERROR("An empty run has no chunks.");
+	});
+}
+
+BOOST_AUTO_TEST_CASE ( without_workers_the_caller_does_everything )
+{
+	WorkerPool lWorkers(0);
+	const auto lCaller = std::this_thread::get_id();
+	std::size_t lVisited = 0;
+	lWorkers.run(100, 8,
+		[&](const std::size_t first, const std::size_t last)
+	{
+		BOOST_CHECK(std::this_thread::get_id() == lCaller);
+		lVisited += last - first;
+	});
+	BOOST_CHECK_EQUAL(lVisited, 100);
+}
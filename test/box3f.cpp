@@ -249,4 +249,22 @@ BOOST_AUTO_TEST_CASE ( collisions_test )
 
 	BOOST_CHECK_EQUAL(intersects(a, b), false);
 
+	b.minCorner = { -1.0f, -4.0f, -1.0f };
+	b.maxCorner = {  1.0f,  4.0f,  1.0f };
+
+	a.minCorner = { -4.0f, -1.0f, -1.0f };
+	a.maxCorner = {  4.0f,  1.0f,  1.0f };
+
+	/* Picture of the situation, no corner of one box is inside the other:
+
+	    +---+
+	    | b |
+	+---+---+---+
+	| a |   |   |
+	+---+---+---+
+	    |   |
+	    +---+          */
+
+	BOOST_CHECK_EQUAL(intersects(a, b), true);
+
 }
\ No newline at end of file
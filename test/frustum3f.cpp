@@ -0,0 +1,92 @@
+#define BOOST_TEST_MODULE frustum3f test
+#include <boost/test/unit_test.hpp>
+
+#include "Foundation/allocator.hpp"
+#include "Math/box3f.hpp"
+#include "Math/frustum3f.hpp"
+#include "Math/mat4f.hpp"
+#include <vector>
+
+using namespace gintonic;
+
+namespace {
+
+// Camera at the origin looking down the negative z-axis.
+frustum3f makeFrustum()
+{
+	mat4f lProjection;
+	lProjection.set_perspective(static_cast<float>(M_PI) / 2.0f, 1.0f, 1.0f, 100.0f);
+	return frustum3f(lProjection * mat4f(1.0f));
+}
+
+box3f boxAround(const float x, const float y, const float z, const float r = 1.0f)
+{
+	return box3f(vec3f(x - r, y - r, z - r), vec3f(x + r, y + r, z + r));
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE ( default_frustum_contains_everything )
+{
+	frustum3f lFrustum;
+	BOOST_CHECK(lFrustum.intersects(boxAround(1e6f, -1e6f, 1e6f)));
+	BOOST_CHECK(lFrustum.contains(boxAround(0.0f, 0.0f, 0.0f)));
+}
+
+BOOST_AUTO_TEST_CASE ( extracted_planes )
+{
+	const auto lFrustum = makeFrustum();
+
+	// The near plane faces away from the camera at distance 1.
+	const auto& lNear = lFrustum.planes[frustum3f::kNear];
+	BOOST_CHECK_SMALL(lNear.x, 1e-5f);
+	BOOST_CHECK_SMALL(lNear.y, 1e-5f);
+	BOOST_CHECK_CLOSE(lNear.z, -1.0f, 1e-3f);
+	BOOST_CHECK_CLOSE(lNear.w, -1.0f, 1e-3f);
+
+	// The far plane faces the camera at distance 100.
+	const auto& lFar = lFrustum.planes[frustum3f::kFar];
+	BOOST_CHECK_CLOSE(lFar.z, 1.0f, 1e-3f);
+	BOOST_CHECK_CLOSE(lFar.w, 100.0f, 1e-2f);
+}
+
+BOOST_AUTO_TEST_CASE ( single_boxes )
+{
+	const auto lFrustum = makeFrustum();
+
+	BOOST_CHECK(lFrustum.intersects(boxAround(0.0f, 0.0f, -10.0f)));
+	BOOST_CHECK(lFrustum.contains(boxAround(0.0f, 0.0f, -10.0f)));
+
+	// Behind the camera, beyond the far plane, and far to the side.
+	BOOST_CHECK(!lFrustum.intersects(boxAround(0.0f, 0.0f, 10.0f)));
+	BOOST_CHECK(!lFrustum.intersects(boxAround(0.0f, 0.0f, -200.0f)));
+	BOOST_CHECK(!lFrustum.intersects(boxAround(50.0f, 0.0f, -10.0f)));
+
+	// Straddling the left plane.
+	BOOST_CHECK(lFrustum.intersects(boxAround(-10.0f, 0.0f, -10.0f)));
+	BOOST_CHECK(!lFrustum.contains(boxAround(-10.0f, 0.0f, -10.0f)));
+}
+
+BOOST_AUTO_TEST_CASE ( batch_agrees_with_single_boxes )
+{
+	const auto lFrustum = makeFrustum();
+
+	std::vector<box3f, allocator<box3f>> lBoxes;
+	for (int i = -20; i <= 20; ++i)
+	{
+		lBoxes.push_back(boxAround(static_cast<float>(i) * 3.0f, 0.0f, static_cast<float>(i) * 5.0f - 20.0f));
+	}
+	std::vector<std::uint8_t> lVisible(lBoxes.size());
+	const auto lCount = lFrustum.intersects(lBoxes.data(), lBoxes.size(), lVisible.data());
+
+	std::size_t lExpected = 0;
+	for (std::size_t i = 0; i < lBoxes.size(); ++i)
+	{
+		const bool lSingle = lFrustum.intersects(lBoxes[i]);
+		BOOST_CHECK_EQUAL(lVisible[i] != 0, lSingle);
+		if (lSingle) ++lExpected;
+	}
+	BOOST_CHECK_EQUAL(lCount, lExpected);
+	BOOST_CHECK(lCount > 0);
+	BOOST_CHECK(lCount < lBoxes.size());
+}
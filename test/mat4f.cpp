@@ -3,6 +3,7 @@
 
 #include "Math/vec4f.hpp"
 #include "Math/mat4f.hpp"
+#include "Math/mat3f.hpp"
 #include "Math/SQT.hpp"
 #include "Entity.hpp"
 #include "Camera.hpp"
@@ -465,4 +466,70 @@ BOOST_AUTO_TEST_CASE ( decomposition )
 		// Here, the tolerance parameter is back to 0.1%.
 		GINTONIC_CHECK_VECTOR3_CLOSE(lRecoveredTranslation, lTranslation, 0.1f);
 	}
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE ( affine_inverse )
+{
+	std::srand((int)std::clock());
+	const mat4f lIdentity(1.0f);
+	for (int i = 0; i < 10000; ++i)
+	{
+		const quatf lRotation = quatf(randf(), randf(), randf(), randf()).normalize();
+		const vec3f lTranslation(
+			static_cast<float>(rand() % 200) - 100.0f,
+			static_cast<float>(rand() % 200) - 100.0f,
+			static_cast<float>(rand() % 200) - 100.0f);
+		const vec3f lScale(
+			0.5f + static_cast<float>(rand() % 100) / 25.0f,
+			0.5f + static_cast<float>(rand() % 100) / 25.0f,
+			0.5f + static_cast<float>(rand() % 100) / 25.0f);
+
+		const mat4f lRigid(SQT(vec3f(1.0f, 1.0f, 1.0f), lRotation, lTranslation));
+		mat4f lShouldBeAlmostZero = lRigid * lRigid.inverseRigid() - lIdentity;
+		GINTONIC_CHECK_MATRIX_SMALL(lShouldBeAlmostZero, 0.001f);
+		lShouldBeAlmostZero = lRigid.inverseAffine() - lRigid.inverseRigid();
+		GINTONIC_CHECK_MATRIX_SMALL(lShouldBeAlmostZero, 0.001f);
+
+		// A non-uniform scale under a rotation shears the child.
+		const mat4f lParent(SQT(lScale, lRotation, lTranslation));
+		const mat4f lAffine = lParent * mat4f(SQT(
+			vec3f(lScale.z, lScale.x, lScale.y), lRotation, lTranslation));
+		lShouldBeAlmostZero = lAffine * lAffine.inverseAffine() - lIdentity;
+		GINTONIC_CHECK_MATRIX_SMALL(lShouldBeAlmostZero, 0.001f);
+		lShouldBeAlmostZero = lAffine.inverseAffine() * lAffine - lIdentity;
+		GINTONIC_CHECK_MATRIX_SMALL(lShouldBeAlmostZero, 0.001f);
+	}
+}
+
+BOOST_AUTO_TEST_CASE ( normal_matrix )
+{
+	const auto lCheckClose = [](const mat3f& lhs, const mat3f& rhs)
+	{
+		for (int k = 0; k < 9; ++k)
+		{
+			BOOST_CHECK_SMALL(lhs.data[k] - rhs.data[k], 0.0001f);
+		}
+	};
+
+	std::srand((int)std::clock());
+	for (int i = 0; i < 10000; ++i)
+	{
+		const quatf lRotation = quatf(randf(), randf(), randf(), randf()).normalize();
+		const vec3f lTranslation(randf(), randf(), randf());
+		const float s = 0.25f + static_cast<float>(rand() % 100) / 10.0f;
+		const vec3f lScale(
+			0.5f + static_cast<float>(rand() % 100) / 25.0f,
+			0.5f + static_cast<float>(rand() % 100) / 25.0f,
+			-0.5f - static_cast<float>(rand() % 100) / 25.0f);
+
+		const mat4f lSimilarity(SQT(vec3f(s, s, s), lRotation, lTranslation));
+		const mat4f lAffine(SQT(lScale, lRotation, lTranslation));
+
+		auto lExpected = lSimilarity.upperLeft33().invert().transpose();
+		lCheckClose(lSimilarity.normalMatrix(false), lExpected);
+		lCheckClose(lSimilarity.normalMatrix(), lExpected);
+
+		lExpected = lAffine.upperLeft33().invert().transpose();
+		lCheckClose(lAffine.normalMatrix(), lExpected);
+	}
+}
@@ -170,3 +170,52 @@ BOOST_AUTO_TEST_CASE(slerp_test)
         prev_q = q;
     }
 }
+
+BOOST_AUTO_TEST_CASE(slerp_has_unit_length)
+{
+    const vec3f axis = vec3f(1.0f, 2.0f, -1.0f).normalize();
+    const auto a = quatf::axis_angle(vec3f(0.0f, 1.0f, 0.0f), 0.3f);
+    for (const float angle : {0.0001f, 0.01f, 1.0f, 2.5f, 5.0f})
+    {
+        const auto b = quatf::axis_angle(axis, angle);
+        for (float lambda = 0.0f; lambda <= 1.0f; lambda += 0.05f)
+        {
+            BOOST_CHECK_SMALL(slerp(a, b, lambda).length() - 1.0f, 1e-5f);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(slerp_takes_the_short_way)
+{
+    // b is stored in the opposite hemisphere of a, but is only 0.4 radians
+    // away from it.
+    const vec3f axis(0.0f, 1.0f, 0.0f);
+    const auto a = quatf::axis_angle(axis, 0.2f);
+    const auto b = quatf::axis_angle(axis, 0.6f) * -1.0f;
+    BOOST_CHECK_LT(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w, 0.0f);
+
+    const auto halfway = slerp(a, b, 0.5f);
+    GINTONIC_CHECK_VECTOR4_SMALL((halfway - quatf::axis_angle(axis, 0.4f)),
+                                 1e-5f);
+    for (float lambda = 0.0f; lambda <= 1.0f; lambda += 0.05f)
+    {
+        const auto q = slerp(a, b, lambda);
+        BOOST_CHECK_GT(q.x * a.x + q.y * a.y + q.z * a.z + q.w * a.w, 0.9f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(slerp_ends_at_the_endpoints)
+{
+    const auto a = quatf::axis_angle(vec3f(0.0f, 1.0f, 0.0f), 0.5f);
+    const auto b = quatf::axis_angle(vec3f(1.0f, 0.0f, 0.0f), 2.0f);
+    const auto near = quatf::axis_angle(vec3f(0.0f, 1.0f, 0.0f), 0.501f);
+
+    GINTONIC_CHECK_VECTOR4_SMALL((slerp(a, b, 0.0f) - a), 1e-5f);
+    GINTONIC_CHECK_VECTOR4_SMALL((slerp(a, b, 1.0f) - b), 1e-5f);
+    GINTONIC_CHECK_VECTOR4_SMALL((slerp(a, near, 0.0f) - a), 1e-5f);
+    GINTONIC_CHECK_VECTOR4_SMALL((slerp(a, near, 1.0f) - near), 1e-5f);
+
+    // From the other hemisphere, the endpoint is the same rotation with the
+    // sign of a.
+    GINTONIC_CHECK_VECTOR4_SMALL((slerp(a, b * -1.0f, 1.0f) - b), 1e-5f);
+}